@@ -2,11 +2,17 @@
  * Sample of sending big amount of delayed messages.
  * This sample can also be used as stress test for
  * SObjectizer timers implementation.
+ *
+ * Since v.5.8.4 this sample can be used as a benchmark for
+ * schedule/cancel throughput of timers: several senders can schedule
+ * timers from different threads at the same time and timers can be
+ * cancelled right after the scheduling.
  */
 
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <chrono>
 
 #include <so_5/all.hpp>
 
@@ -28,8 +34,19 @@ struct cfg_t
 	enum class timer_type_t {
 		wheel,
 		list,
-		heap
+		heap,
+		sharded_wheel,
+		hierarchical_wheel
 	} m_timer_type = { timer_type_t::wheel };
+
+	// Count of shards for sharded_wheel timer.
+	std::size_t m_shards = 4;
+
+	// Count of senders. Every sender works on its own thread.
+	unsigned int m_senders = 1;
+
+	// Should timers be cancelled right after the scheduling?
+	bool m_cancel = false;
 };
 
 // Integer argument parsing helper.
@@ -64,8 +81,13 @@ cfg_t parse_args( int argc, char ** argv )
 				"sample.so_5.many_timers [options]\n\n"
 				"Where options are:\n"
 				"-m <count>       count of delayed messages to be sent\n"
+				"                 by every sender\n"
 				"-d <millisecons> pause for delayed messages\n"
-				"-t <type>        timer type (wheel, list, heap)\n"
+				"-t <type>        timer type (wheel, list, heap, sharded_wheel,\n"
+				"                 hierarchical_wheel)\n"
+				"-s <count>       count of shards for sharded_wheel timer\n"
+				"-p <count>       count of senders (each on its own thread)\n"
+				"-c               cancel every timer right after scheduling\n"
 				"-h               show this help\n"
 				<< std::flush;
 			std::exit( 1 );
@@ -98,9 +120,33 @@ cfg_t parse_args( int argc, char ** argv )
 				result.m_timer_type = cfg_t::timer_type_t::list;
 			else if( 0 == std::strcmp( *current, "heap" ) )
 				result.m_timer_type = cfg_t::timer_type_t::heap;
+			else if( 0 == std::strcmp( *current, "sharded_wheel" ) )
+				result.m_timer_type = cfg_t::timer_type_t::sharded_wheel;
+			else if( 0 == std::strcmp( *current, "hierarchical_wheel" ) )
+				result.m_timer_type = cfg_t::timer_type_t::hierarchical_wheel;
 			else
 				throw std::invalid_argument( "unknown type of timer" );
 		}
+		else if( 0 == std::strcmp( *current, "-s" ) )
+		{
+			++current;
+			if( current == last )
+				throw std::invalid_argument( "-s requires value (shards count)" );
+
+			result.m_shards = str_to_value< std::size_t >( *current );
+		}
+		else if( 0 == std::strcmp( *current, "-p" ) )
+		{
+			++current;
+			if( current == last )
+				throw std::invalid_argument( "-p requires value (senders count)" );
+
+			result.m_senders = str_to_value< unsigned int >( *current );
+			if( !result.m_senders )
+				throw std::invalid_argument( "-p requires non-zero value" );
+		}
+		else if( 0 == std::strcmp( *current, "-c" ) )
+			result.m_cancel = true;
 		else
 			throw std::invalid_argument( std::string( "unknown argument: " ) +
 					*current );
@@ -116,42 +162,99 @@ void show_cfg( const cfg_t & cfg )
 		timer_type = "list";
 	else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
 		timer_type = "heap";
+	else if( cfg.m_timer_type == cfg_t::timer_type_t::sharded_wheel )
+		timer_type = "sharded_wheel(" + std::to_string( cfg.m_shards ) + ")";
+	else if( cfg.m_timer_type == cfg_t::timer_type_t::hierarchical_wheel )
+		timer_type = "hierarchical_wheel";
 
 	std::cout << "timer: " << timer_type
 			<< ", messages: " << cfg.m_messages
 			<< ", delay: " << cfg.m_delay.count() << "ms"
+			<< ", senders: " << cfg.m_senders
+			<< ", cancel: " << (cfg.m_cancel ? "yes" : "no")
 			<< std::endl;
 }
 
 // Timer message.
 struct msg_timer final : public so_5::signal_t {};
 
+// Notification about completion of the work of a sender.
+struct msg_sender_finished final : public so_5::message_t
+{
+	// Time spent for scheduling (and cancelling) of timers.
+	std::chrono::steady_clock::duration m_duration;
+
+	explicit msg_sender_finished( std::chrono::steady_clock::duration duration )
+		:	m_duration( duration )
+	{}
+};
+
 // Agent-receiver.
 class a_receiver_t final : public so_5::agent_t
 {
 public :
 	a_receiver_t(
 		context_t ctx,
-		unsigned long long messages )
+		unsigned long long messages,
+		unsigned int senders,
+		unsigned long long messages_per_sender )
 		:	so_5::agent_t( ctx )
 		,	m_messages_to_receive( messages )
+		,	m_senders( senders )
+		,	m_messages_per_sender( messages_per_sender )
 	{}
 
 	void so_define_agent() override
 	{
-		so_subscribe_self().event( &a_receiver_t::evt_timer );
+		so_subscribe_self()
+			.event( &a_receiver_t::evt_timer )
+			.event( &a_receiver_t::evt_sender_finished );
 	}
 
 	void evt_timer(mhood_t< msg_timer >)
 	{
 		++m_messages_received;
-		if( m_messages_received == m_messages_to_receive )
-			so_deregister_agent_coop_normally();
+		check_completion();
+	}
+
+	void evt_sender_finished(mhood_t< msg_sender_finished > cmd)
+	{
+		++m_senders_finished;
+		m_total_duration += cmd->m_duration;
+
+		if( m_senders_finished == m_senders )
+			show_schedule_stats();
+
+		check_completion();
 	}
 
 private :
 	const unsigned long long m_messages_to_receive;
 	unsigned long long m_messages_received = { 0 };
+
+	const unsigned int m_senders;
+	const unsigned long long m_messages_per_sender;
+	unsigned int m_senders_finished = { 0 };
+	std::chrono::steady_clock::duration m_total_duration{};
+
+	void show_schedule_stats() const
+	{
+		using namespace std::chrono;
+
+		const double avg_sec = duration_cast< duration< double > >(
+				m_total_duration ).count() / m_senders;
+		std::cout << "avg schedule time per sender: " << avg_sec << "s"
+				<< ", throughput per sender: "
+				<< (avg_sec > 0.0 ? m_messages_per_sender / avg_sec : 0.0) << " timers/s"
+				<< std::endl;
+	}
+
+	void check_completion()
+	{
+		if( m_senders_finished == m_senders &&
+				m_messages_received == m_messages_to_receive )
+			so_deregister_agent_coop_normally();
+	}
 };
 
 // Agent-sender.
@@ -162,17 +265,32 @@ public :
 		context_t ctx,
 		so_5::mbox_t dest_mbox,
 		unsigned long long messages_to_send,
-		std::chrono::milliseconds delay )
+		std::chrono::milliseconds delay,
+		bool cancel )
 		:	so_5::agent_t( ctx )
 		,	m_dest_mbox( std::move( dest_mbox ) )
 		,	m_messages_to_send( messages_to_send )
 		,	m_delay( delay )
+		,	m_cancel( cancel )
 	{}
 
 	void so_evt_start() override
 	{
-		for( unsigned long long i = 0; i != m_messages_to_send; ++i )
-			so_5::send_delayed< msg_timer >( m_dest_mbox, m_delay );
+		const auto started_at = std::chrono::steady_clock::now();
+
+		if( m_cancel )
+			for( unsigned long long i = 0; i != m_messages_to_send; ++i )
+			{
+				auto id = so_5::send_periodic< msg_timer >(
+						m_dest_mbox, m_delay, std::chrono::milliseconds::zero() );
+				id.release();
+			}
+		else
+			for( unsigned long long i = 0; i != m_messages_to_send; ++i )
+				so_5::send_delayed< msg_timer >( m_dest_mbox, m_delay );
+
+		so_5::send< msg_sender_finished >( m_dest_mbox,
+				std::chrono::steady_clock::now() - started_at );
 	}
 
 private :
@@ -181,6 +299,8 @@ private :
 	const unsigned long long m_messages_to_send;
 
 	const std::chrono::milliseconds m_delay;
+
+	const bool m_cancel;
 };
 
 void run_sobjectizer( const cfg_t & cfg )
@@ -193,10 +313,18 @@ void run_sobjectizer( const cfg_t & cfg )
 			env.introduce_coop(
 				so_5::disp::active_obj::make_dispatcher( env ).binder(),
 				[&cfg]( so_5::coop_t & coop ) {
-					auto a_receiver = coop.make_agent< a_receiver_t >( cfg.m_messages );
-
-					coop.make_agent< a_sender_t >(
-							a_receiver->so_direct_mbox(), cfg.m_messages, cfg.m_delay );
+					// There will be no timer messages if they are cancelled.
+					auto a_receiver = coop.make_agent< a_receiver_t >(
+							cfg.m_cancel ? 0ull : cfg.m_messages * cfg.m_senders,
+							cfg.m_senders,
+							cfg.m_messages );
+
+					for( unsigned int i = 0; i != cfg.m_senders; ++i )
+						coop.make_agent< a_sender_t >(
+								a_receiver->so_direct_mbox(),
+								cfg.m_messages,
+								cfg.m_delay,
+								cfg.m_cancel );
 				});
 		},
 		// Parameter tuning actions.
@@ -208,6 +336,10 @@ void run_sobjectizer( const cfg_t & cfg )
 				timer = so_5::timer_list_factory();
 			else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
 				timer = so_5::timer_heap_factory();
+			else if( cfg.m_timer_type == cfg_t::timer_type_t::sharded_wheel )
+				timer = so_5::sharded_timer_wheel_factory( cfg.m_shards );
+			else if( cfg.m_timer_type == cfg_t::timer_type_t::hierarchical_wheel )
+				timer = so_5::timer_hierarchical_wheel_factory();
 
 			params.timer_thread( timer );
 		} );
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
@@ -18,6 +19,8 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -174,6 +177,45 @@ struct threading_traits< thread_safety::safe >
 	typedef std::atomic< details::timer_status > status_holder_type;
 };
 
+//
+// timer_object_allocator
+//
+
+/*!
+ * \brief An interface for a custom allocator of timer objects.
+ *
+ * By default timer objects are allocated by operator new. A timer
+ * thread or manager can be told to use a custom allocator (for example,
+ * a pool of preallocated objects) via set_timer_object_allocator().
+ *
+ * \attention
+ * An allocator must be thread-safe because timer objects are allocated
+ * and deallocated on the context of different threads.
+ *
+ * \attention
+ * An allocator must outlive all timer objects created by it.
+ */
+class timer_object_allocator
+{
+public :
+	virtual ~timer_object_allocator() = default;
+
+	//! Allocate a memory block for a timer object.
+	/*!
+	 * \throw std::bad_alloc if there is no memory.
+	 */
+	virtual void *
+	allocate(
+		//! Size of the timer object.
+		std::size_t size ) = 0;
+
+	//! Return a memory block of destroyed timer object.
+	virtual void
+	deallocate(
+		//! Pointer returned by previous call to allocate().
+		void * ptr ) TIMERTT_NOEXCEPT = 0;
+};
+
 //
 // timer_object
 //
@@ -190,6 +232,12 @@ struct timer_object
 	//! Reference counter for the demand.
 	typename threading_traits< Thread_Safety >::reference_counter_type m_references;
 
+	//! Allocator of the demand.
+	/*!
+	 * Value nullptr means that the demand is allocated by operator new.
+	 */
+	timer_object_allocator * m_allocator = nullptr;
+
 	//! Deafault constructor.
 	inline timer_object()
 	{
@@ -212,7 +260,18 @@ struct timer_object
 	decrement_references( timer_object * t )
 	{
 		if( 0 == --(t->m_references) )
-			delete t;
+		{
+			if( t->m_allocator )
+			{
+				timer_object_allocator * allocator = t->m_allocator;
+				void * memory = dynamic_cast< void * >( t );
+
+				t->~timer_object();
+				allocator->deallocate( memory );
+			}
+			else
+				delete t;
+		}
 	}
 };
 
@@ -755,10 +814,56 @@ public :
 		return this->m_timer_quantities;
 	}
 
+	/*!
+	 * \brief Set an allocator for new timer objects.
+	 *
+	 * Value nullptr means that operator new has to be used.
+	 */
+	void
+	set_timer_object_allocator( timer_object_allocator * allocator )
+	{
+		m_timer_object_allocator = allocator;
+	}
+
 protected :
 	//! Error logger.
 	Error_Logger m_error_logger;
 
+	//! Allocator for new timer objects.
+	/*!
+	 * Can be nullptr.
+	 */
+	timer_object_allocator * m_timer_object_allocator = nullptr;
+
+	/*!
+	 * \brief Helper method for creation of a new timer object.
+	 *
+	 * Uses the allocator for timer objects if it is set.
+	 */
+	template< typename Timer_Type >
+	Timer_Type *
+	make_timer_object()
+	{
+		timer_object_allocator * allocator = m_timer_object_allocator;
+		if( !allocator )
+			return new Timer_Type();
+
+		void * memory = allocator->allocate( sizeof(Timer_Type) );
+		Timer_Type * t = nullptr;
+		try
+		{
+			t = new(memory) Timer_Type();
+		}
+		catch( ... )
+		{
+			allocator->deallocate( memory );
+			throw;
+		}
+
+		t->m_allocator = allocator;
+		return t;
+	}
+
 	//! Exception handler.
 	Actor_Exception_Handler m_exception_handler;
 
@@ -932,11 +1037,19 @@ public :
 		clear_all();
 	}
 
+	//! Size of a timer object.
+	static std::size_t
+	timer_object_size()
+	{
+		return sizeof(timer_type);
+	}
+
 	//! Create timer to be activated later.
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -1412,25 +1525,905 @@ private :
 		if( wheel_timer->m_prev )
 			wheel_timer->m_prev->m_next = wheel_timer->m_next;
 		else
-			m_wheel[ wheel_timer->m_position ].m_head = wheel_timer->m_next;
+			m_wheel[ wheel_timer->m_position ].m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			m_wheel[ wheel_timer->m_position ].m_tail = wheel_timer->m_prev;
+	}
+
+	/*!
+	 * \brief Detect elapsed timers for the current time step and
+	 * process them all.
+	 *
+	 * Object \a lock will be unlocked and then locked back.
+	 */
+	template< class Unique_Lock >
+	void
+	process_current_wheel_position(
+		Unique_Lock & lock )
+	{
+		timer_type * exec_list_head = make_exec_list();
+
+		if( exec_list_head )
+		{
+			exec_actions( lock, exec_list_head );
+
+			utilize_exec_list( exec_list_head );
+		}
+	}
+
+	/*!
+	 * \brief Make list of elapsed timers to be executed.
+	 */
+	timer_type *
+	make_exec_list()
+	{
+		timer_type * head = nullptr;
+		timer_type * tail = nullptr;
+
+		timer_type * timer = m_wheel[ m_current_position ].m_head;
+		while( timer )
+		{
+			if( timer->m_full_rolls_left )
+			{
+				timer->m_full_rolls_left -= 1;
+				timer = timer->m_next;
+			}
+			else
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				remove_timer_from_wheel( t );
+				t->m_status = timer_status::wait_for_execution;
+
+				if( head )
+				{
+					tail->m_next = t;
+					t->m_prev = tail;
+					t->m_next = nullptr;
+					tail = t;
+				}
+				else
+				{
+					head = tail = t;
+					t->m_prev = t->m_next = nullptr;
+				}
+			}
+		}
+
+		return head;
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class Unique_Lock >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		Unique_Lock & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head ) TIMERTT_NOEXCEPT
+	{
+		lock.unlock();
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+					head->m_action.exec();
+			}
+			catch( const std::exception & x )
+			{
+				// Note this invoke_noexcept_code_block() is not needed
+				// if compiler supports noexcept.
+				invoke_noexcept_code_block( [this, &x] {
+						this->m_exception_handler( x );
+					} );
+			}
+			catch( ... )
+			{
+				// Logging should not throw exceptions.
+				invoke_noexcept_code_block( [this] {
+						std::ostringstream ss;
+						ss << __FILE__ << "(" << __LINE__ 
+							<< "): an unknown exception from timer action";
+						this->m_error_logger( ss.str() );
+					} );
+
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				set_position_in_the_wheel( t, t->m_period );
+
+				insert_demand_to_wheel( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+	}
+};
+
+//
+// timer_hierarchical_wheel_engine_defaults
+//
+/*!
+ * \brief Container for static method with default values for
+ * timer_hierarchical_wheel engine.
+ */
+struct timer_hierarchical_wheel_engine_defaults
+{
+	//! Default count of levels.
+	inline static unsigned int
+	default_levels() { return 4; }
+
+	//! Default size of the wheel for every level.
+	inline static unsigned int
+	default_wheel_size() { return 256; }
+
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 1 ); }
+};
+
+//
+// timer_hierarchical_wheel_engine
+//
+
+/*!
+ * \brief A engine for hierarchical timer wheel mechanism.
+ *
+ * This engine uses several wheels (levels) of the same size.
+ * One slot of level 0 corresponds to one time step. One slot of level N
+ * corresponds to one full revolution of level N-1. So with the default
+ * parameters (4 levels, 256 slots, 1ms time step) level 0 covers 256ms,
+ * level 1 covers ~65s, level 2 covers ~4.6 hours and level 3 covers
+ * ~49 days.
+ *
+ * A timer is placed to the lowest level that can hold it. When
+ * level 0 completes a revolution the next slot of level 1 is
+ * processed and all timers from that slot are moved (cascaded) to
+ * lower levels. The same is done for higher levels.
+ *
+ * Unlike timer_wheel engine a timer is never revisited until it is
+ * cascaded. A timer is cascaded no more than once per level, so
+ * insertion, deactivation and expiration have O(1) amortized cost
+ * regardless of timer's pause.
+ *
+ * Timers with pause greater than the range of the top level are placed
+ * into the farthest slot of the top level and are placed again
+ * when that slot is processed.
+ *
+ * \note
+ * Unlike timer_wheel engine this engine doesn't require a wakeup on
+ * every time step: nearest_time_point() returns the time point of the
+ * nearest non-empty slot of level 0 or the time point of the nearest
+ * cascading.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_engine
+	:	public engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >;
+
+	struct timer_type;
+
+public :
+	//! Type with default parameters for this engine.
+	using defaults_type = timer_hierarchical_wheel_engine_defaults;
+
+	//! Alias for timer_action type.
+	using timer_action = typename base_type::timer_action;
+
+	//! Alias for scoped timer object.
+	using scoped_timer_object =
+			scoped_timer_object_holder< timer_type >;
+
+	//! Constructor with all parameters.
+	/*!
+	 * \throw std::invalid_argument if \a levels is 0, or \a wheel_size is
+	 * less than 2, or \a granularity isn't positive, or the range of the
+	 * top level can't be represented by 64-bit unsigned integer.
+	 */
+	timer_hierarchical_wheel_engine(
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of the wheel for every level.
+		unsigned int wheel_size,
+		//! Size of time step for the level 0.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_levels( levels )
+		,	m_wheel_size( wheel_size )
+		,	m_granularity( granularity )
+	{
+		if( !m_levels )
+			throw std::invalid_argument( "count of levels can't be 0" );
+		if( m_wheel_size < 2 )
+			throw std::invalid_argument( "wheel size must be greater than 1" );
+		if( m_granularity <= monotonic_clock::duration::zero() )
+			throw std::invalid_argument( "granularity must be positive" );
+
+		m_level_spans.reserve( m_levels );
+		std::uint64_t span = 1;
+		for( unsigned int level = 0; level != m_levels; ++level )
+		{
+			if( span > std::numeric_limits< std::uint64_t >::max() / m_wheel_size )
+				throw std::invalid_argument(
+						"too many levels for the specified wheel size" );
+
+			m_level_spans.push_back( span );
+			span *= m_wheel_size;
+		}
+
+		m_slots.resize( static_cast< std::size_t >(m_levels) * m_wheel_size );
+		m_level_timers.resize( m_levels, 0u );
+
+		m_start_time = monotonic_clock::now();
+	}
+
+	//! Destructor.
+	~timer_hierarchical_wheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Size of a timer object.
+	static std::size_t
+	timer_object_size()
+	{
+		return sizeof(timer_type);
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< Thread_Safety >
+	allocate()
+	{
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned when the timer thread must be
+	 * woken up: if it is the first timer or if the timer expires before
+	 * the time point returned by the last call to nearest_time_point().
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		wheel_timer->m_action.assign( std::move(action) );
+
+		// If there is no timers the current tick can be far behind
+		// the actual time.
+		if( empty() )
+			synchronize_current_tick();
+
+		// Timer must be taken under control.
+		timer_object< Thread_Safety >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		return 1 == this->m_timer_quantities.m_single_shot_count +
+				this->m_timer_quantities.m_periodic_count ||
+				wheel_timer->m_expire_tick < m_planned_tick;
+	}
+
+	/*!
+	 * \brief Perform an attempt to reschedule a timer.
+	 *
+	 * Deactivates the timer (if it is active) and then activates it
+	 * again by using just one operation on a mutex.
+	 *
+	 * \note
+	 * This operation can fail if the timer to be rescheduled is in processing.
+	 *
+	 * \attention
+	 * It move operator for a timer_action throws then timer will be
+	 * deactivated. The state for a timer_action itself will be unknown.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is in processing right now.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	reschedule(
+		//! Timer to be rescheduled. Must be in activated or deactivated state.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		// If timer is deactivated the usual activation logic can be used.
+		if( timer_status::deactivated == wheel_timer->m_status )
+			return this->activate(
+					std::move(timer), pause, period, std::move(action) );
+		else if( timer_status::active != wheel_timer->m_status )
+		{
+			// Timer which is in processing now can't be reactivated.
+			throw std::runtime_error( "timer is in processing now, "
+					"it can't be rescheduled" );
+		}
+
+		// Timer must be removed from the wheel first.
+		this->remove_timer_from_wheel( wheel_timer );
+		this->dec_timer_count( wheel_timer->kind() );
+
+		// If this assigment throws then we must deactivate the timer.
+		try
+		{
+			wheel_timer->m_action.assign( std::move(action) );
+		}
+		catch(...)
+		{
+			wheel_timer->m_status = timer_status::deactivated;
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+			// Exception must be rethrown;
+			throw;
+		}
+
+		this->perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		return wheel_timer->m_expire_tick < m_planned_tick;
+	}
+
+	//! Deactivate timer and remove it from the wheel.
+	void
+	deactivate( timer_object_holder< Thread_Safety > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_wheel( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Process all time steps that are already started.
+	 */
+	template< typename Unique_Lock >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		Unique_Lock & lock )
+	{
+		if( empty() )
+		{
+			// There is nothing to process.
+			synchronize_current_tick();
+			return;
+		}
+
+		/*
+		 * NOTE: It is possible that period between consequtive
+		 * calls to process_expired_timers will be longer than
+		 * m_granuality. In that case several time steps are
+		 * processed at once.
+		 */
+		const auto last_tick = started_ticks_count( monotonic_clock::now() );
+		while( m_current_tick < last_tick )
+		{
+			process_current_tick( lock );
+
+			++m_current_tick;
+
+			// If there is no timers on level 0 then all time steps
+			// until the next revolution of level 0 can be skipped.
+			if( !m_level_timers.front() && m_current_tick % m_wheel_size )
+				m_current_tick = (std::min)( last_tick,
+						(m_current_tick / m_wheel_size + 1u) * m_wheel_size );
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next time step to be processed.
+	 *
+	 * It is the time point of the nearest non-empty slot of level 0
+	 * or the time point of the nearest cascading (whatever is earlier).
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		const bool higher_levels_empty = (m_level_timers.size() == 1u) ||
+				std::all_of( std::next( m_level_timers.begin() ),
+						m_level_timers.end(),
+						[]( std::size_t v ) { return 0u == v; } );
+
+		// If there are timers on higher levels then the nearest
+		// revolution of level 0 is the limit for the search.
+		const std::uint64_t limit = higher_levels_empty ?
+				m_current_tick + m_wheel_size :
+				(m_current_tick + m_wheel_size - 1u) / m_wheel_size * m_wheel_size;
+
+		std::uint64_t tick = m_current_tick;
+		if( m_level_timers.front() )
+			while( tick != limit && !m_slots[ tick % m_wheel_size ].m_head )
+				++tick;
+		else
+			tick = limit;
+
+		m_planned_tick = tick;
+
+		return tick_time_point( tick );
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & item : m_slots )
+		{
+			timer_type * timer = item.m_head;
+			item = wheel_item();
+
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				t->m_status = timer_status::deactivated;
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+
+		std::fill( m_level_timers.begin(), m_level_timers.end(), 0u );
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_start_time = monotonic_clock::now();
+		this->m_current_tick = 0;
+		this->m_planned_tick = 0;
+	}
+
+private :
+	//! Type of hierarchical wheel timer.
+	struct timer_type : public timer_object< Thread_Safety >
+	{
+		//! Status of the timer.
+		typename threading_traits< Thread_Safety >::status_holder_type m_status;
+
+		//! Index of the time step at that the timer expires.
+		std::uint64_t m_expire_tick = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		std::uint64_t m_period = 0;
+
+		//! Level of the wheel the timer is in.
+		unsigned int m_level = 0;
+		//! Index of the slot (for all levels) the timer is in.
+		std::size_t m_slot = 0;
+
+		//! Timer action.
+		timer_action_holder< timer_action > m_action;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		/*!
+		 * \brief Detect type of the timer (single-shot or periodic).
+		 */
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's item.
+	struct wheel_item
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Count of levels.
+	const unsigned int m_levels;
+
+	//! Size of the wheel for every level.
+	const unsigned int m_wheel_size;
+
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! Count of time steps in one slot for every level.
+	std::vector< std::uint64_t > m_level_spans;
+
+	//! Slots of all levels.
+	/*!
+	 * Slots for level N are in [N*m_wheel_size, (N+1)*m_wheel_size).
+	 */
+	std::vector< wheel_item > m_slots;
+
+	//! Count of timers on every level.
+	std::vector< std::size_t > m_level_timers;
+
+	//! Time point for the time step with index 0.
+	monotonic_clock::time_point m_start_time;
+
+	//! Index of the next time step to be processed.
+	std::uint64_t m_current_tick = 0;
+
+	//! Index of the time step returned by the last call to
+	//! nearest_time_point().
+	mutable std::uint64_t m_planned_tick = 0;
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	//! Get the time point at which the time step starts.
+	monotonic_clock::time_point
+	tick_time_point( std::uint64_t tick ) const
+	{
+		return m_start_time + m_granularity *
+				static_cast< monotonic_clock::duration::rep >( tick );
+	}
+
+	/*!
+	 * \brief Move the current time step to the actual time.
+	 *
+	 * \attention Must be called only when there is no timers.
+	 */
+	void
+	synchronize_current_tick()
+	{
+		const auto passed = started_ticks_count( monotonic_clock::now() );
+		if( passed > m_current_tick + 1u )
+			m_current_tick = passed - 1u;
+	}
+
+	//! Get count of time steps started before \a now.
+	std::uint64_t
+	started_ticks_count( monotonic_clock::time_point now ) const
+	{
+		if( now < m_start_time )
+			return 0u;
+
+		return static_cast< std::uint64_t >(
+				(now - m_start_time) / m_granularity ) + 1u;
+	}
+
+	/*!
+	 * \brief Perform insertion of a timer into wheel data structure.
+	 *
+	 * \note
+	 * This method doesn't change reference count to timer object.
+	 */
+	template< class Duration_1, class Duration_2 >
+	void
+	perform_insertion_into_wheel(
+		//! Timer to be inserted.
+		timer_type * wheel_timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period )
+	{
+		// The current time step can be far behind the actual time
+		// because the timer thread sleeps until the nearest non-empty slot
+		// of level 0 or until the nearest cascading. So the pause has to
+		// be counted from the actual time.
+		const std::uint64_t base_tick = (std::max)( m_current_tick,
+				started_ticks_count( monotonic_clock::now() ) );
+		wheel_timer->m_expire_tick = base_tick + duration_to_ticks( pause );
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		this->insert_demand_to_wheel( wheel_timer, m_current_tick );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note This implementation performs rounding up for duration
+	 * values. For example if granularity is 10ms and duration is
+	 * 15ms then result will be 2 time steps.
+	 *
+	 * \note Never return 0. If duration is less then granularity (even
+	 * after rounding up) the value 1 will be returned. E.g. timer
+	 * will be scheduled for the next time step.
+	 *
+	 * \tparam Duration actual type for duration representation.
+	 */
+	template< class Duration >
+	std::uint64_t
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		Duration d ) const
+	{
+		auto d_units =
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		std::uint64_t r = 0;
+		if( d_units > 0 )
+			// Add g_units/2 for rounding up.
+			r = static_cast< std::uint64_t >( (d_units + g_units/2) / g_units );
+		if( !r )
+			r = 1;
+		return r;
+	}
+
+	/*!
+	 * \brief Insert timer to the appropriate level of the wheel.
+	 *
+	 * The lowest level is selected where the slot of the timer is
+	 * less than m_wheel_size slots ahead of the slot of \a base_tick.
+	 * Because of that the selected slot is always ahead of the
+	 * slot that is being processed (for levels greater than 0).
+	 */
+	void
+	insert_demand_to_wheel(
+		//! Timer to be inserted.
+		timer_type * wheel_timer,
+		//! Index of the time step that isn't processed yet.
+		//! Timer's m_expire_tick must not be less than that value.
+		std::uint64_t base_tick )
+	{
+		unsigned int level = 0;
+		std::uint64_t slot_index = 0;
+		for(;;)
+		{
+			const std::uint64_t span = m_level_spans[ level ];
+			const std::uint64_t base_index = base_tick / span;
+
+			slot_index = wheel_timer->m_expire_tick / span;
+			if( slot_index - base_index < m_wheel_size )
+				break;
+
+			if( level + 1u == m_levels )
+			{
+				// The timer is too far in the future. It will be placed
+				// into the farthest slot and will be inserted again
+				// when that slot is processed.
+				slot_index = base_index + m_wheel_size - 1u;
+				break;
+			}
+
+			++level;
+		}
+
+		wheel_timer->m_level = level;
+		wheel_timer->m_slot = static_cast< std::size_t >(level) * m_wheel_size +
+				static_cast< std::size_t >( slot_index % m_wheel_size );
+
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
+		if( item.m_head )
+		{
+			// There is a list of demands for the wheel position.
+			// New demand must be added to the end of that list.
+			wheel_timer->m_prev = item.m_tail;
+			wheel_timer->m_next = nullptr;
+			item.m_tail->m_next = wheel_timer;
+			item.m_tail = wheel_timer;
+		}
+		else
+		{
+			// There is no list of demands for this wheel position yet.
+			// New list must be started.
+			wheel_timer->m_prev = wheel_timer->m_next = nullptr;
+			item.m_head = wheel_timer;
+			item.m_tail = wheel_timer;
+		}
+
+		++m_level_timers[ level ];
+	}
+
+	/*!
+	 * \brief Remove timer from the timer_wheel.
+	 */
+	void
+	remove_timer_from_wheel( timer_type * wheel_timer )
+	{
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
+
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			item.m_head = wheel_timer->m_next;
 
 		if( wheel_timer->m_next )
 			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
 		else
-			m_wheel[ wheel_timer->m_position ].m_tail = wheel_timer->m_prev;
+			item.m_tail = wheel_timer->m_prev;
+
+		--m_level_timers[ wheel_timer->m_level ];
 	}
 
 	/*!
-	 * \brief Detect elapsed timers for the current time step and
-	 * process them all.
+	 * \brief Process the current time step.
+	 *
+	 * Timers from the higher levels are cascaded (if it's time for that)
+	 * and then timers from the current slot of level 0 are executed.
 	 *
 	 * Object \a lock will be unlocked and then locked back.
 	 */
 	template< class Unique_Lock >
 	void
-	process_current_wheel_position(
+	process_current_tick(
 		Unique_Lock & lock )
 	{
+		// Cascading must be performed from the highest level to the lowest.
+		for( unsigned int level = m_levels - 1u; level > 0u; --level )
+		{
+			const std::uint64_t span = m_level_spans[ level ];
+			if( 0u == m_current_tick % span && m_level_timers[ level ] )
+				cascade_slot(
+						static_cast< std::size_t >(level) * m_wheel_size +
+						static_cast< std::size_t >(
+								(m_current_tick / span) % m_wheel_size ) );
+		}
+
 		timer_type * exec_list_head = make_exec_list();
 
 		if( exec_list_head )
@@ -1441,47 +2434,53 @@ private :
 		}
 	}
 
+	/*!
+	 * \brief Move all timers from the slot to lower levels.
+	 */
+	void
+	cascade_slot( std::size_t slot )
+	{
+		timer_type * timer = m_slots[ slot ].m_head;
+		while( timer )
+		{
+			timer_type * t = timer;
+			timer = timer->m_next;
+
+			remove_timer_from_wheel( t );
+			insert_demand_to_wheel( t, m_current_tick );
+		}
+	}
+
 	/*!
 	 * \brief Make list of elapsed timers to be executed.
+	 *
+	 * All timers from the current slot of level 0 are elapsed.
 	 */
 	timer_type *
 	make_exec_list()
 	{
-		timer_type * head = nullptr;
-		timer_type * tail = nullptr;
+		wheel_item & item = m_slots[ m_current_tick % m_wheel_size ];
 
-		timer_type * timer = m_wheel[ m_current_position ].m_head;
-		while( timer )
-		{
-			if( timer->m_full_rolls_left )
-			{
-				timer->m_full_rolls_left -= 1;
-				timer = timer->m_next;
-			}
-			else
-			{
-				timer_type * t = timer;
-				timer = timer->m_next;
+		timer_type * head = item.m_head;
+		m_level_timers.front() -= count_and_mark_for_execution( head );
+		item = wheel_item();
 
-				remove_timer_from_wheel( t );
-				t->m_status = timer_status::wait_for_execution;
+		return head;
+	}
 
-				if( head )
-				{
-					tail->m_next = t;
-					t->m_prev = tail;
-					t->m_next = nullptr;
-					tail = t;
-				}
-				else
-				{
-					head = tail = t;
-					t->m_prev = t->m_next = nullptr;
-				}
-			}
-		}
+	/*!
+	 * \brief Mark all timers from the list as waiting for execution.
+	 *
+	 * \return count of timers in the list.
+	 */
+	static std::size_t
+	count_and_mark_for_execution( timer_type * head )
+	{
+		std::size_t count = 0u;
+		for( ; head; head = head->m_next, ++count )
+			head->m_status = timer_status::wait_for_execution;
 
-		return head;
+		return count;
 	}
 
 	/*!
@@ -1523,7 +2522,7 @@ private :
 				// Logging should not throw exceptions.
 				invoke_noexcept_code_block( [this] {
 						std::ostringstream ss;
-						ss << __FILE__ << "(" << __LINE__ 
+						ss << __FILE__ << "(" << __LINE__
 							<< "): an unknown exception from timer action";
 						this->m_error_logger( ss.str() );
 					} );
@@ -1562,9 +2561,9 @@ private :
 				// Timer is active again.
 				t->m_status = timer_status::active;
 
-				set_position_in_the_wheel( t, t->m_period );
+				t->m_expire_tick = m_current_tick + t->m_period;
 
-				insert_demand_to_wheel( t );
+				insert_demand_to_wheel( t, m_current_tick );
 			}
 			else
 			{
@@ -1692,11 +2691,19 @@ public :
 		clear_all();
 	}
 
+	//! Size of a timer object.
+	static std::size_t
+	timer_object_size()
+	{
+		return sizeof(timer_type);
+	}
+
 	//! Create timer to be activated later.
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -2304,11 +3311,19 @@ public :
 		clear_all();
 	}
 
+	//! Size of a timer object.
+	static std::size_t
+	timer_object_size()
+	{
+		return sizeof(timer_type);
+	}
+
 	//! Create timer to be activated later.
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -3078,6 +4093,34 @@ public :
 		return m_engine.allocate();
 	}
 
+	//! Size of a timer object.
+	/*!
+	 * It can be used for creation of a custom timer_object_allocator.
+	 */
+	static std::size_t
+	timer_object_size()
+	{
+		return Engine::timer_object_size();
+	}
+
+	//! Set an allocator for new timer objects.
+	/*!
+	 * Value nullptr means that operator new has to be used.
+	 *
+	 * \attention
+	 * Must be called before allocation of any timer object.
+	 *
+	 * \attention
+	 * The allocator must outlive all timer objects. It includes
+	 * timers that are still held by timer_holder objects.
+	 */
+	void
+	set_timer_object_allocator( timer_object_allocator * allocator )
+	{
+		typename mixin_type::lock_guard locker{ *this };
+		m_engine.set_timer_object_allocator( allocator );
+	}
+
 	//! Activate timer and schedule it for execution.
 	/*!
 	 *
@@ -3596,6 +4639,30 @@ public :
 		join();
 	}
 
+	//! Set a hook to be called after processing of expired timers.
+	/*!
+	 * The hook is called on the context of the timer thread after
+	 * every processing of expired timers. The object's lock is released
+	 * during the call.
+	 *
+	 * It allows to perform actions that were collected by timer actions
+	 * during the processing of expired timers (for example, to deliver
+	 * them as one batch).
+	 *
+	 * \attention
+	 * The hook must not throw.
+	 *
+	 * \attention
+	 * Must be called before start().
+	 */
+	void
+	set_expired_timers_processed_hook(
+		std::function< void() > hook )
+	{
+		typename base_type::lock_guard locker{ *this };
+		this->m_expired_timers_processed_hook = std::move(hook);
+	}
+
 protected :
 	/*!
 	 * \name Object's attributes.
@@ -3603,6 +4670,12 @@ protected :
 	 */
 	//! Shutdown flag.
 	bool m_shutdown = false;
+
+	//! Hook to be called after processing of expired timers.
+	/*!
+	 * Can be empty.
+	 */
+	std::function< void() > m_expired_timers_processed_hook;
 	/*!
 	 * \}
 	 */
@@ -3617,6 +4690,15 @@ protected :
 		{
 			this->m_engine.process_expired_timers( locker );
 
+			if( this->m_expired_timers_processed_hook )
+			{
+				locker.unlock();
+				invoke_noexcept_code_block( [this] {
+						this->m_expired_timers_processed_hook();
+					} );
+				locker.lock();
+			}
+
 			sleep_for_next_event( locker );
 		}
 
@@ -3842,6 +4924,206 @@ using default_timer_wheel_thread =
 				default_error_logger,
 				default_actor_exception_handler >;
 
+//
+// timer_hierarchical_wheel_thread_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						::timertt::thread_safety::safe,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	using base_type =
+			details::thread_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							::timertt::thread_safety::safe,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_thread_template()
+		:	timer_hierarchical_wheel_thread_template(
+				base_type::default_levels(),
+				base_type::default_wheel_size(),
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with levels, wheel size and granularity parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of the wheel for every level.
+		unsigned int wheel_size,
+		//! Size of time step for the level 0.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_thread_template(
+				levels,
+				wheel_size,
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of the wheel for every level.
+		unsigned int wheel_size,
+		//! Size of time step for the level 0.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				levels,
+				wheel_size,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// timer_hierarchical_wheel_manager_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action = default_timer_action_type,
+	typename Error_Logger = default_error_logger,
+	typename Actor_Exception_Handler = default_actor_exception_handler >
+class timer_hierarchical_wheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						Thread_Safety,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::manager_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							Thread_Safety,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_manager_template()
+		:	timer_hierarchical_wheel_manager_template(
+				base_type::default_levels(),
+				base_type::default_wheel_size(),
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with levels, wheel size and granularity parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of the wheel for every level.
+		unsigned int wheel_size,
+		//! Size of time step for the level 0.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_manager_template(
+				levels,
+				wheel_size,
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of the wheel for every level.
+		unsigned int wheel_size,
+		//! Size of time step for the level 0.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				levels,
+				wheel_size,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// default_timer_hierarchical_wheel_thread
+//
+/*!
+ * \brief Alias for timer_hierarchical_wheel_thread_template with
+ * the default parameters.
+ */
+using default_timer_hierarchical_wheel_thread =
+		timer_hierarchical_wheel_thread_template<
+				default_timer_action_type,
+				default_error_logger,
+				default_actor_exception_handler >;
+
 //
 // timer_list_thread_template
 //
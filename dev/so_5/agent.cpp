@@ -18,6 +18,8 @@
 #include <so_5/impl/subscription_storage_iface.hpp>
 
 #include <so_5/impl/enveloped_msg_details.hpp>
+#include <so_5/impl/event_handler_cache.hpp>
+#include <so_5/impl/agent_deadlines.hpp>
 
 #include <so_5/details/abort_on_fatal_error.hpp>
 
@@ -28,6 +30,8 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <new>
+#include <vector>
 
 namespace so_5
 {
@@ -691,11 +695,21 @@ agent_t::agent_t(
 
 agent_t::~agent_t()
 {
+	// The wakeup mbox for deadlines must forget about the agent
+	// before any other actions.
+	m_deadlines.reset();
+
 	// Sometimes it is possible that agent is destroyed without
 	// correct deregistration from SO Environment.
 	destroy_all_subscriptions_and_filters();
 }
 
+bool
+agent_t::so_cancel_deadline( deadline_id_t id ) noexcept
+{
+	return m_deadlines && m_deadlines->cancel( id );
+}
+
 void
 agent_t::so_evt_start()
 {
@@ -889,6 +903,7 @@ agent_t::so_bind_to_dispatcher(
 					message_limit::control_block_t::none(),
 					0,
 					typeid(void),
+					null_message_type_id(),
 					message_ref_t(),
 					&agent_t::demand_handler_on_start ) );
 	
@@ -1008,6 +1023,7 @@ void
 agent_t::destroy_all_subscriptions_and_filters() noexcept
 {
 	drop_all_delivery_filters();
+	invalidate_handler_cache();
 	m_subscriptions->drop_all_subscriptions();
 }
 
@@ -1051,6 +1067,7 @@ agent_t::shutdown_agent() noexcept
 									message_limit::control_block_t::none(),
 									0,
 									typeid(void),
+									null_message_type_id(),
 									message_ref_t(),
 									&agent_t::demand_handler_on_finish ) );
 
@@ -1099,6 +1116,10 @@ agent_t::so_create_event_subscription(
 				so_5::rc_agent_deactivated,
 				"new subscription can't made for deactivated agent" );
 
+	// Pointers to event handlers can become invalid even if
+	// the subscription fails.
+	invalidate_handler_cache();
+
 	m_subscriptions->create_event_subscription(
 			mbox_ref,
 			msg_type,
@@ -1124,6 +1145,8 @@ agent_t::so_create_deadletter_subscription(
 				so_5::rc_agent_deactivated,
 				"new deadletter handler can't be set for deactivated agent" );
 
+	invalidate_handler_cache();
+
 	m_subscriptions->create_event_subscription(
 			mbox,
 			msg_type,
@@ -1145,6 +1168,7 @@ agent_t::so_destroy_deadletter_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_deadletter_handler" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, deadletter_state );
 }
 
@@ -1176,6 +1200,7 @@ agent_t::do_drop_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_subscription" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
 }
 
@@ -1191,6 +1216,7 @@ agent_t::do_drop_subscription_for_all_states(
 	ensure_operation_is_on_working_thread(
 			"do_drop_subscription_for_all_states" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
 }
 
@@ -1201,7 +1227,7 @@ agent_t::do_check_subscription_presence(
 	const state_t & target_state ) const noexcept
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, target_state );
+			mbox->id(), msg_type, find_message_type_id( msg_type ), target_state );
 }
 
 bool
@@ -1210,7 +1236,8 @@ agent_t::do_check_deadletter_presence(
 	const std::type_index & msg_type ) const noexcept
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, deadletter_state );
+			mbox->id(), msg_type, find_message_type_id( msg_type ),
+			deadletter_state );
 }
 
 namespace {
@@ -1258,6 +1285,25 @@ select_demand_handler_for_message(
 	return result;
 }
 
+/*!
+ * \brief A helper function to get the identifier of the message type
+ * for a demand.
+ *
+ * The identifier is obtained at the moment of the demand creation.
+ * But if the message type had no identifier at that moment
+ * (the first subscription to the message type was made later) the
+ * identifier has to be found again.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+inline message_type_id_t
+actual_msg_type_id( const execution_demand_t & d ) noexcept
+{
+	return null_message_type_id() != d.m_msg_type_id ?
+			d.m_msg_type_id : find_message_type_id( d.m_msg_type );
+}
+
 } /* namespace anonymous */
 
 void
@@ -1282,6 +1328,52 @@ agent_t::push_event(
 					handler ) );
 }
 
+void
+agent_t::push_event_batch(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t messages_count )
+{
+	// The identifier of the message type is the same for all messages.
+	const auto msg_type_id = find_message_type_id( msg_type );
+
+	std::vector< execution_demand_t > demands;
+	demands.reserve( messages_count );
+	for( std::size_t i = 0u; i != messages_count; ++i )
+		demands.emplace_back(
+				this,
+				limit,
+				mbox_id,
+				msg_type,
+				msg_type_id,
+				messages[ i ],
+				select_demand_handler_for_message( *this, messages[ i ] ) );
+
+	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	if( m_event_queue )
+		m_event_queue->push_batch( demands.data(), demands.size() );
+}
+
+void
+agent_t::push_deadlines_wakeup()
+{
+	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	if( m_event_queue )
+		m_event_queue->push(
+				execution_demand_t(
+					this,
+					message_limit::control_block_t::none(),
+					0,
+					typeid(void),
+					null_message_type_id(),
+					message_ref_t(),
+					&agent_t::demand_handler_on_deadlines ) );
+}
+
 void
 agent_t::demand_handler_on_start(
 	current_thread_id_t working_thread_id,
@@ -1438,6 +1530,34 @@ agent_t::process_message(
 		impl::process_unhandled_unknown_exception(
 				working_thread_id, *(d.m_receiver) );
 	}
+
+	// Deadlines are checked between events. It can't be done
+	// for thread-safe handlers because they can be run in parallel.
+	//
+	// NOTE: it's done outside of the try-block above because an
+	// exception from the delivery of deadline messages isn't an
+	// exception from the event handler. Such an exception is handled
+	// the same way as in demand_handler_on_deadlines().
+	if( so_5::thread_safe != thread_safety )
+		if( auto * deadlines = d.m_receiver->m_deadlines.get();
+				deadlines && !deadlines->empty() )
+		{
+			try
+			{
+				d.m_receiver->handle_expired_deadlines(
+						std::chrono::steady_clock::now() );
+			}
+			catch( const std::exception & x )
+			{
+				impl::process_unhandled_exception(
+						working_thread_id, x, *(d.m_receiver) );
+			}
+			catch( ... )
+			{
+				impl::process_unhandled_unknown_exception(
+						working_thread_id, *(d.m_receiver) );
+			}
+		}
 }
 
 void
@@ -1480,6 +1600,95 @@ agent_t::process_enveloped_msg(
 	}
 }
 
+void
+agent_t::demand_handler_on_deadlines(
+	current_thread_id_t working_thread_id,
+	execution_demand_t & d )
+{
+	impl::agent_impl::working_thread_id_sentinel_t sentinel(
+			d.m_receiver->m_working_thread_id,
+			working_thread_id );
+
+	try
+	{
+		if( auto * deadlines = d.m_receiver->m_deadlines.get() )
+		{
+			const auto now = std::chrono::steady_clock::now();
+
+			d.m_receiver->handle_expired_deadlines( now );
+
+			deadlines->wakeup_happened( now );
+			d.m_receiver->schedule_deadlines_wakeup_if_necessary();
+		}
+	}
+	catch( const std::exception & x )
+	{
+		impl::process_unhandled_exception(
+				working_thread_id, x, *(d.m_receiver) );
+	}
+	catch( ... )
+	{
+		impl::process_unhandled_unknown_exception(
+				working_thread_id, *(d.m_receiver) );
+	}
+}
+
+deadline_id_t
+agent_t::do_set_deadline(
+	std::chrono::steady_clock::duration timeout,
+	const std::type_index & msg_type,
+	message_ref_t message )
+{
+	ensure_operation_is_on_working_thread( "so_set_deadline" );
+
+	if( !m_deadlines )
+		m_deadlines = std::make_unique< impl::agent_deadlines_t >( *this );
+
+	const auto id = m_deadlines->add(
+			std::chrono::steady_clock::now() + timeout,
+			msg_type,
+			std::move(message) );
+
+	so_5::details::do_with_rollback_on_exception(
+			[this] { schedule_deadlines_wakeup_if_necessary(); },
+			[this, id] { m_deadlines->cancel( id ); } );
+
+	return id;
+}
+
+void
+agent_t::handle_expired_deadlines(
+	std::chrono::steady_clock::time_point now )
+{
+	m_deadlines->handle_expired( now,
+			[this]( const std::type_index & msg_type, message_ref_t & message ) {
+				so_5::low_level_api::deliver_message(
+						message_delivery_mode_t::ordinary,
+						*m_direct_mbox,
+						msg_type,
+						std::move(message) );
+			} );
+}
+
+void
+agent_t::schedule_deadlines_wakeup_if_necessary()
+{
+	const auto point = m_deadlines->wakeup_point_if_necessary();
+	if( point )
+	{
+		const auto now = std::chrono::steady_clock::now();
+
+		so_5::low_level_api::single_timer(
+				typeid(impl::deadlines_wakeup_mbox_t::msg_wakeup),
+				message_ref_t{},
+				m_deadlines->wakeup_mbox(),
+				*point > now ? *point - now :
+						std::chrono::steady_clock::duration::zero() );
+
+		m_deadlines->wakeup_scheduled( *point );
+	}
+}
+
 void
 agent_t::ensure_operation_is_on_working_thread(
 	const char * operation_name ) const
@@ -1605,13 +1814,58 @@ const impl::event_handler_data_t *
 agent_t::find_event_handler_for_current_state(
 	execution_demand_t & d )
 {
+	agent_t & receiver = *(d.m_receiver);
+	const state_t * current_state = &receiver.so_current_state();
+	const auto msg_type_id = actual_msg_type_id( d );
+
+	// Since v.5.8.4 the cache is used for hierarchical states only.
+	// For a state without parent there is just one lookup in
+	// the subscription storage, the cache won't make it faster.
+	if( !current_state->parent_state() )
+		return receiver.m_subscriptions->find_handler(
+				d.m_mbox_id,
+				d.m_msg_type,
+				msg_type_id,
+				*current_state );
+
+	if( !receiver.m_handler_cache )
+		{
+			// If the cache can't be created we'll work without it.
+			receiver.m_handler_cache.reset(
+					new( std::nothrow ) impl::event_handler_cache_t() );
+			if( !receiver.m_handler_cache )
+				return receiver.find_event_handler_in_states_hierarchy(
+						d.m_mbox_id, d.m_msg_type, msg_type_id, current_state );
+		}
+
 	const impl::event_handler_data_t * search_result = nullptr;
-	const state_t * s = &d.m_receiver->so_current_state();
+	if( !receiver.m_handler_cache->find(
+			d.m_mbox_id, msg_type_id, current_state, search_result ) )
+		{
+			search_result = receiver.find_event_handler_in_states_hierarchy(
+					d.m_mbox_id, d.m_msg_type, msg_type_id, current_state );
+			receiver.m_handler_cache->store(
+					d.m_mbox_id, msg_type_id, current_state, search_result );
+		}
+
+	return search_result;
+}
+
+const impl::event_handler_data_t *
+agent_t::find_event_handler_in_states_hierarchy(
+	mbox_id_t mbox_id,
+	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
+	const state_t * current_state ) const noexcept
+{
+	const impl::event_handler_data_t * search_result = nullptr;
+	const state_t * s = current_state;
 
 	do {
-		search_result = d.m_receiver->m_subscriptions->find_handler(
-				d.m_mbox_id,
-				d.m_msg_type, 
+		search_result = m_subscriptions->find_handler(
+				mbox_id,
+				msg_type,
+				msg_type_id,
 				*s );
 
 		if( !search_result )
@@ -1622,6 +1876,13 @@ agent_t::find_event_handler_for_current_state(
 	return search_result;
 }
 
+void
+agent_t::invalidate_handler_cache() noexcept
+{
+	if( m_handler_cache )
+		m_handler_cache->clear();
+}
+
 const impl::event_handler_data_t *
 agent_t::find_deadletter_handler(
 	execution_demand_t & demand )
@@ -1629,6 +1890,7 @@ agent_t::find_deadletter_handler(
 	return demand.m_receiver->m_subscriptions->find_handler(
 			demand.m_mbox_id,
 			demand.m_msg_type,
+			actual_msg_type_id( demand ),
 			deadletter_state );
 }
 
@@ -35,10 +35,12 @@
 #include <so_5/handler_makers.hpp>
 #include <so_5/message_handler_format_detector.hpp>
 #include <so_5/coop_handle.hpp>
+#include <so_5/deadline_id.hpp>
 
 #include <so_5/disp_binder.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <vector>
@@ -677,6 +679,7 @@ class SO_5_TYPE agent_t
 		friend class so_5::impl::mpsc_mbox_t;
 		friend class so_5::impl::state_switch_guard_t;
 		friend class so_5::impl::internal_agent_iface_t;
+		friend class so_5::impl::deadlines_wakeup_mbox_t;
 
 		friend class so_5::enveloped_msg::impl::agent_demand_handler_invoker_t;
 
@@ -1044,6 +1047,26 @@ class SO_5_TYPE agent_t
 				agent.push_event( limit, mbox_id, msg_type, message );
 			}
 
+		//! Push a batch of events to the agent's event queue.
+		/*!
+			This method is used by SObjectizer for the 
+			agent's event scheduling.
+
+			\since v.5.8.4
+		*/
+		static inline void
+		call_push_event_batch(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count )
+			{
+				agent.push_event_batch(
+						limit, mbox_id, msg_type, messages, messages_count );
+			}
+
 		/*!
 		 * \brief Get the agent's direct mbox.
 		 *
@@ -2539,6 +2562,93 @@ class SO_5_TYPE agent_t
 		 * \}
 		 */
 
+		/*!
+		 * \name Dealing with deadlines.
+		 * \{
+		 */
+		/*!
+		 * \brief Set a deadline.
+		 *
+		 * A deadline is a lightweight alternative to send_delayed() for
+		 * cases when a delayed message is almost always cancelled before
+		 * it fires (like a timeout for a request).
+		 *
+		 * Deadlines are kept inside the agent and are checked by the agent
+		 * itself between events. Cancelling a deadline never touches the
+		 * timer. If the agent has no events then it is woken up by a single
+		 * coarse delayed signal aligned to 10ms. A new delayed signal is
+		 * created (it's an ordinary timer and it requires the acquisition
+		 * of the timer's lock) only if the new deadline is earlier than
+		 * the already scheduled signal. It means that at most one pending
+		 * signal per 10ms interval exists regardless of the count of
+		 * deadlines, and if timeouts are the same (like timeouts for
+		 * requests) the timer is used at most once per 10ms.
+		 * So the message can arrive a bit later than the deadline.
+		 *
+		 * When the deadline elapses an instance of \a Message is sent to
+		 * the agent's direct mbox.
+		 *
+		 * Usage example:
+		 * \code
+		 * class request_processor final : public so_5::agent_t
+		 * {
+		 * 	struct request_timeout { request_id_t m_id; };
+		 * 	std::map< request_id_t, so_5::deadline_id_t > m_deadlines;
+		 * 	...
+		 * 	void on_request( mhood_t< request > cmd )
+		 * 	{
+		 * 		m_deadlines[ cmd->m_id ] = so_set_deadline< request_timeout >(
+		 * 				std::chrono::seconds{ 5 }, cmd->m_id );
+		 * 		...
+		 * 	}
+		 * 	void on_reply( mhood_t< reply > cmd )
+		 * 	{
+		 * 		so_cancel_deadline( m_deadlines[ cmd->m_id ] );
+		 * 		...
+		 * 	}
+		 * 	void on_timeout( mhood_t< request_timeout > cmd ) { ... }
+		 * };
+		 * \endcode
+		 *
+		 * \attention
+		 * Must be called only on the agent's working thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		template< typename Message, typename... Args >
+		deadline_id_t
+		so_set_deadline(
+			//! Time to wait before sending the message.
+			std::chrono::steady_clock::duration timeout,
+			//! Arguments for the message constructor.
+			Args &&... args )
+			{
+				return do_set_deadline(
+						timeout,
+						message_payload_type< Message >::subscription_type_index(),
+						message_ref_t{
+								so_5::details::make_message_instance< Message >(
+										std::forward< Args >( args )... )
+						} );
+			}
+
+		/*!
+		 * \brief Cancel a deadline.
+		 *
+		 * \retval true if the deadline was pending and is cancelled now.
+		 * \retval false if the deadline is already elapsed or cancelled.
+		 *
+		 * \attention
+		 * Must be called only on the agent's working thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		bool
+		so_cancel_deadline( deadline_id_t id ) noexcept;
+		/*!
+		 * \}
+		 */
+
 		/*!
 		 * \brief Helper method that allows to run a block of code as
 		 * non-thread-safe event handler.
@@ -2808,6 +2918,27 @@ class SO_5_TYPE agent_t
 		 */
 		impl::subscription_storage_unique_ptr_t m_subscriptions;
 
+		/*!
+		 * \brief Cache of results of event handler search.
+		 *
+		 * It's used only if the current state of the agent has
+		 * a parent state.
+		 *
+		 * \note Cache is created only when necessary.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::unique_ptr< impl::event_handler_cache_t > m_handler_cache;
+
+		/*!
+		 * \brief Deadlines set by so_set_deadline().
+		 *
+		 * \note Storage is created only when necessary.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::unique_ptr< impl::agent_deadlines_t > m_deadlines;
+
 		/*!
 		 * \brief Holder of message sinks for that agent.
 		 *
@@ -3063,6 +3194,35 @@ class SO_5_TYPE agent_t
 			const std::type_index & msg_type,
 			//! Event message.
 			const message_ref_t & message );
+
+		//! Push several events into the event queue.
+		/*!
+		 * All demands are pushed by one event_queue_t::push_batch() call.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		push_event_batch(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for these events.
+			mbox_id_t mbox_id,
+			//! Message type for events.
+			const std::type_index & msg_type,
+			//! Pointer to the first message.
+			const message_ref_t * messages,
+			//! Count of messages.
+			std::size_t messages_count );
+
+		/*!
+		 * \brief Push a demand for handling of expired deadlines.
+		 *
+		 * It's called when the wakeup signal for deadlines arrives.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		push_deadlines_wakeup();
 		/*!
 		 * \}
 		 */
@@ -3203,6 +3363,51 @@ class SO_5_TYPE agent_t
 			execution_demand_t & d,
 			const impl::event_handler_data_t * handler_data );
 
+		/*!
+		 * \brief Handles expired deadlines on the wakeup signal.
+		 *
+		 * \since v.5.8.4
+		 */
+		static void
+		demand_handler_on_deadlines(
+			current_thread_id_t working_thread_id,
+			execution_demand_t & d );
+
+		/*!
+		 * \brief Actual implementation of so_set_deadline().
+		 *
+		 * \since v.5.8.4
+		 */
+		deadline_id_t
+		do_set_deadline(
+			std::chrono::steady_clock::duration timeout,
+			const std::type_index & msg_type,
+			message_ref_t message );
+
+		/*!
+		 * \brief Send messages for all expired deadlines.
+		 *
+		 * \attention
+		 * m_deadlines must not be nullptr.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		handle_expired_deadlines(
+			std::chrono::steady_clock::time_point now );
+
+		/*!
+		 * \brief Schedule a wakeup signal for the nearest deadline
+		 * if it's necessary.
+		 *
+		 * \attention
+		 * m_deadlines must not be nullptr.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		schedule_deadlines_wakeup_if_necessary();
+
 		/*!
 		 * \brief Enables operation only if it is performed on agent's
 		 * working thread.
@@ -3274,6 +3479,30 @@ class SO_5_TYPE agent_t
 		find_event_handler_for_current_state(
 			execution_demand_t & demand );
 
+		/*!
+		 * \brief Search for event handler in the current state and
+		 * all its parent states without the usage of handler cache.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		const impl::event_handler_data_t *
+		find_event_handler_in_states_hierarchy(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
+			const state_t * current_state ) const noexcept;
+
+		/*!
+		 * \brief Drop all cached results of event handler search.
+		 *
+		 * Must be called after every modification of subscriptions.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		invalidate_handler_cache() noexcept;
+
 		/*!
 		 * \brief Search for event handler between deadletter handlers.
 		 *
@@ -26,15 +26,19 @@
 
 #include <so_5/disp/one_thread/pub.hpp>
 #include <so_5/disp/nef_one_thread/pub.hpp>
+#include <so_5/disp/bounded_one_thread/pub.hpp>
 #include <so_5/disp/active_obj/pub.hpp>
 #include <so_5/disp/active_group/pub.hpp>
 #include <so_5/disp/thread_pool/pub.hpp>
 #include <so_5/disp/adv_thread_pool/pub.hpp>
 #include <so_5/disp/nef_thread_pool/pub.hpp>
+#include <so_5/disp/ws_thread_pool/pub.hpp>
 #include <so_5/disp/prio_one_thread/strictly_ordered/pub.hpp>
 #include <so_5/disp/prio_one_thread/quoted_round_robin/pub.hpp>
 #include <so_5/disp/prio_dedicated_threads/one_per_prio/pub.hpp>
 
+#include <so_5/disp/affinity_work_thread_factory.hpp>
+
 #include <so_5/version.hpp>
 
 #include <so_5/unique_subscribers_mbox.hpp>
@@ -1,3 +1,3 @@
-set(SO_5_VERSION "5.8.3")
+set(SO_5_VERSION "5.8.4")
 set(SO_5_SHARED_LIB so.${SO_5_VERSION})
 set(SO_5_STATIC_LIB so_s.${SO_5_VERSION})
@@ -0,0 +1,86 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief An identifier of agent's deadline.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace so_5
+{
+
+//
+// deadline_id_t
+//
+/*!
+ * \brief An identifier of a deadline set by agent_t::so_set_deadline().
+ *
+ * It's a plain value (a slot index and a generation of that slot).
+ * Unlike timer_id_t there is no reference counting and there is no
+ * need to release it: a deadline is cancelled only by an explicit call
+ * to agent_t::so_cancel_deadline(). A stale identifier (the deadline
+ * is already elapsed or cancelled) is just ignored by
+ * agent_t::so_cancel_deadline().
+ *
+ * Default constructed identifier doesn't refer to any deadline.
+ *
+ * \since v.5.8.4
+ */
+class deadline_id_t
+	{
+	public :
+		deadline_id_t() noexcept = default;
+
+		deadline_id_t(
+			std::uint32_t slot,
+			std::uint32_t generation ) noexcept
+			:	m_slot{ slot }
+			,	m_generation{ generation }
+			{}
+
+		//! Index of the slot in agent's deadline storage.
+		[[nodiscard]]
+		std::uint32_t
+		slot() const noexcept { return m_slot; }
+
+		//! Generation of the slot.
+		/*!
+		 * Zero generation is never used for actual deadlines.
+		 */
+		[[nodiscard]]
+		std::uint32_t
+		generation() const noexcept { return m_generation; }
+
+		//! Does this identifier refer to some deadline?
+		[[nodiscard]]
+		bool
+		is_valid() const noexcept { return 0u != m_generation; }
+
+		[[nodiscard]]
+		bool
+		operator==( const deadline_id_t & o ) const noexcept
+			{
+				return m_slot == o.m_slot && m_generation == o.m_generation;
+			}
+
+		[[nodiscard]]
+		bool
+		operator!=( const deadline_id_t & o ) const noexcept
+			{
+				return !( *this == o );
+			}
+
+	private :
+		std::uint32_t m_slot{ 0u };
+		std::uint32_t m_generation{ 0u };
+	};
+
+} /* namespace so_5 */
+
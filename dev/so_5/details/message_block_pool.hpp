@@ -0,0 +1,575 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A pool of memory blocks for pooled message instances.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/spinlocks.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace so_5 {
+
+//
+// message_pool_stats_t
+//
+/*!
+ * \brief Statistics for a pool of message instances.
+ *
+ * \since v.5.8.4
+ */
+struct message_pool_stats_t
+	{
+		//! Count of allocations satisfied by the pool.
+		std::size_t m_hits{ 0u };
+
+		//! Count of allocations that required a new dynamic allocation.
+		std::size_t m_misses{ 0u };
+
+		//! Count of free blocks in the pool.
+		std::size_t m_free_blocks{ 0u };
+	};
+
+namespace details {
+
+//
+// message_block_pool_t
+//
+/*!
+ * \brief A thread-safe pool of memory blocks of the same size.
+ *
+ * The pool has two parts:
+ *
+ * - a shared part. It's an intrusive single-linked list of free blocks
+ *   protected by a spinlock. The shared part keeps no more than capacity()
+ *   free blocks, a block returned to the full shared part is deallocated;
+ * - a cache of free blocks for every thread that works with the pool
+ *   (see thread_cache_t). Blocks are taken from and returned to the
+ *   thread's cache without any synchronization. The spinlock of the shared
+ *   part is acquired only when the cache is empty or full, and then a group
+ *   of blocks is moved at once.
+ *
+ * The content of a thread's cache is returned to the shared part when
+ * the thread finishes.
+ *
+ * Instances of this class are never destroyed (see message_block_pool()),
+ * so memory blocks can be returned to the pool even during the destruction
+ * of static objects. But the free blocks are deallocated at the end of
+ * the program.
+ *
+ * \since v.5.8.4
+ */
+class message_block_pool_t
+	{
+		//! Type of a free block.
+		struct free_block_t
+			{
+				free_block_t * m_next;
+			};
+
+		using spinlock_t = so_5::default_spinlock_t;
+
+	public :
+		/*!
+		 * \brief A cache of free blocks for one thread.
+		 *
+		 * \note
+		 * This type is trivially destructible, so an instance can
+		 * be used by a thread even after the destruction of
+		 * thread_cache_guard_t (in that case m_closed is true and the
+		 * shared part of the pool is used directly).
+		 */
+		struct thread_cache_t
+			{
+				//! Head of the list of free blocks.
+				free_block_t * m_head{ nullptr };
+				//! Count of free blocks in the cache.
+				std::size_t m_count{ 0u };
+				//! Count of hits that are not yet added to the pool's stats.
+				std::size_t m_hits{ 0u };
+				//! Count of misses that are not yet added to the pool's stats.
+				std::size_t m_misses{ 0u };
+				//! Has the cache been returned to the pool?
+				bool m_closed{ false };
+			};
+
+		/*!
+		 * \brief A guard that returns the content of the thread's cache
+		 * to the pool when the thread finishes.
+		 */
+		class thread_cache_guard_t
+			{
+			public :
+				thread_cache_guard_t(
+					message_block_pool_t & pool,
+					thread_cache_t & cache ) noexcept
+					:	m_pool{ pool }
+					,	m_cache{ cache }
+					{}
+
+				thread_cache_guard_t( const thread_cache_guard_t & ) = delete;
+				thread_cache_guard_t &
+				operator=( const thread_cache_guard_t & ) = delete;
+
+				~thread_cache_guard_t() noexcept
+					{
+						m_pool.close_cache( m_cache );
+					}
+
+			private :
+				message_block_pool_t & m_pool;
+				thread_cache_t & m_cache;
+			};
+
+		message_block_pool_t( const message_block_pool_t & ) = delete;
+		message_block_pool_t & operator=( const message_block_pool_t & ) = delete;
+
+		message_block_pool_t(
+			//! Size of a block.
+			std::size_t block_size )
+			:	m_block_size{ block_size < sizeof(free_block_t) ?
+					sizeof(free_block_t) : block_size }
+			{}
+
+		//! Default max count of free blocks in a pool.
+		[[nodiscard]]
+		static constexpr std::size_t
+		default_capacity() noexcept
+			{
+				return 1024u;
+			}
+
+		//! Max count of free blocks in the cache of one thread.
+		[[nodiscard]]
+		static constexpr std::size_t
+		thread_cache_capacity() noexcept
+			{
+				return 32u;
+			}
+
+		//! Allocate a block.
+		/*!
+		 * \note
+		 * Uses the global operator new if the pool is empty or
+		 * if \a size is greater than the size of the pool's blocks.
+		 */
+		[[nodiscard]]
+		void *
+		allocate( thread_cache_t & cache, std::size_t size )
+			{
+				if( size > m_block_size )
+					return ::operator new( size );
+
+				if( cache.m_closed )
+					return allocate_from_shared_part();
+
+				if( !cache.m_head )
+					refill_cache( cache );
+
+				if( cache.m_head )
+					{
+						free_block_t * r = cache.m_head;
+						cache.m_head = r->m_next;
+						--cache.m_count;
+						++cache.m_hits;
+
+						return r;
+					}
+
+				++cache.m_misses;
+				return ::operator new( m_block_size );
+			}
+
+		//! Return a block to the pool.
+		void
+		deallocate(
+			thread_cache_t & cache,
+			void * block,
+			std::size_t size ) noexcept
+			{
+				if( size > m_block_size )
+					{
+						::operator delete( block );
+						return;
+					}
+
+				if( cache.m_closed )
+					{
+						deallocate_to_shared_part( block );
+						return;
+					}
+
+				const std::size_t limit = current_thread_cache_limit();
+				if( cache.m_count >= limit )
+					{
+						// A half of the cache goes to the shared part.
+						flush_cache( cache, limit / 2u );
+						if( cache.m_count >= limit )
+							{
+								// The capacity is too small to keep anything
+								// in the cache.
+								deallocate_to_shared_part( block );
+								return;
+							}
+					}
+
+				cache.m_head = ::new( block ) free_block_t{ cache.m_head };
+				++cache.m_count;
+			}
+
+		//! Change the max count of free blocks in the shared part of the pool.
+		/*!
+		 * Extra free blocks are deallocated if the new capacity is less
+		 * than the current count of free blocks.
+		 *
+		 * \note
+		 * Caches of threads are shrunk to the new capacity the next time
+		 * a block is returned to them.
+		 */
+		void
+		set_capacity( std::size_t capacity ) noexcept
+			{
+				free_block_t * extra_blocks = nullptr;
+				{
+					std::lock_guard< spinlock_t > lock{ m_lock };
+
+					m_capacity.store( capacity, std::memory_order_relaxed );
+					while( m_free_count > capacity )
+						{
+							free_block_t * b = m_free_head;
+							m_free_head = b->m_next;
+							--m_free_count;
+
+							b->m_next = extra_blocks;
+							extra_blocks = b;
+						}
+				}
+
+				delete_blocks( extra_blocks );
+			}
+
+		//! Get the current stats for the pool.
+		/*!
+		 * \note
+		 * Hits and misses of a thread are added to the stats when
+		 * the thread exchanges blocks with the shared part of the pool
+		 * and when the thread finishes. Blocks in caches of threads
+		 * aren't counted as free blocks.
+		 */
+		[[nodiscard]]
+		message_pool_stats_t
+		query_stats() noexcept
+			{
+				std::lock_guard< spinlock_t > lock{ m_lock };
+
+				return { m_hits, m_misses, m_free_count };
+			}
+
+	private :
+		//! Size of one block.
+		const std::size_t m_block_size;
+
+		//! Object's lock.
+		spinlock_t m_lock;
+
+		//! Max count of free blocks in the shared part.
+		/*!
+		 * It's atomic because it's read without the lock to
+		 * limit the size of threads' caches.
+		 */
+		std::atomic< std::size_t > m_capacity{ default_capacity() };
+
+		//! Head of the list of free blocks.
+		free_block_t * m_free_head{ nullptr };
+
+		//! Count of free blocks.
+		std::size_t m_free_count{ 0u };
+
+		//! Count of allocations satisfied by the pool.
+		std::size_t m_hits{ 0u };
+
+		//! Count of allocations not satisfied by the pool.
+		std::size_t m_misses{ 0u };
+
+		[[nodiscard]]
+		std::size_t
+		current_thread_cache_limit() const noexcept
+			{
+				const auto capacity = m_capacity.load( std::memory_order_relaxed );
+				return capacity < thread_cache_capacity() ?
+						capacity : thread_cache_capacity();
+			}
+
+		//! Add stats of a thread's cache to the pool's stats.
+		/*!
+		 * \attention
+		 * Must be called with m_lock acquired.
+		 */
+		void
+		move_stats( thread_cache_t & cache ) noexcept
+			{
+				m_hits += cache.m_hits;
+				m_misses += cache.m_misses;
+				cache.m_hits = 0u;
+				cache.m_misses = 0u;
+			}
+
+		//! Move up to a half of cache's capacity from the shared part.
+		void
+		refill_cache( thread_cache_t & cache ) noexcept
+			{
+				const std::size_t to_move = current_thread_cache_limit() / 2u + 1u;
+
+				std::lock_guard< spinlock_t > lock{ m_lock };
+
+				move_stats( cache );
+				while( m_free_head && cache.m_count < to_move )
+					{
+						free_block_t * b = m_free_head;
+						m_free_head = b->m_next;
+						--m_free_count;
+
+						b->m_next = cache.m_head;
+						cache.m_head = b;
+						++cache.m_count;
+					}
+			}
+
+		//! Move blocks from the cache to the shared part.
+		/*!
+		 * No more than \a blocks_to_keep blocks remain in the cache.
+		 * Blocks that don't fit into the shared part are deallocated.
+		 */
+		void
+		flush_cache(
+			thread_cache_t & cache,
+			std::size_t blocks_to_keep ) noexcept
+			{
+				free_block_t * extra_blocks = nullptr;
+				{
+					std::lock_guard< spinlock_t > lock{ m_lock };
+
+					move_stats( cache );
+
+					const auto capacity = m_capacity.load( std::memory_order_relaxed );
+					while( cache.m_count > blocks_to_keep )
+						{
+							free_block_t * b = cache.m_head;
+							cache.m_head = b->m_next;
+							--cache.m_count;
+
+							if( m_free_count < capacity )
+								{
+									b->m_next = m_free_head;
+									m_free_head = b;
+									++m_free_count;
+								}
+							else
+								{
+									b->m_next = extra_blocks;
+									extra_blocks = b;
+								}
+						}
+				}
+
+				delete_blocks( extra_blocks );
+			}
+
+		//! Return the whole content of the cache to the shared part.
+		/*!
+		 * The cache isn't used after that.
+		 */
+		void
+		close_cache( thread_cache_t & cache ) noexcept
+			{
+				flush_cache( cache, 0u );
+				cache.m_closed = true;
+			}
+
+		//! Allocate a block without the thread's cache.
+		[[nodiscard]]
+		void *
+		allocate_from_shared_part()
+			{
+				{
+					std::lock_guard< spinlock_t > lock{ m_lock };
+
+					if( m_free_head )
+						{
+							free_block_t * r = m_free_head;
+							m_free_head = r->m_next;
+							--m_free_count;
+							++m_hits;
+
+							return r;
+						}
+
+					++m_misses;
+				}
+
+				return ::operator new( m_block_size );
+			}
+
+		//! Return a block without the thread's cache.
+		void
+		deallocate_to_shared_part( void * block ) noexcept
+			{
+				{
+					std::lock_guard< spinlock_t > lock{ m_lock };
+
+					if( m_free_count < m_capacity.load( std::memory_order_relaxed ) )
+						{
+							m_free_head = ::new( block ) free_block_t{ m_free_head };
+							++m_free_count;
+
+							return;
+						}
+				}
+
+				::operator delete( block );
+			}
+
+		static void
+		delete_blocks( free_block_t * blocks ) noexcept
+			{
+				while( blocks )
+					{
+						void * b = blocks;
+						blocks = blocks->m_next;
+						::operator delete( b );
+					}
+			}
+	};
+
+//
+// message_block_pool_releaser_t
+//
+/*!
+ * \brief A helper that deallocates free blocks of a pool at the end
+ * of the program.
+ *
+ * The pool itself isn't destroyed, it just becomes empty and
+ * doesn't keep blocks anymore.
+ *
+ * \since v.5.8.4
+ */
+class message_block_pool_releaser_t
+	{
+	public :
+		explicit message_block_pool_releaser_t(
+			message_block_pool_t & pool ) noexcept
+			:	m_pool{ pool }
+			{}
+
+		message_block_pool_releaser_t(
+			const message_block_pool_releaser_t & ) = delete;
+		message_block_pool_releaser_t &
+		operator=( const message_block_pool_releaser_t & ) = delete;
+
+		~message_block_pool_releaser_t() noexcept
+			{
+				m_pool.set_capacity( 0u );
+			}
+
+	private :
+		message_block_pool_t & m_pool;
+	};
+
+//
+// message_block_pool
+//
+/*!
+ * \brief Get the pool of blocks for a message type.
+ *
+ * \tparam Envelope actual type of message object to be allocated
+ * (a type derived from so_5::message_t).
+ *
+ * \note
+ * The pool object is intentionally never destroyed. It allows to
+ * destroy message instances after the completion of main().
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope >
+[[nodiscard]]
+message_block_pool_t &
+message_block_pool()
+	{
+		static message_block_pool_t * pool =
+				new message_block_pool_t{ sizeof(Envelope) };
+		static message_block_pool_releaser_t releaser{ *pool };
+
+		return *pool;
+	}
+
+//
+// message_block_thread_cache
+//
+/*!
+ * \brief Get the cache of free blocks of the current thread for
+ * a message type.
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope >
+[[nodiscard]]
+message_block_pool_t::thread_cache_t &
+message_block_thread_cache()
+	{
+		thread_local message_block_pool_t::thread_cache_t cache;
+		thread_local message_block_pool_t::thread_cache_guard_t guard{
+				message_block_pool< Envelope >(), cache };
+
+		return cache;
+	}
+
+//
+// allocate_message_block
+//
+/*!
+ * \brief Allocate memory for a pooled message instance.
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope >
+[[nodiscard]]
+void *
+allocate_message_block( std::size_t size )
+	{
+		static_assert( alignof(Envelope) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+				"over-aligned types can't be pooled" );
+
+		auto & pool = message_block_pool< Envelope >();
+		return pool.allocate( message_block_thread_cache< Envelope >(), size );
+	}
+
+//
+// deallocate_message_block
+//
+/*!
+ * \brief Return memory of a destroyed pooled message instance.
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope >
+void
+deallocate_message_block( void * ptr, std::size_t size ) noexcept
+	{
+		auto & pool = message_block_pool< Envelope >();
+		pool.deallocate( message_block_thread_cache< Envelope >(), ptr, size );
+	}
+
+} /* namespace details */
+
+} /* namespace so_5 */
+
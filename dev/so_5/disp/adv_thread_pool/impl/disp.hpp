@@ -12,7 +12,6 @@
 
 #pragma once
 
-#include <so_5/spinlocks.hpp>
 #include <so_5/atomic_refcounted.hpp>
 
 #include <so_5/event_queue.hpp>
@@ -25,19 +24,12 @@
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
-#include <forward_list>
-
-#if 0
-	#define SO_5_CHECK_INVARIANT_IMPL(what, data, file, line) \
-	if( !(what) ) { \
-		std::cerr << file << ":" << line << ": FAILED INVARIANT: " << #what << "; data: " << data << std::endl; \
-		std::abort(); \
-	}
-	#define SO_5_CHECK_INVARIANT(what, data) SO_5_CHECK_INVARIANT_IMPL(what, data, __FILE__, __LINE__)
-#else
-	#define SO_5_CHECK_INVARIANT(what, data)
-#endif
+#include <so_5/details/rollback_on_exception.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <forward_list>
+#include <memory>
 
 namespace so_5
 {
@@ -51,8 +43,6 @@ namespace adv_thread_pool
 namespace impl
 {
 
-using spinlock_t = so_5::default_spinlock_t;
-
 class agent_queue_t;
 
 namespace stats = so_5::stats;
@@ -69,6 +59,24 @@ using dispatcher_queue_t = so_5::disp::reuse::queue_of_queues_t< agent_queue_t >
 /*!
  * \brief Event queue for the agent (or cooperation).
  *
+ * Since v.5.8.4 it's a lock-free queue:
+ *
+ * - producers add demands to an intrusive lock-free stack by a single
+ *   CAS operation. Demand objects are taken from the dispatcher's
+ *   demand pool;
+ * - the queue can be activated only by one thread at a time. The worker
+ *   that got the activated queue from the dispatcher's queue is the only
+ *   consumer: it moves the whole content of the stack into its own list
+ *   (in reverse order to keep FIFO) and takes demands from that list;
+ * - the activation flag and counters of active workers are kept in one
+ *   atomic value, so the exclusion of not-thread-safe event handlers
+ *   doesn't require a lock;
+ * - a demand is counted in the size of the queue only after it is
+ *   added to the stack. The queue is activated only if its size is
+ *   greater than zero. So the worker that got the activated queue always
+ *   finds a demand and never waits for a producer that is in the middle
+ *   of push().
+ *
  * \since
  * v.5.4.0
  */
@@ -78,92 +86,137 @@ class agent_queue_t final
 	{
 		friend class so_5::intrusive_ptr_t< agent_queue_t >;
 
-	private :
-		//! Actual demand in event queue.
-		struct demand_t
-			{
-				//! Actual demand.
-				execution_demand_t m_demand;
-
-				//! Next item in queue.
-				demand_t * m_next;
-
-				demand_t()
-					:	m_next( nullptr )
-					{}
-				demand_t( execution_demand_t && original )
-					:	m_demand( std::move( original ) )
-					,	m_next( nullptr )
-					{}
-			};
+		using demand_t = so_5::disp::thread_pool::impl::demand_t;
+		using demand_pool_t = so_5::disp::thread_pool::impl::demand_pool_t;
+
+		//! Flag in m_state that tells that the queue is activated.
+		/*!
+		 * The queue is activated if it's scheduled to dispatcher queue
+		 * or it's in the hands of a worker that decides what to do with
+		 * the front demand.
+		 */
+		static constexpr const unsigned int active_flag = 1;
 
 	public :
-		static constexpr const unsigned int thread_safe_worker = 2;
-		static constexpr const unsigned int not_thread_safe_worker = 1;
+		//! Value to be added to m_state for a thread safe worker.
+		static constexpr const unsigned int thread_safe_worker = 4;
+		//! Flag in m_state for a not thread safe worker.
+		static constexpr const unsigned int not_thread_safe_worker = 2;
+
+		//! Result of an attempt to start a worker.
+		struct start_result_t
+			{
+				//! Demand to be processed.
+				/*!
+				 * It's nullptr if the worker can't be started.
+				 */
+				std::unique_ptr< demand_t > m_demand;
+
+				//! Should the queue be scheduled again?
+				bool m_need_schedule{ false };
+			};
 
 		//! Constructor.
 		agent_queue_t(
 			//! Dispatcher queue to work with.
 			outliving_reference_t< dispatcher_queue_t > disp_queue,
+			//! Pool of demand objects.
+			//! Since v.5.8.4.
+			outliving_reference_t<
+					so_5::disp::thread_pool::impl::demand_pool_t > demand_pool,
 			//! Dummy argument. It is necessary here because of
 			//! common implementation for thread-pool and
 			//! adv-thread-pool dispatchers.
-			const bind_params_t & )
+			const bind_params_t &,
+			//! NUMA node of the queue.
+			//! Since v.5.8.4.
+			std::size_t numa_node )
 			:	m_disp_queue( disp_queue.get() )
-			,	m_tail_demand( &m_head_demand )
-			,	m_active( false )
-			,	m_workers( 0 )
+			,	m_demand_pool( demand_pool.get() )
+			,	m_numa_node( numa_node )
 			{}
 
 		~agent_queue_t() override
 			{
-				while( m_head_demand.m_next )
-					delete_head();
-			}
-
-		//! Access to the queue's lock.
-		[[nodiscard]]
-		spinlock_t &
-		lock() noexcept
-			{
-				return m_lock;
+				grab_pushed_demands();
+				while( m_head )
+					m_demand_pool.deallocate( remove_head() );
 			}
 
 		//! Push next demand to queue.
 		void
 		push( execution_demand_t demand ) override
 			{
-				bool need_schedule = false;
-				{
-					// Do memory allocation before spinlock locking.
-					auto new_demand = new demand_t( std::move( demand ) );
+				auto new_demand = m_demand_pool.allocate( std::move( demand ) );
 
-					std::lock_guard< spinlock_t > lock( m_lock );
+				demand_t * d = new_demand.release();
+				push_demands( d, d );
 
-					m_tail_demand->m_next = new_demand;
-					m_tail_demand = m_tail_demand->m_next;
+				// The counter has to be incremented only after the demand
+				// is visible for the consumer. So the counter is never greater
+				// than the count of available demands.
+				m_size.fetch_add( 1 );
 
-					++m_size;
-
-					if( m_head_demand.m_next == m_tail_demand )
-						{
-							// Queue was empty. Need to detect
-							// necessity of queue activation.
-							if( !m_active )
-								if( !is_there_not_thread_safe_worker() )
-								{
-									need_schedule = true;
-									m_active = true;
-								}
-						}
+				if( try_activate() )
+					m_disp_queue.schedule( this, m_numa_node );
+			}
 
-					SO_5_CHECK_INVARIANT( !empty(), this )
-					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
-					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
-				}
+		//! Push several demands to queue.
+		/*!
+		 * All demands are added to the queue by one atomic operation and
+		 * the queue is scheduled at most once.
+		 *
+		 * \note
+		 * If a memory allocation throws then nothing is pushed and
+		 * all demands are kept intact.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t demands_count ) override
+			{
+				if( !demands_count )
+					return;
 
-				if( need_schedule )
-					m_disp_queue.schedule( this );
+				// Demands are linked in reverse order because the last
+				// demand has to be on the top of the stack.
+				demand_t * top = nullptr;
+				demand_t * bottom = nullptr;
+				std::size_t allocated = 0u;
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for(; allocated != demands_count; ++allocated )
+							{
+								auto d = m_demand_pool.allocate(
+										std::move( demands[ allocated ] ) ).release();
+								d->m_next = top;
+								top = d;
+								if( !bottom )
+									bottom = d;
+							}
+					},
+					[&] {
+						// Demands have to be returned to the caller.
+						while( top )
+							{
+								std::unique_ptr< demand_t > current{ top };
+								top = top->m_next;
+
+								demands[ --allocated ] = std::move( *current );
+								m_demand_pool.deallocate( std::move(current) );
+							}
+					} );
+
+				push_demands( top, bottom );
+
+				// The counter is incremented only after demands are
+				// visible for the consumer (see push() for more details).
+				m_size.fetch_add( static_cast< std::ptrdiff_t >( demands_count ) );
+
+				if( try_activate() )
+					m_disp_queue.schedule( this, m_numa_node );
 			}
 
 		/*!
@@ -189,102 +242,114 @@ class agent_queue_t final
 				this->push( std::move(demand) );
 			}
 
-		//! Get the information about the front demand.
+		//! Get access to the front demand.
 		/*!
-		 * \attention This method must be called only on non-empty queue.
+		 * \attention
+		 * This method must be called only by the worker that got the
+		 * queue from the dispatcher queue.
 		 */
 		[[nodiscard]]
-		execution_demand_t
-		peek_front()
+		execution_demand_t &
+		front() noexcept
 			{
-				SO_5_CHECK_INVARIANT( !empty(), this )
-				SO_5_CHECK_INVARIANT( m_active, this )
-
-				m_active = false;
-
-				return m_head_demand.m_next->m_demand;
+				// The activated queue always has a demand. It's either
+				// in the consumer's list or in the stack of pushed demands
+				// because a demand is counted only after it's pushed to
+				// the stack.
+				if( !m_head )
+					grab_pushed_demands();
+
+				return *m_head;
 			}
 
-		//! Remove the front demand.
+		//! An attempt to start a worker for the front demand.
 		/*!
-		 * \retval true queue must be activated.
-		 * \retval false queue must not be activated.
+		 * If the worker can be started then the front demand is removed
+		 * from the queue and returned.
+		 *
+		 * If the worker can't be started then the queue is deactivated.
+		 * It will be activated again when the last of the current
+		 * workers finishes.
+		 *
+		 * \attention
+		 * This method must be called only by the worker that got the
+		 * queue from the dispatcher queue.
 		 */
 		[[nodiscard]]
-		bool
-		worker_started(
+		start_result_t
+		try_start_worker(
 			//! Type of worker.
 			//! Must be thread_safe_worker or not_thread_safe_worker.
-			unsigned int type_of_worker )
+			unsigned int type_of_worker ) noexcept
 			{
-				SO_5_CHECK_INVARIANT( !empty(), this );
-				SO_5_CHECK_INVARIANT( !m_active, this );
+				const bool is_thread_safe = thread_safe_worker == type_of_worker;
+
+				auto state = m_state.load( std::memory_order_acquire );
+				for(;;)
+					{
+						// Thread safe worker can't be started while not thread
+						// safe worker is working. Not thread safe worker can't
+						// be started while there is any other worker.
+						const bool blocked = is_thread_safe ?
+								0 != ( state & not_thread_safe_worker ) :
+								is_there_any_worker( state );
+
+						unsigned int new_state = state & ~active_flag;
+						if( !blocked )
+						{
+							if( is_thread_safe )
+								// The queue remains active until the front demand
+								// will be removed.
+								new_state = state + thread_safe_worker;
+							else
+								new_state |= not_thread_safe_worker;
+						}
+
+						if( m_state.compare_exchange_weak( state, new_state,
+								std::memory_order_acq_rel,
+								std::memory_order_acquire ) )
+						{
+							if( blocked )
+								return {};
+							break;
+						}
+					}
 
-				delete_head();
-				if( !m_head_demand.m_next )
-					m_tail_demand = &m_head_demand;
+				start_result_t result;
+				result.m_demand = remove_head();
 
-				m_workers += type_of_worker;
+				// Queue can be activated again only if the current worker
+				// is a thread safe worker.
+				if( is_thread_safe )
+					result.m_need_schedule = deactivate();
 
-				// Queue must be activated only if queue is not empty
-				// and current worker is a thread safe worker.
-				m_active = ( !empty() &&
-						thread_safe_worker == type_of_worker );
+				return result;
+			}
 
-				return m_active;
+		//! Return the processed demand to the pool.
+		void
+		release_demand( std::unique_ptr< demand_t > demand ) noexcept
+			{
+				m_demand_pool.deallocate( std::move(demand) );
 			}
 
 		//! Signal about finishing of worker of the specified type.
 		/*!
-		 * \retval true queue must be activated.
-		 * \retval false queue must not be activated.
+		 * \retval true queue must be scheduled.
+		 * \retval false queue must not be scheduled.
 		 */
 		[[nodiscard]]
 		bool
 		worker_finished(
 			//! Type of worker.
 			//! Must be thread_safe_worker or not_thread_safe_worker.
-			unsigned int type_of_worker )
-			{
-				m_workers -= type_of_worker;
-
-				bool old_active = m_active;
-				if( !m_active )
-					m_active = !empty();
-
-				SO_5_CHECK_INVARIANT( !(m_active && empty()), this )
-				SO_5_CHECK_INVARIANT(
-						!old_active || m_active, this );
-
-				return old_active != m_active;
-			}
-
-		//! Check the presence of any worker at the moment.
-		[[nodiscard]]
-		bool
-		is_there_any_worker() const
+			unsigned int type_of_worker ) noexcept
 			{
-				return 0 != m_workers;
-			}
+				m_state.fetch_sub( type_of_worker );
 
-		//! Check the presence of thread unsafe worker.
-		[[nodiscard]]
-		bool
-		is_there_not_thread_safe_worker() const
-			{
-				return 0 != (m_workers & not_thread_safe_worker );
+				return try_activate();
 			}
 
-		//! Is empty queue?
-		[[nodiscard]]
-		bool
-		empty() const { return nullptr == m_head_demand.m_next; }
-
-		//! Is active queue?
-		[[nodiscard]]
-		bool
-		active() const { return m_active; }
-
 		/*!
 		 * \brief Get the current size of the queue.
 		 *
@@ -295,7 +360,8 @@ class agent_queue_t final
 		std::size_t
 		size() const noexcept
 			{
-				return m_size.load( std::memory_order_acquire );
+				const auto size = m_size.load( std::memory_order_acquire );
+				return size > 0 ? static_cast< std::size_t >( size ) : 0u;
 			}
 
 		/*!
@@ -331,42 +397,86 @@ class agent_queue_t final
 				m_intrusive_queue_next = next;
 			}
 
+		/*!
+		 * \brief NUMA node of that queue.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		numa_node() const noexcept
+			{
+				return m_numa_node;
+			}
+
 	private :
 		//! Dispatcher queue for scheduling processing of events from
 		//! this queue.
 		dispatcher_queue_t & m_disp_queue;
 
-		//! Object's lock.
-		spinlock_t m_lock;
+		/*!
+		 * \brief Pool of demand objects.
+		 *
+		 * \since v.5.8.4
+		 */
+		demand_pool_t & m_demand_pool;
 
-		//! Head of the demand's queue.
 		/*!
-		 * Never contains actual demand. Only m_next field is used.
+		 * \brief NUMA node of that queue.
+		 *
+		 * \since v.5.8.4
 		 */
-		demand_t m_head_demand;
-		//! Tail of the demand's queue.
+		const std::size_t m_numa_node;
+
 		/*!
-		 * Must point to m_head_demand if queue is empty or to the very
-		 * last queue item otherwise.
+		 * \brief Top of the stack of pushed demands.
+		 *
+		 * The last pushed demand is on the top.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::atomic< demand_t * > m_pushed{ nullptr };
+
+		/*!
+		 * \brief Head of the list of demands grabbed by the consumer.
+		 *
+		 * \note
+		 * It's accessed only by the worker that got the activated queue.
+		 *
+		 * \since v.5.8.4
 		 */
-		demand_t * m_tail_demand;
+		demand_t * m_head{ nullptr };
 
-		//! Is this queue activated?
 		/*!
-		 * Queue is activated if it is scheduled to dispatcher queue.
+		 * \brief Tail of the list of demands grabbed by the consumer.
+		 *
+		 * \since v.5.8.4
 		 */
-		bool m_active;
+		demand_t * m_tail{ nullptr };
 
-		//! Count of active workers.
-		unsigned int m_workers;
+		/*!
+		 * \brief State of the queue.
+		 *
+		 * Contains active_flag, not_thread_safe_worker flag and the count
+		 * of thread safe workers (multiplied by thread_safe_worker).
+		 *
+		 * \since v.5.8.4
+		 */
+		std::atomic< unsigned int > m_state{ 0 };
 
 		/*!
 		 * \brief Current size of the queue.
 		 *
+		 * \note
+		 * Since v.5.8.4 it's a signed value. A demand is counted only
+		 * after it's pushed to the stack, so the consumer can remove it
+		 * before it's counted. The value can be negative for a short
+		 * time in that case.
+		 *
 		 * \since
 		 * v.5.5.4
 		 */
-		std::atomic< std::size_t > m_size = { 0 };
+		std::atomic< std::ptrdiff_t > m_size = { 0 };
 
 		/*!
 		 * \brief The next item in intrusive queue of agent_queues.
@@ -378,16 +488,113 @@ class agent_queue_t final
 		 */
 		agent_queue_t * m_intrusive_queue_next{ nullptr };
 
-		//! Helper method for deleting queue's head object.
-		inline void
-		delete_head() noexcept
+		[[nodiscard]]
+		static bool
+		is_there_any_worker( unsigned int state ) noexcept
+			{
+				return 0 != ( state & ~active_flag );
+			}
+
+		//! Add a chain of demands to the stack of pushed demands.
+		void
+		push_demands( demand_t * top, demand_t * bottom ) noexcept
+			{
+				auto * current = m_pushed.load( std::memory_order_relaxed );
+				do
+					{
+						bottom->m_next = current;
+					}
+				while( !m_pushed.compare_exchange_weak( current, top,
+						std::memory_order_release,
+						std::memory_order_relaxed ) );
+			}
+
+		//! Move all pushed demands to the consumer's list.
+		void
+		grab_pushed_demands() noexcept
+			{
+				demand_t * pushed = m_pushed.exchange(
+						nullptr, std::memory_order_acquire );
+				if( !pushed )
+					return;
+
+				// The order of demands has to be reversed.
+				demand_t * new_tail = pushed;
+				demand_t * reversed = nullptr;
+				while( pushed )
+					{
+						auto * next = pushed->m_next;
+						pushed->m_next = reversed;
+						reversed = pushed;
+						pushed = next;
+					}
+
+				if( m_tail )
+					m_tail->m_next = reversed;
+				else
+					m_head = reversed;
+				m_tail = new_tail;
+			}
+
+		//! Helper method for removing queue's head object.
+		[[nodiscard]]
+		std::unique_ptr< demand_t >
+		remove_head() noexcept
 			{
-				auto to_be_deleted = m_head_demand.m_next;
-				m_head_demand.m_next = m_head_demand.m_next->m_next;
+				std::unique_ptr< demand_t > result{ m_head };
+				m_head = m_head->m_next;
+				if( !m_head )
+					m_tail = nullptr;
+				result->m_next = nullptr;
 
-				--m_size;
+				m_size.fetch_sub( 1 );
 
-				delete to_be_deleted;
+				return result;
+			}
+
+		//! An attempt to activate the queue.
+		/*!
+		 * The queue can be activated if it isn't active, there is no
+		 * not thread safe worker and the queue isn't empty.
+		 *
+		 * \retval true the queue is activated and must be scheduled.
+		 */
+		[[nodiscard]]
+		bool
+		try_activate() noexcept
+			{
+				for(;;)
+					{
+						auto state = m_state.load();
+						if( 0 != ( state & ( active_flag | not_thread_safe_worker ) ) )
+							return false;
+						if( m_size.load() <= 0 )
+							return false;
+
+						if( m_state.compare_exchange_weak(
+								state, state | active_flag ) )
+						{
+							// The queue could be emptied by another worker
+							// after the check of m_size above.
+							if( m_size.load() > 0 )
+								return true;
+
+							m_state.fetch_and( ~active_flag );
+						}
+					}
+			}
+
+		//! Deactivate the queue and activate it again if it isn't empty.
+		/*!
+		 * \retval true the queue is activated again and must be scheduled.
+		 */
+		[[nodiscard]]
+		bool
+		deactivate() noexcept
+			{
+				m_state.fetch_and( ~active_flag );
+
+				return try_activate();
 			}
 	};
 
@@ -635,42 +842,21 @@ class work_thread_template_t final : public Impl
 		void
 		process_queue( agent_queue_t & queue )
 			{
-				std::unique_lock< spinlock_t > lock( queue.lock() );
-
-				auto demand = queue.peek_front();
-				if( queue.is_there_not_thread_safe_worker() )
-					// We can't process any demand until thread unsafe
-					// worker is working.
-					return;
+				auto & demand = queue.front();
 
 				auto hint = demand.m_receiver->so_create_execution_hint( demand );
+				const auto type_of_worker = hint.is_thread_safe() ?
+						agent_queue_t::thread_safe_worker :
+						agent_queue_t::not_thread_safe_worker;
+
+				auto start_result = queue.try_start_worker( type_of_worker );
+				if( !start_result.m_demand )
+					// We can't process the demand until some other
+					// workers are working.
+					return;
 
-				bool need_schedule = true;
-				if( !hint.is_thread_safe() )
-				{
-					if( queue.is_there_any_worker() )
-						// We can't process not thread safe demand until
-						// there are some other workers.
-						return;
-					else
-						need_schedule = queue.worker_started(
-								agent_queue_t::not_thread_safe_worker );
-				}
-				else
-					// Threa-safe worker can be started.
-					need_schedule = queue.worker_started(
-							agent_queue_t::thread_safe_worker );
-
-				SO_5_CHECK_INVARIANT( !(need_schedule && queue.empty()), &queue )
-				SO_5_CHECK_INVARIANT(
-						!need_schedule || hint.is_thread_safe(), &queue );
-				SO_5_CHECK_INVARIANT( !need_schedule || queue.active(), &queue );
-
-				// Next few actions must be done on unlocked queue.
-				lock.unlock();
-
-				if( need_schedule )
-					this->m_disp_queue->schedule( &queue );
+				if( start_result.m_need_schedule )
+					this->m_disp_queue->schedule( &queue, queue.numa_node() );
 
 				// For activity tracking if it is turned on.
 				this->work_started();
@@ -680,21 +866,10 @@ class work_thread_template_t final : public Impl
 
 				this->work_finished();
 
-				// Next actions must be done on locked queue.
-				lock.lock();
-
-				need_schedule = queue.worker_finished(
-						hint.is_thread_safe() ?
-								agent_queue_t::thread_safe_worker :
-								agent_queue_t::not_thread_safe_worker );
-
-				SO_5_CHECK_INVARIANT(
-						!need_schedule || queue.active(), &queue );
+				queue.release_demand( std::move(start_result.m_demand) );
 
-				lock.unlock();
-
-				if( need_schedule )
-					this->m_disp_queue->schedule( &queue );
+				if( queue.worker_finished( type_of_worker ) )
+					this->m_disp_queue->schedule( &queue, queue.numa_node() );
 			}
 	};
 
@@ -757,6 +932,25 @@ struct adaptation_t
 			{
 				// This type of agent_queue doesn't require waiting for emptyness.
 			}
+
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static std::optional< std::size_t >
+		numa_node( const bind_params_t & params ) noexcept
+			{
+				return params.query_numa_node();
+			}
+
+		//! This dispatcher doesn't use the adaptive count of demands
+		//! to be processed at once.
+		[[nodiscard]]
+		static std::size_t
+		adaptive_demands_at_once( const agent_queue_t & ) noexcept
+			{
+				return 0u;
+			}
 	};
 
 //
@@ -155,7 +155,8 @@ class actual_dispatcher_implementation_t final
 					params,
 					name_base,
 					params.thread_count(),
-					params.queue_params()
+					params.queue_params(),
+					params.numa_topology()
 				}
 			{
 				m_impl.start( env.get() );
@@ -20,6 +20,7 @@
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
 #include <so_5/disp/reuse/work_thread_factory_params.hpp>
+#include <so_5/disp/reuse/numa_params.hpp>
 #include <so_5/disp/reuse/default_thread_pool_size.hpp>
 
 #include <string_view>
@@ -55,11 +56,14 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
 	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::numa_topology_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
 		using thread_factory_mixin_t = so_5::disp::reuse::
 				work_thread_factory_mixin_t< disp_params_t >;
+		using numa_topology_mixin_t = so_5::disp::reuse::
+				numa_topology_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -78,6 +82,10 @@ class disp_params_t
 						static_cast< work_thread_factory_mixin_t & >(a),
 						static_cast< work_thread_factory_mixin_t & >(b) );
 
+				swap(
+						static_cast< numa_topology_mixin_t & >(a),
+						static_cast< numa_topology_mixin_t & >(b) );
+
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
 			}
@@ -187,6 +195,7 @@ enum class fifo_t
  * v.5.5.11
  */
 class bind_params_t
+	:	public so_5::disp::reuse::numa_node_mixin_t< bind_params_t >
 	{
 	public :
 		//! Set FIFO type.
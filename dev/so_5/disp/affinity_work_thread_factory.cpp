@@ -0,0 +1,306 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A work thread factory with support of CPU affinity and
+ * thread priorities.
+ *
+ * \since v.5.8.4
+ */
+
+#include <so_5/disp/affinity_work_thread_factory.hpp>
+
+#include <so_5/environment.hpp>
+#include <so_5/error_logger.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <atomic>
+#include <cerrno>
+
+#if defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace so_5::disp
+{
+
+namespace affinity_impl
+{
+
+namespace
+{
+
+#if defined(__linux__)
+//! Pin the current thread to the specified CPUs.
+/*!
+ * \return error code or 0 in the case of success.
+ */
+[[nodiscard]]
+int
+set_current_thread_affinity( const cpu_list_t & cpus ) noexcept
+	{
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		for( const auto cpu : cpus )
+			if( cpu < CPU_SETSIZE )
+				CPU_SET( cpu, &cpu_set );
+
+		return pthread_setaffinity_np( pthread_self(), sizeof(cpu_set), &cpu_set );
+	}
+
+//! Switch the current thread to SCHED_FIFO policy.
+/*!
+ * \return error code or 0 in the case of success.
+ */
+[[nodiscard]]
+int
+set_current_thread_fifo_priority( int priority ) noexcept
+	{
+		sched_param param{};
+		param.sched_priority = priority;
+		return pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+	}
+
+//! Change nice value for the current thread.
+/*!
+ * \note
+ * Linux applies nice values to individual threads if the thread ID
+ * is used as the target of setpriority().
+ *
+ * \return error code or 0 in the case of success.
+ */
+[[nodiscard]]
+int
+set_current_thread_nice( int value ) noexcept
+	{
+		const auto tid = static_cast< id_t >( ::syscall( SYS_gettid ) );
+		if( 0 != ::setpriority( PRIO_PROCESS, tid, value ) )
+			return errno;
+		return 0;
+	}
+#endif
+
+//! Apply parameters to the current thread.
+/*!
+ * Failures are reported via error_logger of \a env.
+ */
+void
+tune_current_thread(
+	so_5::environment_t & env,
+	const affinity_params_t & params,
+	std::size_t thread_index )
+	{
+#if defined(__linux__)
+		const auto & cpu_sets = params.query_cpu_sets();
+		if( !cpu_sets.empty() )
+			{
+				const auto & cpus = cpu_sets[ thread_index % cpu_sets.size() ];
+				if( !cpus.empty() )
+					if( const auto rc = set_current_thread_affinity( cpus ); 0 != rc )
+						SO_5_LOG_ERROR( env, log_stream )
+							{
+								log_stream << "unable to set CPU affinity for work "
+									"thread #" << thread_index << ", error: " << rc;
+							}
+			}
+
+		if( const auto priority = params.query_sched_fifo(); priority )
+			if( const auto rc = set_current_thread_fifo_priority( *priority );
+					0 != rc )
+				SO_5_LOG_ERROR( env, log_stream )
+					{
+						log_stream << "unable to set SCHED_FIFO priority "
+							<< *priority << " for work thread #" << thread_index
+							<< ", error: " << rc;
+					}
+
+		if( const auto nice = params.query_nice(); nice )
+			if( const auto rc = set_current_thread_nice( *nice ); 0 != rc )
+				SO_5_LOG_ERROR( env, log_stream )
+					{
+						log_stream << "unable to set nice value " << *nice
+							<< " for work thread #" << thread_index
+							<< ", error: " << rc;
+					}
+#else
+		(void)env;
+		(void)params;
+		(void)thread_index;
+#endif
+
+		if( const auto & hook = params.query_thread_init_hook(); hook )
+			hook( thread_index );
+	}
+
+} /* namespace anonymous */
+
+//
+// work_thread_t
+//
+/*!
+ * \brief A wrapper around an actual work thread that applies
+ * affinity parameters before the start of the thread body.
+ *
+ * \since v.5.8.4
+ */
+class work_thread_t final : public abstract_work_thread_t
+	{
+	public :
+		work_thread_t(
+			so_5::environment_t & env,
+			abstract_work_thread_t & actual,
+			abstract_work_thread_factory_shptr_t actual_factory,
+			const affinity_params_t & params,
+			std::size_t thread_index )
+			:	m_env{ env }
+			,	m_actual{ actual }
+			,	m_actual_factory{ std::move(actual_factory) }
+			,	m_params{ params }
+			,	m_thread_index{ thread_index }
+			{}
+
+		void
+		start( body_func_t thread_body ) override
+			{
+				m_actual.start(
+					[this, tb = std::move(thread_body)] {
+						tune_current_thread( m_env, m_params, m_thread_index );
+
+						tb();
+					} );
+			}
+
+		void
+		join() override
+			{
+				m_actual.join();
+			}
+
+		//! Return the actual thread to the actual factory.
+		void
+		release_actual() noexcept
+			{
+				m_actual_factory->release( m_actual );
+			}
+
+	private :
+		//! SObjectizer Environment for error reporting.
+		so_5::environment_t & m_env;
+
+		//! Actual thread.
+		abstract_work_thread_t & m_actual;
+
+		//! Factory that created the actual thread.
+		const abstract_work_thread_factory_shptr_t m_actual_factory;
+
+		//! Parameters for the thread.
+		/*!
+		 * \note
+		 * The parameters are owned by the work_thread_factory_t.
+		 * The factory outlives all threads acquired from it.
+		 */
+		const affinity_params_t & m_params;
+
+		//! Index of the thread.
+		const std::size_t m_thread_index;
+	};
+
+//
+// work_thread_factory_t
+//
+/*!
+ * \brief Implementation of factory for worker threads with
+ * affinity parameters.
+ *
+ * \since v.5.8.4
+ */
+class work_thread_factory_t final : public abstract_work_thread_factory_t
+	{
+	public :
+		work_thread_factory_t(
+			affinity_params_t params,
+			abstract_work_thread_factory_shptr_t underlying )
+			:	m_params{ std::move(params) }
+			,	m_underlying{ std::move(underlying) }
+			{}
+
+		[[nodiscard]]
+		abstract_work_thread_t &
+		acquire( so_5::environment_t & env ) override
+			{
+				auto factory = m_underlying ?
+						m_underlying : env.work_thread_factory();
+
+				auto & actual = factory->acquire( env );
+
+				work_thread_t * result = nullptr;
+				so_5::details::do_with_rollback_on_exception(
+						[&] {
+							result = new work_thread_t{
+									env,
+									actual,
+									factory,
+									m_params,
+									m_thread_counter.fetch_add(
+											1u, std::memory_order_relaxed )
+								};
+						},
+						[&] { factory->release( actual ); } );
+
+				return *result;
+			}
+
+		void
+		release( abstract_work_thread_t & thread ) noexcept override
+			{
+				// Assume that 'thread' was created via acquire() method.
+				auto & wrapper = static_cast< work_thread_t & >( thread );
+				wrapper.release_actual();
+				delete (&wrapper);
+			}
+
+	private :
+		//! Parameters for worker threads.
+		const affinity_params_t m_params;
+
+		//! Factory for actual threads.
+		/*!
+		 * \note
+		 * Can be nullptr. The factory from the environment is used in
+		 * that case.
+		 */
+		const abstract_work_thread_factory_shptr_t m_underlying;
+
+		//! Counter of acquired threads.
+		/*!
+		 * It's used as the source of indexes for new threads.
+		 */
+		std::atomic< std::size_t > m_thread_counter{ 0u };
+	};
+
+} /* namespace affinity_impl */
+
+//
+// make_affinity_work_thread_factory
+//
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_affinity_work_thread_factory(
+	affinity_params_t params,
+	abstract_work_thread_factory_shptr_t underlying )
+{
+	return std::make_shared< affinity_impl::work_thread_factory_t >(
+			std::move(params),
+			std::move(underlying) );
+}
+
+} /* namespace so_5::disp */
+
@@ -0,0 +1,287 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A work thread factory with support of CPU affinity and
+ * thread priorities.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp/abstract_work_thread.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace so_5::disp
+{
+
+//
+// cpu_list_t
+//
+/*!
+ * \brief Type of list of CPU indexes.
+ *
+ * \since v.5.8.4
+ */
+using cpu_list_t = std::vector< unsigned int >;
+
+//
+// affinity_params_t
+//
+/*!
+ * \brief Parameters for a work thread factory created by
+ * make_affinity_work_thread_factory().
+ *
+ * Every worker thread acquired from the factory gets a sequential index
+ * (starting from 0). That index is used for the selection of CPUs for the
+ * thread.
+ *
+ * Usage example:
+ * \code
+ * // Every thread of the pool will be pinned to its own core
+ * // from the list. Threads will have SCHED_FIFO policy.
+ * auto disp = so_5::disp::thread_pool::make_dispatcher( env, "latency",
+ * 	so_5::disp::thread_pool::disp_params_t{}
+ * 		.thread_count( 4 )
+ * 		.work_thread_factory(
+ * 			so_5::disp::make_affinity_work_thread_factory(
+ * 				so_5::disp::affinity_params_t{}
+ * 					.round_robin_cpus( { 2, 3, 4, 5 } )
+ * 					.sched_fifo( 10 ) ) ) );
+ * \endcode
+ *
+ * \note
+ * CPU affinity and scheduling parameters are supported only on Linux.
+ * On other platforms they are ignored.
+ *
+ * \since v.5.8.4
+ */
+class affinity_params_t
+	{
+	public :
+		//! Type of hook to be called on the context of a new worker thread.
+		/*!
+		 * The hook receives the index of the thread.
+		 */
+		using thread_init_hook_t = std::function< void(std::size_t) >;
+
+		affinity_params_t() = default;
+
+		friend void
+		swap( affinity_params_t & a, affinity_params_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_cpu_sets, b.m_cpu_sets );
+				swap( a.m_fifo_priority, b.m_fifo_priority );
+				swap( a.m_nice, b.m_nice );
+				swap( a.m_thread_init_hook, b.m_thread_init_hook );
+			}
+
+		//! Set CPU sets for worker threads.
+		/*!
+		 * A thread with index `i` is pinned to the set with index
+		 * `i % sets.size()`. An empty set means that affinity of the
+		 * thread isn't changed.
+		 */
+		affinity_params_t &
+		cpu_sets( std::vector< cpu_list_t > sets ) &
+			{
+				m_cpu_sets = std::move(sets);
+				return *this;
+			}
+
+		//! Set CPU sets for worker threads.
+		affinity_params_t &&
+		cpu_sets( std::vector< cpu_list_t > sets ) &&
+			{
+				return std::move( this->cpu_sets( std::move(sets) ) );
+			}
+
+		//! Set a list of CPUs for round-robin distribution of worker threads.
+		/*!
+		 * A thread with index `i` is pinned to just one CPU with index
+		 * `cpus[i % cpus.size()]`.
+		 *
+		 * \note
+		 * It's a shorthand for cpu_sets() with one-element sets.
+		 */
+		affinity_params_t &
+		round_robin_cpus( const cpu_list_t & cpus ) &
+			{
+				m_cpu_sets.clear();
+				m_cpu_sets.reserve( cpus.size() );
+				for( const auto cpu : cpus )
+					m_cpu_sets.push_back( cpu_list_t{ cpu } );
+				return *this;
+			}
+
+		//! Set a list of CPUs for round-robin distribution of worker threads.
+		affinity_params_t &&
+		round_robin_cpus( const cpu_list_t & cpus ) &&
+			{
+				return std::move( this->round_robin_cpus( cpus ) );
+			}
+
+		//! Getter for CPU sets.
+		[[nodiscard]]
+		const std::vector< cpu_list_t > &
+		query_cpu_sets() const noexcept
+			{
+				return m_cpu_sets;
+			}
+
+		//! Use SCHED_FIFO policy with the specified priority for worker threads.
+		/*!
+		 * \note
+		 * It usually requires CAP_SYS_NICE capability (or an appropriate
+		 * RLIMIT_RTPRIO limit).
+		 */
+		affinity_params_t &
+		sched_fifo( int priority ) &
+			{
+				m_fifo_priority = priority;
+				return *this;
+			}
+
+		//! Use SCHED_FIFO policy with the specified priority for worker threads.
+		affinity_params_t &&
+		sched_fifo( int priority ) &&
+			{
+				return std::move( this->sched_fifo( priority ) );
+			}
+
+		//! Getter for SCHED_FIFO priority.
+		[[nodiscard]]
+		std::optional< int >
+		query_sched_fifo() const noexcept
+			{
+				return m_fifo_priority;
+			}
+
+		//! Set nice value for worker threads.
+		/*!
+		 * \note
+		 * Negative values usually require CAP_SYS_NICE capability.
+		 */
+		affinity_params_t &
+		nice( int value ) &
+			{
+				m_nice = value;
+				return *this;
+			}
+
+		//! Set nice value for worker threads.
+		affinity_params_t &&
+		nice( int value ) &&
+			{
+				return std::move( this->nice( value ) );
+			}
+
+		//! Getter for nice value.
+		[[nodiscard]]
+		std::optional< int >
+		query_nice() const noexcept
+			{
+				return m_nice;
+			}
+
+		//! Set a hook to be called on the context of every new worker thread.
+		/*!
+		 * The hook is called after the change of affinity and scheduling
+		 * parameters but before the actual body of the thread.
+		 *
+		 * \attention
+		 * The hook must not throw.
+		 */
+		affinity_params_t &
+		thread_init_hook( thread_init_hook_t hook ) &
+			{
+				m_thread_init_hook = std::move(hook);
+				return *this;
+			}
+
+		//! Set a hook to be called on the context of every new worker thread.
+		affinity_params_t &&
+		thread_init_hook( thread_init_hook_t hook ) &&
+			{
+				return std::move( this->thread_init_hook( std::move(hook) ) );
+			}
+
+		//! Getter for the thread init hook.
+		[[nodiscard]]
+		const thread_init_hook_t &
+		query_thread_init_hook() const noexcept
+			{
+				return m_thread_init_hook;
+			}
+
+	private :
+		//! CPU sets for worker threads.
+		/*!
+		 * Empty vector means that affinity isn't changed.
+		 */
+		std::vector< cpu_list_t > m_cpu_sets;
+
+		//! Priority for SCHED_FIFO policy.
+		std::optional< int > m_fifo_priority;
+
+		//! Nice value.
+		std::optional< int > m_nice;
+
+		//! Optional hook for a new thread.
+		thread_init_hook_t m_thread_init_hook;
+	};
+
+//
+// make_affinity_work_thread_factory
+//
+/*!
+ * \brief Create a work thread factory that sets CPU affinity and
+ * scheduling parameters for worker threads.
+ *
+ * Worker threads are taken from the \a underlying factory. If
+ * \a underlying is nullptr then the factory from SObjectizer Environment
+ * is used. The body of every worker thread is wrapped: before the start
+ * of the actual body the affinity and scheduling parameters from
+ * \a params are applied to the thread.
+ *
+ * The factory can be passed to any standard dispatcher by the
+ * `work_thread_factory()` method of its disp_params:
+ * \code
+ * auto disp = so_5::disp::active_obj::make_dispatcher( env, "isolated",
+ * 	so_5::disp::active_obj::disp_params_t{}
+ * 		.work_thread_factory(
+ * 			so_5::disp::make_affinity_work_thread_factory(
+ * 				so_5::disp::affinity_params_t{}
+ * 					.cpu_sets( { { 6, 7 } } )
+ * 					.nice( -5 ) ) ) );
+ * \endcode
+ *
+ * \note
+ * Failures during the change of affinity or scheduling parameters
+ * don't prevent the start of the thread. They are reported via
+ * the error_logger of SObjectizer Environment.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_affinity_work_thread_factory(
+	//! Parameters for worker threads.
+	affinity_params_t params,
+	//! Factory for actual worker threads.
+	abstract_work_thread_factory_shptr_t underlying = {} );
+
+} /* namespace so_5::disp */
+
@@ -0,0 +1,172 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Parameters for %bounded_one_thread dispatcher.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/work_thread_factory_params.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace bounded_one_thread {
+
+//
+// overflow_reaction_t
+//
+/*!
+ * \brief What has to be done if the demand queue is still full after
+ * the wait timeout.
+ *
+ * \since v.5.8.4
+ */
+enum class overflow_reaction_t
+	{
+		//! An exception with rc_bounded_disp_queue_overflow error code
+		//! must be thrown from the send operation.
+		throw_exception,
+		//! The new demand must be ignored and dropped.
+		drop_newest
+	};
+
+//
+// disp_params_t
+//
+/*!
+ * \brief Parameters for a dispatcher.
+ *
+ * \since v.5.8.4
+ */
+class disp_params_t
+	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	{
+		using activity_tracking_mixin_t = so_5::disp::reuse::
+				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using thread_factory_mixin_t = so_5::disp::reuse::
+				work_thread_factory_mixin_t< disp_params_t >;
+
+	public :
+		//! Type for representation of producer's waiting time.
+		using duration_t = std::chrono::steady_clock::duration;
+
+		//! Default capacity of the demand queue.
+		static constexpr std::size_t default_capacity = 1024u;
+
+		//! Default time of waiting for a free place in the demand queue.
+		static constexpr duration_t default_wait_timeout =
+				std::chrono::seconds{ 1 };
+
+		//! Default constructor.
+		disp_params_t() = default;
+
+		friend inline void
+		swap( disp_params_t & a, disp_params_t & b ) noexcept
+			{
+				swap(
+						static_cast< activity_tracking_mixin_t & >(a),
+						static_cast< activity_tracking_mixin_t & >(b) );
+
+				swap(
+						static_cast< thread_factory_mixin_t & >(a),
+						static_cast< thread_factory_mixin_t & >(b) );
+
+				std::swap( a.m_capacity, b.m_capacity );
+				std::swap( a.m_wait_timeout, b.m_wait_timeout );
+				std::swap( a.m_overflow_reaction, b.m_overflow_reaction );
+			}
+
+		//! Setter for the capacity of the demand queue.
+		/*!
+		 * Usage example:
+			\code
+			namespace bounded_disp = so_5::disp::bounded_one_thread;
+			auto disp = bounded_disp::make_dispatcher( env,
+				"my_bounded_disp",
+				bounded_disp::disp_params_t{}.capacity(
+					// Max count of demands in the queue.
+					256u,
+					// Max time of waiting for a free place.
+					std::chrono::milliseconds{ 250 },
+					// The demand is dropped if there is no free place
+					// after 250ms.
+					bounded_disp::overflow_reaction_t::drop_newest ) );
+			\endcode
+		 *
+		 * \note
+		 * Value 0 for \a max_size is treated as 1.
+		 *
+		 * \note
+		 * Value 0 for \a wait_timeout means that a producer is never
+		 * blocked and \a reaction is performed immediately.
+		 */
+		disp_params_t &
+		capacity(
+			//! Max count of demands in the queue.
+			std::size_t max_size,
+			//! Max time of waiting for a free place in the queue.
+			duration_t wait_timeout = default_wait_timeout,
+			//! What to do if there is no free place after \a wait_timeout.
+			overflow_reaction_t reaction = overflow_reaction_t::throw_exception )
+			{
+				m_capacity = max_size;
+				m_wait_timeout = wait_timeout;
+				m_overflow_reaction = reaction;
+				return *this;
+			}
+
+		//! Getter for the capacity of the demand queue.
+		[[nodiscard]]
+		std::size_t
+		max_size() const noexcept
+			{
+				return m_capacity;
+			}
+
+		//! Getter for the max time of waiting for a free place.
+		[[nodiscard]]
+		duration_t
+		wait_timeout() const noexcept
+			{
+				return m_wait_timeout;
+			}
+
+		//! Getter for the reaction to the full queue after the wait timeout.
+		[[nodiscard]]
+		overflow_reaction_t
+		overflow_reaction() const noexcept
+			{
+				return m_overflow_reaction;
+			}
+
+	private :
+		//! Max count of demands in the queue.
+		std::size_t m_capacity{ default_capacity };
+
+		//! Max time of waiting for a free place in the queue.
+		duration_t m_wait_timeout{ default_wait_timeout };
+
+		//! What to do if there is no free place after the wait timeout.
+		overflow_reaction_t m_overflow_reaction{
+				overflow_reaction_t::throw_exception };
+	};
+
+} /* namespace bounded_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,207 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Functions for creating and binding of the single thread dispatcher
+ * with a bounded demand queue.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/disp/bounded_one_thread/params.hpp>
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp_binder.hpp>
+
+#include <string>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace bounded_one_thread {
+
+namespace impl
+{
+
+class dispatcher_handle_maker_t;
+
+} /* namespace impl */
+
+//
+// dispatcher_handle_t
+//
+
+/*!
+ * \brief A handle for %bounded_one_thread dispatcher.
+ *
+ * \since v.5.8.4
+ */
+class [[nodiscard]] dispatcher_handle_t
+	{
+		friend class impl::dispatcher_handle_maker_t;
+
+		//! Binder for the dispatcher.
+		disp_binder_shptr_t m_binder;
+
+		dispatcher_handle_t( disp_binder_shptr_t binder ) noexcept
+			:	m_binder{ std::move(binder) }
+			{}
+
+		//! Is this handle empty?
+		bool
+		empty() const noexcept { return !m_binder; }
+
+	public :
+		dispatcher_handle_t() noexcept = default;
+
+		//! Get a binder for that dispatcher.
+		[[nodiscard]]
+		disp_binder_shptr_t
+		binder() const noexcept
+			{
+				return m_binder;
+			}
+
+		//! Is this handle empty?
+		operator bool() const noexcept { return empty(); }
+
+		//! Does this handle contain a reference to dispatcher?
+		bool
+		operator!() const noexcept { return !empty(); }
+
+		//! Drop the content of handle.
+		void
+		reset() noexcept { m_binder.reset(); }
+	};
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %bounded_one_thread dispatcher.
+ *
+ * This dispatcher has one worker thread and a demand queue with limited
+ * capacity. The queue is shared by all agents bound to the dispatcher.
+ * Demands are stored in preallocated nodes, so there are no allocations
+ * for ordinary demands while the queue isn't full.
+ *
+ * If the queue is full then a producer is blocked until there is a free
+ * place in the queue or until disp_params_t::wait_timeout() expires.
+ * If the queue is still full after that then
+ * disp_params_t::overflow_reaction() is performed: the new demand is
+ * dropped or an exception is thrown from the send operation. So the queue
+ * never exceeds its capacity because of blocked producers.
+ *
+ * The producer isn't blocked (and the demand is always stored) if:
+ *
+ * - the message is sent from the worker thread of the dispatcher
+ *   (otherwise the dispatcher could block itself);
+ * - the message is delivered with message_delivery_mode_t::nonblocking
+ *   (for example, it is a delayed or periodic message from the timer thread);
+ * - it is an evt_start/evt_finish demand;
+ * - the dispatcher is being shut down.
+ *
+ * \attention
+ * A blocked producer holds a lock of mbox it sends to. If agents bound
+ * to that dispatcher try to subscribe/unsubscribe to the same mbox
+ * while a producer is blocked, then they will wait until the producer
+ * is unblocked (it can take up to disp_params_t::wait_timeout(), then
+ * the overflow reaction releases the producer). Zero wait timeout can
+ * be used to avoid any blocking of producers.
+ *
+ * \par Usage sample
+\code
+auto my_disp = so_5::disp::bounded_one_thread::make_dispatcher(
+	env,
+	"request_processor",
+	so_5::disp::bounded_one_thread::disp_params_t{}.capacity(
+		// No more than 256 demands in the queue.
+		256u,
+		// Producers can wait for a free place for 250ms.
+		std::chrono::milliseconds{ 250 },
+		// The demand is dropped if there is no free place after 250ms.
+		so_5::disp::bounded_one_thread::overflow_reaction_t::drop_newest ) );
+auto coop = env.make_coop(
+	// The main dispatcher for that coop will be
+	// this instance of bounded_one_thread dispatcher.
+	my_disp.binder() );
+\endcode
+ *
+ * \since v.5.8.4
+ */
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Parameters for the dispatcher.
+	disp_params_t params );
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %bounded_one_thread dispatcher.
+ *
+ * \par Usage sample
+\code
+auto my_disp = so_5::disp::bounded_one_thread::make_dispatcher(
+	env,
+	"request_processor" );
+auto coop = env.make_coop(
+	// The main dispatcher for that coop will be
+	// this instance of bounded_one_thread dispatcher.
+	my_disp.binder() );
+\endcode
+ *
+ * \since v.5.8.4
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base )
+	{
+		return make_dispatcher( env, data_sources_name_base, disp_params_t{} );
+	}
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %bounded_one_thread dispatcher.
+ *
+ * \par Usage sample
+\code
+auto my_disp = so_5::disp::bounded_one_thread::make_dispatcher( env );
+
+auto coop = env.make_coop(
+	// The main dispatcher for that coop will be
+	// private bounded_one_thread dispatcher.
+	my_disp.binder() );
+\endcode
+ *
+ * \since v.5.8.4
+ */
+inline dispatcher_handle_t
+make_dispatcher( environment_t & env )
+	{
+		return make_dispatcher( env, std::string_view{} );
+	}
+
+} /* namespace bounded_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
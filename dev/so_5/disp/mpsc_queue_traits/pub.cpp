@@ -196,6 +196,39 @@ class simple_lock_t : public lock_t
 		bool m_signaled = { false };
 	};
 
+//
+// lock_free_queue_lock_t
+//
+/*!
+ * \brief A lock for lock-free demand queue.
+ *
+ * It's the same combined lock but it tells that a lock-free demand
+ * queue has to be used.
+ *
+ * \since v.5.8.4
+ */
+class lock_free_queue_lock_t final : public combined_lock_t
+	{
+	public :
+		lock_free_queue_lock_t(
+			//! Count of preallocated queue nodes.
+			std::size_t node_pool_size,
+			//! Max waiting time for waiting on spinlock before switching to mutex.
+			std::chrono::high_resolution_clock::duration waiting_time )
+			:	combined_lock_t{ waiting_time }
+			,	m_node_pool_size{ node_pool_size }
+			{}
+
+		std::optional< std::size_t >
+		lock_free_queue_node_pool_size() const noexcept override
+			{
+				return m_node_pool_size;
+			}
+
+	private :
+		const std::size_t m_node_pool_size;
+	};
+
 } /* namespace impl */
 
 //
@@ -219,6 +252,20 @@ simple_lock_factory()
 		return [] { return lock_unique_ptr_t{ new impl::simple_lock_t{} }; };
 	}
 
+//
+// lock_free_queue_lock_factory
+//
+SO_5_FUNC lock_factory_t
+lock_free_queue_lock_factory(
+	std::size_t node_pool_size,
+	std::chrono::high_resolution_clock::duration waiting_time )
+	{
+		return [node_pool_size, waiting_time] {
+			return lock_unique_ptr_t{
+					new impl::lock_free_queue_lock_t{ node_pool_size, waiting_time } };
+		};
+	}
+
 } /* namespace mpsc_queue_traits */
 
 } /* namespace disp */
@@ -17,6 +17,7 @@
 #include <functional>
 #include <memory>
 #include <chrono>
+#include <optional>
 
 namespace so_5 {
 
@@ -53,6 +54,26 @@ class SO_5_TYPE lock_t
 		virtual void
 		unlock() noexcept = 0;
 
+		/*!
+		 * \brief Size of node pool for lock-free demand queue.
+		 *
+		 * An empty value means that the lock is intended to be used
+		 * with an ordinary demand queue protected by that lock.
+		 *
+		 * A non-empty value means that a lock-free MPSC demand queue has
+		 * to be used. The lock is used only for waiting of the consumer on
+		 * the empty queue in that case. The value specifies the count of
+		 * preallocated queue nodes.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		virtual std::optional< std::size_t >
+		lock_free_queue_node_pool_size() const noexcept
+			{
+				return std::nullopt;
+			}
+
 	protected :
 		//! Waiting for nofication.
 		/*!
@@ -162,6 +183,72 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// default_lock_free_queue_node_pool_size
+//
+/*!
+ * \brief Default count of preallocated nodes for lock-free demand queue.
+ *
+ * \since v.5.8.4
+ */
+inline std::size_t
+default_lock_free_queue_node_pool_size()
+	{
+		return 1024u;
+	}
+
+/*!
+ * \brief Factory for creation of lock for lock-free demand queue.
+ *
+ * A lock created by this factory tells the dispatcher that a lock-free
+ * MPSC demand queue has to be used instead of an ordinary demand queue.
+ * Producers of demands never block on such queue. Queue nodes are taken
+ * from a pool of preallocated nodes (nodes are allocated dynamically only
+ * if the pool is exhausted). The consumer takes all available demands
+ * from the queue without locking.
+ *
+ * The lock itself is used only when the consumer waits on the empty
+ * queue. Busy waiting is used first and std::mutex and
+ * std::condition_variable are used after \a waiting_time.
+ *
+ * \par Usage example:
+	\code
+	auto one_thread_disp = so_5::disp::one_thread::make_dispatcher(
+		env,
+		"fan_in",
+		so_5::disp::one_thread::disp_params_t{}.tune_queue_params(
+			[]( so_5::disp::one_thread::queue_traits::queue_params_t & p ) {
+				p.lock_factory( so_5::disp::one_thread::queue_traits::lock_free_queue_lock_factory(
+					// Preallocate 64K queue nodes.
+					64u * 1024u,
+					// Switch to mutex after 125us of busy waiting.
+					std::chrono::microseconds{125}) );
+			} ) );
+	\endcode
+ *
+ * \since v.5.8.4
+ */
+SO_5_FUNC lock_factory_t
+lock_free_queue_lock_factory(
+	//! Count of preallocated queue nodes.
+	std::size_t node_pool_size,
+	//! Max waiting time for waiting on spinlock before switching to mutex.
+	std::chrono::high_resolution_clock::duration waiting_time );
+
+/*!
+ * \brief Factory for creation of lock for lock-free demand queue with
+ * default parameters.
+ *
+ * \since v.5.8.4
+ */
+inline lock_factory_t
+lock_free_queue_lock_factory()
+	{
+		return lock_free_queue_lock_factory(
+				default_lock_free_queue_node_pool_size(),
+				default_combined_lock_waiting_time() );
+	}
+
 //
 // unique_lock_t
 //
@@ -74,9 +74,16 @@ class agent_queue_with_preallocated_finish_demand_t final
 		agent_queue_with_preallocated_finish_demand_t(
 			//! Dispatcher queue to work with.
 			outliving_reference_t< dispatcher_queue_t > disp_queue,
+			//! Pool of demand objects.
+			outliving_reference_t<
+					so_5::disp::thread_pool::impl::demand_pool_t > demand_pool,
 			//! Parameters for the queue.
-			const bind_params_t & params )
-			:	base_type_t{ params.query_max_demands_at_once() }
+			const bind_params_t & params,
+			//! Dummy argument. It is necessary here because of
+			//! common implementation for thread-pool-like dispatchers.
+			//! This dispatcher isn't NUMA-aware.
+			std::size_t )
+			:	base_type_t{ demand_pool, params.query_max_demands_at_once() }
 			,	m_disp_queue{ disp_queue.get() }
 			,	m_finish_demand{ std::make_unique< base_type_t::demand_t >() }
 			{}
@@ -191,6 +198,23 @@ struct adaptation_t
 			{
 				queue.wait_for_emptyness();
 			}
+
+		//! This dispatcher isn't NUMA-aware.
+		[[nodiscard]]
+		static std::optional< std::size_t >
+		numa_node( const bind_params_t & ) noexcept
+			{
+				return std::nullopt;
+			}
+
+		//! This dispatcher doesn't use the adaptive count of demands
+		//! to be processed at once.
+		[[nodiscard]]
+		static std::size_t
+		adaptive_demands_at_once( const agent_queue_with_preallocated_finish_demand_t & ) noexcept
+			{
+				return 0u;
+			}
 	};
 
 //
@@ -0,0 +1,162 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Tools for NUMA-aware dispatchers.
+ *
+ * \since v.5.8.4
+ */
+
+#include <so_5/disp/numa.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace so_5::disp::numa
+{
+
+namespace impl
+{
+
+namespace
+{
+
+//! Index of NUMA node for the current thread.
+thread_local std::size_t current_node{ 0u };
+
+/*!
+ * \brief Parse a list in the form used by Linux's sysfs (like "0-3,8,10-11").
+ *
+ * \return empty list if the list can't be parsed.
+ */
+[[nodiscard]]
+cpu_list_t
+parse_sysfs_list( const std::string & what )
+	{
+		cpu_list_t result;
+
+		std::size_t pos = 0u;
+		while( pos < what.size() )
+			{
+				std::size_t parsed = 0u;
+				const auto first = std::stoul( what.substr( pos ), &parsed );
+				pos += parsed;
+
+				auto last = first;
+				if( pos < what.size() && '-' == what[ pos ] )
+					{
+						++pos;
+						last = std::stoul( what.substr( pos ), &parsed );
+						pos += parsed;
+					}
+
+				for( auto i = first; i <= last; ++i )
+					result.push_back( static_cast< unsigned int >( i ) );
+
+				// Skip the separator and possible trailing spaces.
+				while( pos < what.size() &&
+						( ',' == what[ pos ] || ' ' == what[ pos ] ||
+						'\n' == what[ pos ] ) )
+					++pos;
+			}
+
+		return result;
+	}
+
+/*!
+ * \brief Read the first line of a sysfs file and parse it as a list.
+ *
+ * \return empty list if the file can't be read or parsed.
+ */
+[[nodiscard]]
+cpu_list_t
+read_sysfs_list( const std::string & file_name )
+	{
+		std::ifstream file{ file_name };
+		std::string line;
+		if( !file || !std::getline( file, line ) )
+			return {};
+
+		try
+			{
+				return parse_sysfs_list( line );
+			}
+		catch( const std::logic_error & )
+			{
+				// std::stoul throws std::invalid_argument or std::out_of_range.
+				return {};
+			}
+	}
+
+} /* namespace anonymous */
+
+} /* namespace impl */
+
+//
+// detect_topology
+//
+[[nodiscard]]
+SO_5_FUNC
+topology_t
+detect_topology()
+{
+	topology_t result;
+
+#if defined(__linux__)
+	const std::string sysfs_root{ "/sys/devices/system/node/" };
+
+	for( const auto node : impl::read_sysfs_list( sysfs_root + "online" ) )
+		{
+			auto cpus = impl::read_sysfs_list(
+					sysfs_root + "node" + std::to_string( node ) + "/cpulist" );
+			// Nodes without CPUs (like memory-only nodes) are useless
+			// for worker threads.
+			if( !cpus.empty() )
+				result.add_node( std::move(cpus) );
+		}
+#endif
+
+	if( result.empty() )
+		result.add_node( {} );
+
+	return result;
+}
+
+//
+// current_thread_node
+//
+[[nodiscard]]
+SO_5_FUNC
+std::size_t
+current_thread_node() noexcept
+{
+	return impl::current_node;
+}
+
+//
+// make_node_work_thread_factory
+//
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_node_work_thread_factory(
+	std::size_t node,
+	cpu_list_t cpus,
+	abstract_work_thread_factory_shptr_t underlying )
+{
+	std::vector< cpu_list_t > cpu_sets;
+	cpu_sets.push_back( std::move(cpus) );
+
+	return make_affinity_work_thread_factory(
+			affinity_params_t{}
+				.cpu_sets( std::move(cpu_sets) )
+				.thread_init_hook( [node]( std::size_t ) noexcept {
+						impl::current_node = node;
+					} ),
+			std::move(underlying) );
+}
+
+} /* namespace so_5::disp::numa */
+
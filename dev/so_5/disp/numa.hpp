@@ -0,0 +1,198 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Tools for NUMA-aware dispatchers.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp/affinity_work_thread_factory.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace so_5::disp::numa
+{
+
+//
+// cpu_list_t
+//
+/*!
+ * \brief Type of list of CPU indexes.
+ *
+ * \since v.5.8.4
+ */
+using cpu_list_t = so_5::disp::cpu_list_t;
+
+//
+// topology_t
+//
+/*!
+ * \brief Description of NUMA nodes to be used by a dispatcher.
+ *
+ * Every node is described by a list of CPUs that belong to the node.
+ * The list of CPUs can be empty. In that case worker threads created
+ * for the node won't be pinned to particular CPUs.
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp::thread_pool;
+ * auto disp = make_dispatcher( env, "workers",
+ * 	disp_params_t{}
+ * 		.thread_count( 16 )
+ * 		.numa_topology( so_5::disp::numa::topology_t{}
+ * 			.add_node( { 0, 1, 2, 3, 4, 5, 6, 7 } )
+ * 			.add_node( { 8, 9, 10, 11, 12, 13, 14, 15 } ) ) );
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+class topology_t
+	{
+	public :
+		topology_t() = default;
+
+		friend void
+		swap( topology_t & a, topology_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_nodes, b.m_nodes );
+			}
+
+		//! Add a description of another node.
+		/*!
+		 * The index of the new node is equal to the count of nodes
+		 * added before.
+		 */
+		topology_t &
+		add_node( cpu_list_t cpus ) &
+			{
+				m_nodes.push_back( std::move(cpus) );
+				return *this;
+			}
+
+		//! Add a description of another node.
+		topology_t &&
+		add_node( cpu_list_t cpus ) &&
+			{
+				return std::move( this->add_node( std::move(cpus) ) );
+			}
+
+		//! Count of nodes.
+		[[nodiscard]]
+		std::size_t
+		node_count() const noexcept
+			{
+				return m_nodes.size();
+			}
+
+		//! Is there no nodes at all?
+		[[nodiscard]]
+		bool
+		empty() const noexcept
+			{
+				return m_nodes.empty();
+			}
+
+		//! CPUs of the specified node.
+		/*!
+		 * \attention
+		 * The \a node must be less than node_count().
+		 */
+		[[nodiscard]]
+		const cpu_list_t &
+		node_cpus( std::size_t node ) const noexcept
+			{
+				return m_nodes[ node ];
+			}
+
+	private :
+		//! Descriptions of nodes.
+		std::vector< cpu_list_t > m_nodes;
+	};
+
+//
+// detect_topology
+//
+/*!
+ * \brief Detect NUMA topology of the current machine.
+ *
+ * On Linux the information is taken from /sys/devices/system/node.
+ *
+ * If the information isn't available (or it's not Linux) then a topology
+ * with just one node with empty list of CPUs is returned.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC
+topology_t
+detect_topology();
+
+//
+// current_thread_node
+//
+/*!
+ * \brief Get the index of the NUMA node for the current thread.
+ *
+ * Returns the index of the node if the current thread was started by
+ * a work thread factory created by make_node_work_thread_factory().
+ * Returns 0 for all other threads.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC
+std::size_t
+current_thread_node() noexcept;
+
+//
+// make_node_work_thread_factory
+//
+/*!
+ * \brief Create a work thread factory for worker threads of a NUMA node.
+ *
+ * It's a factory created by make_affinity_work_thread_factory() that
+ * pins threads to \a cpus and remembers \a node as
+ * current_thread_node() before the start of the actual body of
+ * a worker thread.
+ *
+ * The factory can be passed to any standard dispatcher by the
+ * `work_thread_factory()` method of its disp_params:
+ * \code
+ * auto disp = so_5::disp::one_thread::make_dispatcher( env, "node_1",
+ * 	so_5::disp::one_thread::disp_params_t{}
+ * 		.work_thread_factory(
+ * 			so_5::disp::numa::make_node_work_thread_factory(
+ * 				1u, { 8, 9, 10, 11 } ) ) );
+ * \endcode
+ *
+ * \note
+ * CPU affinity is supported only on Linux. On other platforms \a cpus
+ * is ignored. An empty \a cpus means that affinity isn't changed.
+ * Failures during the change of affinity are reported via the
+ * error_logger of SObjectizer Environment.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_node_work_thread_factory(
+	//! Index of NUMA node for worker threads.
+	std::size_t node,
+	//! CPUs for worker threads.
+	cpu_list_t cpus,
+	//! Factory for actual worker threads.
+	abstract_work_thread_factory_shptr_t underlying = {} );
+
+} /* namespace so_5::disp::numa */
+
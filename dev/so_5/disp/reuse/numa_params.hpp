@@ -0,0 +1,132 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Various helpers for parameters of NUMA-aware dispatchers.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/disp/numa.hpp>
+
+#include <optional>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+/*!
+ * \brief Mixin that holds optional NUMA topology for a dispatcher.
+ *
+ * Indended to be used as mixin for various disp_params_t classes.
+ *
+ * \since v.5.8.4
+ */
+template< typename Params >
+class numa_topology_mixin_t
+	{
+		/*!
+		 * Topology to be used.
+		 *
+		 * \note
+		 * Empty topology means that the dispatcher isn't NUMA-aware.
+		 */
+		so_5::disp::numa::topology_t m_numa_topology;
+
+	public :
+		//! Getter for NUMA topology.
+		[[nodiscard]]
+		const so_5::disp::numa::topology_t &
+		numa_topology() const noexcept
+			{
+				return m_numa_topology;
+			}
+
+		friend void
+		swap(
+				numa_topology_mixin_t & a,
+				numa_topology_mixin_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_numa_topology, b.m_numa_topology );
+			}
+
+		//! Setter for NUMA topology.
+		/*!
+		 * Worker threads of the dispatcher are distributed between
+		 * NUMA nodes in round-robin manner. Every worker thread is pinned
+		 * to CPUs of its node.
+		 *
+		 * Usage example:
+		 * \code
+		 * using namespace so_5::disp::thread_pool;
+		 * auto disp = make_dispatcher( env, "workers",
+		 * 	disp_params_t{}
+		 * 		.thread_count( 16 )
+		 * 		.numa_topology( so_5::disp::numa::detect_topology() ) );
+		 * \endcode
+		 */
+		Params &
+		numa_topology( so_5::disp::numa::topology_t v ) noexcept
+			{
+				m_numa_topology = std::move(v);
+				return static_cast< Params & >(*this);
+			}
+	};
+
+/*!
+ * \brief Mixin that holds optional NUMA node for binding an agent.
+ *
+ * Indended to be used as mixin for various bind_params_t classes.
+ *
+ * \since v.5.8.4
+ */
+template< typename Params >
+class numa_node_mixin_t
+	{
+		//! NUMA node to be used.
+		/*!
+		 * If it's empty then a node will be selected by the dispatcher.
+		 */
+		std::optional< std::size_t > m_numa_node;
+
+	public :
+		//! Set NUMA node for the agent (or the cooperation).
+		/*!
+		 * The event queue of the agent (or the cooperation) will be handled
+		 * by worker threads of that node. Worker threads of other nodes will
+		 * handle the queue only if they have nothing to do with queues of
+		 * their own node.
+		 *
+		 * \note
+		 * If the node isn't set then nodes are assigned to event queues
+		 * in round-robin manner.
+		 */
+		Params &
+		numa_node( std::size_t v ) noexcept
+			{
+				m_numa_node = v;
+				return static_cast< Params & >(*this);
+			}
+
+		//! Get NUMA node for the agent (or the cooperation).
+		[[nodiscard]]
+		std::optional< std::size_t >
+		query_numa_node() const noexcept
+			{
+				return m_numa_node;
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
@@ -13,7 +13,13 @@
 
 #include <so_5/disp/mpmc_queue_traits/pub.hpp>
 
+#include <so_5/disp/numa.hpp>
+
+#include <atomic>
+#include <cstdint>
 #include <deque>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -40,6 +46,28 @@ namespace reuse
  * void intrusive_queue_set_next( T * next ) noexcept;
  * \endcode
  *
+ * \note
+ * Since v.5.8.4 this queue can be NUMA-aware. There is a separate list
+ * of event queues for every NUMA node. An event queue is placed into
+ * the list of its node (see schedule()). A working thread takes
+ * event queues from the list of its own node first (the node of a thread
+ * is detected by so_5::disp::numa::current_thread_node()). Event queues
+ * of other nodes are taken only if the list of thread's node is empty.
+ * There is just one node by default.
+ *
+ * \note
+ * Since v.5.8.4 every working thread has a LIFO slot for just one event
+ * queue. An event queue is placed into the slot of the current thread
+ * by schedule_to_lifo_slot(). The queue from the slot is taken by the
+ * thread before any queue from the common list (see pop() and
+ * try_switch_to_another()). So an event queue activated by a handler
+ * is handled on the same (cache-hot) thread. To prevent the starvation of
+ * the common list the slot can be used no more than
+ * max_lifo_slot_picks_in_row times in a row. A queue is never placed into
+ * the slot if there are sleeping threads, and a thread steals a queue
+ * from the slot of another (busy) thread before going to sleep. So a queue
+ * doesn't wait in the slot while other threads are idle.
+ *
  * \tparam T type of event queue.
  *
  * \since v.5.4.0, v.5.8.0
@@ -47,20 +75,125 @@ namespace reuse
 template< class T >
 class queue_of_queues_t
 	{
+		//! Short alias for the type of condition.
+		using condition_t = so_5::disp::mpmc_queue_traits::condition_t;
+
+		/*!
+		 * \brief Data for one NUMA node.
+		 *
+		 * \since v.5.8.4
+		 */
+		struct node_data_t
+			{
+				/*!
+				 * \brief The current head of the intrusive queue.
+				 *
+				 * Holds nullptr if the queue is empty.
+				 *
+				 * \since v.5.8.0
+				 */
+				T * m_head{ nullptr };
+
+				/*!
+				 * \brief The current tail of the intrusive queue.
+				 *
+				 * Holds nullptr if the queue is empty.
+				 * It is equal to m_head if the queue contains just one item.
+				 *
+				 * \since v.5.8.0
+				 */
+				T * m_tail{ nullptr };
+
+				//! Waiting threads of that node.
+				std::vector< condition_t * > m_waiting_customers;
+
+				//! Count of threads of that node that are notified but
+				//! haven't returned from the waiting yet.
+				std::size_t m_awakening{};
+			};
+
+		/*!
+		 * \brief LIFO slot of a working thread.
+		 *
+		 * The slot is filled only by its owner. But the queue from the slot
+		 * can be stolen by an idle thread, so the slot is accessed only by
+		 * atomic operations.
+		 *
+		 * \since v.5.8.4
+		 */
+		struct alignas(64) lifo_slot_t
+			{
+				//! Event queue in the slot.
+				/*!
+				 * Holds nullptr if the slot is empty.
+				 */
+				std::atomic< T * > m_item{ nullptr };
+			};
+
+		//! Special value for the absence of a LIFO slot.
+		static constexpr std::size_t no_lifo_slot =
+				std::numeric_limits< std::size_t >::max();
+
+		/*!
+		 * \brief Binding of the current thread to its LIFO slot.
+		 *
+		 * \since v.5.8.4
+		 */
+		struct lifo_slot_binding_t
+			{
+				//! ID of the queue_of_queues the current thread works for.
+				/*!
+				 * Holds 0 if the current thread isn't a worker thread.
+				 *
+				 * \note
+				 * An unique ID is used instead of a pointer because a thread
+				 * can be reused by a custom work thread factory for a new
+				 * dispatcher that is created at the same address.
+				 */
+				std::uint64_t m_owner_id{ 0u };
+
+				//! Index of the slot of the current thread.
+				/*!
+				 * Holds no_lifo_slot if there is no slot for the thread.
+				 */
+				std::size_t m_index{ no_lifo_slot };
+
+				//! How many times the slot was used in a row.
+				unsigned int m_picks_in_row{ 0u };
+			};
+
 	public :
 		using item_t = T;
 
+		/*!
+		 * \brief How many times in a row an event queue can be taken
+		 * from the LIFO slot of a thread.
+		 *
+		 * When this limit is reached the queue from the slot is moved
+		 * to the end of the common list.
+		 *
+		 * \since v.5.8.4
+		 */
+		static constexpr unsigned int max_lifo_slot_picks_in_row = 3u;
+
 		queue_of_queues_t(
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
-			std::size_t thread_count )
+			std::size_t thread_count,
+			//! Count of NUMA nodes.
+			//! Since v.5.8.4.
+			std::size_t numa_node_count = 1u )
 			:	m_lock{ queue_params.lock_factory()() }
 			,	m_max_thread_count{ thread_count }
 			,	m_next_thread_wakeup_threshold{
 					queue_params.next_thread_wakeup_threshold() }
+			,	m_nodes( numa_node_count ? numa_node_count : 1u )
+			,	m_id{ make_instance_id() }
+			,	m_lifo_slots{ std::make_unique< lifo_slot_t[] >( thread_count ) }
 			{
 				// Reserve some space for storing infos about waiting
 				// customer threads.
-				m_waiting_customers.reserve( thread_count );
+				for( auto & n : m_nodes )
+					n.m_waiting_customers.reserve( thread_count );
 			}
 
 		//! Initiate shutdown for working threads.
@@ -71,33 +204,72 @@ class queue_of_queues_t
 
 				m_shutdown = true;
 
-				while( !m_waiting_customers.empty() )
-					pop_and_notify_one_waiting_customer();
+				for( std::size_t i = 0u; i != m_nodes.size(); ++i )
+					while( !m_nodes[ i ].m_waiting_customers.empty() )
+						pop_and_notify_one_waiting_customer( i );
 			}
 
 		//! Get next active queue.
 		/*!
+		 * Queues of the NUMA node of the current thread are returned first.
+		 * Queues of other nodes are returned only if there are no queues
+		 * of the current thread's node.
+		 *
+		 * \note
+		 * Since v.5.8.4 the queue from the LIFO slot of the current thread
+		 * is returned before any other queue.
+		 *
 		 * \retval nullptr is the case of dispatcher shutdown.
 		 */
 		inline T *
-		pop( so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+		pop( condition_t & condition ) noexcept
 			{
+				const auto node = current_thread_node();
+
+				// The slot is filled only by the current thread, so there is
+				// no need to acquire the lock for it.
+				auto & binding = current_lifo_slot_binding();
+				const bool is_new_binding = m_id != binding.m_owner_id;
+				if( is_new_binding )
+					binding = lifo_slot_binding_t{ m_id };
+				else if( binding.m_picks_in_row < max_lifo_slot_picks_in_row )
+					{
+						if( auto * r = take_from_own_lifo_slot( binding ) )
+							{
+								++binding.m_picks_in_row;
+								return r;
+							}
+					}
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
+				if( is_new_binding )
+					bind_lifo_slot( binding );
+
+				// The queue from the slot was taken too many times in a row.
+				// It has to wait in the common list with other queues.
+				if( auto * r = take_from_own_lifo_slot( binding ) )
+					push_to_queue( node, r );
+				binding.m_picks_in_row = 0u;
+
 				do
 					{
 						if( m_shutdown )
 							break;
 
-						if( m_head )
+						if( m_queue_size )
 							{
 								// The queue isn't empty, the head has to be extracted.
-								auto r = pop_head();
-
-								// There could be non-empty queue and sleeping workers...
-								try_wakeup_someone_if_possible();
-
-								return r;
+								// But it's possible that all items belong to other nodes
+								// and should be handled by threads of those nodes.
+								if( auto r = pop_head_for( node ) )
+									{
+										// There could be non-empty queue and sleeping
+										// workers...
+										try_wakeup_someone_if_possible( node );
+
+										return r;
+									}
 							}
 
 						// Exception safety note: it seems that there should not be
@@ -106,20 +278,49 @@ class queue_of_queues_t
 						// are used. So if the actual count of worker threads equals
 						// to thread_count constructor's parameter, then there is
 						// no need to expand m_waiting_customers vector.
-						m_waiting_customers.push_back( &condition );
+						m_nodes[ node ].m_waiting_customers.push_back( &condition );
+						++m_waiting_customers_count;
+
+						// A queue can be left in the LIFO slot of a busy thread.
+						// It has to be handled by the current thread instead
+						// of sleeping.
+						//
+						// NOTE: the count of waiting customers is incremented
+						// before the check. A thread that places a queue into its
+						// slot checks that count after the placement and takes
+						// the queue back if the count isn't zero
+						// (see schedule_to_lifo_slot()). So the queue can't be
+						// missed by both threads.
+						if( auto * r = steal_from_lifo_slots( binding ) )
+							{
+								m_nodes[ node ].m_waiting_customers.pop_back();
+								--m_waiting_customers_count;
+
+								return r;
+							}
 
 						condition.wait();
 						// If we are here then the current wakeup procedure is
 						// finished.
 						m_wakeup_in_progress = false;
+						--m_nodes[ node ].m_awakening;
 					}
 				while( true );
 
+				// The current thread doesn't work for that queue anymore.
+				binding = lifo_slot_binding_t{};
+
 				return nullptr;
 			}
 
 		//! Switch the current non-empty queue to another one if it is possible.
 		/*!
+		 * Only queues of the NUMA node of the current thread are checked.
+		 *
+		 * \note
+		 * Since v.5.8.4 the queue from the LIFO slot of the current thread
+		 * is returned first (if the slot wasn't used too many times in a row).
+		 *
 		 * \return nullptr is the case of dispatcher shutdown.
 		 *
 		 * \since v.5.5.15.1
@@ -128,19 +329,42 @@ class queue_of_queues_t
 		inline T *
 		try_switch_to_another( T * current ) noexcept
 			{
+				const auto node = current_thread_node();
+				auto & binding = current_lifo_slot_binding();
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				if( m_shutdown )
 					return nullptr;
 
-				if( m_head )
+				if( auto * r = take_from_own_lifo_slot( binding ) )
+					{
+						if( binding.m_picks_in_row < max_lifo_slot_picks_in_row )
+							{
+								++binding.m_picks_in_row;
+
+								// Old non-empty queue must be stored for further
+								// processing. Someone can take it while the queue from
+								// the slot is being processed.
+								push_to_queue( node, current );
+								try_wakeup_someone_if_possible( node );
+
+								return r;
+							}
+
+						push_to_queue( node, r );
+						try_wakeup_someone_if_possible( node );
+					}
+				binding.m_picks_in_row = 0u;
+
+				if( m_nodes[ node ].m_head )
 					{
-						auto r = pop_head();
+						auto r = pop_head( node );
 
 						// Old non-empty queue must be stored for further processing.
 						// No need to wakup someone because the length of the queue
 						// didn't changed.
-						push_to_queue( current );
+						push_to_queue( node, current );
 
 						return r;
 					}
@@ -150,13 +374,62 @@ class queue_of_queues_t
 
 		//! Schedule execution of demands from the queue.
 		void
-		schedule( T * queue ) noexcept
+		schedule(
+			T * queue,
+			//! NUMA node of the queue.
+			//! Since v.5.8.4.
+			std::size_t numa_node = 0u ) noexcept
 			{
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
-				push_to_queue( queue );
+				push_to_queue( numa_node, queue );
 
-				try_wakeup_someone_if_possible();
+				try_wakeup_someone_if_possible( numa_node );
+			}
+
+		//! Schedule execution of demands from the queue on the current
+		//! working thread.
+		/*!
+		 * If the current thread is a working thread for that queue_of_queues,
+		 * belongs to \a numa_node and there are no sleeping threads then
+		 * \a queue is placed into the LIFO slot of the current thread.
+		 * The previous content of the slot (if any) is moved to the common
+		 * list. Otherwise it's the same as schedule().
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		schedule_to_lifo_slot(
+			T * queue,
+			//! NUMA node of the queue.
+			std::size_t numa_node = 0u ) noexcept
+			{
+				const auto & binding = current_lifo_slot_binding();
+				// If there are sleeping threads the queue has to go to the
+				// common list. Otherwise it would wait in the slot until the
+				// current event handler finishes while other threads sleep.
+				if( m_id == binding.m_owner_id &&
+						no_lifo_slot != binding.m_index &&
+						numa_node == current_thread_node() &&
+						0u == m_waiting_customers_count.load() )
+					{
+						auto & item = m_lifo_slots[ binding.m_index ].m_item;
+
+						// No need to wake up someone because the current thread
+						// will take the queue from the slot.
+						if( auto * old = item.exchange( queue ) )
+							schedule( old, numa_node );
+
+						// A thread could start waiting after the check above
+						// and could miss the queue in the slot. The queue has to
+						// go to the common list in that case (if it isn't stolen
+						// yet).
+						if( 0u != m_waiting_customers_count.load() )
+							if( auto * q = item.exchange( nullptr ) )
+								schedule( q, numa_node );
+					}
+				else
+					schedule( queue, numa_node );
 			}
 
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
@@ -165,6 +438,31 @@ class queue_of_queues_t
 				return m_lock->allocate_condition();
 			}
 
+		//! Get the approximate count of event queues waiting for a worker.
+		/*!
+		 * The value is read without acquiring the queue lock, so it
+		 * can be outdated at the moment of return.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		approx_size() const noexcept
+			{
+				return m_queue_size.load( std::memory_order_relaxed );
+			}
+
+		//! Get the count of working threads for that queue.
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		thread_count() const noexcept
+			{
+				return m_max_thread_count;
+			}
+
 	private :
 		//! Object's lock.
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
@@ -173,30 +471,17 @@ class queue_of_queues_t
 		bool	m_shutdown{ false };
 
 		/*!
-		 * \brief The current head of the intrusive queue.
-		 *
-		 * Holds nullptr if the queue is empty.
-		 *
-		 * \since v.5.8.0
-		 */
-		T * m_head{ nullptr };
-
-		/*!
-		 * \brief The current tail of the intrusive queue.
+		 * \brief The current size of the intrusive queue.
 		 *
-		 * Holds nullptr if the queue is empty.
-		 * It is equal to m_head if the queue contains just one item.
+		 * It's the total size of queues of all NUMA nodes.
 		 *
-		 * \since v.5.8.0
-		 */
-		T * m_tail{ nullptr };
-
-		/*!
-		 * \brief The current size of the intrusive queue.
+		 * \note
+		 * It's modified only under the queue lock. It's atomic since
+		 * v.5.8.4 because it's also read without the lock by approx_size().
 		 *
 		 * \since v.5.8.0
 		 */
-		std::size_t m_queue_size{};
+		std::atomic< std::size_t > m_queue_size{};
 
 		/*!
 		 * \brief Is some working thread in wakeup process now?
@@ -222,19 +507,212 @@ class queue_of_queues_t
 		 */
 		const std::size_t m_next_thread_wakeup_threshold;
 
-		//! Waiting threads.
-		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+		/*!
+		 * \brief Data for every NUMA node.
+		 *
+		 * There is always at least one item.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::vector< node_data_t > m_nodes;
 
+		/*!
+		 * \brief Total count of waiting threads.
+		 *
+		 * \note
+		 * It's modified only under the queue lock. It's atomic because
+		 * it's also read without the lock by schedule_to_lifo_slot().
+		 *
+		 * \since v.5.8.4
+		 */
+		std::atomic< std::size_t > m_waiting_customers_count{};
+
+		/*!
+		 * \brief Unique ID of that queue_of_queues.
+		 *
+		 * It's used for the identification of LIFO slots of working threads.
+		 *
+		 * \since v.5.8.4
+		 */
+		const std::uint64_t m_id;
+
+		/*!
+		 * \brief LIFO slots of working threads.
+		 *
+		 * There is a slot for every working thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		const std::unique_ptr< lifo_slot_t[] > m_lifo_slots;
+
+		/*!
+		 * \brief Count of LIFO slots that are bound to working threads.
+		 *
+		 * \note
+		 * It's modified and read only under the queue lock.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::size_t m_lifo_slots_used{};
+
+		//! Generate an unique ID for a new instance.
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static std::uint64_t
+		make_instance_id() noexcept
+			{
+				static std::atomic< std::uint64_t > counter{ 0u };
+				return ++counter;
+			}
+
+		//! Access to the binding of the current thread to its LIFO slot.
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static lifo_slot_binding_t &
+		current_lifo_slot_binding() noexcept
+			{
+				static thread_local lifo_slot_binding_t binding;
+				return binding;
+			}
+
+		//! Bind a free LIFO slot to the current thread.
+		/*!
+		 * The current thread gets no slot if all slots are already bound
+		 * (it's possible if there are more working threads than
+		 * it was specified in the constructor).
+		 *
+		 * \attention
+		 * Must be called under the queue lock.
+		 *
+		 * \since v.5.8.4
+		 */
 		void
-		pop_and_notify_one_waiting_customer() noexcept
+		bind_lifo_slot( lifo_slot_binding_t & binding ) noexcept
 			{
-				auto & condition = *m_waiting_customers.back();
-				m_waiting_customers.pop_back();
+				if( m_lifo_slots_used < m_max_thread_count )
+					binding.m_index = m_lifo_slots_used++;
+			}
+
+		//! Take the queue from the LIFO slot of the current thread.
+		/*!
+		 * \return nullptr if the slot is empty.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		T *
+		take_from_own_lifo_slot( const lifo_slot_binding_t & binding ) noexcept
+			{
+				if( m_id != binding.m_owner_id || no_lifo_slot == binding.m_index )
+					return nullptr;
+
+				auto & item = m_lifo_slots[ binding.m_index ].m_item;
+				// The slot is usually empty, so the exchange is performed
+				// only if there is something to take.
+				if( !item.load( std::memory_order_relaxed ) )
+					return nullptr;
+
+				return item.exchange( nullptr );
+			}
+
+		//! Steal a queue from the LIFO slot of another thread.
+		/*!
+		 * \attention
+		 * Must be called under the queue lock.
+		 *
+		 * \return nullptr if all slots are empty.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		T *
+		steal_from_lifo_slots( const lifo_slot_binding_t & binding ) noexcept
+			{
+				for( std::size_t i = 0u; i != m_lifo_slots_used; ++i )
+					{
+						if( i == binding.m_index )
+							continue;
+
+						auto & item = m_lifo_slots[ i ].m_item;
+						if( item.load() )
+							if( auto * r = item.exchange( nullptr ) )
+								return r;
+					}
+
+				return nullptr;
+			}
+
+		/*!
+		 * \brief Get NUMA node of the current thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		current_thread_node() const noexcept
+			{
+				if( 1u == m_nodes.size() )
+					return 0u;
+
+				return so_5::disp::numa::current_thread_node() % m_nodes.size();
+			}
+
+		void
+		pop_and_notify_one_waiting_customer( std::size_t node ) noexcept
+			{
+				auto & data = m_nodes[ node ];
+				auto & condition = *data.m_waiting_customers.back();
+				data.m_waiting_customers.pop_back();
+				--m_waiting_customers_count;
+				++data.m_awakening;
 
 				m_wakeup_in_progress = true;
 				condition.notify();
 			}
 
+		/*!
+		 * \brief Select NUMA node from that a waiting customer should be
+		 * awakened.
+		 *
+		 * A node that has both non-empty queues and waiting customers is
+		 * preferred (\a preferred_node is checked first). If there is no such
+		 * node then a node with waiting customers is selected. The awakened
+		 * thread will take a queue from other node.
+		 *
+		 * \attention
+		 * Must be called only if there are some waiting customers.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		select_node_for_wakeup( std::size_t preferred_node ) const noexcept
+			{
+				const auto node_count = m_nodes.size();
+
+				for( std::size_t i = 0u; i != node_count; ++i )
+					{
+						const auto node = ( preferred_node + i ) % node_count;
+						const auto & data = m_nodes[ node ];
+						if( data.m_head && !data.m_waiting_customers.empty() )
+							return node;
+					}
+
+				for( std::size_t i = 0u; i != node_count; ++i )
+					{
+						const auto node = ( preferred_node + i ) % node_count;
+						if( !m_nodes[ node ].m_waiting_customers.empty() )
+							return node;
+					}
+
+				// Must not be here because there are waiting customers.
+				return preferred_node;
+			}
+
 		/*!
 		 * \brief An attempt to wakeup another sleeping thread if it's necessary
 		 * and possible.
@@ -250,56 +728,94 @@ class queue_of_queues_t
 		 * \since v.5.5.15.1
 		 */
 		void
-		try_wakeup_someone_if_possible() noexcept
+		try_wakeup_someone_if_possible( std::size_t preferred_node ) noexcept
 			{
-				if( m_head &&
-						!m_waiting_customers.empty() &&
+				if( m_queue_size &&
+						m_waiting_customers_count &&
 						!m_wakeup_in_progress &&
 						( m_queue_size > m_next_thread_wakeup_threshold ||
-						m_max_thread_count == m_waiting_customers.size() ) )
+						m_max_thread_count == m_waiting_customers_count ) )
 					{
-						pop_and_notify_one_waiting_customer();
+						pop_and_notify_one_waiting_customer(
+								select_node_for_wakeup( preferred_node ) );
 					}
 			}
 
 		/*!
-		 * \brief Helper method that extracts the head item from the queue.
+		 * \brief Helper method that extracts the head item from the queue
+		 * of the specified NUMA node.
 		 *
 		 * \attention
-		 * This method must only be called if the queue isn't empty.
-		 * The method doesn't check this condition by itself.
+		 * This method must only be called if the queue of the node isn't
+		 * empty. The method doesn't check this condition by itself.
 		 *
 		 * \since v.5.8.0
 		 */
 		[[nodiscard]]
 		T *
-		pop_head() noexcept
+		pop_head( std::size_t node ) noexcept
 			{
-				auto r = m_head;
-				m_head = r->intrusive_queue_giveout_next();
-				if( !m_head )
-					m_tail = nullptr;
+				auto & data = m_nodes[ node ];
+
+				auto r = data.m_head;
+				data.m_head = r->intrusive_queue_giveout_next();
+				if( !data.m_head )
+					data.m_tail = nullptr;
 				--m_queue_size;
 
 				return r;
 			}
 
 		/*!
-		 * \brief Helper method that pushes a new item to the end of the queue.
+		 * \brief Helper method that extracts the head item for a thread
+		 * from the specified NUMA node.
+		 *
+		 * The queue of \a node is checked first. If it's empty then
+		 * an item is taken from the queue of some other node. But only
+		 * if there is no notified thread of that other node (such a thread
+		 * will take the item soon).
+		 *
+		 * \return nullptr if there is no appropriate item.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		T *
+		pop_head_for( std::size_t node ) noexcept
+			{
+				if( m_nodes[ node ].m_head )
+					return pop_head( node );
+
+				const auto node_count = m_nodes.size();
+				for( std::size_t i = 1u; i != node_count; ++i )
+					{
+						const auto n = ( node + i ) % node_count;
+						const auto & data = m_nodes[ n ];
+						if( data.m_head && !data.m_awakening )
+							return pop_head( n );
+					}
+
+				return nullptr;
+			}
+
+		/*!
+		 * \brief Helper method that pushes a new item to the end of the queue
+		 * of the specified NUMA node.
 		 *
 		 * \since v.5.8.0
 		 */
 		void
-		push_to_queue( T * new_tail ) noexcept
+		push_to_queue( std::size_t node, T * new_tail ) noexcept
 			{
-				if( m_tail )
+				auto & data = m_nodes[ node ];
+				if( data.m_tail )
 					{
-						m_tail->intrusive_queue_set_next( new_tail );
-						m_tail = new_tail;
+						data.m_tail->intrusive_queue_set_next( new_tail );
+						data.m_tail = new_tail;
 					}
 				else
 					{
-						m_head = m_tail = new_tail;
+						data.m_head = data.m_tail = new_tail;
 					}
 				++m_queue_size;
 			}
@@ -48,6 +48,15 @@ struct queue_description_t
 
 		//! Current queue size.
 		std::size_t m_queue_size;
+
+		//! Current count of demands to be processed at once.
+		/*!
+		 * Holds 0 if the adaptive count of demands isn't used for
+		 * that queue.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::size_t m_demands_at_once;
 	};
 
 /*!
@@ -116,6 +125,7 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = agent_count;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_demands_at_once = 0;
 
 		return result;
 	}
@@ -142,6 +152,7 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = 1;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_demands_at_once = 0;
 
 		return result;
 	}
@@ -164,6 +175,18 @@ class stats_consumer_t
 		virtual void
 		set_thread_count( std::size_t value ) = 0;
 
+		/*!
+		 * \brief Informs consumer about stats of dispatcher's demand pool.
+		 *
+		 * \since v.5.8.4
+		 */
+		virtual void
+		set_demand_pool_stats(
+			//! Count of demand allocations satisfied by the pool.
+			std::size_t hits,
+			//! Count of demand allocations not satisfied by the pool.
+			std::size_t misses ) = 0;
+
 		//! Informs counsumer about yet another event queue.
 		virtual void
 		add_queue(
@@ -258,6 +281,18 @@ class data_source_t : public stats::source_t
 						stats::suffixes::agent_count(),
 						collector.agent_count() );
 
+				so_5::send< stats::messages::quantity< std::size_t > >(
+						mbox,
+						m_prefix,
+						stats::suffixes::demand_pool_hits(),
+						collector.demand_pool_hits() );
+
+				so_5::send< stats::messages::quantity< std::size_t > >(
+						mbox,
+						m_prefix,
+						stats::suffixes::demand_pool_misses(),
+						collector.demand_pool_misses() );
+
 				collector.for_each_thread_activity(
 					[this, &mbox]( const so_5::current_thread_id_t & thread_id,
 						const so_5::stats::work_thread_activity_stats_t & stats ) {
@@ -282,6 +317,13 @@ class data_source_t : public stats::source_t
 								queue.m_prefix,
 								stats::suffixes::work_thread_queue_size(),
 								queue.m_queue_size );
+
+						if( queue.m_demands_at_once )
+							so_5::send< stats::messages::quantity< std::size_t > >(
+									mbox,
+									queue.m_prefix,
+									stats::suffixes::demands_at_once(),
+									queue.m_demands_at_once );
 					} );
 			}
 
@@ -378,6 +420,15 @@ class data_source_t : public stats::source_t
 						m_thread_count = thread_count;
 					}
 
+				void
+				set_demand_pool_stats(
+					std::size_t hits,
+					std::size_t misses ) override
+					{
+						m_demand_pool_hits = hits;
+						m_demand_pool_misses = misses;
+					}
+
 				virtual void
 				add_queue(
 					const intrusive_ptr_t< queue_description_holder_t > & info ) override
@@ -417,6 +468,18 @@ class data_source_t : public stats::source_t
 						return m_agent_count;
 					}
 
+				std::size_t
+				demand_pool_hits() const
+					{
+						return m_demand_pool_hits;
+					}
+
+				std::size_t
+				demand_pool_misses() const
+					{
+						return m_demand_pool_misses;
+					}
+
 				template< typename Lambda >
 				void
 				for_each_queue( Lambda lambda ) const
@@ -443,6 +506,8 @@ class data_source_t : public stats::source_t
 
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
+				std::size_t m_demand_pool_hits = { 0 };
+				std::size_t m_demand_pool_misses = { 0 };
 
 				wt_activity_info_container_t & m_wt_activity;
 
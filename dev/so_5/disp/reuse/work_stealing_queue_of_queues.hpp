@@ -0,0 +1,516 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Work-stealing queue of pointers to event queues.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/pub.hpp>
+
+#include <so_5/spinlocks.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// work_stealing_queue_of_queues_t
+//
+/*!
+ * \brief Work-stealing queue of pointers to event queues.
+ *
+ * This is an alternative to so_5::disp::reuse::queue_of_queues_t with
+ * the same interface. Instead of one common intrusive queue protected by
+ * one common lock there is a separate local queue for every worker thread.
+ *
+ * A non-empty event queue is placed into the local queue of the worker
+ * thread that makes the event queue non-empty (if the scheduling is
+ * performed on a worker thread of the same dispatcher). If the scheduling
+ * is performed on some other thread then a local queue is selected
+ * randomly.
+ *
+ * A worker thread takes event queues from its local queue first. If its
+ * local queue is empty the worker tries to steal an event queue from
+ * other workers. A victim is selected randomly.
+ *
+ * The lock created by the lock_factory from queue_params is used only for
+ * putting idle workers to sleep and for waking them up. It isn't touched
+ * by producers if there are no sleeping workers.
+ *
+ * Type \a T has to provide the following methods:
+ * \code
+ * T * intrusive_queue_giveout_next() noexcept;
+ * void intrusive_queue_set_next( T * next ) noexcept;
+ * \endcode
+ *
+ * \note
+ * Worker threads are identified by a thread-local binding that is
+ * established at the first call to pop() made on that thread.
+ *
+ * \tparam T type of event queue.
+ *
+ * \since v.5.8.4
+ */
+template< class T >
+class work_stealing_queue_of_queues_t
+	{
+		//! Short alias for the type of sleep lock.
+		using lock_t = so_5::disp::mpmc_queue_traits::lock_t;
+
+		/*!
+		 * \brief Local queue of a worker thread.
+		 *
+		 * Local queues are aligned to prevent false sharing between
+		 * different workers.
+		 */
+		struct alignas(64) local_queue_t
+			{
+				//! Lock for the local queue.
+				so_5::default_spinlock_t m_lock;
+
+				//! Head of the intrusive queue (nullptr if queue is empty).
+				T * m_head{ nullptr };
+
+				//! Tail of the intrusive queue (nullptr if queue is empty).
+				T * m_tail{ nullptr };
+
+				/*!
+				 * \brief Current size of the local queue.
+				 *
+				 * Modified only when m_lock is acquired but can be read
+				 * without locking.
+				 */
+				std::atomic< std::size_t > m_size{ 0u };
+			};
+
+		/*!
+		 * \brief Information about the binding of the current thread
+		 * to a local queue.
+		 */
+		struct thread_binding_t
+			{
+				//! ID of the queue_of_queues the current thread is bound to.
+				/*!
+				 * Holds 0 if the current thread isn't a worker thread.
+				 *
+				 * \note
+				 * An unique ID is used instead of a pointer because a thread
+				 * can be reused by a custom work thread factory for a new
+				 * dispatcher that is created at the same address.
+				 */
+				std::uint64_t m_owner_id{ 0u };
+
+				//! Index of the local queue for the current thread.
+				std::size_t m_index{ 0u };
+
+				//! State of xorshift generator for victim selection.
+				std::uint32_t m_random{ 0u };
+			};
+
+	public :
+		using item_t = T;
+
+		work_stealing_queue_of_queues_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_id{ make_instance_id() }
+			,	m_thread_count{ thread_count }
+			,	m_local_queues{ new local_queue_t[ thread_count ] }
+			{
+				// Reserve some space for storing infos about waiting
+				// customer threads.
+				m_waiting_customers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		void
+		shutdown() noexcept
+			{
+				std::lock_guard< lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		[[nodiscard]]
+		T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				auto & binding = bind_current_thread_as_worker();
+
+				for(;;)
+					{
+						if( m_shutdown.load( std::memory_order_acquire ) )
+							return nullptr;
+
+						T * r = pop_from( m_local_queues[ binding.m_index ] );
+						if( !r )
+							r = try_steal( binding );
+
+						if( r )
+							{
+								// There could be more non-empty queues and
+								// sleeping workers...
+								//
+								// NOTE: m_sleepers is checked first because
+								// has_pending_items() scans all local queues and
+								// try_wakeup_someone_if_possible() acquires m_lock.
+								// It's just a hint, a producer wakes up a sleeping
+								// worker by itself (see schedule()).
+								if( m_sleepers.load( std::memory_order_relaxed ) &&
+										has_pending_items() )
+									try_wakeup_someone_if_possible();
+
+								return r;
+							}
+
+						std::lock_guard< lock_t > lock{ *m_lock };
+
+						if( m_shutdown.load( std::memory_order_acquire ) )
+							return nullptr;
+
+						// Exception safety note: there is no memory allocation
+						// because m_waiting_customers is reserved in the
+						// constructor.
+						m_waiting_customers.push_back( &condition );
+						m_sleepers.store(
+								m_waiting_customers.size(),
+								std::memory_order_seq_cst );
+
+						// A producer could push a new item before it sees
+						// the updated m_sleepers value.
+						// So it's necessary to recheck local queues.
+						if( has_pending_items() )
+							{
+								m_waiting_customers.pop_back();
+								m_sleepers.store(
+										m_waiting_customers.size(),
+										std::memory_order_seq_cst );
+								continue;
+							}
+
+						condition.wait();
+						// If we are here then the current wakeup procedure is
+						// finished.
+						m_wakeup_in_progress = false;
+					}
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * Only the local queue of the current worker is checked. The
+		 * \a current queue is placed at the end of the local queue if
+		 * there is another queue to be processed.
+		 *
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		[[nodiscard]]
+		T *
+		try_switch_to_another( T * current ) noexcept
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				auto & local_queue = m_local_queues[ current_binding().m_index ];
+
+				std::lock_guard< so_5::default_spinlock_t > lock{ local_queue.m_lock };
+				if( local_queue.m_head )
+					{
+						T * r = pop_head( local_queue );
+						// Old non-empty queue must be stored for further
+						// processing. The size of the local queue isn't changed
+						// so there is no need to wake up someone.
+						push_to_tail( local_queue, current );
+
+						return r;
+					}
+
+				return current;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue ) noexcept
+			{
+				auto & binding = current_binding();
+
+				const std::size_t index = ( m_id == binding.m_owner_id ) ?
+						binding.m_index :
+						( next_random( binding ) % m_thread_count );
+
+				{
+					auto & local_queue = m_local_queues[ index ];
+					std::lock_guard< so_5::default_spinlock_t > lock{ local_queue.m_lock };
+					push_to_tail( local_queue, queue );
+				}
+
+				// This fence is paired with seq_cst stores to m_sleepers
+				// in pop(). Either we'll see the sleeping worker or the
+				// worker will see our new item.
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_sleepers.load( std::memory_order_relaxed ) )
+					try_wakeup_someone_if_possible();
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock->allocate_condition();
+			}
+
+	private :
+		//! Lock for sleeping/wakeup of worker threads.
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Unique ID of that queue_of_queues instance.
+		const std::uint64_t m_id;
+
+		//! Count of working threads (and local queues).
+		const std::size_t m_thread_count;
+
+		//! Local queues for every worker thread.
+		const std::unique_ptr< local_queue_t[] > m_local_queues;
+
+		//! Counter for assigning local queues to worker threads.
+		std::atomic< std::size_t > m_workers_bound{ 0u };
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Count of sleeping workers.
+		/*!
+		 * It's a copy of m_waiting_customers.size() that can be read
+		 * without acquiring m_lock.
+		 */
+		std::atomic< std::size_t > m_sleepers{ 0u };
+
+		//! Is some working thread in wakeup process now?
+		/*!
+		 * \note
+		 * Modified only when m_lock is acquired.
+		 */
+		bool m_wakeup_in_progress{ false };
+
+		//! Waiting threads.
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+
+		//! Generate an unique ID for a new instance.
+		[[nodiscard]]
+		static std::uint64_t
+		make_instance_id() noexcept
+			{
+				static std::atomic< std::uint64_t > counter{ 0u };
+				return ++counter;
+			}
+
+		//! Access to the binding of the current thread.
+		[[nodiscard]]
+		static thread_binding_t &
+		current_binding() noexcept
+			{
+				static thread_local thread_binding_t binding;
+				return binding;
+			}
+
+		/*!
+		 * \brief Bind the current thread to a local queue if it isn't bound
+		 * yet.
+		 */
+		[[nodiscard]]
+		thread_binding_t &
+		bind_current_thread_as_worker() noexcept
+			{
+				auto & binding = current_binding();
+				if( m_id != binding.m_owner_id )
+					{
+						binding.m_owner_id = m_id;
+						binding.m_index = m_workers_bound.fetch_add(
+								1u, std::memory_order_relaxed ) % m_thread_count;
+						binding.m_random = static_cast< std::uint32_t >(
+								binding.m_index + 1u );
+					}
+
+				return binding;
+			}
+
+		//! Get the next pseudo-random value for the current thread.
+		[[nodiscard]]
+		static std::uint32_t
+		next_random( thread_binding_t & binding ) noexcept
+			{
+				auto x = binding.m_random;
+				if( !x )
+					// The generator for that thread isn't initialized yet.
+					x = static_cast< std::uint32_t >(
+							reinterpret_cast< std::uintptr_t >( &binding ) >> 4u ) | 1u;
+
+				// xorshift32.
+				x ^= x << 13u;
+				x ^= x >> 17u;
+				x ^= x << 5u;
+				binding.m_random = x;
+
+				return x;
+			}
+
+		//! Are there some non-empty local queues?
+		[[nodiscard]]
+		bool
+		has_pending_items() const noexcept
+			{
+				for( std::size_t i = 0u; i != m_thread_count; ++i )
+					if( m_local_queues[ i ].m_size.load( std::memory_order_seq_cst ) )
+						return true;
+
+				return false;
+			}
+
+		//! Try to steal an item from local queues of other workers.
+		[[nodiscard]]
+		T *
+		try_steal( thread_binding_t & binding ) noexcept
+			{
+				if( 1u == m_thread_count )
+					return nullptr;
+
+				const std::size_t start = next_random( binding ) % m_thread_count;
+				for( std::size_t i = 0u; i != m_thread_count; ++i )
+					{
+						const std::size_t victim = ( start + i ) % m_thread_count;
+						if( victim != binding.m_index )
+							{
+								auto & local_queue = m_local_queues[ victim ];
+								// Quick check without locking.
+								if( local_queue.m_size.load( std::memory_order_relaxed ) )
+									if( T * r = pop_from( local_queue ) )
+										return r;
+							}
+					}
+
+				return nullptr;
+			}
+
+		//! Extract the head item from a local queue.
+		/*!
+		 * \return nullptr if local queue is empty.
+		 */
+		[[nodiscard]]
+		static T *
+		pop_from( local_queue_t & local_queue ) noexcept
+			{
+				std::lock_guard< so_5::default_spinlock_t > lock{ local_queue.m_lock };
+				if( local_queue.m_head )
+					return pop_head( local_queue );
+
+				return nullptr;
+			}
+
+		/*!
+		 * \attention
+		 * Must be called only when the sleep lock isn't acquired.
+		 */
+		void
+		try_wakeup_someone_if_possible() noexcept
+			{
+				std::lock_guard< lock_t > lock{ *m_lock };
+
+				if( !m_waiting_customers.empty() && !m_wakeup_in_progress )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		/*!
+		 * \attention
+		 * Must be called only when the sleep lock is acquired.
+		 */
+		void
+		pop_and_notify_one_waiting_customer() noexcept
+			{
+				auto & condition = *m_waiting_customers.back();
+				m_waiting_customers.pop_back();
+				m_sleepers.store(
+						m_waiting_customers.size(),
+						std::memory_order_seq_cst );
+
+				m_wakeup_in_progress = true;
+				condition.notify();
+			}
+
+		/*!
+		 * \brief Helper method that extracts the head item from the local
+		 * queue.
+		 *
+		 * \attention
+		 * This method must only be called if the local queue isn't empty
+		 * and its lock is acquired.
+		 */
+		[[nodiscard]]
+		static T *
+		pop_head( local_queue_t & local_queue ) noexcept
+			{
+				auto r = local_queue.m_head;
+				local_queue.m_head = r->intrusive_queue_giveout_next();
+				if( !local_queue.m_head )
+					local_queue.m_tail = nullptr;
+				local_queue.m_size.store(
+						local_queue.m_size.load( std::memory_order_relaxed ) - 1u,
+						std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		/*!
+		 * \brief Helper method that pushes a new item to the end of the local
+		 * queue.
+		 *
+		 * \attention
+		 * This method must only be called if the lock of the local queue
+		 * is acquired.
+		 */
+		static void
+		push_to_tail( local_queue_t & local_queue, T * new_tail ) noexcept
+			{
+				if( local_queue.m_tail )
+					{
+						local_queue.m_tail->intrusive_queue_set_next( new_tail );
+						local_queue.m_tail = new_tail;
+					}
+				else
+					{
+						local_queue.m_head = local_queue.m_tail = new_tail;
+					}
+				local_queue.m_size.store(
+						local_queue.m_size.load( std::memory_order_relaxed ) + 1u,
+						std::memory_order_seq_cst );
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
@@ -0,0 +1,465 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+	\file
+	\brief Lock-free MPSC queue of demands for working threads.
+
+	\since v.5.8.4
+*/
+
+#pragma once
+
+#include <so_5/execution_demand.hpp>
+
+#include <so_5/details/at_scope_exit.hpp>
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+namespace work_thread
+{
+
+namespace lock_free_queue_details
+{
+
+//
+// node_t
+//
+/*!
+ * \brief A node of lock-free demand queue.
+ *
+ * \since v.5.8.4
+ */
+struct node_t
+{
+	//! The next node in the queue.
+	std::atomic< node_t * > m_next{ nullptr };
+
+	//! Index of the next free node in the node pool.
+	/*!
+	 * Value 0 means that there is no next free node.
+	 *
+	 * \note
+	 * It's an atomic because it can be read by a producer
+	 * that loses the race for that node.
+	 */
+	std::atomic< std::uint32_t > m_next_free{ 0u };
+
+	//! Demand itself.
+	execution_demand_t m_demand;
+
+	node_t() = default;
+
+	node_t( execution_demand_t && demand ) noexcept
+		:	m_demand( std::move(demand) )
+	{}
+};
+
+//
+// node_pool_t
+//
+/*!
+ * \brief A pool of preallocated nodes for lock-free demand queue.
+ *
+ * Free nodes are kept in a lock-free stack. The top of the stack is
+ * stored as a pair of 32-bit values: a modification tag (to avoid ABA
+ * problem) and an index of the node (with offset 1, value 0 means empty
+ * stack).
+ *
+ * Nodes are taken by many producers and returned by a single consumer.
+ *
+ * \since v.5.8.4
+ */
+class node_pool_t
+{
+	static constexpr std::uint64_t index_mask = 0xffffffffu;
+
+public :
+	node_pool_t( const node_pool_t & ) = delete;
+	node_pool_t & operator=( const node_pool_t & ) = delete;
+
+	node_pool_t( std::size_t capacity )
+		:	m_capacity{ capacity < index_mask ? capacity : index_mask - 1u }
+		,	m_nodes{ m_capacity ? new node_t[ m_capacity ] : nullptr }
+	{
+		for( std::size_t i = 0u; i != m_capacity; ++i )
+			m_nodes[ i ].m_next_free.store(
+					static_cast< std::uint32_t >( i + 1u < m_capacity ? i + 2u : 0u ),
+					std::memory_order_relaxed );
+
+		m_free_top.store( m_capacity ? 1u : 0u, std::memory_order_release );
+	}
+
+	//! Try to get a free node from the pool.
+	/*!
+	 * \return nullptr if the pool is exhausted.
+	 */
+	[[nodiscard]]
+	node_t *
+	try_allocate() noexcept
+	{
+		auto top = m_free_top.load( std::memory_order_acquire );
+		for(;;)
+		{
+			const auto index = top & index_mask;
+			if( !index )
+				return nullptr;
+
+			node_t * node = &m_nodes[ index - 1u ];
+			const std::uint64_t new_top = next_tag( top ) |
+					node->m_next_free.load( std::memory_order_relaxed );
+
+			if( m_free_top.compare_exchange_weak( top, new_top,
+					std::memory_order_acq_rel,
+					std::memory_order_acquire ) )
+				return node;
+		}
+	}
+
+	//! Does the node belong to the pool?
+	[[nodiscard]]
+	bool
+	owns( const node_t * node ) const noexcept
+	{
+		return node >= m_nodes.get() && node < m_nodes.get() + m_capacity;
+	}
+
+	//! Return a node to the pool.
+	/*!
+	 * \attention
+	 * The node must belong to the pool.
+	 */
+	void
+	deallocate( node_t * node ) noexcept
+	{
+		const auto index = static_cast< std::uint64_t >(
+				node - m_nodes.get() ) + 1u;
+
+		auto top = m_free_top.load( std::memory_order_relaxed );
+		for(;;)
+		{
+			node->m_next_free.store(
+					static_cast< std::uint32_t >( top & index_mask ),
+					std::memory_order_relaxed );
+
+			if( m_free_top.compare_exchange_weak( top, next_tag( top ) | index,
+					std::memory_order_release,
+					std::memory_order_relaxed ) )
+				break;
+		}
+	}
+
+private :
+	//! Count of preallocated nodes.
+	const std::size_t m_capacity;
+
+	//! Preallocated nodes.
+	const std::unique_ptr< node_t[] > m_nodes;
+
+	//! The top of the stack of free nodes.
+	std::atomic< std::uint64_t > m_free_top{ 0u };
+
+	[[nodiscard]]
+	static std::uint64_t
+	next_tag( std::uint64_t top ) noexcept
+	{
+		return ( ( top >> 32u ) + 1u ) << 32u;
+	}
+};
+
+} /* namespace lock_free_queue_details */
+
+//
+// lock_free_demand_queue_t
+//
+/*!
+ * \brief Lock-free MPSC queue of demands.
+ *
+ * It's an implementation of intrusive MPSC queue proposed by
+ * Dmitry Vyukov. Producers never block: a push is just one atomic exchange
+ * (plus taking a node from the node pool). The single consumer extracts
+ * demands without any locking.
+ *
+ * This class doesn't handle waiting of the consumer on the empty queue.
+ * It's a task of the owner of the queue.
+ *
+ * \since v.5.8.4
+ */
+class lock_free_demand_queue_t
+{
+	using node_t = lock_free_queue_details::node_t;
+
+public :
+	lock_free_demand_queue_t( const lock_free_demand_queue_t & ) = delete;
+	lock_free_demand_queue_t & operator=( const lock_free_demand_queue_t & ) = delete;
+
+	lock_free_demand_queue_t(
+		//! Count of preallocated nodes.
+		std::size_t node_pool_size )
+		:	m_pool{ node_pool_size }
+	{}
+
+	~lock_free_demand_queue_t()
+	{
+		clear();
+	}
+
+	//! Push a new demand to the queue.
+	/*!
+	 * \note
+	 * Can throw only if the node pool is exhausted and
+	 * a new node can't be allocated.
+	 */
+	void
+	push( execution_demand_t demand )
+	{
+		node_t * node = m_pool.try_allocate();
+		if( node )
+			node->m_demand = std::move(demand);
+		else
+			node = new node_t{ std::move(demand) };
+
+		m_size.fetch_add( 1u, std::memory_order_seq_cst );
+
+		push_node( node );
+	}
+
+	//! Push several demands to the queue.
+	/*!
+	 * Nodes for all demands are linked into a chain and the whole chain
+	 * is added to the queue by just one atomic exchange.
+	 *
+	 * \note
+	 * Can throw only if the node pool is exhausted and
+	 * a new node can't be allocated. Nothing is pushed in that case
+	 * and all demands are kept intact.
+	 *
+	 * \since v.5.8.4
+	 */
+	void
+	push_batch(
+		execution_demand_t * demands,
+		std::size_t demands_count )
+	{
+		if( !demands_count )
+			return;
+
+		node_t * first = nullptr;
+		node_t * last = nullptr;
+
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				for( std::size_t i = 0u; i != demands_count; ++i )
+				{
+					node_t * node = m_pool.try_allocate();
+					if( !node )
+						node = new node_t{};
+
+					node->m_next.store( nullptr, std::memory_order_relaxed );
+					if( last )
+						last->m_next.store( node, std::memory_order_relaxed );
+					else
+						first = node;
+					last = node;
+				}
+			},
+			[&] {
+				while( first )
+				{
+					node_t * next = first->m_next.load( std::memory_order_relaxed );
+					release_node( first );
+					first = next;
+				}
+			} );
+
+		for( node_t * node = first; node;
+				node = node->m_next.load( std::memory_order_relaxed ) )
+			node->m_demand = std::move( *(demands++) );
+
+		m_size.fetch_add( demands_count, std::memory_order_seq_cst );
+
+		node_t * prev = m_head.exchange( last, std::memory_order_acq_rel );
+		prev->m_next.store( first, std::memory_order_release );
+	}
+
+	//! Move all available demands to the \a receiver.
+	/*!
+	 * \attention
+	 * Must be called only by the consumer.
+	 *
+	 * \note
+	 * If receiver.push_back() throws then the demand that is being
+	 * moved is lost. But the queue remains consistent: its node is
+	 * released and the count of demands is decremented.
+	 *
+	 * \return count of extracted demands.
+	 */
+	template< typename Container >
+	std::size_t
+	extract_to( Container & receiver )
+	{
+		std::size_t extracted = 0u;
+		// The count of demands has to be decremented even if
+		// push_back() throws.
+		auto size_decrementer = so_5::details::at_scope_exit( [&] {
+				if( extracted )
+					m_size.fetch_sub( extracted, std::memory_order_release );
+			} );
+
+		while( node_t * node = try_pop_node() )
+		{
+			// The node is released before push_back() because
+			// push_back() can throw.
+			execution_demand_t demand{ std::move(node->m_demand) };
+			release_node( node );
+			++extracted;
+
+			receiver.push_back( std::move(demand) );
+		}
+
+		return extracted;
+	}
+
+	//! Destroy all demands in the queue.
+	/*!
+	 * \attention
+	 * Must be called only by the consumer or when there is no consumer.
+	 */
+	void
+	clear() noexcept
+	{
+		std::size_t extracted = 0u;
+		for(;;)
+		{
+			node_t * node = try_pop_node();
+			if( !node )
+			{
+				// Some producer can be in the middle of push().
+				// Have to wait for the completion of push() in that case.
+				if( extracted == m_size.load( std::memory_order_acquire ) )
+					break;
+
+				std::this_thread::yield();
+				continue;
+			}
+
+			node->m_demand = execution_demand_t{};
+			release_node( node );
+			++extracted;
+		}
+
+		m_size.fetch_sub( extracted, std::memory_order_release );
+	}
+
+	//! Get the count of demands in the queue.
+	[[nodiscard]]
+	std::size_t
+	size() const noexcept
+	{
+		return m_size.load( std::memory_order_seq_cst );
+	}
+
+private :
+	//! Pool of preallocated nodes.
+	lock_free_queue_details::node_pool_t m_pool;
+
+	//! A stub node.
+	node_t m_stub;
+
+	//! The head of the queue (the last pushed node).
+	std::atomic< node_t * > m_head{ &m_stub };
+
+	//! The tail of the queue (the next node to be extracted).
+	/*!
+	 * \note
+	 * Is used only by the consumer.
+	 */
+	node_t * m_tail{ &m_stub };
+
+	//! The count of demands in the queue.
+	/*!
+	 * \note
+	 * Is incremented before the new node is linked into the queue.
+	 * So if it is greater than zero then there is at least one demand
+	 * in the queue or a demand will be available soon.
+	 */
+	std::atomic< std::size_t > m_size{ 0u };
+
+	void
+	push_node( node_t * node ) noexcept
+	{
+		node->m_next.store( nullptr, std::memory_order_relaxed );
+		node_t * prev = m_head.exchange( node, std::memory_order_acq_rel );
+		prev->m_next.store( node, std::memory_order_release );
+	}
+
+	[[nodiscard]]
+	node_t *
+	try_pop_node() noexcept
+	{
+		node_t * tail = m_tail;
+		node_t * next = tail->m_next.load( std::memory_order_acquire );
+		if( &m_stub == tail )
+		{
+			if( !next )
+				return nullptr;
+
+			m_tail = next;
+			tail = next;
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		if( tail != m_head.load( std::memory_order_acquire ) )
+			// Some producer is in the middle of push().
+			return nullptr;
+
+		push_node( &m_stub );
+
+		next = tail->m_next.load( std::memory_order_acquire );
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		return nullptr;
+	}
+
+	void
+	release_node( node_t * node ) noexcept
+	{
+		if( m_pool.owns( node ) )
+			m_pool.deallocate( node );
+		else
+			delete node;
+	}
+};
+
+} /* namespace work_thread */
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
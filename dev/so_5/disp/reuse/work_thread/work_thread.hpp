@@ -24,6 +24,8 @@
 
 #include <so_5/disp/mpsc_queue_traits/pub.hpp>
 
+#include <so_5/disp/reuse/work_thread/lock_free_demand_queue.hpp>
+
 #include <so_5/stats/work_thread_activity.hpp>
 #include <so_5/stats/impl/activity_tracking.hpp>
 
@@ -86,19 +88,47 @@ struct common_data_t
 	queue_traits::lock_unique_ptr_t m_lock;
 	//! \}
 
+	/*!
+	 * \brief Lock-free demand queue.
+	 *
+	 * It's created only if the lock object requires lock-free
+	 * demand queue. m_demands isn't used in that case and m_lock is
+	 * used only for waiting of the consumer on the empty queue.
+	 *
+	 * \since v.5.8.4
+	 */
+	std::unique_ptr< lock_free_demand_queue_t > m_lock_free_demands;
+
+	/*!
+	 * \brief Is the consumer waiting on the empty lock-free queue?
+	 *
+	 * Is used only with lock-free demand queue.
+	 *
+	 * \since v.5.8.4
+	 */
+	std::atomic< bool > m_consumer_sleeping{ false };
+
 	//! Service flag.
 	/*!
 		true -- shall do the service, methods push/pop must work.
 		false -- the service is stopped or will be stopped.
+
+		\note
+		It's an atomic since v.5.8.4 because it's read without
+		locking if lock-free demand queue is used.
 	*/
-	bool m_in_service{ false };
+	std::atomic< bool > m_in_service{ false };
 
 	//! Initializing constructor.
 	common_data_t(
 		//! Lock object to be used by queue.
 		queue_traits::lock_unique_ptr_t lock )
 		:	m_lock( std::move(lock) )
-	{}
+	{
+		if( const auto pool_size = m_lock->lock_free_queue_node_pool_size() )
+			m_lock_free_demands = std::make_unique< lock_free_demand_queue_t >(
+					*pool_size );
+	}
 
 	~common_data_t()
 	{
@@ -196,6 +226,12 @@ public:
 	virtual void
 	push( execution_demand_t demand ) override
 	{
+		if( this->m_lock_free_demands )
+		{
+			push_lock_free( std::move(demand) );
+			return;
+		}
+
 		queue_traits::lock_guard_t guard{ *(this->m_lock) };
 
 		if( this->m_in_service )
@@ -213,6 +249,58 @@ public:
 		}
 	}
 
+	/*!
+	 * \brief Push several demands under one lock.
+	 *
+	 * The consumer is notified only once (if it's necessary).
+	 *
+	 * \note
+	 * If push_back throws then all demands already added by this call
+	 * are returned to the caller and nothing is pushed.
+	 *
+	 * \since v.5.8.4
+	 */
+	void
+	push_batch(
+		execution_demand_t * demands,
+		std::size_t demands_count ) override
+	{
+		if( !demands_count )
+			return;
+
+		if( this->m_lock_free_demands )
+		{
+			push_batch_lock_free( demands, demands_count );
+			return;
+		}
+
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service )
+		{
+			const bool demands_empty_before_service = this->m_demands.empty();
+
+			std::size_t pushed = 0u;
+			so_5::details::do_with_rollback_on_exception(
+				[&] {
+					for(; pushed != demands_count; ++pushed )
+						this->m_demands.push_back( std::move( demands[ pushed ] ) );
+				},
+				[&] {
+					// Demands have to be returned to the caller.
+					while( pushed )
+					{
+						--pushed;
+						demands[ pushed ] = std::move( this->m_demands.back() );
+						this->m_demands.pop_back();
+					}
+				} );
+
+			if( demands_empty_before_service )
+				guard.notify_one();
+		}
+	}
+
 	/*!
 	 * \note
 	 * Delegates the work to the push() method.
@@ -258,6 +346,9 @@ public:
 		/*! External demands counter to be updated. */
 		demands_counter_t & external_counter )
 	{
+		if( this->m_lock_free_demands )
+			return pop_lock_free( demands, external_counter );
+
 		queue_traits::unique_lock_t lock{ *(this->m_lock) };
 		while( true )
 		{
@@ -307,7 +398,7 @@ public:
 		this->m_in_service = false;
 		// If the demands queue is empty then someone is waiting
 		// for new demands inside pop().
-		if( this->m_demands.empty() )
+		if( this->m_lock_free_demands || this->m_demands.empty() )
 			lock.notify_one();
 	}
 
@@ -315,6 +406,12 @@ public:
 	void
 	clear()
 	{
+		if( this->m_lock_free_demands )
+		{
+			this->m_lock_free_demands->clear();
+			return;
+		}
+
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		this->m_demands.clear();
@@ -332,11 +429,115 @@ public:
 	std::size_t
 	demands_count( const demands_counter_t & external_counter )
 	{
+		if( this->m_lock_free_demands )
+			return this->m_lock_free_demands->size()
+					+ external_counter.load( std::memory_order_acquire );
+
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		return this->m_demands.size()
 				+ external_counter.load( std::memory_order_acquire );
 	}
+
+private :
+	/*!
+	 * \brief Implementation of push() for lock-free demand queue.
+	 *
+	 * The lock is acquired only if the consumer is sleeping.
+	 *
+	 * \since v.5.8.4
+	 */
+	void
+	push_lock_free( execution_demand_t demand )
+	{
+		if( !this->m_in_service.load( std::memory_order_acquire ) )
+			return;
+
+		this->m_lock_free_demands->push( std::move(demand) );
+
+		// Paired with seq_cst store to m_consumer_sleeping in
+		// pop_lock_free(). Either we'll see the sleeping consumer or
+		// the consumer will see our new demand.
+		//
+		// The flag is reset here, so only one producer notifies
+		// the sleeping consumer. It's important for combined_lock
+		// because it doesn't allow repeated notifications while
+		// the consumer is being woken up.
+		if( this->m_consumer_sleeping.exchange( false, std::memory_order_seq_cst ) )
+		{
+			queue_traits::lock_guard_t guard{ *(this->m_lock) };
+			guard.notify_one();
+		}
+	}
+
+	/*!
+	 * \brief Implementation of push_batch() for lock-free demand queue.
+	 *
+	 * \since v.5.8.4
+	 */
+	void
+	push_batch_lock_free(
+		execution_demand_t * demands,
+		std::size_t demands_count )
+	{
+		if( !this->m_in_service.load( std::memory_order_acquire ) )
+			return;
+
+		this->m_lock_free_demands->push_batch( demands, demands_count );
+
+		// See the comment in push_lock_free().
+		if( this->m_consumer_sleeping.exchange( false, std::memory_order_seq_cst ) )
+		{
+			queue_traits::lock_guard_t guard{ *(this->m_lock) };
+			guard.notify_one();
+		}
+	}
+
+	/*!
+	 * \brief Implementation of pop() for lock-free demand queue.
+	 *
+	 * All available demands are extracted without locking.
+	 * The lock is acquired only if the queue is empty.
+	 *
+	 * \since v.5.8.4
+	 */
+	extraction_result_t
+	pop_lock_free(
+		/*! Receiver for extracted demands. */
+		demand_container_t & demands,
+		/*! External demands counter to be updated. */
+		demands_counter_t & external_counter )
+	{
+		while( true )
+		{
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return extraction_result_t::shutting_down;
+
+			if( this->m_lock_free_demands->extract_to( demands ) )
+			{
+				external_counter.store( demands.size(), std::memory_order_release );
+				return extraction_result_t::demand_extracted;
+			}
+
+			queue_traits::unique_lock_t lock{ *(this->m_lock) };
+
+			this->m_consumer_sleeping.store( true, std::memory_order_seq_cst );
+
+			// Some demands could be pushed before the producer saw
+			// the m_consumer_sleeping flag.
+			if( this->m_in_service.load( std::memory_order_acquire ) &&
+					!this->m_lock_free_demands->size() )
+			{
+				this->wait_started();
+
+				lock.wait_for_notify();
+
+				this->wait_finished();
+			}
+
+			this->m_consumer_sleeping.store( false, std::memory_order_relaxed );
+		}
+	}
 };
 
 } /* namespace demand_queue_details */
@@ -14,10 +14,16 @@
 
 #include <so_5/disp/reuse/queue_of_queues.hpp>
 
+#include <so_5/disp/thread_pool/impl/demand_pool.hpp>
+
 #include <so_5/event_queue.hpp>
 #include <so_5/outliving.hpp>
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <algorithm>
+
 namespace so_5
 {
 
@@ -40,36 +46,61 @@ class basic_event_queue_t
 	{
 	protected :
 		//! Actual demand in event queue.
-		struct demand_t : public execution_demand_t
-			{
-				//! Next item in queue.
-				/*!
-				 * \note
-				 * It's a dynamically allocated object that has to be deallocated
-				 * manually during the destruction of the queue.
-				 */
-				demand_t * m_next;
-
-				demand_t()
-					:	m_next( nullptr )
-					{}
-				demand_t( execution_demand_t && original )
-					:	execution_demand_t( std::move( original ) )
-					,	m_next( nullptr )
-					{}
-			};
+		/*!
+		 * \note
+		 * It's an alias for so_5::disp::thread_pool::impl::demand_t
+		 * since v.5.8.4.
+		 */
+		using demand_t = so_5::disp::thread_pool::impl::demand_t;
 
 	public :
 		basic_event_queue_t(
+			//! Pool of demand objects.
+			//! Since v.5.8.4.
+			outliving_reference_t< demand_pool_t > demand_pool,
+			std::size_t max_demands_at_once )
+			:	m_demand_pool( demand_pool.get() )
+			,	m_min_demands_at_once( max_demands_at_once )
+			,	m_max_demands_at_once( max_demands_at_once )
+			,	m_demands_at_once( max_demands_at_once )
+			,	m_tail_demand( &m_head_demand )
+			{}
+
+		/*!
+		 * \brief Constructor for the adaptive count of demands to be
+		 * processed at once.
+		 *
+		 * The count starts from \a min_demands_at_once and is changed
+		 * between \a min_demands_at_once and \a max_demands_at_once
+		 * depending on the load of the dispatcher queue (see
+		 * query_disp_queue_load()).
+		 *
+		 * \note
+		 * If \a max_demands_at_once isn't greater than \a min_demands_at_once
+		 * then the count is fixed.
+		 *
+		 * \since v.5.8.4
+		 */
+		basic_event_queue_t(
+			//! Pool of demand objects.
+			outliving_reference_t< demand_pool_t > demand_pool,
+			//! The lower bound for the count of demands.
+			std::size_t min_demands_at_once,
+			//! The upper bound for the count of demands.
 			std::size_t max_demands_at_once )
-			:	m_max_demands_at_once( max_demands_at_once )
+			:	m_demand_pool( demand_pool.get() )
+			,	m_min_demands_at_once( std::max< std::size_t >(
+					min_demands_at_once, 1u ) )
+			,	m_max_demands_at_once( std::max(
+					m_min_demands_at_once, max_demands_at_once ) )
+			,	m_demands_at_once( m_min_demands_at_once )
 			,	m_tail_demand( &m_head_demand )
 			{}
 
 		~basic_event_queue_t() override
 			{
 				while( m_head_demand.m_next )
-					remove_head();
+					m_demand_pool.deallocate( remove_head() );
 			}
 
 		/*!
@@ -107,10 +138,75 @@ class basic_event_queue_t
 		void
 		push( execution_demand_t demand ) override
 			{
-				std::unique_ptr< demand_t > tail_demand{
-						new demand_t( std::move( demand ) ) };
+				push_preallocated( m_demand_pool.allocate( std::move( demand ) ) );
+			}
 
-				push_preallocated( std::move(tail_demand) );
+		//! Push several demands to queue.
+		/*!
+		 * Demand objects are taken from the pool before locking of
+		 * the queue. Then all of them are added to the queue under
+		 * one lock and the queue is scheduled at most once.
+		 *
+		 * \note
+		 * If the allocation of a demand object throws then nothing
+		 * is pushed and all demands are kept intact.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t demands_count ) override
+			{
+				if( !demands_count )
+					return;
+
+				demand_t * first = nullptr;
+				demand_t * last = nullptr;
+
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for( std::size_t i = 0u; i != demands_count; ++i )
+							{
+								demand_t * d = m_demand_pool.allocate(
+										std::move( demands[ i ] ) ).release();
+								if( last )
+									last->m_next = d;
+								else
+									first = d;
+								last = d;
+							}
+					},
+					[&] {
+						// Demands have to be returned to the caller.
+						for( auto * d = demands; first; ++d )
+							{
+								std::unique_ptr< demand_t > current{ first };
+								first = first->m_next;
+
+								*d = std::move( static_cast< execution_demand_t & >(
+										*current ) );
+								m_demand_pool.deallocate( std::move(current) );
+							}
+					} );
+
+				const bool was_empty = [&]() noexcept {
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool queue_was_empty = (nullptr == m_head_demand.m_next);
+
+					m_tail_demand->m_next = first;
+					m_tail_demand = last;
+
+					m_size += demands_count;
+
+					return queue_was_empty;
+				}();
+
+				// Scheduling of the queue must be done when queue lock
+				// is unlocked.
+				if( was_empty )
+					this->schedule_on_disp_queue();
 			}
 
 		//! Push evt_start demand to the queue.
@@ -156,6 +252,26 @@ class basic_event_queue_t
 				not_empty
 			};
 
+		/*!
+		 * \brief Load of the dispatcher queue.
+		 *
+		 * It's used for the adaptive count of demands to be processed
+		 * at once.
+		 *
+		 * \since v.5.8.4
+		 */
+		enum class disp_queue_load_t
+			{
+				//! There are no other event queues waiting for a worker.
+				//! The count of demands at once can be increased.
+				low,
+				//! The count of demands at once should be kept.
+				normal,
+				//! There are many event queues waiting for a worker.
+				//! The count of demands at once should be decreased.
+				high
+			};
+
 		/*!
 		 * \brief Indication of possibility of continuation of demands processing.
 		 *
@@ -184,8 +300,13 @@ class basic_event_queue_t
 		//! Remove the front demand.
 		/*!
 		 * \note Return processing_continuation_t::disabled if
-		 * \a demands_processed exceeds m_max_demands_at_once or if
+		 * \a demands_processed exceeds m_demands_at_once or if
 		 * event queue is empty.
+		 *
+		 * \note
+		 * Since v.5.8.4 the count of demands to be processed at once
+		 * is adjusted here if the adaptive mode is used and the
+		 * processing is stopped because of that count.
 		 */
 		pop_result_t
 		pop(
@@ -195,21 +316,32 @@ class basic_event_queue_t
 				// Actual deletion of old head must be performed
 				// when m_lock will be released.
 				std::unique_ptr< demand_t > old_head;
-				{
+				const auto emptyness = [&]() noexcept {
 					std::lock_guard< spinlock_t > lock( m_lock );
 
 					old_head = remove_head();
 
-					const auto emptyness = m_head_demand.m_next ?
+					const auto r = m_head_demand.m_next ?
 							emptyness_t::not_empty : emptyness_t::empty;
 
-					if( emptyness_t::empty == emptyness )
+					if( emptyness_t::empty == r )
 						m_tail_demand = &m_head_demand;
 
-					return pop_result_t{
-							detect_continuation( emptyness, demands_processed ),
-							emptyness };
-				}
+					return r;
+				}();
+
+				// Since v.5.8.4 the old head is returned to the pool.
+				m_demand_pool.deallocate( std::move(old_head) );
+
+				const auto continuation =
+						detect_continuation( emptyness, demands_processed );
+
+				if( processing_continuation_t::disabled == continuation &&
+						emptyness_t::not_empty == emptyness &&
+						is_adaptive() )
+					adjust_demands_at_once();
+
+				return pop_result_t{ continuation, emptyness };
 			}
 
 		/*!
@@ -251,6 +383,22 @@ class basic_event_queue_t
 				return m_size.load( std::memory_order_acquire );
 			}
 
+		/*!
+		 * \brief Get the current count of demands to be processed at once
+		 * for the adaptive mode.
+		 *
+		 * \return 0 if the adaptive mode isn't used.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		adaptive_demands_at_once() const noexcept
+			{
+				return is_adaptive() ?
+						m_demands_at_once.load( std::memory_order_relaxed ) : 0u;
+			}
+
 	protected:
 		/*!
 		 * \brief Perform scheduling of processing of this event queue
@@ -262,10 +410,58 @@ class basic_event_queue_t
 		virtual void
 		schedule_on_disp_queue() noexcept = 0;
 
+		/*!
+		 * \brief Get the current load of the dispatcher queue.
+		 *
+		 * This method is called only in the adaptive mode when the processing
+		 * of the queue is stopped because of the count of demands to be
+		 * processed at once. It should be overrided in a derived class
+		 * if the adaptive mode is used.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		virtual disp_queue_load_t
+		query_disp_queue_load() const noexcept
+			{
+				return disp_queue_load_t::normal;
+			}
+
 	private :
+		/*!
+		 * \brief Pool of demand objects.
+		 *
+		 * \since v.5.8.4
+		 */
+		demand_pool_t & m_demand_pool;
+
+		/*!
+		 * \brief The lower bound for the count of demands to be
+		 * processed consequently.
+		 *
+		 * \since v.5.8.4
+		 */
+		const std::size_t m_min_demands_at_once;
+
 		//! Maximum count of demands to be processed consequently.
+		/*!
+		 * \note
+		 * Since v.5.8.4 it's the upper bound for the adaptive mode.
+		 * The adaptive mode is used only if it's greater than
+		 * m_min_demands_at_once.
+		 */
 		const std::size_t m_max_demands_at_once;
 
+		/*!
+		 * \brief The current count of demands to be processed consequently.
+		 *
+		 * It's changed only by a worker thread that handles the queue.
+		 * It's atomic because it's also read for run-time monitoring.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::atomic< std::size_t > m_demands_at_once;
+
 		//! Object's lock.
 		spinlock_t m_lock;
 
@@ -307,10 +503,59 @@ class basic_event_queue_t
 			const std::size_t processed )
 			{
 				return emptyness_t::not_empty == emptyness &&
-						processed < m_max_demands_at_once ?
+						processed < m_demands_at_once.load(
+								std::memory_order_relaxed ) ?
 						processing_continuation_t::enabled :
 						processing_continuation_t::disabled;
 			}
+
+		/*!
+		 * \brief Is the adaptive count of demands to be processed at once
+		 * used?
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		bool
+		is_adaptive() const noexcept
+			{
+				return m_min_demands_at_once < m_max_demands_at_once;
+			}
+
+		/*!
+		 * \brief Change the count of demands to be processed at once
+		 * according to the load of the dispatcher queue.
+		 *
+		 * The count is doubled if there are no other event queues waiting
+		 * for a worker and is halved if there are many of them.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		adjust_demands_at_once() noexcept
+			{
+				const auto current =
+						m_demands_at_once.load( std::memory_order_relaxed );
+				switch( query_disp_queue_load() )
+					{
+					case disp_queue_load_t::low :
+						if( current < m_max_demands_at_once )
+							m_demands_at_once.store(
+									std::min( current * 2u, m_max_demands_at_once ),
+									std::memory_order_relaxed );
+					break;
+
+					case disp_queue_load_t::normal :
+					break;
+
+					case disp_queue_load_t::high :
+						if( current > m_min_demands_at_once )
+							m_demands_at_once.store(
+									std::max( current / 2u, m_min_demands_at_once ),
+									std::memory_order_relaxed );
+					break;
+					}
+			}
 	};
 
 } /* namespace impl */
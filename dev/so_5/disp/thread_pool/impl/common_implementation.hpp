@@ -14,11 +14,19 @@
 #include <so_5/event_queue.hpp>
 
 #include <so_5/disp/reuse/actual_work_thread_factory_to_use.hpp>
+#include <so_5/disp/reuse/numa_params.hpp>
 #include <so_5/disp/reuse/queue_of_queues.hpp>
 #include <so_5/disp/reuse/thread_pool_stats.hpp>
 
+#include <so_5/disp/thread_pool/impl/demand_pool.hpp>
+
 #include <so_5/details/rollback_on_exception.hpp>
 
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
+#include <algorithm>
+
 #include <mutex>
 
 namespace so_5 {
@@ -52,6 +60,19 @@ namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
  * needs of the dispatcher. See so_5::disp::thread_pool::impl::adaptation_t
  * or so_5::disp::adv_thread_pool::impl::adaptation_t as examples.
  *
+ * \note
+ * Since v.5.8.4 the dispatcher can be NUMA-aware. In that case
+ * worker threads are distributed between NUMA nodes and every agent
+ * queue belongs to some NUMA node. Dispatcher_Queue has to accept
+ * the count of NUMA nodes in its constructor and Adaptations has to
+ * provide static method numa_node() for Bind_Params.
+ *
+ * \note
+ * Since v.5.8.4 Adaptations has to provide static method
+ * adaptive_demands_at_once() for an agent queue. It returns the current
+ * count of demands to be processed at once for run-time monitoring
+ * (or 0 if the adaptive mode isn't used).
+ *
  * \since v.5.5.4
  */
 template<
@@ -112,6 +133,8 @@ class dispatcher_t final
 					{
 						m_queue_desc->m_desc.m_agent_count = m_agents;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_demands_at_once =
+								Adaptations::adaptive_demands_at_once( *m_queue );
 					}
 			};
 
@@ -184,6 +207,8 @@ class dispatcher_t final
 					{
 						m_queue_desc->m_desc.m_agent_count = 1;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_demands_at_once =
+								Adaptations::adaptive_demands_at_once( *m_queue );
 					}
 			};
 
@@ -204,24 +229,54 @@ class dispatcher_t final
 			std::size_t thread_count,
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params )
 			:	m_queue{ queue_params, thread_count }
+			,	m_demand_pool{ so_5::disp::thread_pool::impl::demand_pool_t::default_capacity() }
 			,	m_thread_count( thread_count )
+			,	m_numa_node_count{ 1u }
 			,	m_data_source( stats_supplier() )
 			{
-				m_threads.reserve( thread_count );
+				make_work_threads( env, disp_params, nullptr );
 
-				for( std::size_t i = 0; i != m_thread_count; ++i )
-				{
-					// Since v.5.7.3 an instance of the actual work thread
-					// has to be acquired via factory.
-					auto work_thread_holder = acquire_work_thread(
-							disp_params, env );
+				m_data_source.get().set_data_sources_name_base(
+						Adaptations::dispatcher_type_name(),
+						name_base,
+						this );
+			}
 
-					m_threads.emplace_back( std::unique_ptr< Work_Thread >(
-								new Work_Thread{
-										outliving_mutable(m_queue),
-										std::move(work_thread_holder)
-								} ) );
+		//! Constructor for NUMA-aware dispatcher.
+		/*!
+		 * If \a numa_topology is empty then the dispatcher works as
+		 * usual dispatcher without NUMA-awareness.
+		 *
+		 * \note
+		 * If \a thread_count is less than the count of NUMA nodes then
+		 * only first \a thread_count nodes are used.
+		 *
+		 * \since v.5.8.4
+		 */
+		template< typename Dispatcher_Params >
+		dispatcher_t(
+			environment_t & env,
+			const so_5::disp::reuse::work_thread_factory_mixin_t< Dispatcher_Params >
+				& disp_params,
+			const std::string_view name_base,
+			std::size_t thread_count,
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			const so_5::disp::numa::topology_t & numa_topology )
+			:	m_queue{
+					queue_params,
+					thread_count,
+					detect_numa_node_count( thread_count, numa_topology )
 				}
+			,	m_demand_pool{ so_5::disp::thread_pool::impl::demand_pool_t::default_capacity() }
+			,	m_thread_count( thread_count )
+			,	m_numa_node_count{
+					detect_numa_node_count( thread_count, numa_topology ) }
+			,	m_data_source( stats_supplier() )
+			{
+				make_work_threads(
+						env,
+						disp_params,
+						numa_topology.empty() ? nullptr : &numa_topology );
 
 				m_data_source.get().set_data_sources_name_base(
 						Adaptations::dispatcher_type_name(),
@@ -327,9 +382,39 @@ class dispatcher_t final
 		//! Queue for active agent's queues.
 		Dispatcher_Queue m_queue;
 
+		/*!
+		 * \brief Pool of demand objects for agent queues.
+		 *
+		 * \attention
+		 * It has to be destroyed after all agent queues.
+		 *
+		 * \since v.5.8.4
+		 */
+		so_5::disp::thread_pool::impl::demand_pool_t m_demand_pool;
+
 		//! Count of working threads.
 		const std::size_t m_thread_count;
 
+		/*!
+		 * \brief Count of NUMA nodes used by the dispatcher.
+		 *
+		 * It's 1 if the dispatcher isn't NUMA-aware.
+		 *
+		 * \since v.5.8.4
+		 */
+		const std::size_t m_numa_node_count;
+
+		/*!
+		 * \brief NUMA node for the next agent queue without explicitly
+		 * specified node.
+		 *
+		 * \note
+		 * Modified only when m_lock is acquired.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::size_t m_next_numa_node{};
+
 		//! Pool of work threads.
 		std::vector< std::unique_ptr< Work_Thread > > m_threads;
 
@@ -355,6 +440,114 @@ class dispatcher_t final
 		stats::manually_registered_source_holder_t< tp_stats::data_source_t >
 				m_data_source;
 
+		/*!
+		 * \brief Detect the count of NUMA nodes to be used.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static std::size_t
+		detect_numa_node_count(
+			std::size_t thread_count,
+			const so_5::disp::numa::topology_t & numa_topology ) noexcept
+			{
+				if( numa_topology.empty() )
+					return 1u;
+
+				return std::max< std::size_t >( 1u,
+						std::min( thread_count, numa_topology.node_count() ) );
+			}
+
+		/*!
+		 * \brief Creation of all work threads.
+		 *
+		 * If \a numa_topology isn't nullptr then work threads are distributed
+		 * between NUMA nodes in round-robin manner. Work threads of every
+		 * node are acquired via the factory from
+		 * so_5::disp::numa::make_node_work_thread_factory().
+		 *
+		 * \since v.5.8.4
+		 */
+		template< typename Dispatcher_Params >
+		void
+		make_work_threads(
+			environment_t & env,
+			const so_5::disp::reuse::work_thread_factory_mixin_t< Dispatcher_Params >
+				& disp_params,
+			const so_5::disp::numa::topology_t * numa_topology )
+			{
+				std::vector< abstract_work_thread_factory_shptr_t > node_factories;
+				if( numa_topology )
+					{
+						// Since v.5.7.3 an instance of the actual work thread
+						// has to be acquired via factory.
+						auto actual_factory = actual_work_thread_factory_to_use(
+								disp_params, env );
+
+						node_factories.reserve( m_numa_node_count );
+						for( std::size_t n = 0; n != m_numa_node_count; ++n )
+							node_factories.push_back(
+									so_5::disp::numa::make_node_work_thread_factory(
+											n,
+											numa_topology->node_cpus( n ),
+											actual_factory ) );
+					}
+
+				m_threads.reserve( m_thread_count );
+
+				for( std::size_t i = 0; i != m_thread_count; ++i )
+				{
+					work_thread_holder_t work_thread_holder;
+					if( node_factories.empty() )
+						// Since v.5.7.3 an instance of the actual work thread
+						// has to be acquired via factory.
+						work_thread_holder = acquire_work_thread(
+								disp_params, env );
+					else
+						{
+							auto & factory = node_factories[ i % m_numa_node_count ];
+							auto & thread = factory->acquire( env );
+							work_thread_holder = work_thread_holder_t{ thread, factory };
+						}
+
+					m_threads.emplace_back( std::unique_ptr< Work_Thread >(
+								new Work_Thread{
+										outliving_mutable(m_queue),
+										std::move(work_thread_holder)
+								} ) );
+				}
+			}
+
+		/*!
+		 * \brief Select NUMA node for a new agent queue.
+		 *
+		 * \throw so_5::exception_t if the node specified in \a params
+		 * isn't used by the dispatcher.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		select_numa_node( const Bind_Params & params )
+			{
+				const auto node = Adaptations::numa_node( params );
+				if( node )
+					{
+						if( *node >= m_numa_node_count )
+							SO_5_THROW_EXCEPTION( rc_invalid_numa_node,
+									"NUMA node " + std::to_string( *node ) +
+									" isn't used by dispatcher, NUMA nodes in use: " +
+									std::to_string( m_numa_node_count ) );
+
+						return *node;
+					}
+
+				const auto result = m_next_numa_node;
+				m_next_numa_node = ( m_next_numa_node + 1u ) % m_numa_node_count;
+
+				return result;
+			}
+
 		//! Creation event queue for an agent with individual FIFO.
 		void
 		bind_agent_with_inidividual_fifo(
@@ -415,7 +608,11 @@ class dispatcher_t final
 			const Bind_Params & params )
 			{
 				return agent_queue_ref_t(
-						new agent_queue_t{ outliving_mutable(m_queue), params } );
+						new agent_queue_t{
+								outliving_mutable(m_queue),
+								outliving_mutable(m_demand_pool),
+								params,
+								select_numa_node( params ) } );
 			}
 
 		/*!
@@ -444,6 +641,11 @@ class dispatcher_t final
 
 				consumer.set_thread_count( m_threads.size() );
 
+				const auto pool_stats = m_demand_pool.query_stats();
+				consumer.set_demand_pool_stats(
+						pool_stats.m_hits,
+						pool_stats.m_misses );
+
 				for( auto & t : m_threads )
 					{
 						using stats_t = so_5::stats::work_thread_activity_stats_t;
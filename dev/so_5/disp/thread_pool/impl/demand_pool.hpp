@@ -0,0 +1,505 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A pool of demand objects for thread-pool-like dispatchers.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/execution_demand.hpp>
+#include <so_5/spinlocks.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace thread_pool
+{
+
+namespace impl
+{
+
+//
+// demand_t
+//
+/*!
+ * \brief Actual demand in event queue.
+ *
+ * \note
+ * This type was a part of basic_event_queue_t before v.5.8.4.
+ */
+struct demand_t : public execution_demand_t
+	{
+		//! Next item in queue.
+		/*!
+		 * \note
+		 * It's a dynamically allocated object that has to be deallocated
+		 * manually during the destruction of the queue.
+		 */
+		demand_t * m_next;
+
+		demand_t()
+			:	m_next( nullptr )
+			{}
+		demand_t( execution_demand_t && original )
+			:	execution_demand_t( std::move( original ) )
+			,	m_next( nullptr )
+			{}
+	};
+
+//
+// demand_pool_stats_t
+//
+/*!
+ * \brief Statistics for a pool of demands.
+ *
+ * \since v.5.8.4
+ */
+struct demand_pool_stats_t
+	{
+		//! Count of allocations satisfied by the pool.
+		std::size_t m_hits{ 0u };
+
+		//! Count of allocations that required a new dynamic allocation.
+		std::size_t m_misses{ 0u };
+	};
+
+//
+// demand_pool_t
+//
+/*!
+ * \brief A pool of demand objects.
+ *
+ * A demand object is taken from the pool when a new demand is pushed to
+ * an agent's event queue and is returned to the pool after extraction of
+ * the demand from the queue. A new demand object is allocated dynamically
+ * only if the pool is empty.
+ *
+ * Every thread that works with the pool has its own cache of free demand
+ * objects. Demand objects are taken from and returned to that cache
+ * without any synchronization. The shared part of the pool (protected by
+ * a spinlock) is used only when the thread's cache is empty or full, and
+ * then a group of demand objects is moved at once.
+ *
+ * The shared part keeps no more than \a capacity free objects. Objects
+ * returned to the full shared part are deallocated.
+ *
+ * The content of a thread's cache is returned to the shared part when
+ * the thread finishes. All free demand objects (including ones in
+ * caches of threads) are deallocated when the pool is destroyed.
+ *
+ * \attention
+ * The pool has to outlive all event queues that use it.
+ *
+ * \since v.5.8.4
+ */
+class demand_pool_t
+	{
+		using spinlock_t = so_5::default_spinlock_t;
+
+		//! Max count of free demand objects in the cache of one thread.
+		static constexpr std::size_t thread_cache_capacity = 64u;
+
+		//! A cache of free demand objects for one thread.
+		struct thread_cache_t
+			{
+				//! Head of the list of free demand objects.
+				demand_t * m_head{ nullptr };
+
+				//! Count of free demand objects in the cache.
+				std::size_t m_count{ 0u };
+
+				//! Count of allocations satisfied by the pool.
+				/*!
+				 * It's modified by the owner thread only, but it's read
+				 * by query_stats(), so it's atomic.
+				 */
+				std::atomic< std::size_t > m_hits{ 0u };
+
+				//! Count of allocations that required a new dynamic allocation.
+				std::atomic< std::size_t > m_misses{ 0u };
+
+				~thread_cache_t()
+					{
+						delete_demands( m_head );
+					}
+
+				void
+				inc_hits() noexcept
+					{
+						m_hits.store(
+								m_hits.load( std::memory_order_relaxed ) + 1u,
+								std::memory_order_relaxed );
+					}
+
+				void
+				inc_misses() noexcept
+					{
+						m_misses.store(
+								m_misses.load( std::memory_order_relaxed ) + 1u,
+								std::memory_order_relaxed );
+					}
+			};
+
+		//! Data of the pool that can be accessed at the end of a thread.
+		/*!
+		 * This object is owned by demand_pool_t via std::shared_ptr and
+		 * threads hold std::weak_ptr to it. So a thread can detect at its
+		 * end whether the pool is still alive.
+		 */
+		struct shared_data_t
+			{
+				//! Max count of free demand objects in the shared part.
+				const std::size_t m_capacity;
+
+				//! Lock for the shared list of free demand objects.
+				spinlock_t m_lock;
+
+				//! Head of the shared list of free demand objects.
+				demand_t * m_free_head{ nullptr };
+
+				//! Count of free demand objects in the shared list.
+				std::size_t m_free_count{ 0u };
+
+				//! Lock for the list of caches.
+				std::mutex m_caches_lock;
+
+				//! Caches of all threads that work with the pool.
+				std::vector< std::unique_ptr< thread_cache_t > > m_caches;
+
+				//! Stats of caches of already finished threads.
+				demand_pool_stats_t m_finished_threads_stats;
+
+				explicit shared_data_t( std::size_t capacity )
+					:	m_capacity{ capacity }
+					{}
+
+				~shared_data_t()
+					{
+						delete_demands( m_free_head );
+					}
+
+				//! Move demand objects from the cache to the shared list.
+				/*!
+				 * No more than \a demands_to_keep objects remain in the cache.
+				 * Objects that don't fit into the shared list are deallocated.
+				 */
+				void
+				flush_cache(
+					thread_cache_t & cache,
+					std::size_t demands_to_keep ) noexcept
+					{
+						demand_t * extra_demands = nullptr;
+						{
+							std::lock_guard< spinlock_t > lock{ m_lock };
+
+							while( cache.m_count > demands_to_keep )
+								{
+									demand_t * d = cache.m_head;
+									cache.m_head = d->m_next;
+									--cache.m_count;
+
+									if( m_free_count < m_capacity )
+										{
+											d->m_next = m_free_head;
+											m_free_head = d;
+											++m_free_count;
+										}
+									else
+										{
+											d->m_next = extra_demands;
+											extra_demands = d;
+										}
+								}
+						}
+
+						delete_demands( extra_demands );
+					}
+
+				//! Move a group of demand objects from the shared list to the cache.
+				void
+				refill_cache( thread_cache_t & cache ) noexcept
+					{
+						std::lock_guard< spinlock_t > lock{ m_lock };
+
+						while( m_free_head && cache.m_count < thread_cache_capacity / 2u )
+							{
+								demand_t * d = m_free_head;
+								m_free_head = d->m_next;
+								--m_free_count;
+
+								d->m_next = cache.m_head;
+								cache.m_head = d;
+								++cache.m_count;
+							}
+					}
+
+				//! Return the cache of a finished thread to the pool.
+				void
+				release_cache( thread_cache_t * cache ) noexcept
+					{
+						std::lock_guard< std::mutex > lock{ m_caches_lock };
+
+						auto it = std::find_if( m_caches.begin(), m_caches.end(),
+								[cache]( const auto & c ) { return c.get() == cache; } );
+						if( it != m_caches.end() )
+							{
+								flush_cache( *cache, 0u );
+
+								m_finished_threads_stats.m_hits +=
+										cache->m_hits.load( std::memory_order_relaxed );
+								m_finished_threads_stats.m_misses +=
+										cache->m_misses.load( std::memory_order_relaxed );
+
+								m_caches.erase( it );
+							}
+					}
+			};
+
+		//! Caches of the current thread for all pools the thread works with.
+		/*!
+		 * Caches are owned by pools. Caches of finished threads are
+		 * returned to the pools (if the pools are still alive).
+		 */
+		class current_thread_caches_t
+			{
+				struct entry_t
+					{
+						//! Unique ID of the pool.
+						std::uint64_t m_pool_id;
+						//! Pointer to the cache (owned by the pool).
+						thread_cache_t * m_cache;
+						//! The pool's data.
+						std::weak_ptr< shared_data_t > m_pool;
+					};
+
+				std::vector< entry_t > m_entries;
+
+			public :
+				current_thread_caches_t() = default;
+				current_thread_caches_t( const current_thread_caches_t & ) = delete;
+				current_thread_caches_t &
+				operator=( const current_thread_caches_t & ) = delete;
+
+				~current_thread_caches_t()
+					{
+						for( auto & e : m_entries )
+							if( auto pool = e.m_pool.lock() )
+								pool->release_cache( e.m_cache );
+					}
+
+				[[nodiscard]]
+				thread_cache_t *
+				find( std::uint64_t pool_id ) const noexcept
+					{
+						for( const auto & e : m_entries )
+							if( pool_id == e.m_pool_id )
+								return e.m_cache;
+
+						return nullptr;
+					}
+
+				[[nodiscard]]
+				thread_cache_t *
+				make(
+					std::uint64_t pool_id,
+					const std::shared_ptr< shared_data_t > & pool )
+					{
+						// Entries of destroyed pools aren't needed anymore.
+						m_entries.erase(
+								std::remove_if( m_entries.begin(), m_entries.end(),
+										[]( const entry_t & e ) { return e.m_pool.expired(); } ),
+								m_entries.end() );
+						m_entries.reserve( m_entries.size() + 1u );
+
+						auto cache = std::make_unique< thread_cache_t >();
+						auto * result = cache.get();
+						{
+							std::lock_guard< std::mutex > lock{ pool->m_caches_lock };
+							pool->m_caches.push_back( std::move(cache) );
+						}
+
+						m_entries.push_back( entry_t{ pool_id, result, pool } );
+
+						return result;
+					}
+			};
+
+	public :
+		demand_pool_t( const demand_pool_t & ) = delete;
+		demand_pool_t & operator=( const demand_pool_t & ) = delete;
+
+		demand_pool_t(
+			//! Max count of free demand objects in the shared part of the pool.
+			std::size_t capacity )
+			:	m_id{ make_pool_id() }
+			,	m_data{ std::make_shared< shared_data_t >( capacity ) }
+			{}
+
+		~demand_pool_t()
+			{
+				// Caches of threads are deallocated right now, even
+				// if m_data is still used by some finishing thread.
+				std::lock_guard< std::mutex > lock{ m_data->m_caches_lock };
+				m_data->m_caches.clear();
+			}
+
+		//! Default max count of free demand objects in the pool.
+		[[nodiscard]]
+		static constexpr std::size_t
+		default_capacity() noexcept
+			{
+				return 4096u;
+			}
+
+		//! Get a demand object for a new demand.
+		[[nodiscard]]
+		std::unique_ptr< demand_t >
+		allocate( execution_demand_t && demand )
+			{
+				thread_cache_t & cache = current_thread_cache();
+
+				if( !cache.m_head )
+					m_data->refill_cache( cache );
+
+				if( demand_t * result = cache.m_head )
+					{
+						cache.m_head = result->m_next;
+						--cache.m_count;
+						cache.inc_hits();
+
+						result->m_next = nullptr;
+						static_cast< execution_demand_t & >( *result ) =
+								std::move(demand);
+						return std::unique_ptr< demand_t >{ result };
+					}
+
+				cache.inc_misses();
+				return std::make_unique< demand_t >( std::move(demand) );
+			}
+
+		//! Return a demand object to the pool.
+		/*!
+		 * The content of the demand is destroyed before the return of
+		 * the demand object to the pool.
+		 */
+		void
+		deallocate( std::unique_ptr< demand_t > demand ) noexcept
+			{
+				// Reference to the message has to be released before
+				// the demand object will be stored in the pool.
+				static_cast< execution_demand_t & >( *demand ) =
+						execution_demand_t{};
+
+				thread_cache_t * cache = nullptr;
+				try
+					{
+						cache = &current_thread_cache();
+					}
+				catch( ... )
+					{
+						// There is no memory for a cache. The demand object
+						// will be deleted automatically.
+						return;
+					}
+
+				if( cache->m_count >= thread_cache_capacity )
+					// A half of the cache goes to the shared part.
+					m_data->flush_cache( *cache, thread_cache_capacity / 2u );
+
+				demand->m_next = cache->m_head;
+				cache->m_head = demand.release();
+				++cache->m_count;
+			}
+
+		//! Get the current stats for the pool.
+		[[nodiscard]]
+		demand_pool_stats_t
+		query_stats() noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_data->m_caches_lock };
+
+				demand_pool_stats_t result = m_data->m_finished_threads_stats;
+				for( const auto & c : m_data->m_caches )
+					{
+						result.m_hits += c->m_hits.load( std::memory_order_relaxed );
+						result.m_misses += c->m_misses.load( std::memory_order_relaxed );
+					}
+
+				return result;
+			}
+
+	private :
+		//! Unique ID of the pool.
+		/*!
+		 * It's used for the search of the thread's cache. The address
+		 * of the pool can't be used for that because it can be reused
+		 * by another pool.
+		 */
+		const std::uint64_t m_id;
+
+		//! The pool's data.
+		const std::shared_ptr< shared_data_t > m_data;
+
+		[[nodiscard]]
+		static std::uint64_t
+		make_pool_id() noexcept
+			{
+				static std::atomic< std::uint64_t > last_id{ 0u };
+				return ++last_id;
+			}
+
+		[[nodiscard]]
+		static current_thread_caches_t &
+		current_thread_caches()
+			{
+				thread_local current_thread_caches_t caches;
+				return caches;
+			}
+
+		[[nodiscard]]
+		thread_cache_t &
+		current_thread_cache()
+			{
+				auto & caches = current_thread_caches();
+
+				thread_cache_t * r = caches.find( m_id );
+				if( !r )
+					r = caches.make( m_id, m_data );
+
+				return *r;
+			}
+
+		static void
+		delete_demands( demand_t * head ) noexcept
+			{
+				while( head )
+					{
+						std::unique_ptr< demand_t > to_be_deleted{ head };
+						head = head->m_next;
+					}
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace thread_pool */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
@@ -57,12 +57,22 @@ class agent_queue_t
 		agent_queue_t(
 			//! Dispatcher queue to work with.
 			outliving_reference_t< dispatcher_queue_t > disp_queue,
+			//! Pool of demand objects.
+			//! Since v.5.8.4.
+			outliving_reference_t< demand_pool_t > demand_pool,
 			//! Parameters for the queue.
-			const bind_params_t & params )
+			const bind_params_t & params,
+			//! NUMA node of the queue.
+			//! Since v.5.8.4.
+			std::size_t numa_node )
 			:	basic_event_queue_t{
-					params.query_max_demands_at_once()
+					demand_pool,
+					params.query_max_demands_at_once(),
+					params.query_adaptive_demands_at_once_limit()
 				}
 			,	m_disp_queue{ disp_queue.get() }
+			,	m_numa_node{ numa_node }
+			,	m_lifo_slot{ params.query_lifo_slot() }
 			{}
 
 		/*!
@@ -102,13 +112,49 @@ class agent_queue_t
 		void
 		schedule_on_disp_queue() noexcept override
 			{
-				m_disp_queue.schedule( this );
+				if( m_lifo_slot )
+					m_disp_queue.schedule_to_lifo_slot( this, m_numa_node );
+				else
+					m_disp_queue.schedule( this, m_numa_node );
+			}
+
+		/*!
+		 * \brief The load is detected by the count of agent queues waiting
+		 * in the dispatcher queue.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		disp_queue_load_t
+		query_disp_queue_load() const noexcept override
+			{
+				const auto waiting = m_disp_queue.approx_size();
+				if( !waiting )
+					return disp_queue_load_t::low;
+				if( waiting >= m_disp_queue.thread_count() )
+					return disp_queue_load_t::high;
+				return disp_queue_load_t::normal;
 			}
 
 	private :
 		//! Dispatcher queue with that the agent queue has to be used.
 		dispatcher_queue_t & m_disp_queue;
 
+		/*!
+		 * \brief NUMA node of that queue.
+		 *
+		 * \since v.5.8.4
+		 */
+		const std::size_t m_numa_node;
+
+		/*!
+		 * \brief Should the queue be scheduled to the LIFO slot of
+		 * the current worker thread?
+		 *
+		 * \since v.5.8.4
+		 */
+		const bool m_lifo_slot;
+
 		/*!
 		 * \brief The next item in intrusive queue of agent_queues.
 		 *
@@ -150,6 +196,26 @@ struct adaptation_t
 			{
 				queue.wait_for_emptyness();
 			}
+
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static std::optional< std::size_t >
+		numa_node( const bind_params_t & params ) noexcept
+			{
+				return params.query_numa_node();
+			}
+
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		static std::size_t
+		adaptive_demands_at_once( const agent_queue_t & queue ) noexcept
+			{
+				return queue.adaptive_demands_at_once();
+			}
 	};
 
 //
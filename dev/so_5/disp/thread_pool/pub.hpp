@@ -19,6 +19,7 @@
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
 #include <so_5/disp/reuse/work_thread_factory_params.hpp>
+#include <so_5/disp/reuse/numa_params.hpp>
 #include <so_5/disp/reuse/default_thread_pool_size.hpp>
 
 #include <string_view>
@@ -52,11 +53,14 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
 	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::numa_topology_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
 		using thread_factory_mixin_t = so_5::disp::reuse::
 				work_thread_factory_mixin_t< disp_params_t >;
+		using numa_topology_mixin_t = so_5::disp::reuse::
+				numa_topology_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -76,6 +80,10 @@ class disp_params_t
 						static_cast< work_thread_factory_mixin_t & >(a),
 						static_cast< work_thread_factory_mixin_t & >(b) );
 
+				swap(
+						static_cast< numa_topology_mixin_t & >(a),
+						static_cast< numa_topology_mixin_t & >(b) );
+
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
 			}
@@ -183,6 +191,7 @@ enum class fifo_t
  * \since v.5.5.11
  */
 class bind_params_t
+	:	public so_5::disp::reuse::numa_node_mixin_t< bind_params_t >
 	{
 	public :
 		//! Set FIFO type.
@@ -210,6 +219,11 @@ class bind_params_t
 			}
 
 		//! Get maximum count of demands to do processed at once.
+		/*!
+		 * \note
+		 * If the adaptive mode is used it's the lower bound for the count
+		 * of demands to be processed at once.
+		 */
 		[[nodiscard]]
 		std::size_t
 		query_max_demands_at_once() const
@@ -217,12 +231,135 @@ class bind_params_t
 				return m_max_demands_at_once;
 			}
 
+		//! Turn the adaptive count of demands to be processed at once on.
+		/*!
+		 * In this mode the count of demands processed at once from an event
+		 * queue starts from \a min_value. It's doubled (up to \a max_value)
+		 * when the limit is reached and there are no other event queues
+		 * waiting for a worker thread. It's halved (down to \a min_value)
+		 * when the limit is reached and the count of waiting event
+		 * queues isn't less than the count of worker threads.
+		 *
+		 * Usage example:
+		 * \code
+		 * auto disp = so_5::disp::thread_pool::make_dispatcher( env, 4u );
+		 * auto coop = env.make_coop( disp.binder(
+		 * 	so_5::disp::thread_pool::bind_params_t{}
+		 * 		.adaptive_demands_at_once( 2u, 64u ) ) );
+		 * \endcode
+		 *
+		 * \note
+		 * It sets \a min_value as max_demands_at_once(). If \a max_value
+		 * isn't greater than \a min_value then the adaptive mode isn't used.
+		 *
+		 * \note
+		 * The current count for every event queue is available via
+		 * run-time monitoring with so_5::stats::suffixes::demands_at_once()
+		 * suffix.
+		 *
+		 * \since v.5.8.4
+		 */
+		bind_params_t &
+		adaptive_demands_at_once(
+			std::size_t min_value,
+			std::size_t max_value )
+			{
+				m_max_demands_at_once = min_value;
+				m_adaptive_demands_at_once_limit = max_value;
+				return *this;
+			}
+
+		//! Get the upper bound for the adaptive count of demands to be
+		//! processed at once.
+		/*!
+		 * The adaptive mode is used only if the returned value is greater
+		 * than query_max_demands_at_once().
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		query_adaptive_demands_at_once_limit() const
+			{
+				return m_adaptive_demands_at_once_limit;
+			}
+
+		//! Turn the usage of LIFO slots of worker threads on or off.
+		/*!
+		 * If the LIFO slot is used and an event queue of an agent becomes
+		 * non-empty because of a message sent from a worker thread of the
+		 * same dispatcher then that queue is handled next on that worker
+		 * thread (instead of going to the end of the common queue of the
+		 * dispatcher and being taken by an arbitrary worker). It reduces
+		 * cache misses for request/response chains of agents bound to
+		 * the same dispatcher.
+		 *
+		 * Usage example:
+		 * \code
+		 * auto disp = so_5::disp::thread_pool::make_dispatcher( env, 4u );
+		 * auto coop = env.make_coop( disp.binder(
+		 * 	so_5::disp::thread_pool::bind_params_t{}
+		 * 		.fifo( so_5::disp::thread_pool::fifo_t::individual )
+		 * 		.lifo_slot( true ) ) );
+		 * \endcode
+		 *
+		 * \note
+		 * The LIFO slot is used only if all worker threads are busy.
+		 * If there are sleeping worker threads the event queue goes to
+		 * the common queue as usual. An event queue from the LIFO slot
+		 * waits until the worker thread finishes the processing of its
+		 * current event queue, but it can be taken by another worker
+		 * thread that becomes idle in the meantime.
+		 *
+		 * \note
+		 * The LIFO slot of a thread can be used only a few times in a row
+		 * (see so_5::disp::reuse::queue_of_queues_t::max_lifo_slot_picks_in_row).
+		 * Then the event queue from the slot goes to the common queue to
+		 * give a chance to other event queues.
+		 *
+		 * \since v.5.8.4
+		 */
+		bind_params_t &
+		lifo_slot( bool v )
+			{
+				m_lifo_slot = v;
+				return *this;
+			}
+
+		//! Is the LIFO slot of worker threads used?
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		bool
+		query_lifo_slot() const
+			{
+				return m_lifo_slot;
+			}
+
 	private :
 		//! FIFO type.
 		fifo_t m_fifo = { fifo_t::cooperation };
 
 		//! Maximum count of demands to be processed at once.
 		std::size_t m_max_demands_at_once = { 4 };
+
+		/*!
+		 * \brief The upper bound for the adaptive count of demands to be
+		 * processed at once.
+		 *
+		 * The value 0 means that the adaptive mode isn't used.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::size_t m_adaptive_demands_at_once_limit = { 0 };
+
+		/*!
+		 * \brief Should the LIFO slot of worker threads be used?
+		 *
+		 * \since v.5.8.4
+		 */
+		bool m_lifo_slot = { false };
 	};
 
 //
@@ -66,6 +66,8 @@ environment_params_t::environment_params_t(
 	,	m_event_queue_hook( std::move(other.m_event_queue_hook) )
 	,	m_work_thread_factory( std::move(other.m_work_thread_factory) )
 	,	m_default_subscription_storage_factory( std::move(other.m_default_subscription_storage_factory) )
+	,	m_local_mbox_subscribers_table( other.m_local_mbox_subscribers_table )
+	,	m_timer_objects_preallocation( other.m_timer_objects_preallocation )
 {}
 
 environment_params_t::~environment_params_t()
@@ -111,6 +113,10 @@ swap( environment_params_t & a, environment_params_t & b ) noexcept
 	swap( a.m_work_thread_factory, b.m_work_thread_factory );
 
 	swap( a.m_default_subscription_storage_factory, b.m_default_subscription_storage_factory );
+
+	swap( a.m_local_mbox_subscribers_table, b.m_local_mbox_subscribers_table );
+
+	swap( a.m_timer_objects_preallocation, b.m_timer_objects_preallocation );
 }
 
 environment_params_t &
@@ -463,7 +469,8 @@ struct environment_t::internals_t
 				params.so5_giveout_message_delivery_tracer() }
 		,	m_mbox_core(
 				new impl::mbox_core_t{
-						outliving_mutable( m_msg_tracing_stuff ) } )
+						outliving_mutable( m_msg_tracing_stuff ),
+						params.local_mbox_subscribers_table() } )
 		,	m_infrastructure(
 				(params.infrastructure_factory())(
 					env,
@@ -526,6 +533,13 @@ environment_t::create_mbox()
 	return m_impl->m_mbox_core->create_mbox( *this );
 }
 
+mbox_t
+environment_t::create_mbox(
+	local_mbox_subscribers_table_t subscribers_table )
+{
+	return m_impl->m_mbox_core->create_mbox( *this, subscribers_table );
+}
+
 mbox_t
 environment_t::create_mbox(
 	nonempty_name_t nonempty_name )
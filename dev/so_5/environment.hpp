@@ -662,6 +662,97 @@ class SO_5_TYPE environment_params_t
 				return m_default_subscription_storage_factory;
 			}
 
+		/*!
+		 * \brief Set the type of subscribers table to be used by
+		 * standard MPMC mboxes by default.
+		 *
+		 * This type is used for mboxes created by environment_t::create_mbox()
+		 * and for named mboxes. A type for a particular anonymous mbox
+		 * can be specified via environment_t::create_mbox(local_mbox_subscribers_table_t).
+		 *
+		 * Usage example:
+		 *
+		 * \code
+		 * so_5::launch( [](so_5::environment_t & env) {...},
+		 * 	[](so_5::environment_params_t & params) {
+		 * 		params.local_mbox_subscribers_table(
+		 * 			so_5::local_mbox_subscribers_table_t::flat_hash_table );
+		 * 	} );
+		 * \endcode
+		 *
+		 * \since v.5.8.4
+		 */
+		environment_params_t &
+		local_mbox_subscribers_table(
+			local_mbox_subscribers_table_t table_type ) noexcept
+			{
+				m_local_mbox_subscribers_table = table_type;
+				return *this;
+			}
+
+		/*!
+		 * \brief Get the type of subscribers table to be used by
+		 * standard MPMC mboxes by default.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		local_mbox_subscribers_table_t
+		local_mbox_subscribers_table() const noexcept
+			{
+				return m_local_mbox_subscribers_table;
+			}
+
+		/*!
+		 * \brief Set the count of timer objects to be preallocated
+		 * by the timer thread.
+		 *
+		 * If this value isn't zero then the timer thread creates a pool
+		 * of timer objects (see timer_thread_t::preallocate_timer_objects()).
+		 * Timer objects from the pool are reused, so send_delayed() and
+		 * send_periodic() don't allocate memory for timer objects while
+		 * the count of active timers doesn't exceed that value. It's also
+		 * true for versions of send_periodic() that return timer_id_t.
+		 *
+		 * Zero value (the default) means that timer objects are allocated
+		 * individually.
+		 *
+		 * Usage example:
+		 *
+		 * \code
+		 * so_5::launch( [](so_5::environment_t & env) {...},
+		 * 	[](so_5::environment_params_t & params) {
+		 * 		params.timer_objects_preallocation( 100000u );
+		 * 	} );
+		 * \endcode
+		 *
+		 * \note
+		 * This value is used by the default multi-threaded environment
+		 * infrastructure only. Single-threaded environment infrastructures
+		 * use timer managers and ignore it.
+		 *
+		 * \since v.5.8.4
+		 */
+		environment_params_t &
+		timer_objects_preallocation( std::size_t count ) noexcept
+			{
+				m_timer_objects_preallocation = count;
+				return *this;
+			}
+
+		/*!
+		 * \brief Get the count of timer objects to be preallocated
+		 * by the timer thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		timer_objects_preallocation() const noexcept
+			{
+				return m_timer_objects_preallocation;
+			}
+
 		/*!
 		 * \name Methods for internal use only.
 		 * \{
@@ -883,6 +974,22 @@ class SO_5_TYPE environment_params_t
 		 * \since v.5.8.2
 		 */
 		subscription_storage_factory_t m_default_subscription_storage_factory;
+
+		/*!
+		 * \brief Type of subscribers table for standard MPMC mboxes.
+		 *
+		 * \since v.5.8.4
+		 */
+		local_mbox_subscribers_table_t m_local_mbox_subscribers_table{
+				local_mbox_subscribers_table_t::std_map };
+
+		/*!
+		 * \brief Count of timer objects to be preallocated by the
+		 * timer thread.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::size_t m_timer_objects_preallocation{ 0u };
 };
 
 //
@@ -1001,6 +1108,26 @@ class SO_5_TYPE environment_t
 		mbox_t
 		create_mbox();
 
+		//! Create an anonymous MPMC mbox with the specified type of
+		//! subscribers table.
+		/*!
+		 * Usage example:
+		 * \code
+		 * // This mbox will be used for a lot of message types.
+		 * auto mbox = env.create_mbox(
+		 * 	so_5::local_mbox_subscribers_table_t::flat_hash_table );
+		 * \endcode
+		 *
+		 *	\note always creates a new mbox.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		mbox_t
+		create_mbox(
+			//! Type of subscribers table for the new mbox.
+			local_mbox_subscribers_table_t subscribers_table );
+
 		//! Create named MPMC mbox.
 		/*!
 		 * If \a mbox_name is unique then a new mbox will be created.
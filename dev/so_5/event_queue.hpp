@@ -47,6 +47,40 @@ class SO_5_TYPE event_queue_t
 		virtual void
 		push( execution_demand_t demand ) = 0;
 
+		/*!
+		 * \brief Enqueue several new events to the queue.
+		 *
+		 * Demands are moved from the range
+		 * [demands, demands + demands_count) to the queue in the order
+		 * of their appearance in the range.
+		 *
+		 * The default implementation calls push() for every demand.
+		 * Event queues of dispatchers override this method to enqueue
+		 * the whole range under one lock and with one wakeup of
+		 * the consumer.
+		 *
+		 * \note
+		 * This method can throw and it's expected. Event queues of
+		 * SObjectizer's dispatchers push nothing in that case and
+		 * keep all demands in the range intact. But the default
+		 * implementation can leave some demands already in the queue.
+		 *
+		 * \attention
+		 * This method mustn't be used for evt_start and evt_finish demands.
+		 *
+		 * \since v.5.8.4
+		 */
+		virtual void
+		push_batch(
+			//! Pointer to the first demand to be enqueued.
+			execution_demand_t * demands,
+			//! Count of demands to be enqueued.
+			std::size_t demands_count )
+			{
+				for( std::size_t i = 0u; i != demands_count; ++i )
+					this->push( std::move(demands[ i ]) );
+			}
+
 		/*!
 		 * \brief Enqueue a demand for evt_start event.
 		 *
@@ -67,6 +67,14 @@ struct execution_demand_t
 	mbox_id_t m_mbox_id;
 	//! Type of the message.
 	std::type_index m_msg_type;
+	//! Dense identifier of the message type.
+	/*!
+	 * It's null_message_type_id() if there is no identifier for
+	 * the message type at the moment of the demand creation.
+	 *
+	 * \since v.5.8.4
+	 */
+	message_type_id_t m_msg_type_id;
 	//! Event incident.
 	message_ref_t m_message_ref;
 	//! Demand handler.
@@ -78,6 +86,7 @@ struct execution_demand_t
 		,	m_limit( nullptr )
 		,	m_mbox_id( 0 )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_message_type_id() )
 		,	m_demand_handler( nullptr )
 		{}
 
@@ -92,6 +101,30 @@ struct execution_demand_t
 		,	m_limit( limit )
 		,	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( find_message_type_id( msg_type ) )
+		,	m_message_ref( std::move( message_ref ) )
+		,	m_demand_handler( demand_handler )
+		{}
+
+	/*!
+	 * \brief Initializing constructor for the case when the identifier
+	 * of the message type is already known.
+	 *
+	 * \since v.5.8.4
+	 */
+	execution_demand_t(
+		agent_t * receiver,
+		const message_limit::control_block_t * limit,
+		mbox_id_t mbox_id,
+		std::type_index msg_type,
+		message_type_id_t msg_type_id,
+		message_ref_t message_ref,
+		demand_handler_pfn_t demand_handler ) noexcept
+		:	m_receiver( receiver )
+		,	m_limit( limit )
+		,	m_mbox_id( mbox_id )
+		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_message_ref( std::move( message_ref ) )
 		,	m_demand_handler( demand_handler )
 		{}
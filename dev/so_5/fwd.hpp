@@ -28,6 +28,9 @@ class internal_agent_iface_t;
 class layer_core_t;
 class state_switch_guard_t;
 class sinks_storage_t;
+class event_handler_cache_t;
+class agent_deadlines_t;
+class deadlines_wakeup_mbox_t;
 
 } /* namespace impl */
 
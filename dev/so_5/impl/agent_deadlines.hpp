@@ -0,0 +1,528 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A storage of agent's deadlines.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/agent.hpp>
+#include <so_5/deadline_id.hpp>
+#include <so_5/mbox.hpp>
+#include <so_5/spinlocks.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// deadlines_wakeup_mbox_t
+//
+/*!
+ * \brief A special mbox for waking up an agent with pending deadlines.
+ *
+ * A deadline is checked by the agent itself between events. But if the
+ * agent has no events it has to be woken up. A single delayed signal is
+ * sent to this mbox for that. The mbox pushes a special demand to the
+ * agent's event queue and that demand handles all expired deadlines.
+ *
+ * The mbox holds a raw pointer to the agent. That pointer is dropped
+ * by detach() before the destruction of the agent. A signal that is
+ * delivered after that is simply ignored.
+ *
+ * \since v.5.8.4
+ */
+class deadlines_wakeup_mbox_t final : public abstract_message_box_t
+	{
+	public :
+		//! A signal to be sent by the timer.
+		struct msg_wakeup final : public signal_t {};
+
+		deadlines_wakeup_mbox_t(
+			environment_t & env,
+			agent_t & agent )
+			:	m_env{ env }
+			,	m_agent{ &agent }
+			{}
+
+		// NOTE: this method should never be used.
+		mbox_id_t
+		id() const override
+			{
+				return 0;
+			}
+
+		void
+		subscribe_event_handler(
+			const std::type_index & /*type_index*/,
+			abstract_message_sink_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION( rc_not_implemented,
+						"call to subscribe_event_handler() is illegal for "
+						"deadlines_wakeup_mbox_t" );
+			}
+
+		void
+		unsubscribe_event_handler(
+			const std::type_index & /*type_index*/,
+			abstract_message_sink_t & /*subscriber*/ ) noexcept override
+			{
+				// Nothing to do.
+			}
+
+		std::string
+		query_name() const override
+			{
+				return "<deadlines_wakeup_mbox>";
+			}
+
+		mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		void
+		do_deliver_message(
+			message_delivery_mode_t /*delivery_mode*/,
+			const std::type_index & /*msg_type*/,
+			const message_ref_t & /*message*/,
+			unsigned int /*redirection_deep*/ ) override
+			{
+				std::lock_guard< default_spinlock_t > lock{ m_lock };
+				if( m_agent )
+					m_agent->push_deadlines_wakeup();
+			}
+
+		void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			abstract_message_sink_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION( rc_not_implemented,
+						"call to set_delivery_filter() is illegal for "
+						"deadlines_wakeup_mbox_t" );
+			}
+
+		void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			abstract_message_sink_t & /*subscriber*/ ) noexcept override
+			{
+				// Nothing to do.
+			}
+
+		environment_t &
+		environment() const noexcept override
+			{
+				return m_env;
+			}
+
+		//! Forget about the agent.
+		/*!
+		 * Must be called before the destruction of the agent.
+		 */
+		void
+		detach() noexcept
+			{
+				std::lock_guard< default_spinlock_t > lock{ m_lock };
+				m_agent = nullptr;
+			}
+
+	private :
+		//! Environment for which that mbox is created.
+		environment_t & m_env;
+
+		//! Lock for the protection of m_agent.
+		default_spinlock_t m_lock;
+
+		//! The agent to be woken up.
+		/*!
+		 * It's nullptr after detach().
+		 */
+		agent_t * m_agent;
+	};
+
+//
+// agent_deadlines_t
+//
+/*!
+ * \brief A storage of agent's deadlines.
+ *
+ * Every deadline occupies a slot. A slot has a generation counter that
+ * is incremented when the slot is released. The pair (slot, generation)
+ * is used as deadline_id_t, so the cancellation of a deadline is just
+ * a check of the generation and the release of the slot.
+ *
+ * The order of deadlines is kept by a binary min-heap. Cancelled
+ * deadlines are not removed from the heap immediately. They are skipped
+ * when they reach the top of the heap. If there are too many cancelled
+ * items in the heap then the heap is rebuilt.
+ *
+ * The storage also keeps the time point of the pending wakeup signal
+ * (if it's scheduled). Wakeups are aligned to wakeup_resolution, so
+ * there is at most one wakeup timer per resolution interval.
+ *
+ * \note
+ * This class isn't thread safe. It's expected that it's used only
+ * on the agent's working context.
+ *
+ * \since v.5.8.4
+ */
+class agent_deadlines_t
+	{
+	public :
+		using clock_type = std::chrono::steady_clock;
+
+		//! Resolution of wakeups for idle agents.
+		static constexpr clock_type::duration wakeup_resolution =
+				std::chrono::milliseconds( 10 );
+
+		agent_deadlines_t( const agent_deadlines_t & ) = delete;
+		agent_deadlines_t & operator=( const agent_deadlines_t & ) = delete;
+
+		agent_deadlines_t( agent_t & agent )
+			:	m_wakeup_mbox_impl{
+					new deadlines_wakeup_mbox_t{ agent.so_environment(), agent } }
+			,	m_wakeup_mbox{ m_wakeup_mbox_impl }
+			{}
+
+		~agent_deadlines_t() noexcept
+			{
+				m_wakeup_mbox_impl->detach();
+			}
+
+		//! Add a new deadline.
+		[[nodiscard]]
+		deadline_id_t
+		add(
+			clock_type::time_point when,
+			const std::type_index & msg_type,
+			message_ref_t message )
+			{
+				std::uint32_t index = m_free_head;
+				const bool new_slot = ( no_slot == index );
+				if( new_slot )
+					{
+						index = static_cast< std::uint32_t >( m_slots.size() );
+						m_slots.emplace_back();
+					}
+
+				// Reserve the space in the heap before any modification of
+				// the slot. So there won't be exceptions after that.
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						if( m_heap.size() == m_heap.capacity() )
+							m_heap.reserve( std::max(
+									min_heap_capacity, m_heap.capacity() * 2u ) );
+					},
+					[&] {
+						if( new_slot )
+							m_slots.pop_back();
+					} );
+
+				slot_t & slot = m_slots[ index ];
+				m_free_head = slot.m_next_free;
+
+				slot.m_in_use = true;
+				slot.m_next_free = no_slot;
+				slot.m_msg_type = msg_type;
+				slot.m_message = std::move(message);
+
+				m_heap.push_back( heap_item_t{ when, index, slot.m_generation } );
+				std::push_heap( m_heap.begin(), m_heap.end(), heap_item_greater );
+
+				++m_active;
+
+				return { index, slot.m_generation };
+			}
+
+		//! Cancel a deadline.
+		/*!
+		 * \retval true if the deadline was pending and is cancelled now.
+		 * \retval false if there is no such deadline (it's already elapsed
+		 * or cancelled).
+		 */
+		bool
+		cancel( deadline_id_t id ) noexcept
+			{
+				if( id.slot() >= m_slots.size() )
+					return false;
+
+				slot_t & slot = m_slots[ id.slot() ];
+				if( !slot.m_in_use || slot.m_generation != id.generation() )
+					return false;
+
+				release_slot( id.slot() );
+				--m_active;
+				++m_stale;
+
+				compact_if_necessary();
+
+				return true;
+			}
+
+		//! Are there pending deadlines?
+		[[nodiscard]]
+		bool
+		empty() const noexcept
+			{
+				return 0u == m_active;
+			}
+
+		//! Handle all deadlines elapsed at \a now.
+		/*!
+		 * \a handler is called for every elapsed deadline as:
+		 * \code
+		 * handler(const std::type_index & msg_type, message_ref_t & message);
+		 * \endcode
+		 * The deadline is already removed from the storage at this moment.
+		 */
+		template< typename Handler >
+		void
+		handle_expired(
+			clock_type::time_point now,
+			Handler && handler )
+			{
+				while( !m_heap.empty() && m_heap.front().m_when <= now )
+					{
+						const heap_item_t item = pop_heap_top();
+						if( !is_alive( item ) )
+							{
+								--m_stale;
+								continue;
+							}
+
+						slot_t & slot = m_slots[ item.m_slot ];
+						const std::type_index msg_type = slot.m_msg_type;
+						message_ref_t message = std::move(slot.m_message);
+
+						release_slot( item.m_slot );
+						--m_active;
+
+						handler( msg_type, message );
+					}
+			}
+
+		//! Get the time point for a new wakeup if it's necessary.
+		/*!
+		 * The new wakeup is necessary if there are pending deadlines
+		 * and there is no scheduled wakeup that happens before
+		 * the nearest deadline.
+		 */
+		[[nodiscard]]
+		std::optional< clock_type::time_point >
+		wakeup_point_if_necessary() noexcept
+			{
+				remove_stale_top_items();
+				if( m_heap.empty() )
+					return std::nullopt;
+
+				const auto point = align_to_resolution( m_heap.front().m_when );
+				if( m_scheduled_wakeup && *m_scheduled_wakeup <= point )
+					return std::nullopt;
+
+				return point;
+			}
+
+		//! Remember the time point of the scheduled wakeup.
+		void
+		wakeup_scheduled( clock_type::time_point point ) noexcept
+			{
+				m_scheduled_wakeup = point;
+			}
+
+		//! Handle the arrival of a wakeup signal.
+		/*!
+		 * There can be several pending wakeups and it's impossible to
+		 * know which one has arrived. So the scheduled wakeup is treated as
+		 * happened if its time point is near to \a now.
+		 */
+		void
+		wakeup_happened( clock_type::time_point now ) noexcept
+			{
+				if( m_scheduled_wakeup &&
+						*m_scheduled_wakeup <= now + wakeup_resolution )
+					m_scheduled_wakeup.reset();
+			}
+
+		//! The mbox for wakeup signals.
+		[[nodiscard]]
+		const mbox_t &
+		wakeup_mbox() const noexcept
+			{
+				return m_wakeup_mbox;
+			}
+
+	private :
+		//! Special value for absence of the next free slot.
+		static constexpr std::uint32_t no_slot =
+				std::numeric_limits< std::uint32_t >::max();
+
+		//! Initial capacity of the heap.
+		static constexpr std::size_t min_heap_capacity = 16u;
+
+		//! Min size of the heap for rebuilding it.
+		static constexpr std::size_t min_heap_size_to_compact = 64u;
+
+		//! One slot for a deadline.
+		struct slot_t
+			{
+				//! Generation of the slot.
+				/*!
+				 * Is incremented on every release of the slot.
+				 * Value 0 is never used.
+				 */
+				std::uint32_t m_generation{ 1u };
+				//! Index of the next free slot.
+				std::uint32_t m_next_free{ no_slot };
+				//! Is the slot occupied by a pending deadline?
+				bool m_in_use{ false };
+				//! Type of the message to be sent.
+				std::type_index m_msg_type{ typeid(void) };
+				//! The message to be sent.
+				message_ref_t m_message;
+			};
+
+		//! One item of the heap.
+		struct heap_item_t
+			{
+				clock_type::time_point m_when;
+				std::uint32_t m_slot;
+				std::uint32_t m_generation;
+			};
+
+		//! Comparator for making min-heap by std heap functions.
+		static bool
+		heap_item_greater( const heap_item_t & a, const heap_item_t & b ) noexcept
+			{
+				return a.m_when > b.m_when;
+			}
+
+		//! Actual implementation of the mbox for wakeups.
+		deadlines_wakeup_mbox_t * m_wakeup_mbox_impl;
+
+		//! The mbox for wakeups.
+		/*!
+		 * It holds a reference to m_wakeup_mbox_impl.
+		 */
+		const mbox_t m_wakeup_mbox;
+
+		//! All slots.
+		std::vector< slot_t > m_slots;
+
+		//! Index of the first free slot.
+		std::uint32_t m_free_head{ no_slot };
+
+		//! Heap of deadlines.
+		/*!
+		 * Can contain items for cancelled deadlines.
+		 */
+		std::vector< heap_item_t > m_heap;
+
+		//! Count of pending deadlines.
+		std::size_t m_active{ 0u };
+
+		//! Count of items in the heap for cancelled deadlines.
+		std::size_t m_stale{ 0u };
+
+		//! Time point of the scheduled wakeup.
+		std::optional< clock_type::time_point > m_scheduled_wakeup;
+
+		[[nodiscard]]
+		static clock_type::time_point
+		align_to_resolution( clock_type::time_point point ) noexcept
+			{
+				const auto since_epoch = point.time_since_epoch();
+				const auto intervals =
+						( since_epoch + wakeup_resolution - clock_type::duration{ 1 } )
+						/ wakeup_resolution;
+
+				return clock_type::time_point{ intervals * wakeup_resolution };
+			}
+
+		[[nodiscard]]
+		bool
+		is_alive( const heap_item_t & item ) const noexcept
+			{
+				const slot_t & slot = m_slots[ item.m_slot ];
+				return slot.m_in_use && slot.m_generation == item.m_generation;
+			}
+
+		void
+		release_slot( std::uint32_t index ) noexcept
+			{
+				slot_t & slot = m_slots[ index ];
+
+				slot.m_in_use = false;
+				slot.m_message.reset();
+				if( 0u == ++slot.m_generation )
+					slot.m_generation = 1u;
+
+				slot.m_next_free = m_free_head;
+				m_free_head = index;
+			}
+
+		heap_item_t
+		pop_heap_top() noexcept
+			{
+				std::pop_heap( m_heap.begin(), m_heap.end(), heap_item_greater );
+				const heap_item_t item = m_heap.back();
+				m_heap.pop_back();
+
+				return item;
+			}
+
+		void
+		remove_stale_top_items() noexcept
+			{
+				while( !m_heap.empty() && !is_alive( m_heap.front() ) )
+					{
+						pop_heap_top();
+						--m_stale;
+					}
+			}
+
+		void
+		compact_if_necessary() noexcept
+			{
+				if( m_heap.size() < min_heap_size_to_compact ||
+						m_stale <= m_heap.size() / 2u )
+					return;
+
+				m_heap.erase(
+						std::remove_if( m_heap.begin(), m_heap.end(),
+								[this]( const heap_item_t & item ) {
+									return !is_alive( item );
+								} ),
+						m_heap.end() );
+				std::make_heap( m_heap.begin(), m_heap.end(), heap_item_greater );
+
+				m_stale = 0u;
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
@@ -0,0 +1,147 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A cache of results of event handler search for hierarchical states.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/types.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace so_5
+{
+
+class state_t;
+
+namespace impl
+{
+
+struct event_handler_data_t;
+
+//
+// event_handler_cache_t
+//
+/*!
+ * \brief A cache of results of event handler search.
+ *
+ * The search for an event handler in a hierarchical state requires
+ * a lookup in the subscription storage for every state from the current
+ * one to the root. This cache holds the final result of such search
+ * (including the case when there is no handler at all) for a compound key
+ * (mbox_id, msg_type, current_state).
+ *
+ * The cache is a small direct-mapped table. A new item simply replaces
+ * the old one with the same index.
+ *
+ * Because the current state is a part of the key the cache hasn't to be
+ * invalidated on a state change. But it has to be cleared on every
+ * modification of subscriptions because pointers to event_handler_data_t
+ * can become invalid after such modifications.
+ *
+ * \note
+ * This class isn't thread safe. It's expected that it's used only
+ * on the agent's working context.
+ *
+ * \since v.5.8.4
+ */
+class event_handler_cache_t
+	{
+		//! One item of the cache.
+		struct item_t
+			{
+				mbox_id_t m_mbox_id{ null_mbox_id() };
+				message_type_id_t m_msg_type_id{};
+				const state_t * m_state{ nullptr };
+				const event_handler_data_t * m_handler{ nullptr };
+			};
+
+		//! Count of items in the cache.
+		/*!
+		 * \note
+		 * It has to be a power of two.
+		 */
+		static constexpr std::size_t items_count = 16u;
+
+		//! Items of the cache.
+		/*!
+		 * \note
+		 * An item is empty if m_state is nullptr.
+		 */
+		std::array< item_t, items_count > m_items;
+
+		[[nodiscard]]
+		static std::size_t
+		index_of(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) noexcept
+			{
+				const auto state_as_int = reinterpret_cast< std::uintptr_t >( state );
+				return static_cast< std::size_t >(
+						mbox_id ^ (msg_type_id * 0x9e3779b9u) ^ (state_as_int >> 4u) )
+						& (items_count - 1u);
+			}
+
+	public :
+		//! Find a cached result of the search.
+		/*!
+		 * \return true if the result is found in the cache. In that case
+		 * \a handler receives the cached result (it can be nullptr if
+		 * there is no event handler at all).
+		 */
+		[[nodiscard]]
+		bool
+		find(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			const event_handler_data_t *& handler ) const noexcept
+			{
+				const auto & item = m_items[ index_of( mbox_id, msg_type_id, state ) ];
+				if( item.m_state == state && item.m_mbox_id == mbox_id &&
+						item.m_msg_type_id == msg_type_id )
+					{
+						handler = item.m_handler;
+						return true;
+					}
+
+				return false;
+			}
+
+		//! Store the result of the search.
+		void
+		store(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			const event_handler_data_t * handler ) noexcept
+			{
+				auto & item = m_items[ index_of( mbox_id, msg_type_id, state ) ];
+				item.m_mbox_id = mbox_id;
+				item.m_msg_type_id = msg_type_id;
+				item.m_state = state;
+				item.m_handler = handler;
+			}
+
+		//! Remove all items from the cache.
+		void
+		clear() noexcept
+			{
+				for( auto & item : m_items )
+					item.m_state = nullptr;
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
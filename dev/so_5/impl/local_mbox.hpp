@@ -10,6 +10,7 @@
 #pragma once
 
 #include <map>
+#include <type_traits>
 #include <vector>
 
 #include <so_5/types.hpp>
@@ -585,6 +586,227 @@ public :
 		}
 };
 
+//
+// map_based_subscribers_table_t
+//
+/*!
+ * \brief Table of subscribers based on std::map.
+ *
+ * \note
+ * It was the only type of the table before v.5.8.4.
+ *
+ * \since v.5.8.4
+ */
+class map_based_subscribers_table_t
+	{
+		using map_type = std::map<
+				std::type_index,
+				subscriber_adaptive_container_t >;
+
+		map_type m_map;
+
+	public :
+		//! Find subscribers for a message type.
+		/*!
+		 * \return nullptr if there is no subscribers for that type.
+		 */
+		[[nodiscard]]
+		subscriber_adaptive_container_t *
+		find( const std::type_index & msg_type ) noexcept
+			{
+				auto it = m_map.find( msg_type );
+				return it != m_map.end() ? &(it->second) : nullptr;
+			}
+
+		//! Add subscribers for a new message type.
+		/*!
+		 * \attention
+		 * There must not be subscribers for that message type in the table.
+		 */
+		void
+		emplace(
+			const std::type_index & msg_type,
+			subscriber_adaptive_container_t && subscribers )
+			{
+				m_map.emplace( msg_type, std::move(subscribers) );
+			}
+
+		//! Remove subscribers for a message type.
+		void
+		erase( const std::type_index & msg_type ) noexcept
+			{
+				m_map.erase( msg_type );
+			}
+	};
+
+//
+// flat_hash_subscribers_table_t
+//
+/*!
+ * \brief Table of subscribers in the form of flat hash table with
+ * open addressing and linear probing.
+ *
+ * Dense identifiers of message types (see so_5::message_type_id())
+ * are used as hash codes and as keys, so there is no need to compare
+ * std::type_index objects at all.
+ *
+ * Items are removed by backward shift of the following items,
+ * so there is no need for tombstones.
+ *
+ * \since v.5.8.4
+ */
+class flat_hash_subscribers_table_t
+	{
+		//! One slot of the table.
+		struct slot_t
+			{
+				//! Identifier of the message type.
+				message_type_id_t m_msg_type_id{};
+
+				//! Subscribers for the message type.
+				subscriber_adaptive_container_t m_subscribers;
+
+				//! Is this slot occupied?
+				bool m_occupied{ false };
+			};
+
+		//! Initial count of slots in the table.
+		static constexpr std::size_t initial_capacity = 8u;
+
+		//! Slots of the table.
+		/*!
+		 * \note
+		 * Count of slots is always zero or a power of two.
+		 */
+		std::vector< slot_t > m_slots;
+
+		//! Count of occupied slots.
+		std::size_t m_size{ 0u };
+
+		[[nodiscard]]
+		std::size_t
+		mask() const noexcept
+			{
+				return m_slots.size() - 1u;
+			}
+
+		//! Find an index of a slot for a message type.
+		/*!
+		 * \return index of the occupied slot or index of the first free slot
+		 * that terminates the search.
+		 *
+		 * \attention
+		 * There must be at least one free slot in the table.
+		 */
+		[[nodiscard]]
+		std::size_t
+		find_index( message_type_id_t msg_type_id ) const noexcept
+			{
+				std::size_t index = msg_type_id & mask();
+				for(;;)
+					{
+						const auto & slot = m_slots[ index ];
+						if( !slot.m_occupied || slot.m_msg_type_id == msg_type_id )
+							return index;
+
+						index = (index + 1u) & mask();
+					}
+			}
+
+		//! Increase the count of slots if the load factor is too high.
+		void
+		reserve_for_one_more()
+			{
+				// Max load factor is 3/4.
+				if( (m_size + 1u) * 4u <= m_slots.size() * 3u )
+					return;
+
+				std::vector< slot_t > new_slots(
+						m_slots.empty() ? initial_capacity : m_slots.size() * 2u );
+
+				// There won't be exceptions below.
+				swap( m_slots, new_slots );
+				for( auto & old : new_slots )
+					if( old.m_occupied )
+						m_slots[ find_index( old.m_msg_type_id ) ] =
+								std::move(old);
+			}
+
+	public :
+		//! Find subscribers for a message type.
+		/*!
+		 * \return nullptr if there is no subscribers for that type.
+		 */
+		[[nodiscard]]
+		subscriber_adaptive_container_t *
+		find( const std::type_index & msg_type ) noexcept
+			{
+				if( !m_size )
+					return nullptr;
+
+				auto & slot = m_slots[ find_index( find_message_type_id( msg_type ) ) ];
+				return slot.m_occupied ? &slot.m_subscribers : nullptr;
+			}
+
+		//! Add subscribers for a new message type.
+		/*!
+		 * \attention
+		 * There must not be subscribers for that message type in the table.
+		 */
+		void
+		emplace(
+			const std::type_index & msg_type,
+			subscriber_adaptive_container_t && subscribers )
+			{
+				const auto msg_type_id = message_type_id( msg_type );
+
+				reserve_for_one_more();
+
+				auto & slot = m_slots[ find_index( msg_type_id ) ];
+				slot.m_msg_type_id = msg_type_id;
+				slot.m_subscribers = std::move(subscribers);
+				slot.m_occupied = true;
+
+				++m_size;
+			}
+
+		//! Remove subscribers for a message type.
+		void
+		erase( const std::type_index & msg_type ) noexcept
+			{
+				if( !m_size )
+					return;
+
+				std::size_t hole = find_index( find_message_type_id( msg_type ) );
+				if( !m_slots[ hole ].m_occupied )
+					return;
+
+				// Items that can't be found after the removal of this item
+				// have to be moved to the hole.
+				for( std::size_t index = (hole + 1u) & mask();
+						m_slots[ index ].m_occupied;
+						index = (index + 1u) & mask() )
+					{
+						const std::size_t home = m_slots[ index ].m_msg_type_id & mask();
+						// Distances from the home slot of the item to the hole
+						// and to the current position of the item.
+						const std::size_t to_hole = (hole - home) & mask();
+						const std::size_t to_index = (index - home) & mask();
+						if( to_hole < to_index )
+							{
+								m_slots[ hole ] = std::move( m_slots[ index ] );
+								hole = index;
+							}
+					}
+
+				auto & freed = m_slots[ hole ];
+				freed.m_occupied = false;
+				freed.m_subscribers = subscriber_adaptive_container_t{};
+
+				--m_size;
+			}
+	};
+
 //
 // data_t
 //
@@ -594,7 +816,11 @@ public :
  * v.5.5.9
  *
  * \brief A coolection of data required for local mbox implementation.
+ *
+ * \tparam Subscribers_Table type of the table of subscribers.
+ * It's a template parameter since v.5.8.4.
  */
+template< typename Subscribers_Table >
 struct data_t
 	{
 		data_t( mbox_id_t id, environment_t & env )
@@ -616,10 +842,11 @@ struct data_t
 		 * v.5.4.0
 		 *
 		 * \brief Map from message type to subscribers.
+		 *
+		 * \note
+		 * It's an alias for Subscribers_Table since v.5.8.4.
 		 */
-		using messages_table_t = std::map<
-				std::type_index,
-				subscriber_adaptive_container_t >;
+		using messages_table_t = Subscribers_Table;
 
 		//! Map of subscribers to messages.
 		messages_table_t m_subscribers;
@@ -638,11 +865,14 @@ struct data_t
  *
  * \tparam Tracing_Base base class with implementation of message
  * delivery tracing methods.
+ *
+ * \tparam Subscribers_Table type of the table of subscribers.
+ * It's a template parameter since v.5.8.4.
  */
-template< typename Tracing_Base >
+template< typename Tracing_Base, typename Subscribers_Table >
 class local_mbox_template
 	:	public abstract_message_box_t
-	,	private local_mbox_details::data_t
+	,	private local_mbox_details::data_t< Subscribers_Table >
 	,	private Tracing_Base
 	{
 	public:
@@ -654,14 +884,14 @@ class local_mbox_template
 			environment_t & env,
 			//! Optional parameters for Tracing_Base's constructor.
 			Tracing_Args &&... args )
-			:	local_mbox_details::data_t{ id, env }
+			:	local_mbox_details::data_t< Subscribers_Table >{ id, env }
 			,	Tracing_Base{ std::forward< Tracing_Args >(args)... }
 			{}
 
 		mbox_id_t
 		id() const override
 			{
-				return m_id;
+				return this->m_id;
 			}
 
 		void
@@ -699,7 +929,7 @@ class local_mbox_template
 		query_name() const override
 			{
 				std::ostringstream s;
-				s << "<mbox:type=MPMC:id=" << m_id << ">";
+				s << "<mbox:type=MPMC:id=" << this->m_id << ">";
 
 				return s.str();
 			}
@@ -736,6 +966,90 @@ class local_mbox_template
 						redirection_deep );
 			}
 
+		/*!
+		 * \brief Delivery of a batch of messages.
+		 *
+		 * Subscribers are searched just once for the whole batch.
+		 * All messages from the batch are delivered to one subscriber
+		 * before switching to the next subscriber.
+		 *
+		 * If message delivery tracing is off, the whole batch is passed
+		 * to a subscriber's sink by one push_event_batch() call, so
+		 * the subscriber's event queue is locked only once.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		do_deliver_message_batch(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count,
+			unsigned int redirection_deep ) override
+			{
+				// Nothing should be delivered if there is a mutable message
+				// in the batch.
+				for( std::size_t i = 0; i != messages_count; ++i )
+					ensure_immutable_message( msg_type, messages[ i ] );
+
+				read_lock_guard_t< default_rw_spinlock_t > lock( this->m_lock );
+
+				if constexpr( std::is_same_v<
+						Tracing_Base, msg_tracing_helpers::tracing_disabled_base > )
+					{
+						if( const auto * subscribers = this->m_subscribers.find( msg_type ) )
+							for( const auto & a : *subscribers )
+								local_mbox_details::deliver_batch_to_subscriber(
+										a,
+										[&a]() -> abstract_message_sink_t & {
+											return a.sink_reference();
+										},
+										this->m_id,
+										delivery_mode,
+										msg_type,
+										messages,
+										messages_count,
+										redirection_deep );
+					}
+				else if( const auto * subscribers = this->m_subscribers.find( msg_type ) )
+					{
+						for( const auto & a : *subscribers )
+							for( std::size_t i = 0; i != messages_count; ++i )
+								{
+									typename Tracing_Base::deliver_op_tracer tracer{
+											*this, // as Tracing_base
+											*this, // as abstract_message_box_t
+											"deliver_message",
+											delivery_mode,
+											msg_type,
+											messages[ i ],
+											redirection_deep };
+
+									do_deliver_message_to_subscriber(
+											a,
+											tracer,
+											delivery_mode,
+											msg_type,
+											messages[ i ],
+											redirection_deep );
+								}
+					}
+				else
+					for( std::size_t i = 0; i != messages_count; ++i )
+						{
+							typename Tracing_Base::deliver_op_tracer tracer{
+									*this, // as Tracing_base
+									*this, // as abstract_message_box_t
+									"deliver_message",
+									delivery_mode,
+									msg_type,
+									messages[ i ],
+									redirection_deep };
+
+							tracer.no_subscribers();
+						}
+			}
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
@@ -771,7 +1085,7 @@ class local_mbox_template
 		environment_t &
 		environment() const noexcept override
 			{
-				return m_env;
+				return this->m_env;
 			}
 
 	private :
@@ -783,20 +1097,20 @@ class local_mbox_template
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+				std::unique_lock< default_rw_spinlock_t > lock( this->m_lock );
 
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
+				auto * subscribers = this->m_subscribers.find( type_wrapper );
+				if( !subscribers )
 				{
 					// There isn't such message type yet.
 					local_mbox_details::subscriber_adaptive_container_t container;
 					container.insert( subscriber, maker() );
 
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
+					this->m_subscribers.emplace( type_wrapper, std::move( container ) );
 				}
 				else
 				{
-					auto & sinks = it->second;
+					auto & sinks = *subscribers;
 
 					auto pos = sinks.find( subscriber );
 					if( pos != sinks.end() )
@@ -819,12 +1133,12 @@ class local_mbox_template
 			abstract_message_sink_t & subscriber,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+				std::unique_lock< default_rw_spinlock_t > lock( this->m_lock );
 
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
+				auto * subscribers = this->m_subscribers.find( type_wrapper );
+				if( subscribers )
 				{
-					auto & sinks = it->second;
+					auto & sinks = *subscribers;
 
 					auto pos = sinks.find( subscriber );
 					if( pos != sinks.end() )
@@ -839,7 +1153,7 @@ class local_mbox_template
 					}
 
 					if( sinks.empty() )
-						m_subscribers.erase( it );
+						this->m_subscribers.erase( type_wrapper );
 				}
 			}
 
@@ -851,12 +1165,11 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int redirection_deep )
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+				read_lock_guard_t< default_rw_spinlock_t > lock( this->m_lock );
 
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
+				if( const auto * subscribers = this->m_subscribers.find( msg_type ) )
 					{
-						for( const auto & a : it->second )
+						for( const auto & a : *subscribers )
 							do_deliver_message_to_subscriber(
 									a,
 									tracer,
@@ -928,18 +1241,30 @@ class local_mbox_template
  * v.5.5.9
  *
  * \brief Alias for local mbox without message delivery tracing.
+ *
+ * \note
+ * It's a template since v.5.8.4.
  */
+template< typename Subscribers_Table >
 using local_mbox_without_tracing =
-	local_mbox_template< msg_tracing_helpers::tracing_disabled_base >;
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			Subscribers_Table >;
 
 /*!
  * \since
  * v.5.5.9
  *
  * \brief Alias for local mbox with message delivery tracing.
+ *
+ * \note
+ * It's a template since v.5.8.4.
  */
+template< typename Subscribers_Table >
 using local_mbox_with_tracing =
-	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			Subscribers_Table >;
 
 } /* namespace impl */
 
@@ -16,6 +16,8 @@
 #include <so_5/agent.hpp>
 #include <so_5/enveloped_msg.hpp>
 
+#include <vector>
+
 namespace so_5
 {
 
@@ -335,6 +337,78 @@ public :
 	}
 };
 
+/*!
+ * \brief Deliver a batch of messages to one subscriber.
+ *
+ * Messages rejected by the subscriber's delivery filter are skipped.
+ * The rest of the batch is pushed to the subscriber's sink by just one
+ * abstract_message_sink_t::push_event_batch() call.
+ *
+ * \note
+ * This function is intended to be used only when message delivery
+ * tracing is off.
+ *
+ * \tparam Sink_Getter type of functor that returns a reference to
+ * the sink to be used. It's called only if there is something to push.
+ *
+ * \since v.5.8.4
+ */
+template< typename Sink_Getter >
+void
+deliver_batch_to_subscriber(
+	const subscription_info_with_sink_t & subscriber_info,
+	Sink_Getter && sink_getter,
+	mbox_id_t mbox_id,
+	message_delivery_mode_t delivery_mode,
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t messages_count,
+	unsigned int redirection_deep )
+{
+	const auto must_be_delivered = [&]( const message_ref_t & msg ) {
+			return delivery_possibility_t::must_be_delivered ==
+					subscriber_info.must_be_delivered(
+							msg,
+							[]( const message_ref_t & m ) -> message_t & {
+								return *m;
+							} );
+		};
+
+	// Messages are copied into a separate container only if
+	// some of them are rejected.
+	std::size_t first_rejected = 0u;
+	while( first_rejected != messages_count &&
+			must_be_delivered( messages[ first_rejected ] ) )
+		++first_rejected;
+
+	if( first_rejected == messages_count )
+	{
+		sink_getter().push_event_batch(
+				mbox_id,
+				delivery_mode,
+				msg_type,
+				messages,
+				messages_count,
+				redirection_deep );
+		return;
+	}
+
+	std::vector< message_ref_t > accepted{
+			messages, messages + first_rejected };
+	for( std::size_t i = first_rejected + 1u; i < messages_count; ++i )
+		if( must_be_delivered( messages[ i ] ) )
+			accepted.push_back( messages[ i ] );
+
+	if( !accepted.empty() )
+		sink_getter().push_event_batch(
+				mbox_id,
+				delivery_mode,
+				msg_type,
+				accepted.data(),
+				accepted.size(),
+				redirection_deep );
+}
+
 } /* namespace local_mbox_details */
 
 } /* namespace impl */
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <so_5/impl/mchain_details.hpp>
+#include <so_5/impl/mchain_lock_free_details.hpp>
 #include <so_5/impl/msg_tracing_helpers.hpp>
 
 namespace so_5
@@ -56,6 +57,39 @@ make_mchain(
 						std::forward<A>(args)..., params } };
 	}
 
+/*!
+ * \brief Helper function for creation of a new mchain with lock-free
+ * queue with respect to message tracing.
+ *
+ * \tparam A type of arguments for lock_free_mchain_template constructor.
+ *
+ * \since v.5.8.4
+ */
+template< typename... A >
+[[nodiscard]] mchain_t
+make_lock_free_mchain(
+	outliving_reference_t< so_5::msg_tracing::holder_t > tracer,
+	const mchain_params_t & params,
+	A &&... args )
+	{
+		using namespace so_5::mchain_props;
+		using namespace so_5::impl::msg_tracing_helpers;
+		using D = mchain_tracing_disabled_base;
+		using E = mchain_tracing_enabled_base;
+
+		if( tracer.get().is_msg_tracing_enabled()
+				&& !params.msg_tracing_disabled() )
+			return mchain_t{
+					new lock_free_mchain_template< E >{
+						std::forward<A>(args)...,
+						params,
+						tracer } };
+		else
+			return mchain_t{
+					new lock_free_mchain_template< D >{
+						std::forward<A>(args)..., params } };
+	}
+
 } /* namespace impl */
 
 } /* namespace so_5 */
@@ -25,8 +25,10 @@ namespace impl
 //
 
 mbox_core_t::mbox_core_t(
-	outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff )
+	outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff,
+	local_mbox_subscribers_table_t default_subscribers_table )
 	:	m_msg_tracing_stuff{ msg_tracing_stuff }
+	,	m_default_subscribers_table{ default_subscribers_table }
 	,	m_mbox_id_counter{ 1 }
 {
 }
@@ -34,12 +36,47 @@ mbox_core_t::mbox_core_t(
 mbox_t
 mbox_core_t::create_mbox(
 	environment_t & env )
+{
+	return create_mbox( env, m_default_subscribers_table );
+}
+
+namespace {
+
+template< typename Subscribers_Table >
+[[nodiscard]]
+mbox_t
+make_local_mbox(
+	outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff,
+	mbox_id_t id,
+	environment_t & env )
+	{
+		if( !msg_tracing_stuff.get().is_msg_tracing_enabled() )
+			return mbox_t{
+					new local_mbox_without_tracing< Subscribers_Table >{ id, env }
+				};
+		else
+			return mbox_t{
+					new local_mbox_with_tracing< Subscribers_Table >{
+							id, env, msg_tracing_stuff }
+				};
+	}
+
+} /* namespace anonymous */
+
+mbox_t
+mbox_core_t::create_mbox(
+	environment_t & env,
+	local_mbox_subscribers_table_t subscribers_table )
 {
 	auto id = ++m_mbox_id_counter;
-	if( !m_msg_tracing_stuff.get().is_msg_tracing_enabled() )
-		return mbox_t{ new local_mbox_without_tracing{ id, env } };
+	if( local_mbox_subscribers_table_t::flat_hash_table == subscribers_table )
+		return make_local_mbox<
+					local_mbox_details::flat_hash_subscribers_table_t >(
+				m_msg_tracing_stuff, id, env );
 	else
-		return mbox_t{ new local_mbox_with_tracing{ id, env, m_msg_tracing_stuff } };
+		return make_local_mbox<
+					local_mbox_details::map_based_subscribers_table_t >(
+				m_msg_tracing_stuff, id, env );
 }
 
 mbox_t
@@ -284,9 +321,17 @@ mbox_core_t::create_mchain(
 	using namespace so_5::mchain_props;
 	using namespace so_5::mchain_props::details;
 
+	if( params.lock_free_queue_enabled() && params.capacity().unlimited() )
+		SO_5_THROW_EXCEPTION(
+				rc_lock_free_mchain_must_be_size_limited,
+				"mchain with lock-free queue must be size-limited" );
+
 	auto id = ++m_mbox_id_counter;
 
-	if( params.capacity().unlimited() )
+	if( params.lock_free_queue_enabled() )
+		return make_lock_free_mchain(
+				m_msg_tracing_stuff, params, env, id );
+	else if( params.capacity().unlimited() )
 		return make_mchain< unlimited_demand_queue >(
 				m_msg_tracing_stuff, params, env, id );
 	else if( memory_usage_t::dynamic == params.capacity().memory_usage() )
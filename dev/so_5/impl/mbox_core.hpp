@@ -138,7 +138,10 @@ class mbox_core_t final : private atomic_refcounted_t
 	public:
 		mbox_core_t(
 			//! Message delivery tracing stuff.
-			outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff );
+			outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff,
+			//! Type of subscribers table for local mboxes.
+			//! Since v.5.8.4.
+			local_mbox_subscribers_table_t default_subscribers_table );
 
 		//! Create local anonymous mbox.
 		/*!
@@ -148,6 +151,21 @@ class mbox_core_t final : private atomic_refcounted_t
 		mbox_t
 		create_mbox( environment_t & env );
 
+		//! Create local anonymous mbox with the specified type of
+		//! subscribers table.
+		/*!
+		 * \note always creates a new mbox.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		mbox_t
+		create_mbox(
+			//! Environment for which the mbox is created.
+			environment_t & env,
+			//! Type of subscribers table for the new mbox.
+			local_mbox_subscribers_table_t subscribers_table );
+
 		//! Create local named mbox.
 		/*!
 			\note if mbox with specified name \a mbox_name is present, 
@@ -269,6 +287,14 @@ class mbox_core_t final : private atomic_refcounted_t
 		 */
 		outliving_reference_t< so_5::msg_tracing::holder_t > m_msg_tracing_stuff;
 
+		/*!
+		 * \brief Type of subscribers table for local mboxes created
+		 * without explicit specification of the table type.
+		 *
+		 * \since v.5.8.4
+		 */
+		const local_mbox_subscribers_table_t m_default_subscribers_table;
+
 		//! Named mbox map's lock.
 		std::mutex m_dictionary_lock;
 
@@ -47,6 +47,29 @@ class mbox_iface_for_timers_t
 						1u /* redirection_deep */ );
 			}
 
+		/*!
+		 * \brief Deliver a batch of messages of the same type
+		 * from a timer.
+		 *
+		 * \since v.5.8.4
+		 */
+		inline void
+		deliver_message_batch_from_timer(
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Pointer to the first message in the batch.
+			const message_ref_t * messages,
+			//! Count of messages in the batch.
+			std::size_t messages_count )
+			{
+				m_mb.do_deliver_message_batch(
+						message_delivery_mode_t::nonblocking,
+						msg_type,
+						messages,
+						messages_count,
+						1u /* redirection_deep */ );
+			}
+
 	private :
 		abstract_message_box_t & m_mb;
 	};
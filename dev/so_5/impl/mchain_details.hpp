@@ -19,15 +19,20 @@
 #include <so_5/ret_code.hpp>
 #include <so_5/exception.hpp>
 #include <so_5/error_logger.hpp>
+#include <so_5/spinlocks.hpp>
 
 #include <so_5/details/abort_on_fatal_error.hpp>
 #include <so_5/details/at_scope_exit.hpp>
 #include <so_5/details/safe_cv_wait_for.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 namespace so_5 {
 
@@ -299,6 +304,135 @@ enum class status
 		closed
 	};
 
+//
+// adaptive_consumer_waiting_t
+//
+/*!
+ * \brief Implementation of active waiting on empty chain.
+ *
+ * Holds the current limit of spin iterations. This limit is doubled
+ * (up to the value from consumer_waiting_params_t) every time active
+ * waiting succeeds and is halved every time a consumer has to go to sleep.
+ *
+ * Also collects statistics of waitings.
+ *
+ * \note
+ * All members are atomics because several consumers can wait on the same
+ * chain at the same time.
+ *
+ * \since v.5.8.4
+ */
+class adaptive_consumer_waiting_t
+	{
+	public :
+		explicit adaptive_consumer_waiting_t(
+			consumer_waiting_params_t params ) noexcept
+			:	m_params{ params }
+			,	m_spin_limit{ params.m_spin_count }
+			{}
+
+		//! Is active waiting enabled?
+		[[nodiscard]]
+		bool
+		enabled() const noexcept
+			{
+				return 0u != m_params.m_spin_count || 0u != m_params.m_yield_count;
+			}
+
+		//! Spin and yield until \a predicate returns true.
+		/*!
+		 * \return false if the consumer has to go to sleep.
+		 */
+		template< typename Predicate >
+		[[nodiscard]]
+		bool
+		wait_actively( Predicate && predicate ) noexcept
+			{
+				const auto limit = m_spin_limit.load( std::memory_order_relaxed );
+
+				pause_backoff_t backoff;
+				for( std::size_t i = 0u; i != limit; ++i )
+					{
+						if( predicate() )
+							{
+								increment( m_completed_by_spinning );
+								grow_spin_limit( limit );
+								return true;
+							}
+						backoff();
+					}
+
+				for( std::size_t i = 0u; i != m_params.m_yield_count; ++i )
+					{
+						std::this_thread::yield();
+						if( predicate() )
+							{
+								increment( m_completed_by_yielding );
+								grow_spin_limit( limit );
+								return true;
+							}
+					}
+
+				increment( m_blocked );
+				m_spin_limit.store(
+						std::max( limit / 2u,
+								std::min( min_spin_limit, m_params.m_spin_count ) ),
+						std::memory_order_relaxed );
+				return false;
+			}
+
+		//! Inform about going to sleep without active waiting.
+		void
+		on_blocked() noexcept
+			{
+				increment( m_blocked );
+			}
+
+		[[nodiscard]]
+		consumer_waiting_stats_t
+		query_stats() const noexcept
+			{
+				consumer_waiting_stats_t result;
+				result.m_completed_by_spinning =
+						m_completed_by_spinning.load( std::memory_order_relaxed );
+				result.m_completed_by_yielding =
+						m_completed_by_yielding.load( std::memory_order_relaxed );
+				result.m_blocked = m_blocked.load( std::memory_order_relaxed );
+				return result;
+			}
+
+	private :
+		//! The lower bound for the adjusted limit of spin iterations.
+		/*!
+		 * Doesn't allow to switch spinning off completely.
+		 */
+		static constexpr std::size_t min_spin_limit = 16u;
+
+		//! Parameters of waiting.
+		const consumer_waiting_params_t m_params;
+
+		//! The current limit of spin iterations.
+		std::atomic< std::size_t > m_spin_limit;
+
+		std::atomic< std::uint64_t > m_completed_by_spinning{ 0u };
+		std::atomic< std::uint64_t > m_completed_by_yielding{ 0u };
+		std::atomic< std::uint64_t > m_blocked{ 0u };
+
+		static void
+		increment( std::atomic< std::uint64_t > & counter ) noexcept
+			{
+				counter.fetch_add( 1u, std::memory_order_relaxed );
+			}
+
+		void
+		grow_spin_limit( std::size_t current ) noexcept
+			{
+				m_spin_limit.store(
+						std::min( current * 2u, m_params.m_spin_count ),
+						std::memory_order_relaxed );
+			}
+	};
+
 } /* namespace details */
 
 //
@@ -336,6 +470,9 @@ class mchain_template
 			,	m_capacity( params.capacity() )
 			,	m_not_empty_notificator( params.not_empty_notificator() )
 			,	m_queue( params.capacity() )
+			,	m_consumer_waiting(
+					params.consumer_waiting().value_or(
+							consumer_waiting_params_t{} ) )
 			{}
 
 		mbox_id_t
@@ -427,45 +564,53 @@ class mchain_template
 			{
 				std::unique_lock< std::mutex > lock{ m_lock };
 
-				// If queue is empty we must wait for some time.
-				bool queue_empty = m_queue.is_empty();
-				if( queue_empty )
-					{
-						if( details::status::closed == m_status )
-							// Waiting for new messages has no sence because
-							// chain is closed.
-							return extraction_status_t::chain_closed;
+				const auto status = wait_for_not_empty_queue(
+						lock, empty_queue_timeout );
+				if( extraction_status_t::msg_extracted != status )
+					return status;
 
-						auto predicate = [this, &queue_empty]() -> bool {
-								queue_empty = m_queue.is_empty();
-								return !queue_empty ||
-										details::status::closed == m_status;
-							};
+				return extract_demand_from_not_empty_queue( dest );
+			}
 
-						// Count of sleeping thread must be incremented before
-						// going to sleep and decremented right after.
-						++m_threads_to_wakeup;
-						auto decrement_threads = so_5::details::at_scope_exit(
-								[this] { --m_threads_to_wakeup; } );
+		[[nodiscard]]
+		extraction_status_t
+		extract_bulk(
+			demand_t * dest,
+			std::size_t dest_capacity,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
 
-						// Wait until arrival of any message or closing of chain.
-						::so_5::details::wait_for_big_interval(
-								lock,
-								m_underflow_cond,
-								empty_queue_timeout,
-								predicate );
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				const auto status = wait_for_not_empty_queue(
+						lock, empty_queue_timeout );
+				if( extraction_status_t::msg_extracted != status )
+					return status;
+
+				// If queue was full then someone can wait on it.
+				const bool queue_was_full = m_queue.is_full();
+				do
+					{
+						demand_t & d = dest[ extracted ];
+						d = std::move( m_queue.front() );
+						m_queue.pop_front();
+						++extracted;
+
+						this->trace_extracted_demand( *this, d );
 					}
+				while( extracted < dest_capacity && !m_queue.is_empty() );
 
-				// If queue is still empty nothing can be extracted and
-				// we must stop operation.
-				if( queue_empty )
-					return details::status::open == m_status ?
-							// The chain is still open so there must be this result
-							extraction_status_t::no_messages :
-							// The chain is closed and there must be different result
-							extraction_status_t::chain_closed;
+				// All waiting producers are notified only once for the
+				// whole batch.
+				if( queue_was_full )
+					{
+						notify_multi_chain_select_ops();
+						m_overflow_cond.notify_all();
+					}
 
-				return extract_demand_from_not_empty_queue( dest );
+				return extraction_status_t::msg_extracted;
 			}
 
 		bool
@@ -480,6 +625,12 @@ class mchain_template
 				return m_queue.size();
 			}
 
+		consumer_waiting_stats_t
+		query_consumer_waiting_stats() const override
+			{
+				return m_consumer_waiting.query_stats();
+			}
+
 		environment_t &
 		environment() const noexcept override
 			{
@@ -586,6 +737,7 @@ class mchain_template
 					return;
 
 				m_status = details::status::closed;
+				increment_state_version();
 
 				const bool was_full = m_queue.is_full();
 
@@ -660,6 +812,26 @@ class mchain_template
 		 */
 		select_case_t * m_select_tail = nullptr;
 
+		/*!
+		 * \brief Active waiting on empty chain and its statistics.
+		 *
+		 * \since v.5.8.4
+		 */
+		details::adaptive_consumer_waiting_t m_consumer_waiting;
+
+		/*!
+		 * \brief Counter of chain's changes.
+		 *
+		 * Is incremented on every store of a new message and on close.
+		 * A consumer that waits actively without holding m_lock looks
+		 * at this counter.
+		 *
+		 * Is modified only when m_lock is acquired.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::atomic< std::size_t > m_state_version{ 0u };
+
 		//! Actual implementation of pushing message to the queue.
 		/*!
 		 * \note
@@ -831,6 +1003,125 @@ class mchain_template
 						message );
 			}
 
+		/*!
+		 * \brief Wait until the queue becomes not empty.
+		 *
+		 * Returns extraction_status_t::msg_extracted if the queue
+		 * isn't empty and there is something to extract.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		extraction_status_t
+		wait_for_not_empty_queue(
+			std::unique_lock< std::mutex > & lock,
+			duration_t empty_queue_timeout )
+			{
+				// If queue is empty we must wait for some time.
+				bool queue_empty = m_queue.is_empty();
+				if( queue_empty )
+					{
+						if( details::status::closed == m_status )
+							// Waiting for new messages has no sence because
+							// chain is closed.
+							return extraction_status_t::chain_closed;
+
+						auto predicate = [this, &queue_empty]() -> bool {
+								queue_empty = m_queue.is_empty();
+								return !queue_empty ||
+										details::status::closed == m_status;
+							};
+
+						so_5::details::remaining_time_counter_t remaining_time{
+								empty_queue_timeout };
+						// There is no need to wait actively if the consumer
+						// doesn't want to wait at all.
+						if( duration_t::zero() != empty_queue_timeout )
+							{
+								wait_actively( lock );
+								remaining_time.update();
+							}
+
+						// Count of sleeping thread must be incremented before
+						// going to sleep and decremented right after.
+						++m_threads_to_wakeup;
+						auto decrement_threads = so_5::details::at_scope_exit(
+								[this] { --m_threads_to_wakeup; } );
+
+						// Wait until arrival of any message or closing of chain.
+						// NOTE: predicate is checked before going to sleep,
+						// so there is no sleep if active waiting succeeded.
+						::so_5::details::wait_for_big_interval(
+								lock,
+								m_underflow_cond,
+								remaining_time.remaining(),
+								predicate );
+					}
+
+				// If queue is still empty nothing can be extracted and
+				// we must stop operation.
+				if( queue_empty )
+					return details::status::open == m_status ?
+							// The chain is still open so there must be this result
+							extraction_status_t::no_messages :
+							// The chain is closed and there must be different result
+							extraction_status_t::chain_closed;
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		/*!
+		 * \brief Spin and yield without holding the chain's lock
+		 * until the chain is changed.
+		 *
+		 * Does nothing except updating the statistics if active waiting
+		 * is disabled.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked. The lock is released during active waiting and
+		 * is acquired again before the return.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		wait_actively( std::unique_lock< std::mutex > & lock )
+			{
+				if( !m_consumer_waiting.enabled() )
+					{
+						m_consumer_waiting.on_blocked();
+						return;
+					}
+
+				const auto version = m_state_version.load(
+						std::memory_order_relaxed );
+
+				lock.unlock();
+				(void)m_consumer_waiting.wait_actively( [this, version] {
+						return version != m_state_version.load(
+								std::memory_order_acquire );
+					} );
+				lock.lock();
+			}
+
+		/*!
+		 * \brief Increment the counter of chain's changes.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		increment_state_version() noexcept
+			{
+				m_state_version.store(
+						m_state_version.load( std::memory_order_relaxed ) + 1u,
+						std::memory_order_release );
+			}
+
 		/*!
 		 * \brief Implementation of extract operation for the case when
 		 * message queue is not empty.
@@ -899,6 +1190,7 @@ class mchain_template
 				const bool was_empty = m_queue.is_empty();
 				
 				m_queue.push_back( demand_t{ msg_type, message } );
+				increment_state_version();
 
 				tracer.stored( m_queue );
 
@@ -0,0 +1,941 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Implementation details for message chains with lock-free queue.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/impl/mchain_details.hpp>
+
+#include <so_5/spinlocks.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace lock_free_details {
+
+//
+// cell_t
+//
+/*!
+ * \brief A cell of the ring buffer for lock-free mchain.
+ *
+ * \since v.5.8.4
+ */
+struct cell_t
+	{
+		//! Sequence number of the cell.
+		/*!
+		 * Value pos means that the cell is free for a producer with
+		 * position pos. Value pos+1 means that the cell contains a demand
+		 * for a consumer with position pos.
+		 */
+		std::atomic< std::size_t > m_sequence{ 0u };
+
+		//! Demand itself.
+		demand_t m_demand;
+	};
+
+//
+// bounded_queue_t
+//
+/*!
+ * \brief Lock-free bounded queue of demands.
+ *
+ * It is an implementation of bounded MPMC queue by Dmitry Vyukov.
+ * Every cell has a sequence number that tells a producer or a
+ * consumer whether the cell is ready for it. Producers and consumers
+ * synchronize only through positions and sequence numbers, so a
+ * single producer and a single consumer never touch the same cache
+ * line except the cell being transferred.
+ *
+ * \note
+ * The buffer is allocated in the constructor and is never reallocated.
+ *
+ * \since v.5.8.4
+ */
+class bounded_queue_t
+	{
+	public :
+		bounded_queue_t( const bounded_queue_t & ) = delete;
+		bounded_queue_t & operator=( const bounded_queue_t & ) = delete;
+
+		bounded_queue_t( std::size_t capacity )
+			:	m_capacity{ capacity ? capacity : 1u }
+			,	m_cells{ new cell_t[ m_capacity ] }
+			{
+				for( std::size_t i = 0u; i != m_capacity; ++i )
+					m_cells[ i ].m_sequence.store( i, std::memory_order_relaxed );
+			}
+
+		//! Try to store a new demand.
+		/*!
+		 * \a demand is moved only if the queue isn't full.
+		 *
+		 * \return false if the queue is full.
+		 */
+		[[nodiscard]]
+		bool
+		try_push( demand_t & demand ) noexcept
+			{
+				std::size_t pos = m_enqueue_pos.load( std::memory_order_relaxed );
+				cell_t * cell;
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const std::size_t seq =
+								cell->m_sequence.load( std::memory_order_acquire );
+						const auto diff = static_cast< std::intptr_t >( seq ) -
+								static_cast< std::intptr_t >( pos );
+						if( 0 == diff )
+							{
+								if( m_enqueue_pos.compare_exchange_weak(
+										pos, pos + 1u, std::memory_order_relaxed ) )
+									break;
+							}
+						else if( diff < 0 )
+							return false;
+						else
+							pos = m_enqueue_pos.load( std::memory_order_relaxed );
+					}
+
+				cell->m_demand = std::move(demand);
+				cell->m_sequence.store( pos + 1u, std::memory_order_release );
+
+				return true;
+			}
+
+		//! Try to extract the oldest demand.
+		/*!
+		 * \return false if the queue is empty.
+		 */
+		[[nodiscard]]
+		bool
+		try_pop( demand_t & dest ) noexcept
+			{
+				std::size_t pos = m_dequeue_pos.load( std::memory_order_relaxed );
+				cell_t * cell;
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const std::size_t seq =
+								cell->m_sequence.load( std::memory_order_acquire );
+						const auto diff = static_cast< std::intptr_t >( seq ) -
+								static_cast< std::intptr_t >( pos + 1u );
+						if( 0 == diff )
+							{
+								if( m_dequeue_pos.compare_exchange_weak(
+										pos, pos + 1u, std::memory_order_relaxed ) )
+									break;
+							}
+						else if( diff < 0 )
+							return false;
+						else
+							pos = m_dequeue_pos.load( std::memory_order_relaxed );
+					}
+
+				dest = std::move(cell->m_demand);
+				cell->m_sequence.store( pos + m_capacity, std::memory_order_release );
+
+				return true;
+			}
+
+		//! Approximate count of demands in the queue.
+		[[nodiscard]]
+		std::size_t
+		size() const noexcept
+			{
+				const std::size_t dequeue_pos =
+						m_dequeue_pos.load( std::memory_order_acquire );
+				const std::size_t enqueue_pos =
+						m_enqueue_pos.load( std::memory_order_acquire );
+				return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0u;
+			}
+
+		//! Is there a demand ready for extraction?
+		[[nodiscard]]
+		bool
+		is_empty() const noexcept
+			{
+				const std::size_t pos =
+						m_dequeue_pos.load( std::memory_order_acquire );
+				return m_cells[ pos % m_capacity ].m_sequence.load(
+						std::memory_order_acquire ) != pos + 1u;
+			}
+
+		//! Is there a free cell for a producer?
+		[[nodiscard]]
+		bool
+		is_full() const noexcept
+			{
+				const std::size_t pos =
+						m_enqueue_pos.load( std::memory_order_acquire );
+				return m_cells[ pos % m_capacity ].m_sequence.load(
+						std::memory_order_acquire ) != pos;
+			}
+
+	private :
+		//! Max count of demands.
+		const std::size_t m_capacity;
+
+		//! Ring buffer.
+		const std::unique_ptr< cell_t[] > m_cells;
+
+		//! Position for the next push.
+		alignas(64) std::atomic< std::size_t > m_enqueue_pos{ 0u };
+
+		//! Position for the next pop.
+		alignas(64) std::atomic< std::size_t > m_dequeue_pos{ 0u };
+	};
+
+//
+// spin_iterations
+//
+/*!
+ * \brief Count of spin iterations before parking a thread on
+ * empty or full chain.
+ *
+ * \since v.5.8.4
+ */
+constexpr std::size_t spin_iterations = 1024u;
+
+//
+// yield_iterations
+//
+/*!
+ * \brief Count of std::this_thread::yield() calls after spinning and
+ * before parking a thread on empty or full chain.
+ *
+ * \since v.5.8.4
+ */
+constexpr std::size_t yield_iterations = 16u;
+
+} /* namespace lock_free_details */
+
+//
+// lock_free_mchain_template
+//
+/*!
+ * \brief Implementation of size-limited message chain with lock-free
+ * ring buffer.
+ *
+ * Messages are sent and extracted without acquiring a mutex.
+ * A thread that has to wait on empty chain (or on full chain) spins for
+ * some time, then yields and only then parks on a condition variable.
+ * The mutex is used only for parking, for multi chain select and for
+ * closing the chain. A producer or a consumer acquires the mutex only
+ * if there is some sleeping counterpart or a registered select case.
+ *
+ * \note
+ * Messages sent concurrently with close() can still be stored into
+ * the chain even if close_mode_t::drop_content is used. They will be
+ * extracted before chain_closed status.
+ *
+ * \tparam Tracing_Base type with message tracing implementation details.
+ *
+ * \since v.5.8.4
+ */
+template< typename Tracing_Base >
+class lock_free_mchain_template
+	:	public abstract_message_chain_t
+	,	private Tracing_Base
+	{
+		using queue_t = lock_free_details::bounded_queue_t;
+
+	public :
+		//! Initializing constructor.
+		template< typename... Tracing_Args >
+		lock_free_mchain_template(
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for Tracing_Base's constructor.
+			Tracing_Args &&... tracing_args )
+			:	Tracing_Base( std::forward<Tracing_Args>(tracing_args)... )
+			,	m_env( env )
+			,	m_id( id )
+			,	m_capacity( params.capacity() )
+			,	m_not_empty_notificator( params.not_empty_notificator() )
+			,	m_queue( params.capacity().max_size() )
+			,	m_consumer_waiting(
+					params.consumer_waiting().value_or(
+							consumer_waiting_params_t{
+									lock_free_details::spin_iterations,
+									lock_free_details::yield_iterations } ) )
+			{}
+
+		mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		void
+		subscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			abstract_message_sink_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_subscriptions,
+						"mchain doesn't support subscription" );
+			}
+
+		void
+		unsubscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			abstract_message_sink_t & /*subscriber*/ ) noexcept override
+			{}
+
+		std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mchain:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		void
+		do_deliver_message(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*redirection_deep*/ ) override
+			{
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message };
+
+				// Message cannot be stored to closed chain.
+				if( is_closed() )
+					return;
+
+				demand_t demand{ msg_type, message };
+				if( m_queue.try_push( demand ) )
+					{
+						complete_store_message_to_queue( tracer );
+						return;
+					}
+
+				// There is no waiting on full chain for delayed/periodic
+				// messages. See mchain_template for more details.
+				if( message_delivery_mode_t::ordinary == delivery_mode &&
+						m_capacity.is_overflow_timeout_defined() )
+					{
+						switch( wait_and_push( demand ) )
+							{
+							case push_status_t::stored:
+								complete_store_message_to_queue( tracer );
+								return;
+
+							case push_status_t::chain_closed:
+								return;
+
+							case push_status_t::not_stored:
+							case push_status_t::deffered:
+								break;
+							}
+					}
+
+				handle_overflow( delivery_mode, tracer, demand );
+			}
+
+		/*!
+		 * \attention Will throw an exception because delivery
+		 * filter is not applicable to MPSC-mboxes.
+		 */
+		void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			abstract_message_sink_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_delivery_filters,
+						"set_delivery_filter is called for mchain" );
+			}
+
+		void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			abstract_message_sink_t & /*subscriber*/ ) noexcept override
+			{}
+
+		[[nodiscard]]
+		extraction_status_t
+		extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout ) override
+			{
+				if( try_extract( dest ) )
+					return extraction_status_t::msg_extracted;
+
+				so_5::details::remaining_time_counter_t remaining_time{
+						empty_queue_timeout };
+				for(;;)
+					{
+						if( is_closed() )
+							// Some messages could be stored just before close.
+							return try_extract( dest ) ?
+									extraction_status_t::msg_extracted :
+									extraction_status_t::chain_closed;
+
+						if( !remaining_time )
+							return extraction_status_t::no_messages;
+
+						wait_for_not_empty_queue( remaining_time.remaining() );
+
+						if( try_extract( dest ) )
+							return extraction_status_t::msg_extracted;
+
+						remaining_time.update();
+					}
+			}
+
+		[[nodiscard]]
+		extraction_status_t
+		extract_bulk(
+			demand_t * dest,
+			std::size_t dest_capacity,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
+
+				const auto status = extract( dest[ 0 ], empty_queue_timeout );
+				if( extraction_status_t::msg_extracted == status )
+					{
+						extracted = 1u;
+						while( extracted < dest_capacity &&
+								try_extract( dest[ extracted ] ) )
+							++extracted;
+					}
+
+				return status;
+			}
+
+		bool
+		empty() const override
+			{
+				return m_queue.is_empty();
+			}
+
+		std::size_t
+		size() const override
+			{
+				return m_queue.size();
+			}
+
+		consumer_waiting_stats_t
+		query_consumer_waiting_stats() const override
+			{
+				return m_consumer_waiting.query_stats();
+			}
+
+		environment_t &
+		environment() const noexcept override
+			{
+				return m_env;
+			}
+
+	protected :
+		[[nodiscard]]
+		extraction_status_t
+		extract(
+			demand_t & dest,
+			select_case_t & select_case ) override
+			{
+				for(;;)
+					{
+						if( try_extract( dest ) )
+							return extraction_status_t::msg_extracted;
+
+						{
+							std::lock_guard< std::mutex > lock{ m_lock };
+
+							if( !is_closed() )
+								{
+									add_select_case( select_case );
+
+									// A message could be stored before select_case
+									// became visible to producers.
+									if( m_queue.is_empty() )
+										return extraction_status_t::no_messages;
+
+									remove_select_case( select_case );
+									continue;
+								}
+						}
+
+						// Some messages could be stored just before close.
+						return try_extract( dest ) ?
+								extraction_status_t::msg_extracted :
+								extraction_status_t::chain_closed;
+					}
+			}
+
+		[[nodiscard]]
+		mchain_props::push_status_t
+		push(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			mchain_props::select_case_t & select_case ) override
+			{
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message };
+
+				demand_t demand{ msg_type, message };
+				for(;;)
+					{
+						// Message cannot be stored to closed chain.
+						if( is_closed() )
+							return push_status_t::chain_closed;
+
+						if( m_queue.try_push( demand ) )
+							{
+								complete_store_message_to_queue( tracer );
+								return push_status_t::stored;
+							}
+
+						std::lock_guard< std::mutex > lock{ m_lock };
+
+						if( is_closed() )
+							return push_status_t::chain_closed;
+
+						// The select_case should be stored until there will
+						// be a free space in the chain (or chain will be closed).
+						add_select_case( select_case );
+
+						// Some message could be extracted before select_case
+						// became visible to consumers.
+						if( m_queue.is_full() )
+							return push_status_t::deffered;
+
+						remove_select_case( select_case );
+					}
+			}
+
+		void
+		remove_from_select(
+			select_case_t & select_case ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				remove_select_case( select_case );
+			}
+
+		void
+		actual_close( close_mode_t mode ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( is_closed() )
+					return;
+
+				m_closed.store( true, std::memory_order_seq_cst );
+
+				if( close_mode_t::drop_content == mode )
+					{
+						demand_t demand;
+						while( m_queue.try_pop( demand ) )
+							this->trace_demand_drop_on_close( *this, demand );
+					}
+
+				// All waiting threads and select operations must be
+				// informed that the chain is closed.
+				notify_multi_chain_select_ops();
+
+				m_underflow_cond.notify_all();
+				m_overflow_cond.notify_all();
+			}
+
+	private :
+		//! SObjectizer Environment for which message chain is created.
+		environment_t & m_env;
+
+		//! Mbox ID for chain.
+		const mbox_id_t m_id;
+
+		//! Chain capacity.
+		const capacity_t m_capacity;
+
+		//! Optional notificator for 'not_empty' condition.
+		const not_empty_notification_func_t m_not_empty_notificator;
+
+		//! Chain's demands queue.
+		queue_t m_queue;
+
+		//! Is the chain closed?
+		std::atomic< bool > m_closed{ false };
+
+		//! Count of threads sleeping on empty chain.
+		/*!
+		 * Is modified only when m_lock is acquired.
+		 */
+		std::atomic< std::size_t > m_sleeping_consumers{ 0u };
+
+		//! Count of threads sleeping on full chain.
+		/*!
+		 * Is modified only when m_lock is acquired.
+		 */
+		std::atomic< std::size_t > m_sleeping_producers{ 0u };
+
+		//! Is there any select case in m_select_tail?
+		/*!
+		 * Is modified only when m_lock is acquired.
+		 */
+		std::atomic< bool > m_has_select_cases{ false };
+
+		//! Lock for parking threads and for select operations.
+		std::mutex m_lock;
+
+		//! Condition variable for waiting on empty queue.
+		std::condition_variable m_underflow_cond;
+		//! Condition variable for waiting on full queue.
+		std::condition_variable m_overflow_cond;
+
+		//! A queue of multi-chain selects in which this chain is used.
+		/*!
+		 * Is protected by m_lock.
+		 */
+		select_case_t * m_select_tail = nullptr;
+
+		//! Active waiting on empty chain and its statistics.
+		details::adaptive_consumer_waiting_t m_consumer_waiting;
+
+		[[nodiscard]]
+		bool
+		is_closed() const noexcept
+			{
+				return m_closed.load( std::memory_order_acquire );
+			}
+
+		//! Try to extract a message and wake up sleeping producers if any.
+		[[nodiscard]]
+		bool
+		try_extract( demand_t & dest )
+			{
+				if( !m_queue.try_pop( dest ) )
+					return false;
+
+				this->trace_extracted_demand( *this, dest );
+
+				// The fence is paired with the fence in
+				// wait_and_push() or in add_select_case().
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_sleeping_producers.load( std::memory_order_relaxed ) ||
+						m_has_select_cases.load( std::memory_order_relaxed ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+
+						// Waiting select_cases should be notified too because
+						// they can be send_cases.
+						notify_multi_chain_select_ops();
+
+						m_overflow_cond.notify_all();
+					}
+
+				return true;
+			}
+
+		/*!
+		 * \brief Completion of storing a message into chain.
+		 *
+		 * Wakes up sleeping consumers and select operations if any.
+		 */
+		void
+		complete_store_message_to_queue(
+			typename Tracing_Base::deliver_op_tracer & tracer )
+			{
+				tracer.stored( m_queue );
+
+				// Size of the queue is approximate, so the notificator
+				// can be called more than once for one empty-to-not-empty
+				// transition if there are several producers.
+				if( m_not_empty_notificator && 1u == m_queue.size() )
+					so_5::details::invoke_noexcept_code(
+						[this] { m_not_empty_notificator(); } );
+
+				// The fence is paired with the fence in
+				// wait_for_not_empty_queue() or in add_select_case().
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_sleeping_consumers.load( std::memory_order_relaxed ) ||
+						m_has_select_cases.load( std::memory_order_relaxed ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+
+						notify_multi_chain_select_ops();
+
+						m_underflow_cond.notify_one();
+					}
+			}
+
+		//! Wait until chain becomes not empty or closed.
+		/*!
+		 * Spins first, then yields and only then parks the current thread.
+		 * Counts of spin and yield iterations are taken from
+		 * chain's consumer_waiting_params_t.
+		 */
+		void
+		wait_for_not_empty_queue( duration_t timeout )
+			{
+				const auto ready = [this] {
+						return !m_queue.is_empty() || is_closed();
+					};
+
+				if( m_consumer_waiting.enabled() )
+					{
+						if( m_consumer_waiting.wait_actively( ready ) )
+							return;
+					}
+				else
+					m_consumer_waiting.on_blocked();
+
+				if( duration_t::zero() == timeout )
+					return;
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				m_sleeping_consumers.fetch_add( 1u, std::memory_order_relaxed );
+				auto decrement = so_5::details::at_scope_exit( [this] {
+						m_sleeping_consumers.fetch_sub( 1u, std::memory_order_relaxed );
+					} );
+
+				// The fence is paired with the fence in
+				// complete_store_message_to_queue().
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				::so_5::details::wait_for_big_interval(
+						lock,
+						m_underflow_cond,
+						timeout,
+						ready );
+			}
+
+		//! Wait for free space in the chain and try to push a message.
+		/*!
+		 * The waiting time is limited by chain's overflow timeout.
+		 */
+		[[nodiscard]]
+		push_status_t
+		wait_and_push( demand_t & demand )
+			{
+				const auto ready = [this] {
+						return !m_queue.is_full() || is_closed();
+					};
+
+				so_5::details::remaining_time_counter_t remaining_time{
+						m_capacity.overflow_timeout() };
+				while( remaining_time )
+					{
+						if( !spin_until( ready ) )
+							{
+								std::unique_lock< std::mutex > lock{ m_lock };
+
+								m_sleeping_producers.fetch_add(
+										1u, std::memory_order_relaxed );
+								auto decrement = so_5::details::at_scope_exit( [this] {
+										m_sleeping_producers.fetch_sub(
+												1u, std::memory_order_relaxed );
+									} );
+
+								// The fence is paired with the fence in try_extract().
+								std::atomic_thread_fence( std::memory_order_seq_cst );
+
+								::so_5::details::wait_for_big_interval(
+										lock,
+										m_overflow_cond,
+										remaining_time.remaining(),
+										ready );
+							}
+
+						if( is_closed() )
+							return push_status_t::chain_closed;
+
+						if( m_queue.try_push( demand ) )
+							return push_status_t::stored;
+
+						remaining_time.update();
+					}
+
+				return push_status_t::not_stored;
+			}
+
+		//! Spin until \a predicate returns true.
+		/*!
+		 * \return false if predicate is still false after spinning.
+		 */
+		template< typename Predicate >
+		[[nodiscard]]
+		static bool
+		spin_until( Predicate && predicate )
+			{
+				pause_backoff_t backoff;
+				for( std::size_t i = 0u;
+						i != lock_free_details::spin_iterations; ++i )
+					{
+						if( predicate() )
+							return true;
+						backoff();
+					}
+
+				for( std::size_t i = 0u;
+						i != lock_free_details::yield_iterations; ++i )
+					{
+						if( predicate() )
+							return true;
+						std::this_thread::yield();
+					}
+
+				return predicate();
+			}
+
+		//! Reaction to full chain.
+		void
+		handle_overflow(
+			message_delivery_mode_t delivery_mode,
+			typename Tracing_Base::deliver_op_tracer & tracer,
+			demand_t & demand )
+			{
+				const auto reaction = m_capacity.overflow_reaction();
+				if( overflow_reaction_t::drop_newest == reaction ||
+						// There can't be an exception on timer thread.
+						( overflow_reaction_t::throw_exception == reaction &&
+							message_delivery_mode_t::nonblocking == delivery_mode ) )
+					{
+						// New message must be simply ignored.
+						tracer.overflow_drop_newest();
+					}
+				else if( overflow_reaction_t::remove_oldest == reaction )
+					{
+						// The oldest messages must be removed until there
+						// will be a place for the new one.
+						while( !is_closed() )
+							{
+								demand_t oldest;
+								if( m_queue.try_pop( oldest ) )
+									tracer.overflow_remove_oldest( oldest );
+
+								if( m_queue.try_push( demand ) )
+									{
+										complete_store_message_to_queue( tracer );
+										break;
+									}
+							}
+					}
+				else if( overflow_reaction_t::throw_exception == reaction )
+					{
+						tracer.overflow_throw_exception();
+						SO_5_THROW_EXCEPTION(
+								rc_msg_chain_overflow,
+								"an attempt to push message to full mchain "
+								"with overflow_reaction_t::throw_exception policy" );
+					}
+				else
+					{
+						so_5::details::abort_on_fatal_error( [&] {
+								tracer.overflow_throw_exception();
+								SO_5_LOG_ERROR( m_env, log_stream ) {
+									log_stream << "overflow_reaction_t::abort_app "
+											"will be performed for mchain (id="
+											<< m_id << "), msg_type: "
+											<< demand.m_msg_type.name()
+											<< ". Application will be aborted"
+											<< std::endl;
+								}
+							} );
+					}
+			}
+
+		//! Add a select case to the queue of select operations.
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		add_select_case( select_case_t & select_case ) noexcept
+			{
+				select_case.set_next( m_select_tail );
+				m_select_tail = &select_case;
+				m_has_select_cases.store( true, std::memory_order_relaxed );
+
+				// The fence is paired with fences in try_extract() and
+				// in complete_store_message_to_queue().
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+			}
+
+		//! Remove a select case from the queue of select operations.
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		remove_select_case( select_case_t & select_case ) noexcept
+			{
+				select_case_t * c = m_select_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &select_case )
+							{
+								if( prev )
+									prev->set_next( next );
+								else
+									m_select_tail = next;
+
+								break;
+							}
+
+						prev = c;
+						c = next;
+					}
+
+				m_has_select_cases.store(
+						nullptr != m_select_tail, std::memory_order_relaxed );
+			}
+
+		//! Notify all select operations.
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		notify_multi_chain_select_ops() noexcept
+			{
+				if( m_select_tail )
+					{
+						auto old = m_select_tail;
+						m_select_tail = nullptr;
+						m_has_select_cases.store( false, std::memory_order_relaxed );
+						old->notify();
+					}
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
@@ -11,6 +11,9 @@
 #pragma once
 
 #include <so_5/impl/message_sink_for_agent.hpp>
+#include <so_5/impl/nonblocking_delivery_scope.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
 
 namespace so_5
 {
@@ -123,6 +126,11 @@ class message_sink_with_message_limit_t final
 						if( tracer )
 							tracer->push_to_queue( this, owner_pointer() );
 
+						// Some event queues can block a producer.
+						// They have to know about nonblocking delivery.
+						nonblocking_delivery_scope_t delivery_scope{
+								message_delivery_mode_t::nonblocking == delivery_mode };
+
 						agent_t::call_push_event(
 								owner_reference(),
 								std::addressof( m_control_block ),
@@ -133,6 +141,66 @@ class message_sink_with_message_limit_t final
 						exception_guard.commit();
 					}
 			}
+
+		/*!
+		 * Messages that fit into the limit are pushed to the agent's
+		 * queue as one batch. The rest of messages are handled by
+		 * push_event() one by one (the overlimit reaction is
+		 * performed for them if the limit is still reached).
+		 */
+		void
+		push_event_batch(
+			mbox_id_t mbox_id,
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count,
+			unsigned int redirection_deep ) override
+			{
+				std::size_t accepted = 0u;
+				while( accepted != messages_count &&
+						m_control_block.m_limit >= ++(m_control_block.m_count) )
+					++accepted;
+				if( accepted != messages_count )
+					// The last increment wasn't successful.
+					--(m_control_block.m_count);
+
+				if( accepted )
+					{
+						// Counters for accepted messages have to be
+						// decremented if the batch can't be pushed.
+						// NOTE: it's assumed that event queue pushes nothing
+						// in the case of an exception (event queues of all
+						// SObjectizer's dispatchers work that way).
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								// Some event queues can block a producer.
+								// They have to know about nonblocking delivery.
+								nonblocking_delivery_scope_t delivery_scope{
+										message_delivery_mode_t::nonblocking == delivery_mode };
+
+								agent_t::call_push_event_batch(
+										owner_reference(),
+										std::addressof( m_control_block ),
+										mbox_id,
+										msg_type,
+										messages,
+										accepted );
+							},
+							[&] {
+								m_control_block.m_count -= static_cast< unsigned int >( accepted );
+							} );
+					}
+
+				for( std::size_t i = accepted; i != messages_count; ++i )
+					this->push_event(
+							mbox_id,
+							delivery_mode,
+							msg_type,
+							messages[ i ],
+							redirection_deep,
+							nullptr );
+			}
 	};
 
 } /* namespace impl */
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <so_5/impl/message_sink_for_agent.hpp>
+#include <so_5/impl/nonblocking_delivery_scope.hpp>
 
 namespace so_5
 {
@@ -45,7 +46,7 @@ class message_sink_without_message_limit_t final
 		void
 		push_event(
 			mbox_id_t mbox_id,
-			message_delivery_mode_t /*delivery_mode*/,
+			message_delivery_mode_t delivery_mode,
 			const std::type_index & msg_type,
 			const message_ref_t & message,
 			unsigned int /*redirection_deep*/,
@@ -56,6 +57,11 @@ class message_sink_without_message_limit_t final
 				if( tracer )
 					tracer->push_to_queue( this, owner_pointer() );
 
+				// Some event queues can block a producer.
+				// They have to know about nonblocking delivery.
+				nonblocking_delivery_scope_t delivery_scope{
+						message_delivery_mode_t::nonblocking == delivery_mode };
+
 				agent_t::call_push_event(
 						owner_reference(),
 						nullptr /* no message limit */,
@@ -63,6 +69,29 @@ class message_sink_without_message_limit_t final
 						msg_type,
 						message );
 			}
+
+		void
+		push_event_batch(
+			mbox_id_t mbox_id,
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count,
+			unsigned int /*redirection_deep*/ ) override
+			{
+				// Some event queues can block a producer.
+				// They have to know about nonblocking delivery.
+				nonblocking_delivery_scope_t delivery_scope{
+						message_delivery_mode_t::nonblocking == delivery_mode };
+
+				agent_t::call_push_event_batch(
+						owner_reference(),
+						nullptr /* no message limit */,
+						mbox_id,
+						msg_type,
+						messages,
+						messages_count );
+			}
 	};
 
 } /* namespace impl */
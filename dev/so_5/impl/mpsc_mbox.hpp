@@ -278,6 +278,51 @@ class mpsc_mbox_template_t final
 					} );
 			}
 
+		/*!
+		 * \brief Delivery of a batch of messages.
+		 *
+		 * If message delivery tracing is off, the whole batch is passed
+		 * to the owner's sink by one push_event_batch() call, so
+		 * the owner's event queue is locked only once.
+		 *
+		 * \since v.5.8.4
+		 */
+		void
+		do_deliver_message_batch(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count,
+			unsigned int redirection_deep ) override
+			{
+				if constexpr( std::is_same_v<
+						Tracing_Base, msg_tracing_helpers::tracing_disabled_base > )
+					{
+						read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+						const auto it = m_subscriptions.find( msg_type );
+						if( it != m_subscriptions.end() )
+							local_mbox_details::deliver_batch_to_subscriber(
+									it->second,
+									[&]() -> abstract_message_sink_t & {
+										return this->message_sink_to_use( it->second );
+									},
+									this->m_id,
+									delivery_mode,
+									msg_type,
+									messages,
+									messages_count,
+									redirection_deep );
+					}
+				else
+					abstract_message_box_t::do_deliver_message_batch(
+							delivery_mode,
+							msg_type,
+							messages,
+							messages_count,
+							redirection_deep );
+			}
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
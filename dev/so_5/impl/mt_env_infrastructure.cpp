@@ -474,6 +474,8 @@ factory()
 					so_5::internal_timer_helpers::create_appropriate_timer_thread(
 							params.so5_error_logger(),
 							params.so5_giveout_timer_thread_factory() );
+			if( const auto count = params.timer_objects_preallocation(); count )
+				timer->preallocate_timer_objects( count );
 
 			// Now the environment object can be created.
 			auto obj = new impl::mt_env_infrastructure_t(
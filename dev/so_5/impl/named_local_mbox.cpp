@@ -83,6 +83,22 @@ named_local_mbox_t::do_deliver_message(
 			redirection_deep );
 }
 
+void
+named_local_mbox_t::do_deliver_message_batch(
+	message_delivery_mode_t delivery_mode,
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t messages_count,
+	unsigned int redirection_deep )
+{
+	m_mbox->do_deliver_message_batch(
+			delivery_mode,
+			msg_type,
+			messages,
+			messages_count,
+			redirection_deep );
+}
+
 void
 named_local_mbox_t::set_delivery_filter(
 	const std::type_index & msg_type,
@@ -72,6 +72,14 @@ class named_local_mbox_t final
 			const message_ref_t & message,
 			unsigned int redirection_deep ) override;
 
+		void
+		do_deliver_message_batch(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t messages_count,
+			unsigned int redirection_deep ) override;
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
@@ -0,0 +1,90 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Helper for marking the current thread as performing
+ * a nonblocking message delivery.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// nonblocking_delivery_scope_t
+//
+/*!
+ * \brief Helper that marks the current thread as performing a message
+ * delivery with message_delivery_mode_t::nonblocking.
+ *
+ * The delivery mode isn't passed to event queues. But some event queues
+ * can block the producer (for example, event queues of %bounded_one_thread
+ * dispatcher). Such event queues have to check
+ * nonblocking_delivery_scope_t::active() and must not block if it
+ * returns `true` (for example, the timer thread must not be blocked).
+ *
+ * Scopes can be nested, the previous state is restored in the destructor.
+ *
+ * Usage example:
+ * \code
+ * nonblocking_delivery_scope_t scope{
+ * 	message_delivery_mode_t::nonblocking == delivery_mode };
+ * agent_t::call_push_event( ... );
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+class nonblocking_delivery_scope_t
+	{
+		//! The previous state of the flag.
+		const bool m_previous;
+
+		//! Access to thread-local flag.
+		[[nodiscard]]
+		static bool &
+		flag() noexcept
+			{
+				static thread_local bool value = false;
+				return value;
+			}
+
+	public:
+		nonblocking_delivery_scope_t( const nonblocking_delivery_scope_t & ) = delete;
+		nonblocking_delivery_scope_t &
+		operator=( const nonblocking_delivery_scope_t & ) = delete;
+
+		//! Initializing constructor.
+		explicit nonblocking_delivery_scope_t(
+			//! Is the delivery nonblocking?
+			bool nonblocking ) noexcept
+			:	m_previous{ flag() }
+			{
+				if( nonblocking )
+					flag() = true;
+			}
+
+		~nonblocking_delivery_scope_t() noexcept
+			{
+				flag() = m_previous;
+			}
+
+		//! Is there a nonblocking delivery on the current thread?
+		[[nodiscard]]
+		static bool
+		active() noexcept
+			{
+				return flag();
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
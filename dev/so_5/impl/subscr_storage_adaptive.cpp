@@ -79,6 +79,7 @@ class storage_t : public subscription_storage_t
 		find_handler(
 			mbox_id_t mbox_id,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -187,11 +188,13 @@ const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
 	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
 		return m_current_storage->find_handler(
 				mbox_id,
 				msg_type,
+				msg_type_id,
 				current_state );
 	}
 
@@ -0,0 +1,639 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A storage for agent's subscriptions information based on
+ * an open-addressing hash table.
+ *
+ * \since v.5.8.4
+ */
+
+#include <so_5/impl/subscription_storage_iface.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+/*!
+ * \brief A storage for agent's subscriptions information based on
+ * an open-addressing hash table.
+ *
+ * \since v.5.8.4
+ */
+namespace flat_hash_table_based_subscr_storage
+{
+
+/*!
+ * \brief A storage for agent's subscriptions information based on
+ * an open-addressing hash table.
+ *
+ * All subscriptions are stored in one flat table with open addressing
+ * and linear probing. The key (mbox_id, msg_type_id, state) and
+ * event_handler_data_t are stored directly in the slot of the table,
+ * so the search for an event handler doesn't require any additional
+ * memory access except the slots of the table. The max load factor
+ * of the table is 1/2 to keep probe sequences short.
+ *
+ * The same table holds counters of subscriptions for every
+ * (mbox_id, msg_type_id) pair. Such counters use nullptr as the state
+ * in the key. They are necessary for detection of cases when
+ * subscribe_event_handler/unsubscribe_event_handler have to be called
+ * for a mbox.
+ *
+ * Mboxes and message types are stored in a separate vector of records,
+ * because they are necessary only for creation and destruction of
+ * subscriptions.
+ *
+ * This storage is intended for agents with large amount of subscriptions
+ * (hundreds and thousands) for which the speed of event handler search
+ * is important.
+ *
+ * \since v.5.8.4
+ */
+class storage_t : public subscription_storage_t
+	{
+	public :
+		storage_t(
+			std::size_t initial_capacity );
+		~storage_t() override;
+
+		void
+		create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			abstract_message_sink_t & message_sink,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety,
+			event_handler_kind_t handler_kind ) override;
+
+		void
+		drop_subscription(
+			const mbox_t & mbox,
+			const std::type_index & msg_type,
+			const state_t & target_state ) noexcept override;
+
+		void
+		drop_subscription_for_all_states(
+			const mbox_t & mbox,
+			const std::type_index & msg_type ) noexcept override;
+
+		void
+		drop_all_subscriptions() noexcept override;
+
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
+			const state_t & current_state ) const noexcept override;
+
+		void
+		debug_dump( std::ostream & to ) const override;
+
+		void
+		drop_content() noexcept override;
+
+		subscription_storage_common::subscr_info_vector_t
+		query_content() const override;
+
+		void
+		setup_content(
+			subscription_storage_common::subscr_info_vector_t && info ) override;
+
+		std::size_t
+		query_subscriptions_count() const override;
+
+	private :
+		//! Key of an item in the table.
+		struct key_t
+			{
+				mbox_id_t m_mbox_id;
+				message_type_id_t m_msg_type_id;
+				//! nullptr for counters of (mbox_id, msg_type_id) pairs.
+				const state_t * m_state;
+
+				[[nodiscard]] bool
+				operator==( const key_t & o ) const noexcept
+					{
+						return m_mbox_id == o.m_mbox_id &&
+								m_msg_type_id == o.m_msg_type_id &&
+								m_state == o.m_state;
+					}
+			};
+
+		//! One slot of the table.
+		struct slot_t
+			{
+				key_t m_key{ null_mbox_id(), 0u, nullptr };
+
+				//! Index of the record for a subscription or count of
+				//! subscriptions for a (mbox_id, msg_type_id) pair.
+				std::size_t m_value{ 0u };
+
+				//! Event handler.
+				/*!
+				 * Is not used for counters of (mbox_id, msg_type_id) pairs.
+				 */
+				event_handler_data_t m_handler{
+						event_handler_method_t{},
+						not_thread_safe,
+						event_handler_kind_t::final_handler };
+
+				//! Is this slot occupied?
+				bool m_occupied{ false };
+			};
+
+		//! Information about a subscription that isn't needed for
+		//! the search of event handlers.
+		struct record_t
+			{
+				mbox_t m_mbox;
+				std::type_index m_msg_type;
+				message_type_id_t m_msg_type_id;
+				std::reference_wrapper< abstract_message_sink_t > m_message_sink;
+				const state_t * m_state;
+
+				[[nodiscard]] key_t
+				key() const noexcept
+					{
+						return { m_mbox->id(), m_msg_type_id, m_state };
+					}
+
+				[[nodiscard]] key_t
+				pair_key() const noexcept
+					{
+						return { m_mbox->id(), m_msg_type_id, nullptr };
+					}
+			};
+
+		//! Minimal count of slots in the table.
+		static constexpr std::size_t min_capacity = 8u;
+
+		//! Count of slots for the first allocation of the table.
+		const std::size_t m_initial_capacity;
+
+		//! Slots of the table.
+		/*!
+		 * \note
+		 * Count of slots is always zero or a power of two.
+		 */
+		std::vector< slot_t > m_slots;
+
+		//! Count of occupied slots.
+		std::size_t m_used{ 0u };
+
+		//! Records for all subscriptions.
+		std::vector< record_t > m_records;
+
+		[[nodiscard]]
+		static std::size_t
+		hash_of( const key_t & key ) noexcept
+			{
+				std::uint64_t h = key.m_mbox_id * 0x9e3779b97f4a7c15ull;
+				h ^= key.m_msg_type_id + 0x9e3779b9u + (h << 6) + (h >> 2);
+				h ^= (reinterpret_cast< std::uintptr_t >( key.m_state ) >> 3u) *
+						0xff51afd7ed558ccdull;
+				return static_cast< std::size_t >( h ^ (h >> 29u) );
+			}
+
+		[[nodiscard]]
+		std::size_t
+		mask() const noexcept
+			{
+				return m_slots.size() - 1u;
+			}
+
+		//! Find an index of a slot for a key.
+		/*!
+		 * \return index of the occupied slot or index of the first free slot
+		 * that terminates the search.
+		 *
+		 * \attention
+		 * There must be at least one free slot in the table.
+		 */
+		[[nodiscard]]
+		std::size_t
+		find_index( const key_t & key ) const noexcept
+			{
+				std::size_t index = hash_of( key ) & mask();
+				for(;;)
+					{
+						const auto & slot = m_slots[ index ];
+						if( !slot.m_occupied || slot.m_key == key )
+							return index;
+
+						index = (index + 1u) & mask();
+					}
+			}
+
+		//! Find an occupied slot for a key.
+		/*!
+		 * \return nullptr if there is no such key in the table.
+		 */
+		[[nodiscard]]
+		slot_t *
+		find_slot( const key_t & key ) noexcept
+			{
+				if( !m_used )
+					return nullptr;
+
+				auto & slot = m_slots[ find_index( key ) ];
+				return slot.m_occupied ? &slot : nullptr;
+			}
+
+		//! Ensure that there is a place for \a count new items.
+		void
+		reserve_for( std::size_t count );
+
+		//! Put a new item into the table.
+		/*!
+		 * \attention
+		 * There must not be such a key in the table and there must be
+		 * a place for a new item (see reserve_for()).
+		 */
+		slot_t &
+		insert( const key_t & key, std::size_t value ) noexcept;
+
+		//! Remove an item from the table.
+		void
+		erase( slot_t & slot ) noexcept;
+
+		//! Remove the record and the event handler for a subscription.
+		/*!
+		 * The counter for (mbox_id, msg_type_id) pair isn't changed.
+		 */
+		void
+		remove_subscription( std::size_t record_index ) noexcept;
+
+		void
+		destroy_all_subscriptions() noexcept;
+	};
+
+storage_t::storage_t(
+	std::size_t initial_capacity )
+	:	m_initial_capacity{ [initial_capacity]() {
+				std::size_t capacity = min_capacity;
+				// Every subscription can require two slots and
+				// the table has to be at most half full.
+				while( capacity < initial_capacity * 4u )
+					capacity *= 2u;
+				return capacity;
+			}() }
+	{
+		m_records.reserve( initial_capacity );
+	}
+
+storage_t::~storage_t()
+	{
+		destroy_all_subscriptions();
+	}
+
+void
+storage_t::create_event_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	abstract_message_sink_t & message_sink,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety,
+	event_handler_kind_t handler_kind )
+	{
+		using namespace subscription_storage_common;
+
+		const auto msg_type_id = message_type_id( msg_type );
+		const key_t key{ mbox->id(), msg_type_id, std::addressof(target_state) };
+
+		if( find_slot( key ) )
+			SO_5_THROW_EXCEPTION(
+				rc_evt_handler_already_provided,
+				"agent is already subscribed to message, " +
+				make_subscription_description( mbox, msg_type, target_state ) );
+
+		// All actions that can throw have to be performed before
+		// modification of the table.
+		event_handler_data_t handler{ method, thread_safety, handler_kind };
+		reserve_for( 2u );
+		m_records.push_back( record_t{
+				mbox,
+				msg_type,
+				msg_type_id,
+				std::ref(message_sink),
+				std::addressof(target_state) } );
+
+		insert( key, m_records.size() - 1u ).m_handler = std::move(handler);
+
+		const key_t pair_key{ key.m_mbox_id, msg_type_id, nullptr };
+		if( auto * counter = find_slot( pair_key ) )
+			++(counter->m_value);
+		else
+			{
+				insert( pair_key, 1u );
+
+				// Note: since v.5.5.9 mbox subscription is initiated even if
+				// it is MPSC mboxes. It is important for the case of message
+				// delivery tracing.
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						mbox->subscribe_event_handler( msg_type, message_sink );
+					},
+					[&] {
+						erase( *find_slot( pair_key ) );
+						remove_subscription( m_records.size() - 1u );
+					} );
+			}
+	}
+
+void
+storage_t::drop_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const state_t & target_state ) noexcept
+	{
+		const auto msg_type_id = find_message_type_id( msg_type );
+		auto * slot = find_slot(
+				key_t{ mbox->id(), msg_type_id, std::addressof(target_state) } );
+		if( !slot )
+			return;
+
+		// This value may be necessary for unsubscription.
+		abstract_message_sink_t & message_sink =
+				m_records[ slot->m_value ].m_message_sink.get();
+
+		remove_subscription( slot->m_value );
+
+		auto * counter = find_slot( key_t{ mbox->id(), msg_type_id, nullptr } );
+		if( 0u == --(counter->m_value) )
+			{
+				erase( *counter );
+
+				// Note v.5.5.9 unsubscribe_event_handler is called for
+				// mbox even if it is MPSC mbox. It is necessary for the case
+				// of message delivery tracing.
+				mbox->unsubscribe_event_handler( msg_type, message_sink );
+			}
+	}
+
+void
+storage_t::drop_subscription_for_all_states(
+	const mbox_t & mbox,
+	const std::type_index & msg_type ) noexcept
+	{
+		const key_t pair_key{
+				mbox->id(), find_message_type_id( msg_type ), nullptr };
+		auto * counter = find_slot( pair_key );
+		if( !counter )
+			return;
+
+		erase( *counter );
+
+		// Records are scanned from the end because remove_subscription
+		// moves the last record to the place of the removed one.
+		abstract_message_sink_t * message_sink = nullptr;
+		for( std::size_t i = m_records.size(); i != 0u; --i )
+			{
+				const auto & record = m_records[ i - 1u ];
+				if( record.pair_key() == pair_key )
+					{
+						message_sink = std::addressof( record.m_message_sink.get() );
+						remove_subscription( i - 1u );
+					}
+			}
+
+		// Note: since v.5.5.9 mbox unsubscription is initiated even if
+		// it is MPSC mboxes. It is important for the case of message
+		// delivery tracing.
+		mbox->unsubscribe_event_handler( msg_type, *message_sink );
+	}
+
+void
+storage_t::drop_all_subscriptions() noexcept
+	{
+		destroy_all_subscriptions();
+	}
+
+const event_handler_data_t *
+storage_t::find_handler(
+	mbox_id_t mbox_id,
+	const std::type_index & /*msg_type*/,
+	message_type_id_t msg_type_id,
+	const state_t & current_state ) const noexcept
+	{
+		if( !m_used )
+			return nullptr;
+
+		const auto & slot = m_slots[ find_index( key_t{
+				mbox_id,
+				msg_type_id,
+				std::addressof(current_state) } ) ];
+
+		return slot.m_occupied ? std::addressof(slot.m_handler) : nullptr;
+	}
+
+void
+storage_t::debug_dump( std::ostream & to ) const
+	{
+		for( const auto & r : m_records )
+			to << "{" << r.m_mbox->id() << ", "
+					<< r.m_msg_type.name() << ", "
+					<< r.m_state->query_name() << "}"
+					<< std::endl;
+	}
+
+void
+storage_t::drop_content() noexcept
+	{
+		m_slots.clear();
+		m_used = 0u;
+		m_records.clear();
+	}
+
+subscription_storage_common::subscr_info_vector_t
+storage_t::query_content() const
+	{
+		using namespace subscription_storage_common;
+
+		subscr_info_vector_t result;
+		result.reserve( m_records.size() );
+
+		for( const auto & r : m_records )
+			{
+				const auto & handler = m_slots[ find_index( r.key() ) ].m_handler;
+				result.emplace_back(
+						r.m_mbox,
+						r.m_msg_type,
+						r.m_message_sink.get(),
+						*(r.m_state),
+						handler.m_method,
+						handler.m_thread_safety,
+						handler.m_kind );
+			}
+
+		return result;
+	}
+
+void
+storage_t::setup_content(
+	subscription_storage_common::subscr_info_vector_t && info )
+	{
+		drop_content();
+
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				reserve_for( info.size() * 2u );
+				m_records.reserve( info.size() );
+
+				for( auto & i : info )
+					{
+						m_records.push_back( record_t{
+								i.m_mbox,
+								i.m_msg_type,
+								i.m_msg_type_id,
+								i.m_message_sink,
+								i.m_state } );
+
+						insert( m_records.back().key(), m_records.size() - 1u )
+								.m_handler = std::move(i.m_handler);
+
+						const auto pair_key = m_records.back().pair_key();
+						if( auto * counter = find_slot( pair_key ) )
+							++(counter->m_value);
+						else
+							insert( pair_key, 1u );
+					}
+			},
+			[&] { drop_content(); } );
+	}
+
+std::size_t
+storage_t::query_subscriptions_count() const
+	{
+		return m_records.size();
+	}
+
+void
+storage_t::reserve_for( std::size_t count )
+	{
+		// Max load factor is 1/2.
+		if( (m_used + count) * 2u <= m_slots.size() )
+			return;
+
+		std::size_t new_capacity = m_slots.empty() ?
+				m_initial_capacity : m_slots.size() * 2u;
+		while( (m_used + count) * 2u > new_capacity )
+			new_capacity *= 2u;
+
+		std::vector< slot_t > new_slots( new_capacity );
+
+		// There won't be exceptions below.
+		swap( m_slots, new_slots );
+		for( auto & old : new_slots )
+			if( old.m_occupied )
+				m_slots[ find_index( old.m_key ) ] = std::move(old);
+	}
+
+storage_t::slot_t &
+storage_t::insert( const key_t & key, std::size_t value ) noexcept
+	{
+		auto & slot = m_slots[ find_index( key ) ];
+		slot.m_key = key;
+		slot.m_value = value;
+		slot.m_occupied = true;
+
+		++m_used;
+
+		return slot;
+	}
+
+void
+storage_t::erase( slot_t & slot ) noexcept
+	{
+		std::size_t hole = static_cast< std::size_t >(
+				std::addressof(slot) - m_slots.data() );
+
+		// Items that can't be found after the removal of this item
+		// have to be moved to the hole.
+		for( std::size_t index = (hole + 1u) & mask();
+				m_slots[ index ].m_occupied;
+				index = (index + 1u) & mask() )
+			{
+				const std::size_t home = hash_of( m_slots[ index ].m_key ) & mask();
+				// Distances from the home slot of the item to the hole
+				// and to the current position of the item.
+				const std::size_t to_hole = (hole - home) & mask();
+				const std::size_t to_index = (index - home) & mask();
+				if( to_hole < to_index )
+					{
+						m_slots[ hole ] = std::move( m_slots[ index ] );
+						hole = index;
+					}
+			}
+
+		auto & freed = m_slots[ hole ];
+		freed.m_occupied = false;
+		freed.m_handler.m_method = event_handler_method_t{};
+
+		--m_used;
+	}
+
+void
+storage_t::remove_subscription( std::size_t record_index ) noexcept
+	{
+		erase( *find_slot( m_records[ record_index ].key() ) );
+
+		const std::size_t last_index = m_records.size() - 1u;
+		if( record_index != last_index )
+			{
+				// The last record is moved to the place of the removed one.
+				// The slot for the moved record has to be updated.
+				m_records[ record_index ] = std::move( m_records[ last_index ] );
+				find_slot( m_records[ record_index ].key() )->m_value = record_index;
+			}
+
+		m_records.pop_back();
+	}
+
+void
+storage_t::destroy_all_subscriptions() noexcept
+	{
+		// Every (mbox, msg_type) pair has to be unsubscribed only once.
+		// A counter for the pair is removed at the first occurence of
+		// the pair, so the next occurences will be skipped.
+		for( const auto & r : m_records )
+			if( auto * counter = find_slot( r.pair_key() ) )
+				{
+					erase( *counter );
+					r.m_mbox->unsubscribe_event_handler(
+							r.m_msg_type,
+							r.m_message_sink.get() );
+				}
+
+		drop_content();
+	}
+
+} /* namespace flat_hash_table_based_subscr_storage */
+
+} /* namespace impl */
+
+SO_5_FUNC subscription_storage_factory_t
+flat_hash_table_based_subscription_storage_factory(
+	std::size_t initial_capacity )
+	{
+		return [initial_capacity]() {
+			return impl::subscription_storage_unique_ptr_t(
+					new impl::flat_hash_table_based_subscr_storage::storage_t(
+							initial_capacity ) );
+		};
+	}
+
+} /* namespace so_5 */
@@ -80,6 +80,7 @@ class storage_t : public subscription_storage_t
 		find_handler(
 			mbox_id_t mbox_id,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -112,13 +113,13 @@ class storage_t : public subscription_storage_t
 		struct is_same_mbox_msg_t
 			{
 				const mbox_id_t m_id;
-				const std::type_index & m_type;
+				const message_type_id_t m_type_id;
 
 				[[nodiscard]] bool
 				operator()( const info_t & info ) const noexcept
 					{
 						return m_id == info.m_mbox->id() &&
-								m_type == info.m_msg_type;
+								m_type_id == info.m_msg_type_id;
 					}
 			};
 
@@ -128,11 +129,15 @@ class storage_t : public subscription_storage_t
 		 * For fast search in a vector of subscriptions we have to deal with
 		 * only a few of key fields of subscr_info_t. This helper type allows to
 		 * agregate all those fields in a (rather) small object.
+		 *
+		 * @note
+		 * Since v.5.8.4 message types are compared by their dense
+		 * identifiers instead of std::type_index.
 		 */
 		struct key_info_t
 			{
 				mbox_id_t m_mbox_id;
-				const std::type_index & m_msg_type;
+				message_type_id_t m_msg_type_id;
 				const state_t * m_state;
 			};
 
@@ -153,9 +158,9 @@ class storage_t : public subscription_storage_t
 							return true;
 						else if( a.m_mbox_id == b.m_mbox_id )
 							{
-								if( a.m_msg_type < b.m_msg_type )
+								if( a.m_msg_type_id < b.m_msg_type_id )
 									return true;
-								else if( a.m_msg_type == b.m_msg_type )
+								else if( a.m_msg_type_id == b.m_msg_type_id )
 									{
 										// NOTE: it's UB to compare two arbitrary pointers.
 										using ptr_comparator_t = std::less< const state_t * >;
@@ -170,7 +175,7 @@ class storage_t : public subscription_storage_t
 				operator()( const info_t & a, const key_info_t & b ) const noexcept
 					{
 						return (*this)(
-								key_info_t{ a.m_mbox->id(), a.m_msg_type, a.m_state },
+								key_info_t{ a.m_mbox->id(), a.m_msg_type_id, a.m_state },
 								b );
 					}
 
@@ -178,8 +183,8 @@ class storage_t : public subscription_storage_t
 				operator()( const info_t & a, const info_t & b ) const noexcept
 					{
 						return (*this)(
-								key_info_t{ a.m_mbox->id(), a.m_msg_type, a.m_state },
-								key_info_t{ b.m_mbox->id(), b.m_msg_type, b.m_state } );
+								key_info_t{ a.m_mbox->id(), a.m_msg_type_id, a.m_state },
+								key_info_t{ b.m_mbox->id(), b.m_msg_type_id, b.m_state } );
 					}
 			};
 
@@ -224,7 +229,7 @@ is_equal(
 	const subscription_storage_common::subscr_info_t & b ) noexcept
 {
 	return a.m_mbox->id() == b.m_mbox->id()
-			&& a.m_msg_type == b.m_msg_type
+			&& a.m_msg_type_id == b.m_msg_type_id
 			&& a.m_state == b.m_state
 			;
 }
@@ -239,11 +244,11 @@ is_equal(
 is_equal(
 	const subscription_storage_common::subscr_info_t & a,
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t * target_state ) noexcept
 {
 	return a.m_mbox->id() == mbox_id
-			&& a.m_msg_type == msg_type
+			&& a.m_msg_type_id == msg_type_id
 			&& a.m_state == target_state
 			;
 }
@@ -305,7 +310,7 @@ storage_t::create_event_subscription(
 		const bool info_for_mbox_msg_type_exists =
 				check_presence_of_mbox_msg_type_info_around_it(
 						it,
-						is_same_mbox_msg_t{ mbox->id(), msg_type } );
+						is_same_mbox_msg_t{ mbox->id(), it->m_msg_type_id } );
 
 		// Note: since v.5.5.9 mbox subscription is initiated even if
 		// it is MPSC mboxes. It is important for the case of message
@@ -334,13 +339,15 @@ storage_t::drop_subscription(
 	{
 		using namespace std;
 
+		const auto msg_type_id = find_message_type_id( msg_type );
+
 		auto existed_position = std::lower_bound(
 				m_events.begin(), m_events.end(),
-				key_info_t{ mbox->id(), msg_type, std::addressof(target_state) },
+				key_info_t{ mbox->id(), msg_type_id, std::addressof(target_state) },
 				key_info_comparator_t{} );
 		if( existed_position != m_events.end()
 				&& is_equal( *existed_position,
-						mbox->id(), msg_type, std::addressof(target_state) ) )
+						mbox->id(), msg_type_id, std::addressof(target_state) ) )
 			{
 				// This value may be necessary for unsubscription.
 				abstract_message_sink_t & message_sink =
@@ -352,7 +359,7 @@ storage_t::drop_subscription(
 				const bool info_for_mbox_msg_type_exists =
 						check_presence_of_mbox_msg_type_info_around_it(
 								existed_position,
-								is_same_mbox_msg_t{ mbox->id(), msg_type } );
+								is_same_mbox_msg_t{ mbox->id(), msg_type_id } );
 
 				// Item is no more needed.
 				m_events.erase( existed_position );
@@ -380,10 +387,12 @@ storage_t::drop_subscription_for_all_states(
 	{
 		using namespace std;
 
-		const auto predicate = is_same_mbox_msg_t{ mbox->id(), msg_type };
+		const auto msg_type_id = find_message_type_id( msg_type );
+
+		const auto predicate = is_same_mbox_msg_t{ mbox->id(), msg_type_id };
 		if( auto it = std::lower_bound( m_events.begin(), m_events.end(),
 					// NOTE: use NULL instead of actual pointer to a state.
-					key_info_t{ mbox->id(), msg_type, nullptr },
+					key_info_t{ mbox->id(), msg_type_id, nullptr },
 					key_info_comparator_t{} );
 				it != m_events.end() && predicate( *it ) )
 			{
@@ -413,16 +422,17 @@ storage_t::drop_all_subscriptions() noexcept
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	const std::type_index & /*msg_type*/,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
 		auto existed_position = std::lower_bound(
 				m_events.begin(), m_events.end(),
-				key_info_t{ mbox_id, msg_type, std::addressof(current_state) },
+				key_info_t{ mbox_id, msg_type_id, std::addressof(current_state) },
 				key_info_comparator_t{} );
 		if( existed_position != m_events.end()
 				&& is_equal( *existed_position,
-						mbox_id, msg_type, std::addressof(current_state) ) )
+						mbox_id, msg_type_id, std::addressof(current_state) ) )
 		{
 			return std::addressof(existed_position->m_handler);
 		}
@@ -463,7 +473,7 @@ storage_t::destroy_all_subscriptions() noexcept
 					{
 						const auto & next_info = m_events[ i+j ];
 						if( current_info.m_mbox->id() != next_info.m_mbox->id() ||
-								current_info.m_msg_type != next_info.m_msg_type )
+								current_info.m_msg_type_id != next_info.m_msg_type_id )
 							break;
 					}
 
@@ -41,6 +41,13 @@ struct key_t
 	mbox_id_t m_mbox_id;
 	//! Message type.
 	std::type_index m_msg_type;
+	//! Dense identifier of the message type.
+	/*!
+	 * It's used for comparison and hashing instead of m_msg_type.
+	 *
+	 * \since v.5.8.4
+	 */
+	message_type_id_t m_msg_type_id;
 	//! State of agent.
 	const state_t * m_state;
 
@@ -48,6 +55,7 @@ struct key_t
 	inline key_t()
 		:	m_mbox_id( null_mbox_id() )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_message_type_id() )
 		,	m_state( nullptr )
 		{}
 
@@ -55,9 +63,11 @@ struct key_t
 	//! find all keys with (mbox_id, msg_type) prefix.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type )
+		std::type_index msg_type,
+		message_type_id_t msg_type_id )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( nullptr )
 		{}
 
@@ -65,9 +75,11 @@ struct key_t
 	inline key_t(
 		mbox_id_t mbox_id,
 		std::type_index msg_type,
+		message_type_id_t msg_type_id,
 		const state_t & state )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( &state )
 		{}
 
@@ -78,9 +90,9 @@ struct key_t
 				return true;
 			else if( m_mbox_id == o.m_mbox_id )
 				{
-					if( m_msg_type < o.m_msg_type )
+					if( m_msg_type_id < o.m_msg_type_id )
 						return true;
-					else if( m_msg_type == o.m_msg_type )
+					else if( m_msg_type_id == o.m_msg_type_id )
 						return m_state < o.m_state;
 				}
 
@@ -91,7 +103,7 @@ struct key_t
 	operator==( const key_t & o ) const noexcept
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type &&
+					m_msg_type_id == o.m_msg_type_id &&
 					m_state == o.m_state;
 		}
 
@@ -99,7 +111,7 @@ struct key_t
 	is_same_mbox_msg_pair( const key_t & o ) const noexcept
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type;
+					m_msg_type_id == o.m_msg_type_id;
 		}
 };
 
@@ -125,7 +137,7 @@ struct hash_t
 				const auto h1 =
 					std::hash< so_5::mbox_id_t >()( ptr->m_mbox_id );
 				const auto h2 = h1 ^
-					(std::hash< std::type_index >()( ptr->m_msg_type ) +
+					(std::hash< message_type_id_t >()( ptr->m_msg_type_id ) +
 					 	0x9e3779b9 + (h1 << 6) + (h1 >> 2));
 
 				return h2 ^ (std::hash< const state_t * >()(
@@ -238,6 +250,7 @@ class storage_t : public subscription_storage_t
 		find_handler(
 			mbox_id_t mbox_id,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -310,7 +323,11 @@ storage_t::create_event_subscription(
 	{
 		using namespace subscription_storage_common;
 
-		key_t key{ mbox->id(), type_index, target_state };
+		key_t key{
+				mbox->id(),
+				type_index,
+				message_type_id( type_index ),
+				target_state };
 
 		auto insertion_result = m_map.emplace(
 				key,
@@ -352,7 +369,11 @@ storage_t::drop_subscription(
 	const std::type_index & type_index,
 	const state_t & target_state ) noexcept
 	{
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key(
+				mbox_ref->id(),
+				type_index,
+				find_message_type_id( type_index ),
+				target_state );
 
 		auto it = m_map.find( key );
 
@@ -379,7 +400,8 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox_ref,
 	const std::type_index & type_index ) noexcept
 	{
-		const key_t key( mbox_ref->id(), type_index );
+		const key_t key(
+				mbox_ref->id(), type_index, find_message_type_id( type_index ) );
 
 		auto it = m_map.lower_bound( key );
 		auto need_erase = [&] {
@@ -415,9 +437,10 @@ const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
 	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
-		key_t k( mbox_id, msg_type, current_state );
+		key_t k( mbox_id, msg_type, msg_type_id, current_state );
 		auto it = m_hash_table.find( &k );
 		if( it != m_hash_table.end() )
 			return &(it->second);
@@ -514,7 +537,8 @@ storage_t::setup_content(
 		for_each( begin(info), end(info),
 			[&]( const subscr_info_t & i )
 			{
-				key_t k{ i.m_mbox->id(), i.m_msg_type, *(i.m_state) };
+				key_t k{
+						i.m_mbox->id(), i.m_msg_type, i.m_msg_type_id, *(i.m_state) };
 
 				auto ins_result = fresh_map.emplace(
 						k,
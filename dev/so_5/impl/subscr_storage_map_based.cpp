@@ -76,6 +76,7 @@ class storage_t : public subscription_storage_t
 		find_handler(
 			mbox_id_t mbox_id,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -359,6 +360,7 @@ const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
 	const std::type_index & msg_type,
+	message_type_id_t /*msg_type_id*/,
 	const state_t & current_state ) const noexcept
 	{
 		auto it = find( m_events, mbox_id, msg_type, current_state );
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <so_5/types.hpp>
+#include <so_5/message_type_id.hpp>
 
 #include <so_5/mbox.hpp>
 #include <so_5/state.hpp>
@@ -87,6 +88,13 @@ struct subscr_info_t
 		 */
 		mbox_t m_mbox;
 		std::type_index m_msg_type;
+		//! Dense identifier of the message type.
+		/*!
+		 * It's used for comparison of message types instead of m_msg_type.
+		 *
+		 * \since v.5.8.4
+		 */
+		message_type_id_t m_msg_type_id;
 		//! Message sink used for subscription.
 		std::reference_wrapper< abstract_message_sink_t > m_message_sink;
 		const state_t * m_state;
@@ -102,6 +110,7 @@ struct subscr_info_t
 			event_handler_kind_t handler_kind )
 			:	m_mbox( std::move( mbox ) )
 			,	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( message_type_id( m_msg_type ) )
 			,	m_message_sink( message_sink )
 			,	m_state( &state )
 			,	m_handler( method, thread_safety, handler_kind )
@@ -197,10 +206,18 @@ class subscription_storage_t
 		virtual void
 		drop_all_subscriptions() noexcept = 0;
 
+		/*!
+		 * \note
+		 * Since v.5.8.4 the dense identifier of the message type is
+		 * passed too. It can be null_message_type_id() if the message
+		 * type has no identifier (there can't be subscriptions for
+		 * such a type).
+		 */
 		virtual const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept = 0;
 
 		virtual void
@@ -15,6 +15,22 @@ namespace so_5
 // abstract_message_box_t
 //
 
+void
+abstract_message_box_t::do_deliver_message_batch(
+	message_delivery_mode_t delivery_mode,
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t messages_count,
+	unsigned int redirection_deep )
+	{
+		for( std::size_t i = 0; i != messages_count; ++i )
+			this->do_deliver_message(
+					delivery_mode,
+					msg_type,
+					messages[ i ],
+					redirection_deep );
+	}
+
 //
 // wrap_to_msink
 //
@@ -280,6 +280,35 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int redirection_deep ) = 0;
 
+		/*!
+		 * \brief Deliver a batch of messages of the same type for all
+		 * subscribers with respect to message limits.
+		 *
+		 * The default implementation simply calls do_deliver_message()
+		 * for every message from the batch. A derived class can provide
+		 * a more efficient implementation (for example, find subscribers
+		 * just once for the whole batch).
+		 *
+		 * \note
+		 * The order of messages is preserved for every subscriber.
+		 * But there is no guarantee about the order of deliveries
+		 * between different subscribers.
+		 *
+		 * \since v.5.8.4
+		 */
+		virtual void
+		do_deliver_message_batch(
+			//! Can the delivery blocks the current thread?
+			message_delivery_mode_t delivery_mode,
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Pointer to the first message in the batch.
+			const message_ref_t * messages,
+			//! Count of messages in the batch.
+			std::size_t messages_count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int redirection_deep );
+
 		/*!
 		 * \name Methods for working with delivery filters.
 		 * \{
@@ -427,6 +456,37 @@ deliver_message(
 				1u );
 	}
 
+//! Deliver a batch of messages of the same type.
+/*!
+ * \note
+ * This function is a part of low-level SObjectizer's interface.
+ * Because of that this function can be removed or changed in some
+ * future version without prior notice.
+ *
+ * \since v.5.8.4
+ */
+inline void
+deliver_message_batch(
+	//! Can the delivery blocks the current thread?
+	message_delivery_mode_t delivery_mode,
+	//! Destination for messages.
+	abstract_message_box_t & target,
+	//! Subscription type for messages.
+	const std::type_index & subscription_type,
+	//! Pointer to the first message in the batch.
+	const message_ref_t * messages,
+	//! Count of messages in the batch.
+	std::size_t messages_count )
+	{
+		if( messages_count )
+			target.do_deliver_message_batch(
+					delivery_mode,
+					subscription_type,
+					messages,
+					messages_count,
+					1u );
+	}
+
 //! Deliver signal.
 /*!
  * \attention
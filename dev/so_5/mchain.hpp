@@ -20,8 +20,12 @@
 #include <so_5/details/invoke_noexcept_code.hpp>
 #include <so_5/details/remaining_time_counter.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <optional>
+#include <vector>
 
 namespace so_5 {
 
@@ -444,6 +448,66 @@ enum class close_mode_t
  */
 using not_empty_notification_func_t = std::function< void() >;
 
+//
+// consumer_waiting_params_t
+//
+/*!
+ * \brief Parameters of waiting for a message on empty chain.
+ *
+ * A consumer that has to wait on empty chain can spin for some time and
+ * then call std::this_thread::yield() several times before going to
+ * sleep on a condition variable. It allows to avoid expensive sleeps
+ * and wakeups in ping-pong-like scenarios where the next message
+ * arrives very quickly.
+ *
+ * The actual count of spin iterations is adjusted at run-time: it grows
+ * (up to \a spin_count) if the waiting completes during spinning or
+ * yielding, and it decreases if the consumer has to go to sleep.
+ *
+ * Zero values for both counts mean that a consumer will be
+ * sent to sleep immediately. It is the default behaviour.
+ *
+ * \since v.5.8.4
+ */
+struct consumer_waiting_params_t
+	{
+		//! Max count of spin iterations before yielding.
+		std::size_t m_spin_count{ 0u };
+		//! Count of std::this_thread::yield() calls before sleeping.
+		std::size_t m_yield_count{ 0u };
+
+		consumer_waiting_params_t() noexcept = default;
+
+		consumer_waiting_params_t(
+			std::size_t spin_count,
+			std::size_t yield_count ) noexcept
+			:	m_spin_count{ spin_count }
+			,	m_yield_count{ yield_count }
+			{}
+	};
+
+//
+// consumer_waiting_stats_t
+//
+/*!
+ * \brief Statistics of waiting for messages on empty chain.
+ *
+ * Only waitings that were started on empty chain are counted.
+ * An extraction from not empty chain or an extraction with
+ * no_wait_on_empty() doesn't change these values.
+ *
+ * \since v.5.8.4
+ */
+struct consumer_waiting_stats_t
+	{
+		//! Count of waitings completed during spinning.
+		std::uint64_t m_completed_by_spinning{ 0u };
+		//! Count of waitings completed during yielding.
+		std::uint64_t m_completed_by_yielding{ 0u };
+		//! Count of waitings where the consumer had to sleep.
+		std::uint64_t m_blocked{ 0u };
+	};
+
 //
 // Forward declarations related to multi chain select operations.
 //
@@ -485,6 +549,44 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Max time to wait on empty queue.
 			mchain_props::duration_t empty_queue_timeout ) = 0;
 
+		/*!
+		 * \brief Extraction of several messages by one operation.
+		 *
+		 * Waits for at least one message (like ordinary extract()) and then
+		 * moves up to \a dest_capacity messages from the chain to \a dest.
+		 * The chain is locked only once for the whole batch.
+		 *
+		 * The default implementation just calls extract() for one
+		 * message.
+		 *
+		 * \note
+		 * \a extracted is set to the count of extracted messages. It can
+		 * be greater than zero only if msg_extracted is returned.
+		 *
+		 * \pre \a dest_capacity is greater than 0.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		virtual mchain_props::extraction_status_t
+		extract_bulk(
+			//! Destination for extracted messages.
+			mchain_props::demand_t * dest,
+			//! Max count of messages to be extracted.
+			std::size_t dest_capacity,
+			//! Count of extracted messages.
+			std::size_t & extracted,
+			//! Max time to wait on empty queue.
+			mchain_props::duration_t empty_queue_timeout )
+			{
+				(void)dest_capacity;
+
+				const auto status = this->extract( *dest, empty_queue_timeout );
+				extracted = mchain_props::extraction_status_t::msg_extracted ==
+						status ? 1u : 0u;
+				return status;
+			}
+
 		//! Cast message chain to message box.
 		[[nodiscard]]
 		so_5::mbox_t
@@ -500,6 +602,19 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 		virtual std::size_t
 		size() const = 0;
 
+		//! Get the statistics of waiting on empty chain.
+		/*!
+		 * The default implementation returns zeros.
+		 *
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		virtual mchain_props::consumer_waiting_stats_t
+		query_consumer_waiting_stats() const
+			{
+				return {};
+			}
+
 		//! Close the chain.
 		/*!
 		 * Since v.5.7.3 this is the recommended way of closing a mchain.
@@ -762,6 +877,19 @@ class mchain_params_t
 		//! Is message delivery tracing disabled explicitly?
 		bool m_msg_tracing_disabled = { false };
 
+		//! Should lock-free queue be used?
+		/*!
+		 * \since v.5.8.4
+		 */
+		bool m_lock_free_queue_enabled = { false };
+
+		//! Parameters of waiting on empty chain.
+		/*!
+		 * \since v.5.8.4
+		 */
+		std::optional< mchain_props::consumer_waiting_params_t >
+				m_consumer_waiting;
+
 	public :
 		//! Initializing constructor.
 		mchain_params_t(
@@ -824,6 +952,85 @@ class mchain_params_t
 			{
 				return m_msg_tracing_disabled;
 			}
+
+		//! Use lock-free ring buffer for chain's queue.
+		/*!
+		 * A chain with lock-free queue doesn't acquire a mutex during
+		 * ordinary send and receive operations. A thread that waits on
+		 * empty (or full) chain spins for some time and only then is
+		 * parked on a condition variable. It is intended for pipelines
+		 * where a producer and a consumer work on dedicated threads.
+		 *
+		 * Such a chain must be size-limited. The storage for the chain is
+		 * always preallocated regardless of the memory_usage_t value.
+		 *
+		 * Usage example:
+		 * \code
+		 * auto ch = env.create_mchain(
+		 * 		so_5::make_limited_with_waiting_mchain_params(
+		 * 				1024,
+		 * 				so_5::mchain_props::memory_usage_t::preallocated,
+		 * 				so_5::mchain_props::overflow_reaction_t::throw_exception,
+		 * 				std::chrono::seconds(1) )
+		 * 			.enable_lock_free_queue() );
+		 * \endcode
+		 *
+		 * \note
+		 * Messages sent concurrently with close() can still be stored
+		 * into the chain, even if close_mode_t::drop_content is used.
+		 *
+		 * \since v.5.8.4
+		 */
+		mchain_params_t &
+		enable_lock_free_queue()
+			{
+				m_lock_free_queue_enabled = true;
+				return *this;
+			}
+
+		//! Should lock-free queue be used?
+		/*!
+		 * \since v.5.8.4
+		 */
+		bool
+		lock_free_queue_enabled() const
+			{
+				return m_lock_free_queue_enabled;
+			}
+
+		//! Set parameters of waiting on empty chain.
+		/*!
+		 * Usage example:
+		 * \code
+		 * auto ch = env.create_mchain(
+		 * 		so_5::make_unlimited_mchain_params()
+		 * 			.consumer_waiting(
+		 * 				so_5::mchain_props::consumer_waiting_params_t{ 1000, 16 } ) );
+		 * \endcode
+		 *
+		 * \note
+		 * If these parameters aren't set then an ordinary chain sends
+		 * a consumer to sleep immediately, and a chain with lock-free
+		 * queue uses its own default values.
+		 *
+		 * \since v.5.8.4
+		 */
+		mchain_params_t &
+		consumer_waiting( mchain_props::consumer_waiting_params_t params )
+			{
+				m_consumer_waiting = params;
+				return *this;
+			}
+
+		//! Get parameters of waiting on empty chain.
+		/*!
+		 * \since v.5.8.4
+		 */
+		const std::optional< mchain_props::consumer_waiting_params_t > &
+		consumer_waiting() const
+			{
+				return m_consumer_waiting;
+			}
 	};
 
 /*!
@@ -1184,6 +1391,13 @@ class mchain_bulk_processing_basic_params_t
 				m_data.m_chain_closed_handler = std::move(handler);
 			}
 
+		//! Access to internal data for modification.
+		/*!
+		 * \since v.5.8.4
+		 */
+		Basic_Data &
+		so5_mutable_data() noexcept { return m_data; }
+
 	public :
 		//! Default constructor.
 		mchain_bulk_processing_basic_params_t() = default;
@@ -1450,6 +1664,12 @@ struct adv_receive_data_t : public bulk_processing_basic_data_t
 		//! A chain to be used in receive operation.
 		mchain_t m_chain;
 
+		//! Max count of messages to be extracted from the chain at once.
+		/*!
+		 * \since v.5.8.4
+		 */
+		std::size_t m_bulk_size = { 1 };
+
 		//! Default constructor.
 		adv_receive_data_t() = default;
 
@@ -1521,6 +1741,48 @@ class mchain_receive_params_t final
 		//! Chain from which messages must be extracted and handled.
 		const mchain_t &
 		chain() const { return this->so5_data().m_chain; }
+
+		//! Allow extraction of several messages from the chain at once.
+		/*!
+		 * By default receive() extracts messages one by one and the chain
+		 * is locked for every message. If bulk_extraction() is used then
+		 * up to \a v messages are extracted under one lock and then
+		 * handled one after another. It reduces the contention between
+		 * a consumer and producers on a busy chain.
+		 *
+		 * The count of extracted messages is limited by remaining
+		 * values of handle_n() and extract_n(), so receive() doesn't
+		 * extract more messages than it can handle. If stop_on() is
+		 * used then messages are extracted one by one.
+		 *
+		 * Usage example:
+		 * \code
+		 * so_5::receive(so_5::from(ch).handle_all().bulk_extraction(32), ...);
+		 * \endcode
+		 *
+		 * \attention
+		 * If a message handler throws then the rest of already extracted
+		 * messages will be lost.
+		 *
+		 * \note
+		 * Value 0 is treated as 1.
+		 *
+		 * \since v.5.8.4
+		 */
+		mchain_receive_params_t &
+		bulk_extraction( std::size_t v ) noexcept
+			{
+				this->so5_mutable_data().m_bulk_size = v ? v : 1u;
+				return *this;
+			}
+
+		//! Max count of messages to be extracted at once.
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		bulk_size() const noexcept { return this->so5_data().m_bulk_size; }
 	};
 
 //
@@ -1604,33 +1866,96 @@ class receive_actions_performer_t
 		std::size_t m_handled_messages = 0;
 		extraction_status_t m_status;
 
+		//! Buffer for bulk extraction.
+		/*!
+		 * It is empty if bulk extraction isn't used.
+		 *
+		 * \note
+		 * The buffer is owned by the performer because receive() can
+		 * be called from a message handler of another receive().
+		 *
+		 * \since v.5.8.4
+		 */
+		std::vector< demand_t > m_bulk_buffer;
+
+		//! Detect how many messages can be extracted by the next step.
+		/*!
+		 * \since v.5.8.4
+		 */
+		[[nodiscard]]
+		std::size_t
+		messages_to_extract() const noexcept
+			{
+				// Stop-predicate has to be checked after every message.
+				if( m_params.stop_on() )
+					return 1u;
+
+				std::size_t result = m_bulk_buffer.size();
+				if( m_params.to_handle() )
+					result = (std::min)( result,
+							m_params.to_handle() - m_handled_messages );
+				if( m_params.to_extract() )
+					result = (std::min)( result,
+							m_params.to_extract() - m_extracted_messages );
+
+				return result;
+			}
+
+		void
+		handle_extracted( demand_t & extracted_demand )
+			{
+				++m_extracted_messages;
+				const bool handled = m_bunch.handle(
+						extracted_demand.m_msg_type,
+						extracted_demand.m_message_ref );
+				if( handled )
+					++m_handled_messages;
+			}
+
 	public :
 		receive_actions_performer_t(
 			const mchain_receive_params_t< msg_count_status_t::defined > & params,
 			const Bunch & bunch )
 			:	m_params( params )
 			,	m_bunch( bunch )
-			{}
+			{
+				if( m_params.bulk_size() > 1u )
+					m_bulk_buffer.resize( m_params.bulk_size() );
+			}
 
 		void
 		handle_next( duration_t empty_timeout )
 			{
-				demand_t extracted_demand;
-				m_status = m_params.chain()->extract(
-						extracted_demand, empty_timeout );
-
-				if( extraction_status_t::msg_extracted == m_status )
+				const std::size_t capacity = messages_to_extract();
+				if( capacity > 1u )
 					{
-						++m_extracted_messages;
-						const bool handled = m_bunch.handle(
-								extracted_demand.m_msg_type,
-								extracted_demand.m_message_ref );
-						if( handled )
-							++m_handled_messages;
+						std::size_t extracted = 0u;
+						m_status = m_params.chain()->extract_bulk(
+								m_bulk_buffer.data(),
+								capacity,
+								extracted,
+								empty_timeout );
+
+						for( std::size_t i = 0u; i != extracted; ++i )
+							{
+								// Message should be released right after handling.
+								demand_t extracted_demand{ std::move(m_bulk_buffer[ i ]) };
+								handle_extracted( extracted_demand );
+							}
 					}
+				else
+					{
+						demand_t extracted_demand;
+						m_status = m_params.chain()->extract(
+								extracted_demand, empty_timeout );
+
+						if( extraction_status_t::msg_extracted == m_status )
+							handle_extracted( extracted_demand );
+					}
+
 				// Since v.5.5.17 we must check presence of chain-closed handler.
 				// This handler must be used if chain is closed.
-				else if( extraction_status_t::chain_closed == m_status )
+				if( extraction_status_t::chain_closed == m_status )
 					{
 						if( const auto & handler = m_params.closed_handler() )
 							so_5::details::invoke_noexcept_code(
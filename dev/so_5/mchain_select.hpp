@@ -20,6 +20,8 @@
 
 #include <iterator>
 #include <array>
+#include <exception>
+#include <optional>
 
 #if defined(__clang__) && (__clang_major__ >= 16)
 #pragma clang diagnostic push
@@ -616,6 +618,247 @@ fill_select_cases_holder(
 				holder, index + 1, std::forward< Cases >(other_cases)... );
 	}
 
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+//
+// actual_select_notificator_t
+//
+/*!
+ * \brief Actual implementation of notificator for multi chain select.
+ *
+ * \since
+ * v.5.5.16
+ */
+class actual_select_notificator_t : public select_notificator_t
+	{
+	private :
+		std::mutex m_lock;
+		std::condition_variable m_condition;
+
+		//! Queue of already notified select_cases.
+		select_case_t * m_tail = nullptr;
+
+		/*!
+		 * \attention This method must be called only on locked object.
+		 */
+		void
+		push_to_notified_chain( select_case_t & what ) noexcept
+			{
+				what.set_next( m_tail );
+				m_tail = &what;
+			}
+
+	public :
+		/*!
+		 * \brief Constructor for the case of empty list of notified
+		 * select_cases.
+		 *
+		 * \since v.5.8.4
+		 */
+		actual_select_notificator_t() = default;
+
+		/*!
+		 * \brief Initializing constructor.
+		 *
+		 * Intended to be used with select_cases_holder and its iterators.
+		 *
+		 * Every select_case is automatically added to the list of notified
+		 * select_cases.
+		 */
+		template< typename Fwd_it >
+		actual_select_notificator_t( Fwd_it b, Fwd_it e )
+			{
+				// All select_cases from range [b,e) must be included in
+				// ready_cases list.
+				while( b != e )
+					{
+						b->set_next( m_tail );
+						m_tail = &(*b);
+						++b;
+					}
+			}
+
+		void
+		notify( select_case_t & what ) noexcept override
+			{
+				select_case_t * old_tail = nullptr;
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+
+					old_tail = m_tail;
+					push_to_notified_chain( what );
+				}
+
+				if( !old_tail )
+					m_condition.notify_one();
+			}
+
+		/*!
+		 * \brief Return specifed select_case object to the chain of
+		 * 'notified select_cases'.
+		 *
+		 * If a message has been read from a mchain then there could be
+		 * other messages in that mchain. Because of that the select_case
+		 * for that mchain must be seen as 'notified' -- it should be
+		 * processed on next call to wait() method. This method must be
+		 * used for immediately return of select_case to the chain of
+		 * 'notified select_cases'.
+		 */
+		void
+		return_to_ready_chain( select_case_t & what ) noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				push_to_notified_chain( what );
+			}
+
+		/*!
+		 * \brief Wait for any notified select_case.
+		 *
+		 * Waiting no more than \a wait_time.
+		 *
+		 * \return nullptr if there is no notified select_cases after
+		 * waiting for \a wait_time.
+		 */
+		[[nodiscard]]
+		select_case_t *
+		wait(
+			//! Maximum waiting time for notified select_case.
+			duration_t wait_time )
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+				if( !m_tail )
+					::so_5::details::wait_for_big_interval(
+							lock,
+							m_condition,
+							wait_time,
+							[this]{ return m_tail != nullptr; } );
+
+				auto * result = m_tail;
+				m_tail = nullptr;
+
+				return result;
+			}
+
+		/*!
+		 * \brief Make all select_cases from range [b,e) notified again.
+		 *
+		 * The previous content of the chain of 'notified select_cases'
+		 * is dropped.
+		 *
+		 * \since v.5.8.4
+		 */
+		template< typename Fwd_it >
+		void
+		reset( Fwd_it b, Fwd_it e ) noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				m_tail = nullptr;
+				while( b != e )
+					{
+						push_to_notified_chain( *b );
+						++b;
+					}
+			}
+	};
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+//
+// select_readiness_t
+//
+/*!
+ * \brief State of select_cases that is kept between select() calls.
+ *
+ * An ordinary select() call tries every select_case at the start and
+ * then removes every select_case from mchains at the end. It makes the
+ * cost of one call proportional to the number of select_cases even if
+ * only one mchain has messages.
+ *
+ * A prepared-select object holds an instance of select_readiness_t
+ * and its select_cases stay registered in mchains between select() calls.
+ * An mchain pushes a select_case to the ready list of the notificator
+ * when the mchain becomes not empty (or is closed). The next select()
+ * call starts with this ready list only.
+ *
+ * The select_cases that are completed (their mchains are closed or
+ * their messages are sent) are not registered anywhere. They are kept
+ * in a separate list and are returned to the ready list at the start
+ * of the next select() call. Thus every call sees closed mchains and
+ * performs send_cases like an ordinary select() does.
+ *
+ * \note
+ * The completed select_cases are linked via select_case_t::m_next
+ * because such select_cases don't belong to any other queue.
+ *
+ * \since v.5.8.4
+ */
+class select_readiness_t
+	{
+		//! Notificator that lives as long as the prepared-select object.
+		actual_select_notificator_t m_notificator;
+
+		//! List of select_cases completed during the last select() call.
+		select_case_t * m_completed_tail = nullptr;
+
+	public :
+		/*!
+		 * \note
+		 * The ready list is empty after the construction.
+		 * The reset() method should be called to fill it.
+		 */
+		select_readiness_t() = default;
+
+		[[nodiscard]]
+		actual_select_notificator_t &
+		notificator() noexcept { return m_notificator; }
+
+		//! Store select_case that is completed in the current select() call.
+		void
+		on_case_completed( select_case_t & what ) noexcept
+			{
+				what.set_next( m_completed_tail );
+				m_completed_tail = &what;
+			}
+
+		//! Return all completed select_cases to the ready list.
+		/*!
+		 * Must be called at the start of select() call.
+		 */
+		void
+		restore_completed_cases() noexcept
+			{
+				while( m_completed_tail )
+					{
+						auto * c = m_completed_tail;
+						m_completed_tail = c->giveout_next();
+						m_notificator.return_to_ready_chain( *c );
+					}
+			}
+
+		//! Remove all select_cases from mchains and make them ready again.
+		/*!
+		 * Must be used if the state of select_cases is unknown (for
+		 * example, if select() call is aborted by an exception) and
+		 * at the destruction of the prepared-select object.
+		 */
+		template< typename Holder >
+		void
+		reset( const Holder & cases ) noexcept
+			{
+				for( auto & c : cases )
+					c.on_select_finish();
+
+				m_completed_tail = nullptr;
+				m_notificator.reset( cases.begin(), cases.end() );
+			}
+	};
+
 /*!
  * \brief The current status of prepared-select instance.
  *
@@ -663,6 +906,12 @@ class prepared_select_data_t
 		//! A list of cases for extensible-select operation.
 		select_cases_holder_t< Cases_Count > m_cases;
 
+		//! State of select_cases between select() calls.
+		/*!
+		 * \since v.5.8.4
+		 */
+		select_readiness_t m_readiness;
+
 	public :
 		prepared_select_data_t(
 			const prepared_select_data_t & ) = delete;
@@ -682,6 +931,15 @@ class prepared_select_data_t
 
 				fill_select_cases_holder(
 						m_cases, 0u, std::forward<Cases>(cases)... );
+
+				m_readiness.reset( m_cases );
+			}
+
+		~prepared_select_data_t() noexcept
+			{
+				// select_cases can still be registered in mchains.
+				for( auto & c : m_cases )
+					c.on_select_finish();
 			}
 
 		friend class activation_locker_t;
@@ -757,6 +1015,15 @@ class prepared_select_data_t
 					{
 						return m_data.get().m_cases;
 					}
+
+				/*!
+				 * \since v.5.8.4
+				 */
+				select_readiness_t &
+				readiness() const noexcept
+					{
+						return m_data.get().m_readiness;
+					}
 			};
 	};
 
@@ -1094,145 +1361,59 @@ class extensible_select_data_t
 			};
 	};
 
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
-#endif
-
 //
-// actual_select_notificator_t
+// select_actions_performer_t
 //
 /*!
- * \brief Actual implementation of notificator for multi chain select.
+ * \brief Helper class for performing select-specific operations.
+ *
+ * \tparam Holder type of actual select_cases_holder_t.
  *
  * \since
  * v.5.5.16
  */
-class actual_select_notificator_t : public select_notificator_t
+template< typename Holder >
+class select_actions_performer_t
 	{
-	private :
-		std::mutex m_lock;
-		std::condition_variable m_condition;
+		const mchain_select_params_t< msg_count_status_t::defined > & m_params;
 
-		//! Queue of already notified select_cases.
-		select_case_t * m_tail = nullptr;
+		const Holder & m_select_cases;
 
 		/*!
-		 * \attention This method must be called only on locked object.
+		 * \brief State of select_cases that must be kept after
+		 * the completion of select() call.
+		 *
+		 * Is nullptr for an ordinary select() call.
+		 *
+		 * \since v.5.8.4
 		 */
-		void
-		push_to_notified_chain( select_case_t & what ) noexcept
-			{
-				what.set_next( m_tail );
-				m_tail = &what;
-			}
+		select_readiness_t * m_readiness;
 
-	public :
 		/*!
-		 * \brief Initializing constructor.
+		 * \brief Notificator for an ordinary select() call.
 		 *
-		 * Intended to be used with select_cases_holder and its iterators.
+		 * Is empty if m_readiness is not nullptr.
 		 *
-		 * Every select_case is automatically added to the list of notified
-		 * select_cases.
+		 * \since v.5.8.4
 		 */
-		template< typename Fwd_it >
-		actual_select_notificator_t( Fwd_it b, Fwd_it e )
-			{
-				// All select_cases from range [b,e) must be included in
-				// ready_cases list.
-				while( b != e )
-					{
-						b->set_next( m_tail );
-						m_tail = &(*b);
-						++b;
-					}
-			}
-
-		void
-		notify( select_case_t & what ) noexcept override
-			{
-				select_case_t * old_tail = nullptr;
-				{
-					std::lock_guard< std::mutex > lock{ m_lock };
-
-					old_tail = m_tail;
-					push_to_notified_chain( what );
-				}
-
-				if( !old_tail )
-					m_condition.notify_one();
-			}
+		std::optional< actual_select_notificator_t > m_own_notificator;
 
+		//! Notificator to be used.
 		/*!
-		 * \brief Return specifed select_case object to the chain of
-		 * 'notified select_cases'.
-		 *
-		 * If a message has been read from a mchain then there could be
-		 * other messages in that mchain. Because of that the select_case
-		 * for that mchain must be seen as 'notified' -- it should be
-		 * processed on next call to wait() method. This method must be
-		 * used for immediately return of select_case to the chain of
-		 * 'notified select_cases'.
+		 * \note
+		 * It's a reference to m_own_notificator or to notificator from
+		 * m_readiness since v.5.8.4.
 		 */
-		void
-		return_to_ready_chain( select_case_t & what ) noexcept
-			{
-				std::lock_guard< std::mutex > lock{ m_lock };
-				push_to_notified_chain( what );
-			}
+		actual_select_notificator_t & m_notificator;
 
 		/*!
-		 * \brief Wait for any notified select_case.
+		 * \brief Count of uncaught exceptions at the start of select() call.
 		 *
-		 * Waiting no more than \a wait_time.
+		 * It's used for detection of select() call aborted by an exception.
 		 *
-		 * \return nullptr if there is no notified select_cases after
-		 * waiting for \a wait_time.
+		 * \since v.5.8.4
 		 */
-		[[nodiscard]]
-		select_case_t *
-		wait(
-			//! Maximum waiting time for notified select_case.
-			duration_t wait_time )
-			{
-				std::unique_lock< std::mutex > lock{ m_lock };
-				if( !m_tail )
-					::so_5::details::wait_for_big_interval(
-							lock,
-							m_condition,
-							wait_time,
-							[this]{ return m_tail != nullptr; } );
-
-				auto * result = m_tail;
-				m_tail = nullptr;
-
-				return result;
-			}
-	};
-
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
-
-//
-// select_actions_performer_t
-//
-/*!
- * \brief Helper class for performing select-specific operations.
- *
- * \tparam Holder type of actual select_cases_holder_t.
- *
- * \since
- * v.5.5.16
- */
-template< typename Holder >
-class select_actions_performer_t
-	{
-		const mchain_select_params_t< msg_count_status_t::defined > & m_params;
-
-		const Holder & m_select_cases;
-		actual_select_notificator_t m_notificator;
+		const int m_uncaught_exceptions;
 
 		std::size_t m_closed_chains = 0;
 		std::size_t m_extracted_messages = 0;
@@ -1258,15 +1439,29 @@ class select_actions_performer_t
 	public :
 		select_actions_performer_t(
 			const mchain_select_params_t< msg_count_status_t::defined > & params,
-			const Holder & select_cases )
+			const Holder & select_cases,
+			select_readiness_t * readiness )
 			:	m_params( params )
 			,	m_select_cases( select_cases )
-			,	m_notificator( select_cases.begin(), select_cases.end() )
-			{}
+			,	m_readiness( readiness )
+			,	m_notificator( readiness ? readiness->notificator() :
+					m_own_notificator.emplace(
+							select_cases.begin(), select_cases.end() ) )
+			,	m_uncaught_exceptions( std::uncaught_exceptions() )
+			{
+				if( m_readiness )
+					m_readiness->restore_completed_cases();
+			}
 		~select_actions_performer_t()
 			{
-				for( auto & c : m_select_cases )
-					c.on_select_finish();
+				if( !m_readiness )
+					{
+						for( auto & c : m_select_cases )
+							c.on_select_finish();
+					}
+				else if( std::uncaught_exceptions() != m_uncaught_exceptions )
+					// The state of select_cases is unknown.
+					m_readiness->reset( m_select_cases );
 			}
 
 		void
@@ -1329,6 +1524,16 @@ class select_actions_performer_t
 
 						update_can_continue_flag();
 					}
+
+				// Unhandled select_cases must be kept as ready
+				// for the next select() call.
+				if( m_readiness )
+					while( ready_chain )
+						{
+							auto * current = ready_chain;
+							ready_chain = current->giveout_next();
+							m_notificator.return_to_ready_chain( *current );
+						}
 			}
 
 		void
@@ -1351,6 +1556,7 @@ class select_actions_performer_t
 				else if( extraction_status_t::chain_closed == result.status() )
 					{
 						react_on_closed_chain( current );
+						on_case_completed( current );
 					}
 			}
 
@@ -1367,6 +1573,7 @@ class select_actions_performer_t
 					case push_status_t::stored :
 						++m_completed_send_cases;
 						m_sent_messages += result.sent();
+						on_case_completed( current );
 					break;
 
 					case push_status_t::deffered :
@@ -1376,16 +1583,28 @@ class select_actions_performer_t
 					case push_status_t::not_stored :
 						// Message wasn't sent but the send_case completed.
 						++m_completed_send_cases;
+						on_case_completed( current );
 					break;
 
 					case push_status_t::chain_closed :
 						// Message wasn't sent but the send_case completed.
 						++m_completed_send_cases;
 						react_on_closed_chain( current );
+						on_case_completed( current );
 					break;
 					}
 			}
 
+		/*!
+		 * \since v.5.8.4
+		 */
+		void
+		on_case_completed( select_case_t * current ) noexcept
+			{
+				if( m_readiness )
+					m_readiness->on_case_completed( *current );
+			}
+
 		void
 		react_on_closed_chain( select_case_t * current )
 			{
@@ -1433,11 +1652,13 @@ template< typename Holder >
 mchain_select_result_t
 do_adv_select_with_total_time(
 	const mchain_select_params_t< msg_count_status_t::defined > & params,
-	const Holder & select_cases )
+	const Holder & select_cases,
+	select_readiness_t * readiness )
 	{
 		using namespace so_5::details;
 
-		select_actions_performer_t< Holder > performer{ params, select_cases };
+		select_actions_performer_t< Holder > performer{
+				params, select_cases, readiness };
 
 		remaining_time_counter_t time_counter{ params.total_time() };
 		do
@@ -1454,11 +1675,13 @@ template< typename Holder >
 mchain_select_result_t
 do_adv_select_without_total_time(
 	const mchain_select_params_t< msg_count_status_t::defined > & params,
-	const Holder & select_cases )
+	const Holder & select_cases,
+	select_readiness_t * readiness )
 	{
 		using namespace so_5::details;
 
-		select_actions_performer_t< Holder > performer{ params, select_cases };
+		select_actions_performer_t< Holder > performer{
+				params, select_cases, readiness };
 
 		remaining_time_counter_t wait_time{ params.empty_timeout() };
 		do
@@ -1501,12 +1724,17 @@ perform_select(
 	//! Parameters for advanced select.
 	const mchain_select_params_t< msg_count_status_t::defined > & params,
 	//! Select cases.
-	const Cases_Holder & cases_holder )
+	const Cases_Holder & cases_holder,
+	//! State of select_cases to be kept between select() calls.
+	//! Is nullptr if select_cases must be finished at the end of the call.
+	select_readiness_t * readiness = nullptr )
 	{
 		if( is_infinite_wait_timevalue( params.total_time() ) )
-			return do_adv_select_without_total_time( params, cases_holder );
+			return do_adv_select_without_total_time(
+					params, cases_holder, readiness );
 		else
-			return do_adv_select_with_total_time( params, cases_holder );
+			return do_adv_select_with_total_time(
+					params, cases_holder, readiness );
 	}
 
 } /* namespace details */
@@ -1927,7 +2155,8 @@ select(
 
 		return mchain_props::details::perform_select(
 				locker.params(),
-				locker.cases() );
+				locker.cases(),
+				&locker.readiness() );
 	}
 
 //
@@ -15,6 +15,9 @@
 #include <so_5/types.hpp>
 
 #include <so_5/agent_ref_fwd.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <so_5/details/message_block_pool.hpp>
 
 #include <type_traits>
 #include <typeindex>
@@ -299,6 +302,147 @@ class SO_5_TYPE signal_t
 		~signal_t() noexcept override = default;
 };
 
+//
+// pooled_message_t
+//
+/*!
+ * \brief A base class for messages whose instances have to be taken
+ * from a pool.
+ *
+ * By default every message instance is allocated dynamically by
+ * the global operator new and is deallocated when the last reference
+ * to it disappears. It can be too expensive for messages which are sent
+ * at high rate. If a message type is derived from pooled_message_t then
+ * memory blocks for instances of that type are recycled: a block is
+ * returned to a pool of that type when the last reference to the message
+ * disappears and is reused for the next instance.
+ *
+ * It's the only change: message instances are created by so_5::send,
+ * so_5::message_holder_t and so on as usual, they can be sent as mutable
+ * messages, handlers receive them via mhood_t or const references.
+ *
+ * Usage example:
+ * \code
+	struct telemetry final : public so_5::pooled_message_t< telemetry >
+	{
+		sensor_id m_sensor;
+		double m_value;
+
+		telemetry( sensor_id sensor, double value )
+			:	m_sensor{ sensor }, m_value{ value }
+			{}
+	};
+	...
+	so_5::send< telemetry >( dest, sensor, value );
+ * \endcode
+ *
+ * There is a separate process-wide pool for every pooled message type.
+ * See so_5::message_pool_t for the control of a pool.
+ *
+ * \note
+ * Message types that aren't derived from message_t can also be pooled.
+ * See so_5::use_message_pool.
+ *
+ * \tparam Derived type of the actual message.
+ *
+ * \since v.5.8.4
+ */
+template< typename Derived >
+class pooled_message_t : public message_t
+	{
+	public :
+		//! Allocate memory for a new message instance.
+		[[nodiscard]]
+		static void *
+		operator new( std::size_t size )
+			{
+				return details::allocate_message_block< Derived >( size );
+			}
+
+		//! Return memory of the destroyed message instance to the pool.
+		static void
+		operator delete( void * ptr, std::size_t size ) noexcept
+			{
+				details::deallocate_message_block< Derived >( ptr, size );
+			}
+	};
+
+//
+// use_message_pool
+//
+/*!
+ * \brief A trait that enables pooling for message of user type.
+ *
+ * An instance of message of user type \a T (a type that isn't derived
+ * from so_5::message_t) is stored inside so_5::user_type_message_t<T>.
+ * Such instances are allocated from a pool if this trait is specialized
+ * for \a T this way:
+ * \code
+	struct telemetry { sensor_id m_sensor; double m_value; };
+
+	template<>
+	struct so_5::use_message_pool< telemetry > : public std::true_type {};
+ * \endcode
+ *
+ * \note
+ * The specialization must be visible at every point where
+ * messages of type \a T are created.
+ *
+ * \since v.5.8.4
+ */
+template< typename T >
+struct use_message_pool : public std::false_type {};
+
+namespace details
+{
+
+//
+// user_type_message_base_t
+//
+/*!
+ * \brief A base for so_5::user_type_message_t.
+ *
+ * This version is used if a user type isn't pooled. It doesn't define
+ * any allocation functions, so all forms of operator new/delete
+ * (including ones for over-aligned types) are available.
+ *
+ * \tparam Envelope actual type of message object.
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope, bool Pooled >
+class user_type_message_base_t : public message_t
+	{};
+
+/*!
+ * \brief A base for so_5::user_type_message_t for pooled user types.
+ *
+ * Memory for message instances is taken from a pool.
+ *
+ * \since v.5.8.4
+ */
+template< typename Envelope >
+class user_type_message_base_t< Envelope, true > : public message_t
+	{
+	public :
+		//! Allocate memory for a new message instance.
+		[[nodiscard]]
+		static void *
+		operator new( std::size_t size )
+			{
+				return allocate_message_block< Envelope >( size );
+			}
+
+		//! Return memory of the destroyed message instance to the pool.
+		static void
+		operator delete( void * ptr, std::size_t size ) noexcept
+			{
+				deallocate_message_block< Envelope >( ptr, size );
+			}
+	};
+
+} /* namespace details */
+
 //
 // user_type_message_t
 //
@@ -311,7 +455,10 @@ class SO_5_TYPE signal_t
  * \since v.5.5.9
  */
 template< typename T >
-struct user_type_message_t : public message_t
+struct user_type_message_t
+	:	public details::user_type_message_base_t<
+			user_type_message_t< T >,
+			use_message_pool< T >::value >
 {
 	//! Instance of user message.
 	/*!
@@ -342,10 +489,10 @@ struct user_type_message_t : public message_t
 		{}
 
 private :
-	kind_t
+	message_t::kind_t
 	so5_message_kind() const noexcept override
 		{
-			return kind_t::user_type_message;
+			return message_t::kind_t::user_type_message;
 		}
 };
 
@@ -789,6 +936,65 @@ struct message_payload_type< user_type_message_t< T > >
 	{
 	};
 
+//
+// message_pool_t
+//
+/*!
+ * \brief Control of the pool of message instances of type \a Msg.
+ *
+ * \tparam Msg type of message. It has to be derived from
+ * so_5::pooled_message_t or it has to be a user type for which
+ * so_5::use_message_pool is specialized.
+ *
+ * Usage example:
+ * \code
+	// Keep up to 64K free instances of telemetry.
+	so_5::message_pool_t< telemetry >::set_capacity( 64u * 1024u );
+	...
+	const auto stats = so_5::message_pool_t< telemetry >::query_stats();
+	std::cout << "hits: " << stats.m_hits << ", misses: " << stats.m_misses
+		<< std::endl;
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+template< typename Msg >
+class message_pool_t
+	{
+		//! Type of actual message object.
+		using envelope_type = typename message_payload_type< Msg >::envelope_type;
+
+		static_assert(
+				std::is_base_of_v< pooled_message_t< envelope_type >, envelope_type > ||
+				(is_user_type_message< envelope_type >::value &&
+					use_message_pool<
+							typename message_payload_type< Msg >::payload_type >::value),
+				"Msg should be derived from so_5::pooled_message_t or "
+				"so_5::use_message_pool should be specialized for Msg" );
+
+	public :
+		message_pool_t() = delete;
+
+		//! Change the max count of free instances in the pool.
+		/*!
+		 * The default value is 1024.
+		 */
+		static void
+		set_capacity( std::size_t capacity ) noexcept
+			{
+				details::message_block_pool< envelope_type >().set_capacity(
+						capacity );
+			}
+
+		//! Get the current stats for the pool.
+		[[nodiscard]]
+		static message_pool_stats_t
+		query_stats() noexcept
+			{
+				return details::message_block_pool< envelope_type >().query_stats();
+			}
+	};
+
 namespace details
 {
 
@@ -134,6 +134,47 @@ class SO_5_TYPE abstract_message_sink_t
 			//! NOTE: it will be nullptr when message delivery tracing if off.
 			const message_limit::impl::action_msg_tracer_t * tracer ) = 0;
 
+		//! Push a batch of messages of the same type to the appropriate
+		//! destination.
+		/*!
+		 * This method is used by mboxes for the delivery of a batch of
+		 * messages when message delivery tracing is off. So there is no
+		 * tracer for overlimit reactions.
+		 *
+		 * The default implementation calls push_event() for every message.
+		 * Message sinks for agents override it to push the whole batch
+		 * to the agent's event queue by just one event_queue_t::push_batch()
+		 * call.
+		 *
+		 * \note The order of messages has to be preserved.
+		 *
+		 * \since v.5.8.4
+		 */
+		virtual void
+		push_event_batch(
+			//! ID of mbox from that messages are received.
+			mbox_id_t mbox_id,
+			//! Delivery mode for this delivery attempt.
+			message_delivery_mode_t delivery_mode,
+			//! Type of messages to be delivered.
+			const std::type_index & msg_type,
+			//! Pointer to the first message in the batch.
+			const message_ref_t * messages,
+			//! Count of messages in the batch.
+			std::size_t messages_count,
+			//! The current deep of message redirection between mboxes and msinks.
+			unsigned int redirection_deep )
+			{
+				for( std::size_t i = 0u; i != messages_count; ++i )
+					this->push_event(
+							mbox_id,
+							delivery_mode,
+							msg_type,
+							messages[ i ],
+							redirection_deep,
+							nullptr );
+			}
+
 		[[nodiscard]]
 		static bool
 		special_sink_ptr_compare(
@@ -0,0 +1,253 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Dense integer identifiers for message types.
+ *
+ * \since v.5.8.4
+ */
+
+#include <so_5/message_type_id.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace so_5
+{
+
+namespace
+{
+
+//
+// lookup_table_t
+//
+/*!
+ * \brief Lock-free lookup table for registered message types.
+ *
+ * It's an open-addressing hash table with a fixed size. Every item
+ * holds a pointer to std::type_index object from the registry (those
+ * objects are never removed from the registry, so pointers remain valid).
+ *
+ * Items are added only under the registry's lock and are never
+ * removed. Readers don't use any locks: an item is published by
+ * a store with release semantic, and the identifier is written before
+ * the publication.
+ *
+ * If the table becomes too full new types aren't added to it.
+ * In that case the overflow flag is set and the registry has to be
+ * used for types not found in the table.
+ *
+ * \since v.5.8.4
+ */
+class lookup_table_t
+	{
+		//! Count of items in the table.
+		/*!
+		 * \note
+		 * It has to be a power of two.
+		 */
+		static constexpr std::size_t items_count = 4096u;
+
+		//! Max count of types in the table.
+		static constexpr std::size_t max_types = items_count / 4u * 3u;
+
+		std::array< std::atomic< const std::type_index * >, items_count > m_types{};
+		std::array< std::atomic< message_type_id_t >, items_count > m_ids{};
+
+		//! Count of types in the table.
+		/*!
+		 * \note
+		 * Is modified only under the registry's lock.
+		 */
+		std::size_t m_size{};
+
+		//! Is there a type that can't be stored in the table?
+		std::atomic< bool > m_overflowed{ false };
+
+		[[nodiscard]]
+		static std::size_t
+		start_index( const std::type_index & msg_type ) noexcept
+			{
+				return msg_type.hash_code() & (items_count - 1u);
+			}
+
+	public :
+		//! Result of a search in the table.
+		enum class lookup_result_t
+			{
+				//! The type is found.
+				found,
+				//! The type isn't registered.
+				not_registered,
+				//! The type isn't in the table, but it can be in the registry.
+				unknown
+			};
+
+		[[nodiscard]]
+		lookup_result_t
+		find(
+			const std::type_index & msg_type,
+			message_type_id_t & id ) const noexcept
+			{
+				for( std::size_t i = start_index( msg_type ), probes = 0u;
+						probes != items_count;
+						i = (i + 1u) & (items_count - 1u), ++probes )
+					{
+						const auto * t = m_types[ i ].load( std::memory_order_acquire );
+						if( !t )
+							break;
+						if( *t == msg_type )
+							{
+								id = m_ids[ i ].load( std::memory_order_relaxed );
+								return lookup_result_t::found;
+							}
+					}
+
+				return m_overflowed.load( std::memory_order_acquire ) ?
+						lookup_result_t::unknown : lookup_result_t::not_registered;
+			}
+
+		/*!
+		 * \attention
+		 * Must be called under the registry's lock.
+		 */
+		void
+		add(
+			const std::type_index & msg_type,
+			message_type_id_t id ) noexcept
+			{
+				if( m_size == max_types )
+					{
+						m_overflowed.store( true, std::memory_order_release );
+						return;
+					}
+
+				std::size_t i = start_index( msg_type );
+				while( m_types[ i ].load( std::memory_order_relaxed ) )
+					i = (i + 1u) & (items_count - 1u);
+
+				m_ids[ i ].store( id, std::memory_order_relaxed );
+				m_types[ i ].store( &msg_type, std::memory_order_release );
+				++m_size;
+			}
+	};
+
+//
+// registry_t
+//
+/*!
+ * \brief Global registry of message type identifiers.
+ *
+ * \since v.5.8.4
+ */
+struct registry_t
+	{
+		std::mutex m_lock;
+		std::unordered_map< std::type_index, message_type_id_t > m_ids;
+		lookup_table_t m_table;
+	};
+
+/*!
+ * \brief Get the global registry.
+ *
+ * \note
+ * The registry is intentionally never destroyed. It allows to get
+ * identifiers during the destruction of static objects.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+registry_t &
+registry()
+	{
+		static registry_t * instance = new registry_t{};
+		return *instance;
+	}
+
+/*!
+ * \brief Get the identifier from the global registry.
+ *
+ * A new identifier is assigned if there is no such type in the registry.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+message_type_id_t
+find_or_assign_id( registry_t & r, const std::type_index & msg_type )
+	{
+		std::lock_guard< std::mutex > lock{ r.m_lock };
+
+		const auto next_id = static_cast< message_type_id_t >( r.m_ids.size() );
+		const auto ins_result = r.m_ids.emplace( msg_type, next_id );
+		if( ins_result.second )
+			r.m_table.add( ins_result.first->first, next_id );
+
+		return ins_result.first->second;
+	}
+
+/*!
+ * \brief Get the identifier from the global registry without
+ * an assignment of a new one.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+message_type_id_t
+find_id( registry_t & r, const std::type_index & msg_type ) noexcept
+	{
+		try
+			{
+				std::lock_guard< std::mutex > lock{ r.m_lock };
+
+				const auto it = r.m_ids.find( msg_type );
+				return it != r.m_ids.end() ? it->second : null_message_type_id();
+			}
+		catch( ... )
+			{
+				// If the registry can't be locked the type will be treated
+				// as not registered.
+				return null_message_type_id();
+			}
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & msg_type )
+	{
+		auto & r = registry();
+
+		message_type_id_t id;
+		if( lookup_table_t::lookup_result_t::found == r.m_table.find( msg_type, id ) )
+			return id;
+
+		return find_or_assign_id( r, msg_type );
+	}
+
+SO_5_FUNC message_type_id_t
+find_message_type_id( const std::type_index & msg_type ) noexcept
+	{
+		auto & r = registry();
+
+		message_type_id_t id;
+		switch( r.m_table.find( msg_type, id ) )
+			{
+			case lookup_table_t::lookup_result_t::found:
+				return id;
+
+			case lookup_table_t::lookup_result_t::not_registered:
+				return null_message_type_id();
+
+			case lookup_table_t::lookup_result_t::unknown:
+				break;
+			}
+
+		return find_id( r, msg_type );
+	}
+
+} /* namespace so_5 */
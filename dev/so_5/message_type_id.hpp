@@ -0,0 +1,124 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Dense integer identifiers for message types.
+ *
+ * \since v.5.8.4
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <cstdint>
+#include <typeindex>
+
+namespace so_5
+{
+
+//
+// message_type_id_t
+//
+/*!
+ * \brief Type for a dense integer identifier of a message type.
+ *
+ * Identifiers are assigned lazily, on the first request for a type.
+ * The first assigned identifier is 0, the next one is 1 and so on.
+ * So identifiers can be used as indexes in arrays and as ready-to-use
+ * hash values.
+ *
+ * \attention
+ * Identifiers are valid only inside one run of an application.
+ * They can't be stored and transferred to another process.
+ *
+ * \since v.5.8.4
+ */
+using message_type_id_t = std::uint32_t;
+
+//
+// null_message_type_id
+//
+/*!
+ * \brief A special value for a message type without an identifier.
+ *
+ * This value is never assigned to a message type.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+constexpr message_type_id_t
+null_message_type_id() noexcept
+	{
+		return ~static_cast< message_type_id_t >( 0u );
+	}
+
+//
+// message_type_id
+//
+/*!
+ * \brief Get the dense integer identifier for a message type.
+ *
+ * Equal std::type_index objects always get the same identifier,
+ * even if they are obtained in different shared objects.
+ *
+ * This function is thread safe. The identifier of an already registered
+ * type is taken from a lock-free lookup table. A global registry
+ * (protected by a mutex) is used only for the registration of a new type.
+ *
+ * \throw std::exception if a new identifier can't be assigned.
+ *
+ * Usage example:
+ * \code
+ * const auto id = so_5::message_type_id( typeid(my_message) );
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & msg_type );
+
+/*!
+ * \brief Find the dense integer identifier for a message type
+ * without an assignment of a new identifier.
+ *
+ * This function is intended to be used in noexcept contexts, for
+ * example, in searches of event handlers. If a type has no identifier
+ * yet then there is no subscription for it.
+ *
+ * \return null_message_type_id() if there is no identifier for the type.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC message_type_id_t
+find_message_type_id( const std::type_index & msg_type ) noexcept;
+
+/*!
+ * \brief Get the dense integer identifier for a message type
+ * known at the compile time.
+ *
+ * The identifier is obtained just once and then it's cached in a
+ * static variable.
+ *
+ * Usage example:
+ * \code
+ * const auto id = so_5::message_type_id< my_message >();
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+template< typename Msg >
+[[nodiscard]]
+message_type_id_t
+message_type_id()
+	{
+		static const message_type_id_t id =
+				::so_5::message_type_id( typeid(Msg) );
+		return id;
+	}
+
+} /* namespace so_5 */
@@ -46,6 +46,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 
 		# Run-time.
 		cpp_source 'message.cpp'
+		cpp_source 'message_type_id.cpp'
 		cpp_source 'enveloped_msg.cpp'
 		cpp_source 'handler_makers.cpp'
 
@@ -77,6 +78,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 			cpp_source 'subscr_storage_flat_set_based.cpp'
 			cpp_source 'subscr_storage_map_based.cpp'
 			cpp_source 'subscr_storage_hash_table_based.cpp'
+			cpp_source 'subscr_storage_flat_hash_table_based.cpp'
 			cpp_source 'subscr_storage_adaptive.cpp'
 
 			cpp_source 'process_unhandled_exception.cpp'
@@ -108,6 +110,8 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 
 		sources_root( 'disp' ) {
 			cpp_source 'abstract_work_thread.cpp'
+			cpp_source 'affinity_work_thread_factory.cpp'
+			cpp_source 'numa.cpp'
 
 			sources_root( 'mpsc_queue_traits' ) {
 				cpp_source 'pub.cpp'
@@ -125,6 +129,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'pub.cpp'
 			}
 
+			sources_root( 'bounded_one_thread' ) {
+				cpp_source 'pub.cpp'
+			}
+
 			sources_root( 'active_obj' ) {
 				cpp_source 'pub.cpp'
 			}
@@ -145,6 +153,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'pub.cpp'
 			}
 
+			sources_root( 'ws_thread_pool' ) {
+				cpp_source 'pub.cpp'
+			}
+
 			sources_root( 'prio_one_thread' ) {
 				sources_root( 'strictly_ordered' ) {
 					cpp_source 'pub.cpp'
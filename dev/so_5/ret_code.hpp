@@ -525,6 +525,29 @@ const int rc_agent_name_too_long = 197;
  */
 const int rc_stored_msg_inspection_result_not_found = 198;
 
+/*!
+ * \brief An attempt to create size-unlimited mchain with lock-free queue.
+ *
+ * \since v.5.8.4
+ */
+const int rc_lock_free_mchain_must_be_size_limited = 199;
+
+/*!
+ * \brief An attempt to bind an agent to a NUMA node that isn't used
+ * by a dispatcher.
+ *
+ * \since v.5.8.4
+ */
+const int rc_invalid_numa_node = 200;
+
+/*!
+ * \brief The demand queue of bounded_one_thread dispatcher is still full
+ * after the wait timeout and overflow_reaction_t::throw_exception is used.
+ *
+ * \since v.5.8.4
+ */
+const int rc_bounded_disp_queue_overflow = 201;
+
 //! \name Common error codes.
 //! \{
 
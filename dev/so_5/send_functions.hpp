@@ -16,6 +16,9 @@
 
 #include <so_5/compiler_features.hpp>
 
+#include <iterator>
+#include <vector>
+
 namespace so_5
 {
 
@@ -349,6 +352,74 @@ send(
 				what.make_reference() );
 	}
 
+/*!
+ * \brief A utility function for creating and delivering a batch of
+ * messages of the same type.
+ *
+ * A new message instance of type \a Message is created for every item
+ * from \a items (an item is passed to Message's constructor). Then all
+ * message instances are delivered to the destination by one call to
+ * so_5::abstract_message_box_t::do_deliver_message_batch(). It allows
+ * a mbox to find subscribers just once for the whole batch.
+ *
+ * Usage example:
+ * \code
+	struct quote { instrument_id m_instrument; double m_price; };
+
+	std::vector< quote > quotes = ...;
+	so_5::send_batch< quote >( market_data_mbox, quotes );
+ * \endcode
+ *
+ * \note
+ * Signals can't be sent by send_batch().
+ *
+ * \tparam Message type of messages to be sent. It can be in form of
+ * Msg, so_5::immutable_msg<Msg> or so_5::mutable_msg<Msg>.
+ * \tparam Target identification of the destination. Could be reference to
+ * so_5::mbox_t, to so_5::agent_t or to so_5::mchain_t.
+ * \tparam Items type of a range of items for Message's constructor.
+ *
+ * \since v.5.8.4
+ */
+template< typename Message, typename Target, typename Items >
+void
+send_batch(
+	//! Destination for messages.
+	Target && to,
+	//! Items to be used for creation of messages.
+	const Items & items )
+	{
+		static_assert( !is_signal< Message >::value,
+				"signals can't be sent by send_batch" );
+
+		using std::begin;
+		using std::end;
+
+		const auto first = begin( items );
+		const auto last = end( items );
+
+		std::vector< message_ref_t > messages;
+		if constexpr( std::is_base_of_v<
+				std::forward_iterator_tag,
+				typename std::iterator_traits<
+						std::decay_t< decltype(first) > >::iterator_category > )
+			{
+				messages.reserve( static_cast< std::size_t >(
+						std::distance( first, last ) ) );
+			}
+
+		for( auto it = first; it != last; ++it )
+			messages.emplace_back(
+					so_5::details::make_message_instance< Message >( *it ) );
+
+		so_5::low_level_api::deliver_message_batch(
+				message_delivery_mode_t::ordinary,
+				*send_functions_details::arg_to_mbox( std::forward<Target>(to) ),
+				message_payload_type< Message >::subscription_type_index(),
+				messages.data(),
+				messages.size() );
+	}
+
 /*!
  * \brief A utility function for creating and delivering a delayed message
  * to the specified destination.
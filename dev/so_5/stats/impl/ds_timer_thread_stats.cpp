@@ -46,6 +46,11 @@ ds_timer_thread_stats_t::distribute(
 				prefixes::timer_thread(),
 				suffixes::timer_periodic_count(),
 				stats.m_periodic_count );
+
+		send< messages::quantity< std::size_t > >( distribution_mbox,
+				prefixes::timer_thread(),
+				suffixes::timer_fired_per_tick(),
+				stats.m_fired_per_tick );
 	}
 
 } /* namespace impl */
@@ -104,12 +104,36 @@ timer_periodic_count()
 		IMPL_SUFFIX( "/periodic.count" )
 	}
 
+SO_5_FUNC suffix_t
+timer_fired_per_tick()
+	{
+		IMPL_SUFFIX( "/fired_per_tick.count" )
+	}
+
 SO_5_FUNC suffix_t
 demand_quote()
 	{
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+demand_pool_hits()
+	{
+		IMPL_SUFFIX( "/demand_pool.hits" )
+	}
+
+SO_5_FUNC suffix_t
+demand_pool_misses()
+	{
+		IMPL_SUFFIX( "/demand_pool.misses" )
+	}
+
+SO_5_FUNC suffix_t
+demands_at_once()
+	{
+		IMPL_SUFFIX( "/demands.at_once" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
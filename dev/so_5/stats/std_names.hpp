@@ -146,6 +146,15 @@ timer_single_shot_count();
 SO_5_FUNC suffix_t
 timer_periodic_count();
 
+/*!
+ * \brief Suffix for data source with count of timers fired during
+ * the last tick of timer thread.
+ *
+ * \since v.5.8.4
+ */
+SO_5_FUNC suffix_t
+timer_fired_per_tick();
+
 /*!
  * \since
  * v.5.5.8
@@ -157,6 +166,43 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \since
+ * v.5.8.4
+ *
+ * \brief Suffix for data source with count of demand allocations
+ * satisfied by the dispatcher's demand pool.
+ *
+ * This suffix is used in thread_pool-like dispatchers.
+ */
+SO_5_FUNC suffix_t
+demand_pool_hits();
+
+/*!
+ * \since
+ * v.5.8.4
+ *
+ * \brief Suffix for data source with count of demand allocations
+ * that weren't satisfied by the dispatcher's demand pool.
+ *
+ * This suffix is used in thread_pool-like dispatchers.
+ */
+SO_5_FUNC suffix_t
+demand_pool_misses();
+
+/*!
+ * \since
+ * v.5.8.4
+ *
+ * \brief Suffix for data source with the current count of demands
+ * to be processed at once from an event queue.
+ *
+ * This suffix is used in thread_pool dispatcher for event queues
+ * with the adaptive count of demands to be processed at once.
+ */
+SO_5_FUNC suffix_t
+demands_at_once();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
@@ -209,5 +209,31 @@ flat_set_based_subscription_storage_factory(
 	//! Initial storage capacity.
 	std::size_t initial_capacity );
 
+/*!
+ * \brief Factory for subscription storage based on a flat hash table
+ * with open addressing.
+ *
+ * Keys of subscriptions and event handlers are stored directly in slots
+ * of the hash table. It makes the search for an event handler very
+ * cheap: only a few neighbouring slots are examined.
+ *
+ * \note
+ * This storage is intended for agents with large amount of subscriptions
+ * (from several hundreds to thousands) for which the speed of event
+ * handler search is the main concern. It uses more memory than
+ * other storages.
+ *
+ * \par More about subscription storage tuning
+ * See \ref so_5_5_3__subscr_storage_selection for more details about selection
+ * of appropriate subscription storage type.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+SO_5_FUNC subscription_storage_factory_t
+flat_hash_table_based_subscription_storage_factory(
+	//! Expected count of subscriptions.
+	std::size_t initial_capacity );
+
 } /* namespace so_5 */
 
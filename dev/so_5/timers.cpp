@@ -15,9 +15,18 @@
 #include <so_5/impl/mbox_iface_for_timers.hpp>
 
 #include <so_5/timers.hpp>
+#include <so_5/spinlocks.hpp>
 
 #include <so_5/3rd_party/timertt/all.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
 namespace so_5
 {
 
@@ -36,17 +45,97 @@ namespace timers_details
  * \note
  * Since v.5.5.19 this template can be used with timer_thread and
  * with timer_manager.
+ *
+ * \note
+ * Since v.5.8.4 an object can be created in memory from a pool of
+ * preallocated objects: `new(allocator) actual_timer_t(...)`. The pointer
+ * to the allocator is stored right before the object, so the object is
+ * returned to the right pool by the ordinary delete.
  * 
  * \tparam Timer A type of timertt-based thread/manager which implements timers.
  */
 template< class Timer >
 class actual_timer_t : public timer_t
 	{
+		//! Header of a memory block for an object.
+		/*!
+		 * \since v.5.8.4
+		 */
+		struct alignas(std::max_align_t) allocation_header_t
+			{
+				//! Allocator of the memory block.
+				/*!
+				 * nullptr means that ordinary operator new was used.
+				 */
+				timertt::timer_object_allocator * m_allocator;
+			};
+
 	public :
 		//! The actual type of timer holder for timertt.
 		using timer_holder_t = timertt::timer_object_holder<
 				typename Timer::thread_safety >;
 
+		//! Size of a memory block required for an object.
+		/*!
+		 * \since v.5.8.4
+		 */
+		static constexpr std::size_t block_size =
+				sizeof(allocation_header_t) + sizeof(actual_timer_t);
+
+		//! Allocate memory for an object from the specified allocator.
+		/*!
+		 * \since v.5.8.4
+		 */
+		static void *
+		operator new(
+			std::size_t size,
+			//! Allocator to be used. Can be nullptr.
+			timertt::timer_object_allocator * allocator )
+			{
+				const auto full_size = sizeof(allocation_header_t) + size;
+				void * block = allocator ?
+						allocator->allocate( full_size ) :
+						::operator new( full_size );
+
+				return new(block) allocation_header_t{ allocator } + 1;
+			}
+
+		//! Allocate memory for an object by ordinary operator new.
+		/*!
+		 * \since v.5.8.4
+		 */
+		static void *
+		operator new( std::size_t size )
+			{
+				return operator new( size, nullptr );
+			}
+
+		//! Return memory of an object to its allocator.
+		/*!
+		 * \since v.5.8.4
+		 */
+		static void
+		operator delete( void * ptr ) noexcept
+			{
+				auto * header = static_cast< allocation_header_t * >( ptr ) - 1;
+				if( auto * allocator = header->m_allocator )
+					allocator->deallocate( header );
+				else
+					::operator delete( header );
+			}
+
+		//! Deallocation function for the case of an exception in constructor.
+		/*!
+		 * \since v.5.8.4
+		 */
+		static void
+		operator delete(
+			void * ptr,
+			timertt::timer_object_allocator * /*allocator*/ ) noexcept
+			{
+				operator delete( ptr );
+			}
+
 		//! Initialized constructor.
 		actual_timer_t(
 			Timer * thread )
@@ -92,6 +181,250 @@ class actual_timer_t : public timer_t
 		timer_holder_t m_timer;
 	};
 
+//
+// timer_objects_pool_t
+//
+/*!
+ * \brief A pool of preallocated timer objects for timertt.
+ *
+ * All objects are allocated as one memory block at the construction
+ * time. Free objects are linked into a list. An object from the list
+ * is reused for a new timer, so if the count of simultaneously existing
+ * timers doesn't exceed the capacity of the pool there is no allocation
+ * for timer objects at all.
+ *
+ * If the pool is empty (or the size of the requested object is greater
+ * than the size of the pool's item) the ordinary operator new is used.
+ *
+ * \note
+ * Timer objects are allocated and deallocated on the context of
+ * different threads, so the list of free objects is protected by
+ * a spinlock.
+ *
+ * \since v.5.8.4
+ */
+class timer_objects_pool_t final : public timertt::timer_object_allocator
+	{
+		//! An item in the list of free objects.
+		struct free_item_t
+			{
+				free_item_t * m_next;
+			};
+
+		//! Size of one item.
+		const std::size_t m_item_size;
+
+		//! Memory for all items.
+		std::unique_ptr< std::byte[] > m_memory;
+
+		//! Address right after the last item.
+		const std::byte * m_memory_end;
+
+		//! Lock for the list of free objects.
+		default_spinlock_t m_lock;
+
+		//! Head of the list of free objects.
+		free_item_t * m_free_head{ nullptr };
+
+		[[nodiscard]]
+		static std::size_t
+		actual_item_size( std::size_t object_size ) noexcept
+			{
+				constexpr std::size_t alignment = alignof(std::max_align_t);
+				const auto size = std::max( object_size, sizeof(free_item_t) );
+				return (size + alignment - 1u) / alignment * alignment;
+			}
+
+		[[nodiscard]]
+		bool
+		is_pool_item( const void * ptr ) const noexcept
+			{
+				const auto * p = static_cast< const std::byte * >( ptr );
+				return p >= m_memory.get() && p < m_memory_end;
+			}
+
+	public :
+		timer_objects_pool_t(
+			//! Size of a timer object.
+			std::size_t object_size,
+			//! Count of objects in the pool.
+			std::size_t capacity )
+			:	m_item_size( actual_item_size( object_size ) )
+			,	m_memory( new std::byte[ m_item_size * capacity ] )
+			,	m_memory_end( m_memory.get() + m_item_size * capacity )
+			{
+				// Items are linked in the order of their addresses.
+				for( std::size_t i = capacity; i != 0u; --i )
+					{
+						auto * item = new( m_memory.get() + m_item_size * (i - 1u) )
+								free_item_t{ m_free_head };
+						m_free_head = item;
+					}
+			}
+
+		void *
+		allocate( std::size_t size ) override
+			{
+				if( size <= m_item_size )
+					{
+						std::lock_guard< default_spinlock_t > lock{ m_lock };
+						if( m_free_head )
+							{
+								free_item_t * item = m_free_head;
+								m_free_head = item->m_next;
+								return item;
+							}
+					}
+
+				return ::operator new( size );
+			}
+
+		void
+		deallocate( void * ptr ) noexcept override
+			{
+				if( is_pool_item( ptr ) )
+					{
+						std::lock_guard< default_spinlock_t > lock{ m_lock };
+						m_free_head = new( ptr ) free_item_t{ m_free_head };
+					}
+				else
+					::operator delete( ptr );
+			}
+	};
+
+//
+// expired_timers_batch_t
+//
+/*!
+ * \brief A collector of messages from timers elapsed during one tick
+ * of a timer thread.
+ *
+ * Timer actions don't deliver messages by themselves. They store
+ * messages in that collector. When the timer thread finishes the processing
+ * of elapsed timers the collected messages are delivered by flush().
+ *
+ * Consecutive messages of the same type for the same mbox are grouped
+ * into a run and are delivered as one batch. So if thousands of timers
+ * for the same receiver expire on the same tick the mbox is locked just
+ * once. The order of messages is preserved.
+ *
+ * \note
+ * Methods accept() and flush() are called on the context of the timer
+ * thread only, so there is no need for any synchronization.
+ *
+ * \since v.5.8.4
+ */
+class expired_timers_batch_t
+	{
+		//! Description of messages of the same type for the same mbox.
+		struct run_t
+			{
+				mbox_t m_mbox;
+				std::type_index m_type_index;
+				//! Count of messages in the run.
+				std::size_t m_count;
+			};
+
+		//! Runs in the order of appearance.
+		std::vector< run_t > m_runs;
+
+		//! Messages for all runs.
+		/*!
+		 * Messages of one run are stored together, so they can
+		 * be passed to do_deliver_message_batch() directly.
+		 */
+		std::vector< message_ref_t > m_messages;
+
+		//! Count of messages delivered during the last non-empty tick.
+		std::atomic< std::size_t > m_fired_per_tick{ 0u };
+
+		//! Delivery of a single message.
+		static void
+		deliver(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg )
+			{
+				::so_5::impl::mbox_iface_for_timers_t{ mbox }
+						.deliver_message_from_timer( type_index, msg );
+			}
+
+	public :
+		//! Store a message from elapsed timer.
+		/*!
+		 * If the message can't be stored it is delivered immediately.
+		 */
+		void
+		accept(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg ) noexcept
+			{
+				try
+					{
+						if( m_runs.empty() ||
+								m_runs.back().m_mbox.get() != mbox.get() ||
+								m_runs.back().m_type_index != type_index )
+							m_runs.push_back( run_t{ mbox, type_index, 0u } );
+
+						m_messages.push_back( msg );
+						++(m_runs.back().m_count);
+					}
+				catch( ... )
+					{
+						deliver( type_index, mbox, msg );
+					}
+			}
+
+		//! Deliver all collected messages.
+		void
+		flush() noexcept
+			{
+				if( m_messages.empty() )
+					return;
+
+				const message_ref_t * messages = m_messages.data();
+				for( const auto & r : m_runs )
+					{
+						if( 1u == r.m_count )
+							deliver( r.m_type_index, r.m_mbox, *messages );
+						else if( r.m_count )
+							::so_5::impl::mbox_iface_for_timers_t{ r.m_mbox }
+									.deliver_message_batch_from_timer(
+											r.m_type_index,
+											messages,
+											r.m_count );
+
+						messages += r.m_count;
+					}
+
+				m_fired_per_tick.store(
+						m_messages.size(), std::memory_order_relaxed );
+
+				// A defense from cases where were too many timers.
+				if( m_messages.size() < 1000u )
+					{
+						// A simple clean is enough.
+						m_runs.clear();
+						m_messages.clear();
+					}
+				else
+					{
+						// Old containers must be utilized.
+						std::vector< run_t >{}.swap( m_runs );
+						std::vector< message_ref_t >{}.swap( m_messages );
+					}
+			}
+
+		//! Count of messages delivered during the last non-empty tick.
+		[[nodiscard]]
+		std::size_t
+		fired_per_tick() const noexcept
+			{
+				return m_fired_per_tick.load( std::memory_order_relaxed );
+			}
+	};
+
 //
 // timer_action_for_timer_thread_t
 //
@@ -99,21 +432,29 @@ class actual_timer_t : public timer_t
  * \brief A functor to be used as timer action in implementation
  * of timer thread.
  *
+ * \note
+ * Since v.5.8.4 the message isn't delivered directly. It's stored
+ * in expired_timers_batch_t and is delivered after the processing
+ * of all elapsed timers.
+ *
  * \since
  * v.5.5.20
  */
 class timer_action_for_timer_thread_t
 	{
+		outliving_reference_t< expired_timers_batch_t > m_batch;
 		std::type_index m_type_index;
 		mbox_t m_mbox;
 		message_ref_t m_msg;
 
 	public:
 		timer_action_for_timer_thread_t(
+			outliving_reference_t< expired_timers_batch_t > batch,
 			std::type_index type_index,
 			mbox_t mbox,
 			message_ref_t msg )
-			:	m_type_index( std::move(type_index) )
+			:	m_batch( batch )
+			,	m_type_index( std::move(type_index) )
 			,	m_mbox( std::move(mbox) )
 			,	m_msg( std::move(msg) )
 			{}
@@ -121,8 +462,7 @@ class timer_action_for_timer_thread_t
 		void
 		operator()() noexcept
 			{
-				::so_5::impl::mbox_iface_for_timers_t{ m_mbox }
-						.deliver_message_from_timer( m_type_index, m_msg );
+				m_batch.get().accept( m_type_index, m_mbox, m_msg );
 			}
 	};
 
@@ -148,7 +488,10 @@ class actual_thread_t : public timer_thread_t
 			//! Real timer thread.
 			std::unique_ptr< Timer_Thread > thread )
 			:	m_thread( std::move( thread ) )
-			{}
+			{
+				m_thread->set_expired_timers_processed_hook(
+						[this]() noexcept { m_batch.flush(); } );
+			}
 
 		virtual void
 		start() override
@@ -170,12 +513,16 @@ class actual_thread_t : public timer_thread_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = std::make_unique< timer_demand_t >( m_thread.get() );
+				std::unique_ptr< timer_demand_t > timer{
+						new( m_timer_demands_pool.get() )
+								timer_demand_t( m_thread.get() ) };
 
 				m_thread->activate( timer->timer_holder(),
 						pause,
 						period,
-						timer_action_for_timer_thread_t( type_index, mbox, msg ) );
+						timer_action_for_timer_thread_t(
+								outliving_mutable( m_batch ),
+								type_index, mbox, msg ) );
 
 				return timer_id_t( timer.release() );
 			}
@@ -191,7 +538,9 @@ class actual_thread_t : public timer_thread_t
 				m_thread->activate(
 						pause,
 						period,
-						timer_action_for_timer_thread_t( type_index, mbox, msg ) );
+						timer_action_for_timer_thread_t(
+								outliving_mutable( m_batch ),
+								type_index, mbox, msg ) );
 			}
 
 		virtual timer_thread_stats_t
@@ -201,14 +550,286 @@ class actual_thread_t : public timer_thread_t
 
 				return timer_thread_stats_t{
 						d.m_single_shot_count,
-						d.m_periodic_count
+						d.m_periodic_count,
+						m_batch.fired_per_tick()
 					};
 			}
 
+		void
+		preallocate_timer_objects( std::size_t count ) override
+			{
+				// The pool can't be replaced because there can be
+				// timer objects allocated from it.
+				if( !m_pool && count )
+					{
+						m_pool = std::make_unique< timer_objects_pool_t >(
+								Timer_Thread::timer_object_size(), count );
+						m_thread->set_timer_object_allocator( m_pool.get() );
+
+						m_timer_demands_pool = std::make_unique< timer_objects_pool_t >(
+								timer_demand_t::block_size, count );
+					}
+			}
+
 	private :
+		//! Pool for timer objects.
+		/*!
+		 * It's nullptr if preallocation wasn't requested.
+		 *
+		 * \note
+		 * It's declared before m_thread because it has to outlive
+		 * the timer thread.
+		 */
+		std::unique_ptr< timer_objects_pool_t > m_pool;
+
+		//! Pool for timer demands returned as timer_id_t.
+		/*!
+		 * It's nullptr if preallocation wasn't requested.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::unique_ptr< timer_objects_pool_t > m_timer_demands_pool;
+
+		//! Collector for messages from elapsed timers.
+		/*!
+		 * \note
+		 * It's declared before m_thread because it has to outlive
+		 * the timer thread.
+		 */
+		expired_timers_batch_t m_batch;
+
 		std::unique_ptr< Timer_Thread > m_thread;
 	};
 
+namespace
+{
+
+//
+// current_thread_shard_key
+//
+/*!
+ * \brief Get a key for selection of a timer shard for the current thread.
+ *
+ * Every thread receives its own sequential number at the first call.
+ * It allows to distribute threads over the shards in round-robin manner.
+ *
+ * \since v.5.8.4
+ */
+[[nodiscard]]
+std::size_t
+current_thread_shard_key() noexcept
+	{
+		static std::atomic< std::size_t > s_counter{ 0u };
+		static thread_local const std::size_t s_key =
+				s_counter.fetch_add( 1u, std::memory_order_relaxed );
+
+		return s_key;
+	}
+
+} /* namespace anonymous */
+
+//
+// sharded_thread_t
+//
+/*!
+ * \brief An implementation of timer thread that consists of several
+ * independent timertt threads.
+ *
+ * A shard for a new timer is selected by the current thread. So timers
+ * scheduled from different threads are handled by different timertt
+ * threads and don't contend for the same lock.
+ *
+ * \note
+ * Every timer holds a pointer to its own shard. So deactivation of
+ * a timer is performed on the same shard that was used for activation.
+ *
+ * \tparam Timer_Thread A type of timertt-based thread which implements timers.
+ *
+ * \since v.5.8.4
+ */
+template< class Timer_Thread >
+class sharded_thread_t : public timer_thread_t
+	{
+		using timer_demand_t = actual_timer_t< Timer_Thread >;
+
+	public :
+		//! Type of container for shards.
+		using shards_container_t = std::vector< std::unique_ptr< Timer_Thread > >;
+
+		//! Initializing constructor.
+		sharded_thread_t(
+			//! Real timer threads.
+			//! There should be at least one item in the container.
+			shards_container_t shards )
+			:	m_batches( std::make_unique< expired_timers_batch_t[] >(
+					shards.size() ) )
+			,	m_shards( std::move( shards ) )
+			{
+				for( std::size_t i = 0u; i != m_shards.size(); ++i )
+					{
+						auto * batch = &m_batches[ i ];
+						m_shards[ i ]->set_expired_timers_processed_hook(
+								[batch]() noexcept { batch->flush(); } );
+					}
+			}
+
+		virtual void
+		start() override
+			{
+				std::size_t started = 0u;
+				try
+					{
+						for( ; started != m_shards.size(); ++started )
+							m_shards[ started ]->start();
+					}
+				catch( ... )
+					{
+						// Shards that are already started have to be stopped.
+						for( std::size_t i = 0u; i != started; ++i )
+							m_shards[ i ]->shutdown_and_join();
+						throw;
+					}
+			}
+
+		virtual void
+		finish() override
+			{
+				// Send shutdown signal to all shards first to allow
+				// them to finish in parallel.
+				for( auto & shard : m_shards )
+					shard->shutdown();
+				for( auto & shard : m_shards )
+					shard->join();
+			}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				const auto index = shard_index_for_current_thread();
+				auto & shard = *(m_shards[ index ]);
+
+				std::unique_ptr< timer_demand_t > timer{
+						new( m_timer_demands_pools.empty() ?
+									nullptr : m_timer_demands_pools[ index ].get() )
+								timer_demand_t( &shard ) };
+
+				shard.activate( timer->timer_holder(),
+						pause,
+						period,
+						timer_action_for_timer_thread_t(
+								outliving_mutable( m_batches[ index ] ),
+								type_index, mbox, msg ) );
+
+				return timer_id_t( timer.release() );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				const auto index = shard_index_for_current_thread();
+				m_shards[ index ]->activate(
+						pause,
+						period,
+						timer_action_for_timer_thread_t(
+								outliving_mutable( m_batches[ index ] ),
+								type_index, mbox, msg ) );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				timer_thread_stats_t result{ 0u, 0u, 0u };
+
+				for( std::size_t i = 0u; i != m_shards.size(); ++i )
+					{
+						auto d = m_shards[ i ]->get_timer_quantities();
+						result.m_single_shot_count += d.m_single_shot_count;
+						result.m_periodic_count += d.m_periodic_count;
+						result.m_fired_per_tick += m_batches[ i ].fired_per_tick();
+					}
+
+				return result;
+			}
+
+		/*!
+		 * Every shard gets its own pool, the \a count is divided
+		 * between shards.
+		 */
+		void
+		preallocate_timer_objects( std::size_t count ) override
+			{
+				// Pools can't be replaced because there can be
+				// timer objects allocated from them.
+				if( !m_pools.empty() || !count )
+					return;
+
+				const auto per_shard =
+						(count + m_shards.size() - 1u) / m_shards.size();
+
+				m_pools.reserve( m_shards.size() );
+				m_timer_demands_pools.reserve( m_shards.size() );
+				for( auto & shard : m_shards )
+					{
+						m_pools.push_back( std::make_unique< timer_objects_pool_t >(
+								Timer_Thread::timer_object_size(), per_shard ) );
+						shard->set_timer_object_allocator( m_pools.back().get() );
+
+						m_timer_demands_pools.push_back(
+								std::make_unique< timer_objects_pool_t >(
+										timer_demand_t::block_size, per_shard ) );
+					}
+			}
+
+	private :
+		//! Pools for timer objects.
+		/*!
+		 * It's empty if preallocation wasn't requested.
+		 *
+		 * \note
+		 * It's declared before m_shards because pools have to outlive
+		 * timer threads.
+		 */
+		std::vector< std::unique_ptr< timer_objects_pool_t > > m_pools;
+
+		//! Pools for timer demands returned as timer_id_t.
+		/*!
+		 * There is a separate pool for every shard.
+		 * It's empty if preallocation wasn't requested.
+		 *
+		 * \since v.5.8.4
+		 */
+		std::vector< std::unique_ptr< timer_objects_pool_t > > m_timer_demands_pools;
+
+		//! Collectors for messages from elapsed timers.
+		/*!
+		 * There is a separate collector for every shard.
+		 *
+		 * \note
+		 * It's declared before m_shards because collectors have to
+		 * outlive timer threads.
+		 */
+		std::unique_ptr< expired_timers_batch_t[] > m_batches;
+
+		shards_container_t m_shards;
+
+		[[nodiscard]]
+		std::size_t
+		shard_index_for_current_thread() const noexcept
+			{
+				return current_thread_shard_key() % m_shards.size();
+			}
+	};
+
 //
 // timer_action_for_timer_manager_t
 //
@@ -461,6 +1082,13 @@ using timer_list_thread_t = timertt::timer_list_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel thread type.
+using timer_hierarchical_wheel_thread_t =
+		timertt::timer_hierarchical_wheel_thread_template<
+				timer_action_for_timer_thread_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
 //! timer_wheel manager type.
 using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
 		timertt::thread_safety::unsafe,
@@ -481,6 +1109,14 @@ using timer_list_manager_t = timertt::timer_list_manager_template<
 		timer_action_for_timer_manager_t,
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel manager type.
+using timer_hierarchical_wheel_manager_t =
+		timertt::timer_hierarchical_wheel_manager_template<
+				timertt::thread_safety::unsafe,
+				timer_action_for_timer_manager_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
 /*!
  * \}
  */
@@ -564,6 +1200,84 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+
+		return create_timer_hierarchical_wheel_thread(
+				std::move(logger),
+				timertt_thread_t::default_levels(),
+				timertt_thread_t::default_wheel_size(),
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger,
+	unsigned int levels,
+	unsigned int wheel_size,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						levels,
+						wheel_size,
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_wheel_thread(
+	error_logger_shptr_t logger,
+	std::size_t shards_count )
+	{
+		using timertt_thread_t = timers_details::timer_wheel_thread_t;
+
+		return create_sharded_timer_wheel_thread(
+				std::move(logger),
+				shards_count,
+				timertt_thread_t::default_wheel_size(),
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_wheel_thread(
+	error_logger_shptr_t logger,
+	std::size_t shards_count,
+	unsigned int wheel_size,
+	std::chrono::steady_clock::duration granuality )
+	{
+		using timertt_thread_t = timers_details::timer_wheel_thread_t;
+		using namespace timers_details;
+
+		using actual_timer_thread_t = sharded_thread_t< timertt_thread_t >;
+
+		actual_timer_thread_t::shards_container_t shards;
+		shards.reserve( std::max( shards_count, std::size_t{1u} ) );
+		do
+			{
+				shards.push_back( std::make_unique< timertt_thread_t >(
+						wheel_size,
+						granuality,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+			}
+		while( shards.size() < shards_count );
+
+		return std::make_unique< actual_timer_thread_t >( std::move( shards ) );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_wheel_manager(
 	error_logger_shptr_t logger,
@@ -653,5 +1367,47 @@ create_timer_list_manager(
 				collector );
 	}
 
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+
+		return create_timer_hierarchical_wheel_manager(
+				std::move(logger),
+				collector,
+				timertt_manager_t::default_levels(),
+				timertt_manager_t::default_wheel_size(),
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector,
+	unsigned int levels,
+	unsigned int wheel_size,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+		using namespace timers_details;
+
+		auto manager = std::make_unique< timertt_manager_t >(
+				levels,
+				wheel_size,
+				granularity,
+				create_error_logger_for_timertt( logger ),
+				create_exception_handler_for_timertt_manager( logger ) );
+
+		return std::make_unique< actual_manager_t< timertt_manager_t > >(
+				std::move( manager ),
+				collector );
+	}
+
 } /* namespace so_5 */
 
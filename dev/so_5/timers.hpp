@@ -123,6 +123,18 @@ struct timer_thread_stats_t
 
 	//! Quantity of periodic timers.
 	std::size_t m_periodic_count;
+
+	//! Quantity of timers fired during the last tick.
+	/*!
+	 * Only ticks with at least one elapsed timer are taken into account.
+	 *
+	 * \note
+	 * This value is collected by timer threads only. It's always
+	 * zero for timer managers.
+	 *
+	 * \since v.5.8.4
+	 */
+	std::size_t m_fired_per_tick{ 0u };
 };
 
 //
@@ -204,6 +216,29 @@ class SO_5_TYPE timer_thread_t
 		 */
 		virtual timer_thread_stats_t
 		query_stats() = 0;
+
+		/*!
+		 * \brief Preallocate memory for timer objects.
+		 *
+		 * A timer thread can create a pool of \a count timer objects.
+		 * Objects from the pool are reused, so if the count of
+		 * simultaneously active timers doesn't exceed \a count then
+		 * scheduling of a timer doesn't allocate memory for timer object.
+		 * Objects behind timer_id_t returned by schedule() are also
+		 * taken from a pool of the same capacity.
+		 *
+		 * The default implementation does nothing.
+		 *
+		 * \note
+		 * This method is called by SObjectizer Environment before start()
+		 * if environment_params_t::timer_objects_preallocation() is
+		 * not zero.
+		 *
+		 * \since v.5.8.4
+		 */
+		virtual void
+		preallocate_timer_objects( std::size_t /*count*/ )
+			{}
 	};
 
 //! Auxiliary typedef for timer_thread autopointer.
@@ -289,6 +324,90 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * A hierarchical timer wheel consists of several levels of wheels.
+ * Every slot of a level covers the whole range of the previous level.
+ * It allows to handle a mix of very short and very long timers
+ * (e.g. 1ms and 1 hour) with O(1) amortized cost of insertion and
+ * cancellation.
+ *
+ * \note Default parameters will be used for timer thread:
+ * 4 levels, 256 slots per level, 1ms time step.
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \throw std::invalid_argument if parameters are invalid (\a levels is 0,
+ * \a wheel_size is less than 2, or \a granularity isn't positive).
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of levels.
+	unsigned int levels,
+	//! Size of the wheel for every level.
+	unsigned int wheel_size,
+	//! A size of one time step for the level 0.
+	std::chrono::steady_clock::duration granularity );
+
+/*!
+ * \brief Create a sharded timer thread based on timer_wheel mechanism.
+ *
+ * A sharded timer thread consists of several independent timer_wheel
+ * threads (shards). Every shard has its own lock and its own thread.
+ * A shard for a new timer is selected by the thread that schedules
+ * the timer: all timers from one thread go to the same shard, but
+ * different threads are distributed over the shards in round-robin
+ * manner. It reduces the contention on the timer lock if many
+ * worker threads send delayed/periodic messages at the same time.
+ *
+ * \note
+ * Default parameters will be used for every shard.
+ *
+ * \note
+ * Value 0 for \a shards_count is treated as 1.
+ *
+ * \since v.5.8.4
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of shards.
+	std::size_t shards_count );
+
+/*!
+ * \brief Create a sharded timer thread based on timer_wheel mechanism.
+ *
+ * \note
+ * Parameters must be specified explicitely. The same parameters will
+ * be used for every shard.
+ *
+ * \note
+ * Value 0 for \a shards_count is treated as 1.
+ *
+ * \since v.5.8.4
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of shards.
+	std::size_t shards_count,
+	//! Size of the wheel for every shard.
+	unsigned int wheel_size,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granuality );
 /*!
  * \}
  */
@@ -386,6 +505,120 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with default
+ * parameters.
+ *
+ * Usage example:
+ * \code
+ * so_5::launch( []( so_5::environment_t & env ) { ... },
+ * 	[]( so_5::environment_params_t & params ) {
+ * 		params.timer_thread( so_5::timer_hierarchical_wheel_factory() );
+ * 	} );
+ * \endcode
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_thread;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory(
+	//! Count of levels.
+	unsigned int levels,
+	//! Size of the wheel for every level.
+	unsigned int wheel_size,
+	//! A size of one time step for the level 0.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_thread;
+
+		return std::bind(
+				f,
+				std::placeholders::_1,
+				levels,
+				wheel_size,
+				granularity );
+	}
+
+/*!
+ * \brief Factory for sharded timer_wheel thread with default parameters
+ * for every shard.
+ *
+ * Usage example:
+ * \code
+ * so_5::launch( []( so_5::environment_t & env ) {...},
+ * 	[]( so_5::environment_params_t & params ) {
+ * 		params.timer_thread( so_5::sharded_timer_wheel_factory( 4u ) );
+ * 	} );
+ * \endcode
+ *
+ * \since v.5.8.4
+ */
+inline timer_thread_factory_t
+sharded_timer_wheel_factory(
+	//! Count of shards.
+	std::size_t shards_count )
+	{
+		// Use this trick because create_sharded_timer_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t, std::size_t ) =
+				create_sharded_timer_wheel_thread;
+
+		return std::bind(
+				f,
+				std::placeholders::_1,
+				shards_count );
+	}
+
+/*!
+ * \brief Factory for sharded timer_wheel thread with explicitely
+ * specified parameters.
+ *
+ * \since v.5.8.4
+ */
+inline timer_thread_factory_t
+sharded_timer_wheel_factory(
+	//! Count of shards.
+	std::size_t shards_count,
+	//! Size of the wheel for every shard.
+	unsigned int wheel_size,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_sharded_timer_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						std::size_t,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_sharded_timer_wheel_thread;
+
+		return std::bind(
+				f,
+				std::placeholders::_1,
+				shards_count,
+				wheel_size,
+				granularity );
+	}
 /*!
  * \}
  */
@@ -626,6 +859,36 @@ create_timer_list_manager(
 	//! A collector for elapsed timers.
 	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
 		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector,
+	//! Count of levels.
+	unsigned int levels,
+	//! Size of the wheel for every level.
+	unsigned int wheel_size,
+	//! A size of one time step for the level 0.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -738,6 +1001,57 @@ timer_list_manager_factory()
 	{
 		return &create_timer_list_manager;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with default
+ * parameters.
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+					error_logger_shptr_t,
+					outliving_reference_t<
+							timer_manager_t::elapsed_timers_collector_t > ) =
+				create_timer_hierarchical_wheel_manager;
+
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory(
+	//! Count of levels.
+	unsigned int levels,
+	//! Size of the wheel for every level.
+	unsigned int wheel_size,
+	//! A size of one time step for the level 0.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t >,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_manager;
+
+		return std::bind(
+				f,
+				std::placeholders::_1,
+				std::placeholders::_2,
+				levels,
+				wheel_size,
+				granularity );
+	}
 /*!
  * \}
  */
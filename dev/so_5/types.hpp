@@ -183,5 +183,29 @@ enum class message_delivery_mode_t
 		nonblocking
 	};
 
+//
+// local_mbox_subscribers_table_t
+//
+/*!
+ * \brief Possible types of the table of subscribers for standard
+ * MPMC mboxes.
+ *
+ * A standard MPMC mbox holds a table with a list of subscribers
+ * for every message type. This table is searched on every delivery
+ * of a message.
+ *
+ * \since v.5.8.4
+ */
+enum class local_mbox_subscribers_table_t
+	{
+		//! An ordered map with std::type_index as a key.
+		//! It's the default type.
+		std_map,
+		//! A flat hash table with open addressing.
+		//! Message types are searched by precomputed hash codes.
+		//! It's faster for mboxes with many message types.
+		flat_hash_table
+	};
+
 } /* namespace so_5 */
 
@@ -11,7 +11,7 @@
 
 #pragma once
 
-// The current version is 5.8.3
+// The current version is 5.8.4
 //
 /*!
  * A number next to generation number in SObjectizer's version.
@@ -31,7 +31,7 @@
  * When minor version is changed some new features are added to SObjectizer
  * but SObjectizer API is compatible on source-code level.
  */
-#define SO_5_VERSION_MINOR 3ull
+#define SO_5_VERSION_MINOR 4ull
 
 /*!
  * A number next to minor version in SObjectizer's version.
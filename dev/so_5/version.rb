@@ -1,4 +1,4 @@
 module So5
-  VERSION = "5.8.3"
+  VERSION = "5.8.4"
 end
 
@@ -6,5 +6,6 @@ MxxRu::Cpp::composite_target {
 	path = 'test/so_5/agent'
 
 	required_prj( "#{path}/agent_name/prj.ut.rb" )
+	required_prj( "#{path}/deadlines/prj.ut.rb" )
 }
 
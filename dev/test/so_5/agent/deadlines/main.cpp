@@ -0,0 +1,222 @@
+/*
+ * A unit-test for agent_t::so_set_deadline()/so_cancel_deadline().
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/ensure.hpp>
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <iostream>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace test
+{
+
+struct msg_timeout final : public so_5::message_t
+	{
+		int m_value;
+
+		msg_timeout( int value ) : m_value{ value } {}
+	};
+
+struct msg_cancelled final : public so_5::signal_t {};
+
+struct msg_finish final : public so_5::signal_t {};
+
+// Deadlines must be handled in the right order even if the agent is idle.
+// Cancelled deadlines must not be handled.
+class a_idle_agent_t final : public so_5::agent_t
+	{
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_idle_agent_t::evt_timeout )
+					.event( []( mhood_t< msg_cancelled > ) {
+							ensure_or_die( false, "msg_cancelled received" );
+						} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				m_started_at = std::chrono::steady_clock::now();
+
+				so_set_deadline< msg_timeout >( 60ms, 3 );
+				so_set_deadline< msg_timeout >( 20ms, 1 );
+				so_set_deadline< msg_timeout >( 40ms, 2 );
+
+				const auto id = so_set_deadline< msg_cancelled >( 30ms );
+				ensure_or_die( id.is_valid(), "deadline_id must be valid" );
+				ensure_or_die( so_cancel_deadline( id ),
+						"the first cancellation must succeed" );
+				ensure_or_die( !so_cancel_deadline( id ),
+						"the second cancellation must fail" );
+				ensure_or_die( !so_cancel_deadline( so_5::deadline_id_t{} ),
+						"cancellation of empty deadline_id must fail" );
+
+				// The slot of the cancelled deadline is reused.
+				// The old id must not cancel the new deadline.
+				const auto new_id = so_set_deadline< msg_timeout >( 80ms, 4 );
+				ensure_or_die( new_id != id, "ids must be different" );
+				ensure_or_die( !so_cancel_deadline( id ),
+						"the stale id must not cancel new deadline" );
+			}
+
+	private :
+		std::chrono::steady_clock::time_point m_started_at;
+		std::vector< int > m_received;
+
+		void
+		evt_timeout( mhood_t< msg_timeout > cmd )
+			{
+				const auto passed = std::chrono::steady_clock::now() - m_started_at;
+				ensure_or_die( passed >= cmd->m_value * 20ms,
+						"deadline is handled too early: " +
+								std::to_string( cmd->m_value ) );
+
+				m_received.push_back( cmd->m_value );
+				if( 4u == m_received.size() )
+					{
+						ensure_or_die(
+								( std::vector< int >{ 1, 2, 3, 4 } == m_received ),
+								"unexpected order of deadlines" );
+
+						so_deregister_agent_coop_normally();
+					}
+			}
+	};
+
+// Deadlines must be handled between events of a busy agent.
+class a_busy_agent_t final : public so_5::agent_t
+	{
+		struct msg_work final : public so_5::signal_t {};
+
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( [this]( mhood_t< msg_work > ) {
+							if( !m_timeout_received )
+								so_5::send< msg_work >( *this );
+						} )
+					.event( [this]( mhood_t< msg_timeout > ) {
+							m_timeout_received = true;
+							so_deregister_agent_coop_normally();
+						} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_set_deadline< msg_timeout >( 20ms, 0 );
+				so_5::send< msg_work >( *this );
+			}
+
+	private :
+		bool m_timeout_received{ false };
+	};
+
+// An agent is destroyed before its deadline.
+class a_short_living_agent_t final : public so_5::agent_t
+	{
+	public :
+		a_short_living_agent_t( context_t ctx, so_5::mbox_t finish_mbox )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_finish_mbox{ std::move(finish_mbox) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( []( mhood_t< msg_cancelled > ) {
+						ensure_or_die( false, "msg_cancelled received" );
+					} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_set_deadline< msg_cancelled >( 20ms );
+				so_deregister_agent_coop_normally();
+			}
+
+		void
+		so_evt_finish() override
+			{
+				// Wait for the wakeup signal for the destroyed agent.
+				so_5::send_delayed< msg_finish >( m_finish_mbox, 100ms );
+			}
+
+	private :
+		const so_5::mbox_t m_finish_mbox;
+	};
+
+class a_finisher_t final : public so_5::agent_t
+	{
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_finish > ) {
+						so_environment().stop();
+					} );
+			}
+	};
+
+template< typename Lambda >
+void
+run_case( const char * case_name, Lambda && lambda )
+	{
+		std::cout << case_name << "..." << std::flush;
+
+		so_5::launch( std::forward< Lambda >( lambda ) );
+
+		std::cout << "OK" << std::endl;
+	}
+
+} /* namespace test */
+
+using namespace test;
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			run_case( "idle_agent", []( so_5::environment_t & env ) {
+					env.register_agent_as_coop(
+							env.make_agent< a_idle_agent_t >() );
+				} );
+
+			run_case( "busy_agent", []( so_5::environment_t & env ) {
+					env.register_agent_as_coop(
+							env.make_agent< a_busy_agent_t >() );
+				} );
+
+			run_case( "short_living_agent", []( so_5::environment_t & env ) {
+					auto finisher = env.make_agent< a_finisher_t >();
+					const auto finish_mbox = finisher->so_direct_mbox();
+					env.register_agent_as_coop( std::move(finisher) );
+
+					env.register_agent_as_coop(
+							env.make_agent< a_short_living_agent_t >( finish_mbox ) );
+				} );
+		},
+		20 );
+
+	return 0;
+}
+
@@ -52,6 +52,8 @@ struct	cfg_t
 	pool_fifo_t m_fifo = pool_fifo_t::individual;
 
 	std::size_t m_next_thread_wakeup_threshold = 0;
+
+	bool m_lifo_slot = false;
 };
 
 cfg_t
@@ -87,6 +89,8 @@ try_parse_cmdline(
 							"-T, --threshold      value of next_thread_wakeup_threshold for\n"
 							"                     thread_pool and adv_thread_pool dispatchers\n"
 							"                     (defaule value: 0)\n"
+							"-l, --lifo-slot      use LIFO slots of worker threads for\n"
+							"                     thread_pool dispatcher\n"
 							"-h, --help           show this help"
 							<< std::endl;
 					std::exit( 1 );
@@ -150,6 +154,8 @@ try_parse_cmdline(
 				mandatory_arg_to_value(
 						tmp_cfg.m_next_thread_wakeup_threshold, ++current, last_arg,
 						"-T", "value of next_thread_wakeup_threshold param" );
+			else if( is_arg( *current, "-l", "--lifo-slot" ) )
+				tmp_cfg.m_lifo_slot = true;
 			else
 				throw std::runtime_error(
 						std::string( "unknown argument: " ) + *current );
@@ -290,6 +296,9 @@ show_cfg(
 			std::cout << "\n\t" "fifo: " << fifo_name( cfg.m_fifo )
 					<< "\n\t" "threshold: " << cfg.m_next_thread_wakeup_threshold;
 
+		if( dispatcher_type_t::thread_pool == cfg.m_dispatcher_type )
+			std::cout << "\n\t" "lifo slot: " << ( cfg.m_lifo_slot ? "yes" : "no" );
+
 		std::cout << std::endl;
 	}
 
@@ -384,6 +393,7 @@ create_disp_binder(
 					[&cfg]( bind_params_t & p ) {
 						if( pool_fifo_t::individual == cfg.m_fifo )
 							p.fifo( fifo_t::individual );
+						p.lifo_slot( cfg.m_lifo_slot );
 					} );
 		}
 		else if( dispatcher_type_t::adv_thread_pool == t )
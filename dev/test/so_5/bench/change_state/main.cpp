@@ -7,6 +7,7 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <memory>
 
 #include <so_5/all.hpp>
 
@@ -100,20 +101,111 @@ class a_test_t
 		std::vector< const so_5::state_t * > m_states;
 	};
 
+// Changes of states in a hierarchy of nested states.
+// There are two branches of states with the same depth. Every change
+// of state means leaving all states from one branch and entering
+// all states from another branch.
+class a_nested_test_t
+	:	public so_5::agent_t
+	{
+	public :
+		a_nested_test_t(
+			so_5::environment_t & env,
+			unsigned int iterations,
+			std::size_t depth )
+			:	so_5::agent_t( env )
+			,	m_iterations( iterations )
+			{
+				m_leafs[ 0 ] = make_branch( depth );
+				m_leafs[ 1 ] = make_branch( depth );
+			}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe( so_direct_mbox() )
+						.in( st_root ).event( &a_nested_test_t::evt_dummy );
+			}
+
+		void
+		so_evt_start() override
+			{
+				benchmarker_t bench;
+				bench.start();
+
+				unsigned long long changes = 0;
+				for( unsigned int i = 0; i != m_iterations; ++i )
+					{
+						for( auto sp : m_leafs )
+							{
+								so_change_state( *sp );
+								++changes;
+							}
+					}
+
+				bench.finish_and_show_stats( changes, "changes" );
+
+				so_environment().stop();
+			}
+
+		void
+		evt_dummy( mhood_t< msg_dummy > )
+			{
+			}
+
+	private :
+		so_5::state_t st_root{ this, "root" };
+
+		unsigned int m_iterations;
+
+		std::vector< std::unique_ptr< so_5::state_t > > m_states;
+
+		const so_5::state_t * m_leafs[ 2 ];
+
+		const so_5::state_t *
+		make_branch( std::size_t depth )
+			{
+				so_5::state_t * parent = &st_root;
+				for( std::size_t i = 0; i != depth; ++i )
+					{
+						m_states.push_back( std::make_unique< so_5::state_t >(
+								so_5::substate_of{ *parent } ) );
+						parent = m_states.back().get();
+					}
+
+				return parent;
+			}
+	};
+
 int
 main( int argc, char ** argv )
 {
 	try
 	{
 		const unsigned int tick_count =
-				static_cast< unsigned int >( 2 == argc ? std::atoi( argv[1] ) : 1000);
+				static_cast< unsigned int >( argc >= 2 ? std::atoi( argv[1] ) : 1000);
+		const std::size_t depth =
+				static_cast< std::size_t >( argc >= 3 ? std::atoi( argv[2] ) : 4 );
 
+		std::cout << "*** flat states ***" << std::endl;
 		so_5::launch(
 			[tick_count]( so_5::environment_t & env )
 			{
 				env.register_agent_as_coop(
 					env.make_agent< a_test_t >( tick_count ) );
 			} );
+
+		std::cout << "*** nested states, depth: " << depth << " ***"
+				<< std::endl;
+		so_5::launch(
+			[tick_count, depth]( so_5::environment_t & env )
+			{
+				env.register_agent_as_coop(
+					env.make_agent< a_nested_test_t >(
+						// There are just two states instead of 10.
+						tick_count * 5u,
+						depth ) );
+			} );
 	}
 	catch( const std::exception & ex )
 	{
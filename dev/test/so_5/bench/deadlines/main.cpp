@@ -0,0 +1,288 @@
+/*
+ * A benchmark for request deadlines that are cancelled before they fire.
+ *
+ * Compares agent_t::so_set_deadline()/so_cancel_deadline() with
+ * send_periodic() + timer_id_t::release().
+ */
+
+#include <iostream>
+#include <chrono>
+#include <sstream>
+#include <cstdlib>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+#include <test/3rd_party/various_helpers/cmd_line_args_helpers.hpp>
+
+namespace benchmark
+{
+
+enum class deadline_kind_t
+	{
+		agent_deadline,
+		timer_id
+	};
+
+const char *
+deadline_kind_name( deadline_kind_t kind )
+	{
+		if( deadline_kind_t::agent_deadline == kind )
+			return "agent_deadline";
+		else
+			return "timer_id";
+	}
+
+struct cfg_t
+	{
+		std::size_t m_agents = 4;
+		std::size_t m_requests = 1000;
+		std::size_t m_loops = 1000;
+
+		deadline_kind_t m_kind = deadline_kind_t::agent_deadline;
+	};
+
+cfg_t
+try_parse_cmdline(
+	int argc,
+	char ** argv )
+{
+	cfg_t tmp_cfg;
+
+	for( char ** current = &argv[ 1 ], **last = argv + argc;
+			current != last;
+			++current )
+		{
+			if( is_arg( *current, "-h", "--help" ) )
+				{
+					std::cout << "usage:\n"
+							"_test.bench.so_5.deadlines <options>\n"
+							"\noptions:\n"
+							"-a, --agents    count of agents\n"
+							"-r, --requests  count of pending requests for every agent\n"
+							"                in one loop\n"
+							"-l, --loops     loops to be done\n"
+							"-k, --kind      kind of deadlines\n"
+							"                allowed values: deadline, timer\n"
+							"-h, --help      show this description\n"
+							<< std::endl;
+					std::exit(1);
+				}
+			else if( is_arg( *current, "-a", "--agents" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_agents, ++current, last,
+						"-a", "count of agents" );
+			else if( is_arg( *current, "-r", "--requests" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_requests, ++current, last,
+						"-r", "count of pending requests" );
+			else if( is_arg( *current, "-l", "--loops" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_loops, ++current, last,
+						"-l", "loops to be done" );
+			else if( is_arg( *current, "-k", "--kind" ) )
+				{
+					std::string kind;
+					mandatory_arg_to_value( kind, ++current, last,
+							"-k", "kind of deadlines" );
+					if( "deadline" == kind )
+						tmp_cfg.m_kind = deadline_kind_t::agent_deadline;
+					else if( "timer" == kind )
+						tmp_cfg.m_kind = deadline_kind_t::timer_id;
+					else
+						throw std::runtime_error(
+								std::string( "unsupported kind of deadlines: " ) +
+										kind );
+				}
+			else
+				throw std::runtime_error(
+						std::string( "unknown argument: " ) + *current );
+		}
+
+	return tmp_cfg;
+}
+
+// Timeout for a request. Must never happen during the benchmark.
+struct msg_request_timeout final : public so_5::message_t
+	{
+		std::size_t m_request;
+
+		msg_request_timeout( std::size_t request ) : m_request{ request } {}
+	};
+
+struct msg_next_loop final : public so_5::signal_t {};
+
+struct msg_loops_finished final : public so_5::signal_t {};
+
+constexpr std::chrono::seconds request_timeout{ 30 };
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		a_worker_t(
+			context_t ctx,
+			const cfg_t & cfg,
+			so_5::mbox_t manager )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_cfg{ cfg }
+			,	m_manager{ std::move(manager) }
+			{
+				m_deadlines.resize( m_cfg.m_requests );
+				m_timers.resize( m_cfg.m_requests );
+			}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_worker_t::evt_next_loop )
+					.event( []( mhood_t< msg_request_timeout > cmd ) {
+							std::cerr << "unexpected timeout for request: "
+									<< cmd->m_request << std::endl;
+							std::abort();
+						} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_5::send< msg_next_loop >( *this );
+			}
+
+	private :
+		const cfg_t m_cfg;
+		const so_5::mbox_t m_manager;
+
+		std::size_t m_loop_index{};
+
+		std::vector< so_5::deadline_id_t > m_deadlines;
+		std::vector< so_5::timer_id_t > m_timers;
+
+		void
+		evt_next_loop( mhood_t< msg_next_loop > )
+			{
+				if( m_cfg.m_loops == m_loop_index )
+					{
+						so_5::send< msg_loops_finished >( m_manager );
+						return;
+					}
+				++m_loop_index;
+
+				if( deadline_kind_t::agent_deadline == m_cfg.m_kind )
+					{
+						// Requests are sent...
+						for( std::size_t i = 0; i != m_cfg.m_requests; ++i )
+							m_deadlines[ i ] =
+									so_set_deadline< msg_request_timeout >(
+											request_timeout, i );
+						// ...and replies are received.
+						for( auto id : m_deadlines )
+							so_cancel_deadline( id );
+					}
+				else
+					{
+						for( std::size_t i = 0; i != m_cfg.m_requests; ++i )
+							m_timers[ i ] = so_5::send_periodic< msg_request_timeout >(
+									*this,
+									request_timeout,
+									std::chrono::steady_clock::duration::zero(),
+									i );
+						for( auto & id : m_timers )
+							id.release();
+					}
+
+				so_5::send< msg_next_loop >( *this );
+			}
+	};
+
+class a_manager_t final : public so_5::agent_t
+	{
+	public :
+		a_manager_t( context_t ctx, const cfg_t & cfg )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_cfg{ cfg }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_manager_t::evt_loops_finished );
+			}
+
+		void
+		so_evt_start() override
+			{
+				m_benchmark.start();
+
+				for( std::size_t i = 0; i != m_cfg.m_agents; ++i )
+					introduce_child_coop( *this,
+						so_5::disp::active_obj::make_dispatcher(
+								so_environment() ).binder(),
+						[this]( so_5::coop_t & coop ) {
+							coop.make_agent< a_worker_t >( m_cfg, so_direct_mbox() );
+						} );
+			}
+
+	private :
+		const cfg_t m_cfg;
+
+		std::size_t m_finished{};
+
+		benchmarker_t m_benchmark;
+
+		void
+		evt_loops_finished( mhood_t< msg_loops_finished > )
+			{
+				if( m_cfg.m_agents == ++m_finished )
+					{
+						m_benchmark.finish_and_show_stats(
+								static_cast< unsigned long long >( m_cfg.m_agents ) *
+										m_cfg.m_loops * m_cfg.m_requests,
+								"deadlines" );
+
+						so_deregister_agent_coop_normally();
+					}
+			}
+	};
+
+} /* namespace benchmark */
+
+using namespace benchmark;
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		cfg_t cfg = try_parse_cmdline( argc, argv );
+		if( !cfg.m_agents || !cfg.m_requests )
+			{
+				std::ostringstream ss;
+				ss << "count of agents and requests can't be 0";
+
+				throw std::logic_error( ss.str() );
+			}
+
+		std::cout
+				<< "* agents: " << cfg.m_agents << "\n"
+				<< "* requests: " << cfg.m_requests << "\n"
+				<< "* loops: " << cfg.m_loops << "\n"
+				<< "* kind: " << deadline_kind_name( cfg.m_kind )
+				<< std::endl;
+
+		so_5::launch(
+			[cfg]( so_5::environment_t & env )
+			{
+				env.register_agent_as_coop( env.make_agent< a_manager_t >( cfg ) );
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -52,8 +52,20 @@ struct cfg_t
 				subscr_storage_type_t::map_based;
 
 		std::size_t m_vector_subscr_storage_capacity = 8;
+
+		so_5::local_mbox_subscribers_table_t m_mbox_subscribers_table =
+				so_5::local_mbox_subscribers_table_t::std_map;
 	};
 
+const char *
+mbox_subscribers_table_name( so_5::local_mbox_subscribers_table_t type )
+	{
+		if( so_5::local_mbox_subscribers_table_t::std_map == type )
+			return "std_map";
+		else
+			return "flat_hash_table";
+	}
+
 cfg_t
 try_parse_cmdline(
 	int argc,
@@ -79,6 +91,8 @@ try_parse_cmdline(
 							"                       allowed values: vector, map, hash, flat_set\n"
 							"-V, --vector-capacity  initial capacity of vector-based and "
 									"flat-set-based subscription storage\n"
+							"-T, --mbox-table       type of subscribers table for mboxes\n"
+							"                       allowed values: map, flat_hash\n"
 							"-h, --help        show this description\n"
 							<< std::endl;
 					std::exit(1);
@@ -104,6 +118,22 @@ try_parse_cmdline(
 						tmp_cfg.m_vector_subscr_storage_capacity, ++current, last,
 						"-V", "initial capacity on vector-based and flat-set-based"
 								"subscription storage" );
+			else if( is_arg( *current, "-T", "--mbox-table" ) )
+				{
+					std::string type;
+					mandatory_arg_to_value( type, ++current, last,
+							"-T", "type of subscribers table for mboxes" );
+					if( "map" == type )
+						tmp_cfg.m_mbox_subscribers_table =
+								so_5::local_mbox_subscribers_table_t::std_map;
+					else if( "flat_hash" == type )
+						tmp_cfg.m_mbox_subscribers_table =
+								so_5::local_mbox_subscribers_table_t::flat_hash_table;
+					else
+						throw std::runtime_error(
+								std::string( "unsupported mbox subscribers table type: " ) +
+										type );
+				}
 			else if( is_arg( *current, "-s", "--storage-type" ) )
 				{
 					std::string type;
@@ -301,7 +331,9 @@ class a_starter_stopper_t
 						<< "* msg_types: " << m_cfg.m_msg_types << "\n"
 						<< "* iterations: " << m_cfg.m_iterations << "\n"
 						<< "* subscr_storage: "
-						<< subscr_storage_name( m_cfg.m_subscr_storage )
+						<< subscr_storage_name( m_cfg.m_subscr_storage ) << "\n"
+						<< "* mbox_subscribers_table: "
+						<< mbox_subscribers_table_name( m_cfg.m_mbox_subscribers_table )
 						<< std::endl;
 				if( subscr_storage_type_t::vector_based == m_cfg.m_subscr_storage )
 					std::cout << "* vector_initial_capacity: "
@@ -414,7 +446,8 @@ class a_starter_stopper_t
 					duration_meter_t meter( "creating mboxes" );
 					m_mboxes.reserve( m_cfg.m_mboxes );
 					for( std::size_t i = 0; i != m_cfg.m_mboxes; ++i )
-						m_mboxes.emplace_back( so_environment().create_mbox() );
+						m_mboxes.emplace_back( so_environment().create_mbox(
+								m_cfg.m_mbox_subscribers_table ) );
 				}
 
 				auto coop = so_5::create_child_coop( *this );
@@ -1,5 +1,9 @@
 /*
  * A simple benchmark for select() and prepare_select() performance.
+ *
+ * Since v.5.8.4 there is also a producer-consumer case for receive()
+ * with and without bulk extraction of messages, for ordinary mchains
+ * and for mchains with lock-free queue.
  */
 
 #include <iostream>
@@ -7,6 +11,7 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <thread>
 
 #include <so_5/all.hpp>
 
@@ -78,6 +83,46 @@ prepared_receive_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_receive_case" );
 }
 
+void
+producer_consumer_case(
+	so_5::environment_t & env,
+	std::size_t bulk_size,
+	bool lock_free )
+{
+	const unsigned long long messages = max_iterations * 20u;
+
+	auto params = so_5::make_limited_with_waiting_mchain_params(
+			1024u,
+			so_5::mchain_props::memory_usage_t::preallocated,
+			so_5::mchain_props::overflow_reaction_t::throw_exception,
+			std::chrono::seconds(5) );
+	if( lock_free )
+		params.enable_lock_free_queue();
+
+	auto ch1 = env.create_mchain( params );
+
+	unsigned long long received = 0u;
+
+	benchmarker_t bench;
+	bench.start();
+
+	std::thread producer{ [&ch1, messages] {
+		for( unsigned long long i = 0u; i != messages; ++i )
+			so_5::send< unsigned long long >( ch1, i );
+	} };
+
+	so_5::receive(
+			from( ch1 ).handle_n( messages ).bulk_extraction( bulk_size ),
+			[&received]( unsigned long long ) { ++received; } );
+
+	producer.join();
+
+	bench.finish_and_show_stats( received,
+			std::string{ "producer_consumer_case(bulk=" } +
+					std::to_string( bulk_size ) +
+					( lock_free ? ",lock_free)" : ")" ) );
+}
+
 int
 main()
 {
@@ -88,6 +133,10 @@ main()
 			{
 				raw_receive_case( env );
 				prepared_receive_case( env );
+				producer_consumer_case( env, 1u, false );
+				producer_consumer_case( env, 64u, false );
+				producer_consumer_case( env, 1u, true );
+				producer_consumer_case( env, 64u, true );
 			} );
 	}
 	catch( const std::exception & ex )
@@ -7,6 +7,10 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <so_5/all.hpp>
 
@@ -78,6 +82,110 @@ prepared_select_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_select_case" );
 }
 
+//
+// Scaling cases.
+//
+// A token is passed through a ring of mchains. Only one mchain has a
+// message at any time, so the cost of one select() call should not depend
+// on the total count of mchains.
+//
+
+using chains_container_t = std::vector< so_5::mchain_t >;
+
+chains_container_t
+make_chains( so_5::environment_t & env, std::size_t count )
+{
+	chains_container_t result;
+	result.reserve( count );
+	std::generate_n( std::back_inserter( result ), count,
+			[&env] { return make_mchain( env ); } );
+	return result;
+}
+
+// Handler for a token. Token's value is the index of the current mchain.
+struct token_passer_t
+{
+	const chains_container_t & m_chains;
+
+	void
+	operator()( std::size_t index ) const
+	{
+		const auto next = (index + 1u) % m_chains.size();
+		so_5::send< std::size_t >( m_chains[ next ], next );
+	}
+};
+
+template< std::size_t... I >
+auto
+make_ring_prepared_select(
+	const chains_container_t & chains,
+	std::index_sequence< I... > )
+{
+	return so_5::prepare_select(
+			so_5::from_all().handle_n( 1 ).no_wait_on_empty(),
+			receive_case( chains[ I ], token_passer_t{ chains } )... );
+}
+
+template< std::size_t Chains_Count >
+void
+prepared_select_scaling_case( so_5::environment_t & env )
+{
+	const auto chains = make_chains( env, Chains_Count );
+
+	auto prepared = make_ring_prepared_select(
+			chains, std::make_index_sequence< Chains_Count >{} );
+
+	unsigned long long iterations = 0u;
+	const unsigned long long max_iterations = 100000u;
+
+	so_5::send< std::size_t >( chains.front(), 0u );
+
+	benchmarker_t bench;
+	bench.start();
+
+	while( iterations < max_iterations )
+	{
+		select( prepared );
+		++iterations;
+	}
+
+	bench.finish_and_show_stats( iterations,
+			"prepared_select_scaling_case(" + std::to_string( Chains_Count ) +
+			")" );
+}
+
+void
+extensible_select_scaling_case(
+	so_5::environment_t & env,
+	std::size_t chains_count )
+{
+	const auto chains = make_chains( env, chains_count );
+
+	auto extensible = so_5::make_extensible_select(
+			so_5::from_all().handle_n( 1 ).no_wait_on_empty() );
+	for( const auto & ch : chains )
+		so_5::add_select_cases( extensible,
+				receive_case( ch, token_passer_t{ chains } ) );
+
+	unsigned long long iterations = 0u;
+	const unsigned long long max_iterations = 100000u;
+
+	so_5::send< std::size_t >( chains.front(), 0u );
+
+	benchmarker_t bench;
+	bench.start();
+
+	while( iterations < max_iterations )
+	{
+		select( extensible );
+		++iterations;
+	}
+
+	bench.finish_and_show_stats( iterations,
+			"extensible_select_scaling_case(" + std::to_string( chains_count ) +
+			")" );
+}
+
 int
 main()
 {
@@ -88,6 +196,14 @@ main()
 			{
 				raw_select_case( env );
 				prepared_select_case( env );
+
+				prepared_select_scaling_case< 10 >( env );
+				prepared_select_scaling_case< 100 >( env );
+				prepared_select_scaling_case< 400 >( env );
+
+				extensible_select_scaling_case( env, 10 );
+				extensible_select_scaling_case( env, 100 );
+				extensible_select_scaling_case( env, 400 );
 			} );
 	}
 	catch( const std::exception & ex )
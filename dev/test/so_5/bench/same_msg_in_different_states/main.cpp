@@ -26,6 +26,7 @@ class a_test_t
 		a_test_t(
 			so_5::environment_t & env,
 			std::size_t states_count,
+			std::size_t nesting_depth,
 			int tick_count )
 			:	so_5::agent_t( env )
 			,	m_self_mbox( env.create_mbox() )
@@ -33,9 +34,22 @@ class a_test_t
 			,	m_messages_received( 0 )
 			{
 				for( size_t i = 0; i != states_count; ++i )
-					m_states.emplace_back(
-							std::make_shared< so_5::state_t >(
-									self_ptr(), "noname" ) );
+				{
+					// The message is handled in the top-most state,
+					// but the agent is switched to the most nested one.
+					auto top = std::make_shared< so_5::state_t >(
+							self_ptr(), "noname" );
+					m_top_states.push_back( top );
+
+					for( size_t d = 0; d != nesting_depth; ++d )
+					{
+						m_parent_states.push_back( top );
+						top = std::make_shared< so_5::state_t >(
+								so_5::substate_of{ *top }, "nested" );
+					}
+
+					m_states.push_back( top );
+				}
 
 				m_it_current_state = m_states.begin();
 			}
@@ -43,7 +57,7 @@ class a_test_t
 		void
 		so_define_agent() override
 			{
-				for( auto s : m_states )
+				for( auto s : m_top_states )
 					so_subscribe( m_self_mbox )
 							.in( *s )
 							.event( &a_test_t::evt_tick );
@@ -92,6 +106,8 @@ class a_test_t
 		std::uint_fast64_t m_messages_received;
 
 		std::vector< std::shared_ptr< so_5::state_t > > m_states;
+		std::vector< std::shared_ptr< so_5::state_t > > m_top_states;
+		std::vector< std::shared_ptr< so_5::state_t > > m_parent_states;
 		std::vector< std::shared_ptr< so_5::state_t > >::iterator m_it_current_state;
 
 		benchmarker_t m_benchmarker;
@@ -103,32 +119,44 @@ main( int argc, char ** argv )
 	try
 	{
 		std::size_t max_states = 16;
-		int tick_count = 100000;
+		int initial_tick_count = 100000;
+		std::size_t nesting_depth = 4;
 
-		if( 3 == argc )
+		if( 3 == argc || 4 == argc )
 		{
 			max_states = static_cast< std::size_t >(std::atoi( argv[1] ));
 			ensure( max_states > 0, "max_states must be >= 1" );
 
-			tick_count = std::atoi( argv[2] );
-			ensure( tick_count > 0, "tick_count must be >= 1" );
+			initial_tick_count = std::atoi( argv[2] );
+			ensure( initial_tick_count > 0, "tick_count must be >= 1" );
+
+			if( 4 == argc )
+				nesting_depth = static_cast< std::size_t >(std::atoi( argv[3] ));
 		}
 
-		for( std::size_t states = 1; states <= max_states; states *= 2 )
+		for( std::size_t depth : { std::size_t{0}, nesting_depth } )
 		{
-			std::cout << "*** benchmark for " << states << " state(s) ***"
-				<< std::endl;
-
-			so_5::launch(
-				[states, tick_count]( so_5::environment_t & env )
-				{
-					env.register_agent_as_coop(
-							env.make_agent< a_test_t >( states, tick_count ) );
-				} );
+			int tick_count = initial_tick_count;
+			for( std::size_t states = 1; states <= max_states; states *= 2 )
+			{
+				std::cout << "*** benchmark for " << states << " state(s)"
+					", nesting depth: " << depth << " ***" << std::endl;
+
+				so_5::launch(
+					[states, depth, tick_count]( so_5::environment_t & env )
+					{
+						env.register_agent_as_coop(
+								env.make_agent< a_test_t >(
+										states, depth, tick_count ) );
+					} );
+
+				tick_count /= 2;
+				if( tick_count < 10 )
+					tick_count = 10;
+			}
 
-			tick_count /= 2;
-			if( tick_count < 10 )
-				tick_count = 10;
+			if( 0 == nesting_depth )
+				break;
 		}
 	}
 	catch( const std::exception & ex )
@@ -28,7 +28,8 @@ enum class subscr_storage_type_t
 		vector_based,
 		map_based,
 		hash_table_based,
-		flat_set_based
+		flat_set_based,
+		flat_hash_table_based
 	};
 
 const char *
@@ -40,8 +41,10 @@ subscr_storage_name( subscr_storage_type_t type )
 			return "map_based";
 		else if( subscr_storage_type_t::hash_table_based == type )
 			return "hash_table_based";
-		else
+		else if( subscr_storage_type_t::flat_set_based == type )
 			return "flat_set_based";
+		else
+			return "flat_hash_table_based";
 	}
 
 struct cfg_t
@@ -49,6 +52,7 @@ struct cfg_t
 		std::size_t m_agents = 32;
 		std::size_t m_iterations = 10;
 		std::size_t m_loops = 20;
+		std::size_t m_extra_subscriptions = 0;
 
 		subscr_storage_type_t m_subscr_storage =
 				subscr_storage_type_t::map_based;
@@ -74,8 +78,12 @@ try_parse_cmdline(
 							"-i, --iterations       count of iterations for subscribe/unsubscribe\n"
 							"                       operations for every agent\n"
 							"-l, --loops            loops to be done\n"
+							"-x, --extra-subscriptions\n"
+							"                       count of permanent subscriptions\n"
+							"                       every agent has during the benchmark\n"
 							"-s, --storage-type     type of subscription storage\n"
-							"                       allowed values: vector, map, hash, flat_set\n"
+							"                       allowed values: vector, map, hash, flat_set,\n"
+							"                       flat_hash\n"
 							"-h, --help             show this description\n"
 							<< std::endl;
 					std::exit(1);
@@ -92,6 +100,10 @@ try_parse_cmdline(
 				mandatory_arg_to_value(
 						tmp_cfg.m_loops, ++current, last,
 						"-l", "loops to be done" );
+			else if( is_arg( *current, "-x", "--extra-subscriptions" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_extra_subscriptions, ++current, last,
+						"-x", "count of permanent subscriptions" );
 			else if( is_arg( *current, "-s", "--storage-type" ) )
 				{
 					std::string type;
@@ -105,6 +117,8 @@ try_parse_cmdline(
 						tmp_cfg.m_subscr_storage = subscr_storage_type_t::hash_table_based;
 					else if( "flat_set" == type )
 						tmp_cfg.m_subscr_storage = subscr_storage_type_t::flat_set_based;
+					else if( "flat_hash" == type )
+						tmp_cfg.m_subscr_storage = subscr_storage_type_t::flat_hash_table_based;
 					else
 						throw std::runtime_error(
 								std::string( "unsupported subscription storage type: " ) +
@@ -186,6 +200,9 @@ struct alice_msg final : public so_5::signal_t {};
 
 struct msg_next_loop : public so_5::signal_t {};
 
+// Type for permanent subscriptions.
+struct msg_extra final : public so_5::signal_t {};
+
 class a_worker_t
 	:	public so_5::agent_t
 	{
@@ -193,10 +210,15 @@ class a_worker_t
 		a_worker_t(
 			context_t ctx,
 			std::size_t iterations,
+			std::size_t extra_subscriptions,
 			so_5::subscription_storage_factory_t subscr_storage_factory )
 			:	so_5::agent_t{ ctx + subscr_storage_factory }
 			,	m_iterations{ iterations }
-			{}
+			{
+				for( std::size_t i = 0; i != extra_subscriptions; ++i )
+					so_subscribe( so_environment().create_mbox() )
+						.event( [](mhood_t<msg_extra>) {} );
+			}
 
 		void
 		set_next( so_5::mbox_t next )
@@ -380,8 +402,13 @@ class a_first_worker_t final : public a_worker_t
 			context_t ctx,
 			std::size_t loops,
 			std::size_t iterations,
+			std::size_t extra_subscriptions,
 			so_5::subscription_storage_factory_t subscr_storage_factory )
-			:	a_worker_t{ std::move(ctx), iterations, std::move(subscr_storage_factory) }
+			:	a_worker_t{
+					std::move(ctx),
+					iterations,
+					extra_subscriptions,
+					std::move(subscr_storage_factory) }
 			,	m_loops{ loops }
 			{}
 
@@ -454,9 +481,12 @@ factory_by_cfg( const cfg_t & cfg )
 			return map_based_subscription_storage_factory();
 		else if( subscr_storage_type_t::hash_table_based == type )
 			return hash_table_based_subscription_storage_factory();
-		else
+		else if( subscr_storage_type_t::flat_set_based == type )
 			return flat_set_based_subscription_storage_factory(
 					default_initial_capacity );
+		else
+			return flat_hash_table_based_subscription_storage_factory(
+					default_initial_capacity + cfg.m_extra_subscriptions );
 	}
 
 void
@@ -473,11 +503,13 @@ run_benchmark(
 			workers.push_back( coop.make_agent< a_first_worker_t >(
 					cfg.m_loops,
 					cfg.m_iterations,
+					cfg.m_extra_subscriptions,
 					factory ) );
 
 			for( std::size_t i = 1; i != cfg.m_agents; ++i )
 				workers.push_back( coop.make_agent< a_worker_t >(
 						cfg.m_iterations,
+						cfg.m_extra_subscriptions,
 						factory ) );
 
 			for( std::size_t i = 0; i != cfg.m_agents; ++i )
@@ -507,6 +539,7 @@ main( int argc, char ** argv )
 				<< "* agents: " << cfg.m_agents << "\n"
 				<< "* iterations: " << cfg.m_iterations << "\n"
 				<< "* loops: " << cfg.m_loops << "\n"
+				<< "* extra_subscriptions: " << cfg.m_extra_subscriptions << "\n"
 				<< "* subscr_storage: " << subscr_storage_name( cfg.m_subscr_storage )
 				<< std::endl;
 
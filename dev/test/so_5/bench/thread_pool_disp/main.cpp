@@ -33,7 +33,8 @@ default_thread_pool_size()
 enum class dispatcher_t
 	{
 		thread_pool,
-		adv_thread_pool
+		adv_thread_pool,
+		ws_thread_pool
 	};
 
 enum class lock_type_t
@@ -48,12 +49,14 @@ struct cfg_t
 		std::size_t m_agents = 512;
 		std::size_t m_messages = 100;
 		std::size_t m_demands_at_once = 0;
+		std::size_t m_adaptive_demands_limit = 0;
 		std::size_t m_threads = 0;
 		bool m_individual_fifo = false;
 		dispatcher_t m_dispatcher = dispatcher_t::thread_pool;
 		std::size_t m_messages_to_send_at_start = 1;
 		lock_type_t m_lock_type = lock_type_t::combined_lock;
 		bool m_track_activity = false;
+		bool m_compare = false;
 	};
 
 cfg_t
@@ -76,10 +79,17 @@ try_parse_cmdline(
 							"-a, --agents            count of agents in cooperation\n"
 							"-m, --messages          count of messages for every agent\n"
 							"-d, --demands-at-once   count consequently processed demands\n"
+							"-A, --adaptive-demands  upper bound for adaptive count of\n"
+							"                        consequently processed demands\n"
+							"                        (thread_pool only)\n"
 							"-S, --messages-at-start count of messages to be sent at start\n"
 							"-t, --threads           size of thread pool\n"
 							"-i, --individual-fifo   use individual FIFO for agents\n"
 							"-P, --adv-thread-pool   use adv_thread_pool dispatcher\n"
+							"-W, --ws-thread-pool    use ws_thread_pool dispatcher\n"
+							"-C, --compare           compare thread_pool, adv_thread_pool and\n"
+							"                        ws_thread_pool dispatchers with 4, 16\n"
+							"                        and 64 threads\n"
 							"-s, --simple-lock       use simple_lock_factory for MPMC queue\n"
 							"-T, --track-activity    turn work thread activity tracking on\n"
 							"-h, --help              show this description\n"
@@ -106,6 +116,11 @@ try_parse_cmdline(
 						tmp_cfg.m_demands_at_once, ++current, last,
 						"-d", "count of consequently processed demands" );
 
+			else if( is_arg( *current, "-A", "--adaptive-demands" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_adaptive_demands_limit, ++current, last,
+						"-A", "upper bound for adaptive count of demands" );
+
 			else if( is_arg( *current, "-S", "--messages-at-start" ) )
 				mandatory_arg_to_value(
 						tmp_cfg.m_messages_to_send_at_start, ++current, last,
@@ -122,6 +137,12 @@ try_parse_cmdline(
 			else if( is_arg( *current, "-P", "--adv-thread-pool" ) )
 				tmp_cfg.m_dispatcher = dispatcher_t::adv_thread_pool;
 
+			else if( is_arg( *current, "-W", "--ws-thread-pool" ) )
+				tmp_cfg.m_dispatcher = dispatcher_t::ws_thread_pool;
+
+			else if( is_arg( *current, "-C", "--compare" ) )
+				tmp_cfg.m_compare = true;
+
 			else if( is_arg( *current, "-s", "--simple-lock" ) )
 				tmp_cfg.m_lock_type = lock_type_t::simple_lock;
 
@@ -317,6 +338,10 @@ class a_contoller_t : public so_5::agent_t
 						params.fifo( fifo_t::individual );
 					if( m_cfg.m_demands_at_once )
 						params.max_demands_at_once( m_cfg.m_demands_at_once );
+					if( m_cfg.m_adaptive_demands_limit )
+						params.adaptive_demands_at_once(
+								params.query_max_demands_at_once(),
+								m_cfg.m_adaptive_demands_limit );
 					return params;
 				};
 
@@ -324,6 +349,31 @@ class a_contoller_t : public so_5::agent_t
 							so_environment(), "thread_pool", disp_params() )
 						.binder( bind_params() );
 			}
+			else if( dispatcher_t::ws_thread_pool == m_cfg.m_dispatcher )
+			{
+				using namespace so_5::disp::ws_thread_pool;
+
+				const auto disp_params = [&] {
+					disp_params_t params;
+					params.thread_count( threads );
+					if( lock_type_t::simple_lock == m_cfg.m_lock_type )
+						params.set_queue_params( queue_traits::queue_params_t{}
+								.lock_factory( queue_traits::simple_lock_factory() ) );
+					return params;
+				};
+				const auto bind_params = [&] {
+					bind_params_t params;
+					if( m_cfg.m_individual_fifo )
+						params.fifo( fifo_t::individual );
+					if( m_cfg.m_demands_at_once )
+						params.max_demands_at_once( m_cfg.m_demands_at_once );
+					return params;
+				};
+
+				m_binder = make_dispatcher(
+							so_environment(), "ws_thread_pool", disp_params() )
+						.binder( bind_params() );
+			}
 			else
 			{
 				using namespace so_5::disp::adv_thread_pool;
@@ -345,7 +395,7 @@ class a_contoller_t : public so_5::agent_t
 				};
 
 				m_binder = make_dispatcher(
-							so_environment(), "thread_pool", disp_params() )
+							so_environment(), "adv_thread_pool", disp_params() )
 						.binder( bind_params() );
 			}
 
@@ -353,6 +403,19 @@ class a_contoller_t : public so_5::agent_t
 		}
 };
 
+const char *
+dispatcher_name( dispatcher_t dispatcher )
+{
+	switch( dispatcher )
+	{
+		case dispatcher_t::thread_pool: return "thread_pool";
+		case dispatcher_t::adv_thread_pool: return "adv_thread_pool";
+		case dispatcher_t::ws_thread_pool: return "ws_thread_pool";
+	}
+
+	return "unknown";
+}
+
 void
 show_cfg( const cfg_t & cfg )
 {
@@ -364,15 +427,14 @@ show_cfg( const cfg_t & cfg )
 			<< std::endl;
 
 	std::cout << "\n" "dispatcher: "
-			<< (dispatcher_t::thread_pool == cfg.m_dispatcher ?
-					"thread_pool" : "adv_thread_pool")
+			<< dispatcher_name( cfg.m_dispatcher )
 			<< std::endl;
 	std::cout << "  MPMC queue lock: "
 			<< (lock_type_t::combined_lock == cfg.m_lock_type ?
 					"combined" : "simple")
 			<< std::endl;
 
-	if( dispatcher_t::thread_pool == cfg.m_dispatcher ) 
+	if( dispatcher_t::adv_thread_pool != cfg.m_dispatcher )
 	{
 		std::cout << "\n*** demands_at_once: ";
 		if( cfg.m_demands_at_once )
@@ -383,6 +445,11 @@ show_cfg( const cfg_t & cfg )
 				<< ")";
 	}
 
+	if( dispatcher_t::thread_pool == cfg.m_dispatcher &&
+			cfg.m_adaptive_demands_limit )
+		std::cout << "\n*** adaptive demands_at_once limit: "
+				<< cfg.m_adaptive_demands_limit;
+
 	std::cout << "\n*** threads in pool: ";
 	if( cfg.m_threads )
 		std::cout << cfg.m_threads;
@@ -410,6 +477,46 @@ show_cfg( const cfg_t & cfg )
 	std::cout << std::endl;
 }
 
+void
+run_benchmark( const cfg_t & cfg )
+{
+	so_5::launch(
+		[cfg]( so_5::environment_t & env )
+		{
+			env.register_agent_as_coop(
+					env.make_agent< a_contoller_t >( cfg ) );
+		},
+		[cfg]( so_5::environment_params_t & params )
+		{
+			if( cfg.m_track_activity )
+				params.turn_work_thread_activity_tracking_on();
+
+			// This timer thread doesn't consume resources without
+			// actual delayed/periodic messages.
+			params.timer_thread( so_5::timer_list_factory() );
+		});
+}
+
+void
+run_comparison( const cfg_t & cfg )
+{
+	for( const std::size_t threads : { 4u, 16u, 64u } )
+		for( const auto dispatcher :
+				{ dispatcher_t::thread_pool,
+					dispatcher_t::adv_thread_pool,
+					dispatcher_t::ws_thread_pool } )
+		{
+			cfg_t current = cfg;
+			current.m_threads = threads;
+			current.m_dispatcher = dispatcher;
+
+			std::cout << "\n=== " << dispatcher_name( dispatcher )
+					<< ", threads: " << threads << " ===" << std::endl;
+
+			run_benchmark( current );
+		}
+}
+
 int
 main( int argc, char ** argv )
 {
@@ -418,21 +525,10 @@ main( int argc, char ** argv )
 		cfg_t cfg = try_parse_cmdline( argc, argv );
 		show_cfg( cfg );
 
-		so_5::launch(
-			[cfg]( so_5::environment_t & env )
-			{
-				env.register_agent_as_coop(
-						env.make_agent< a_contoller_t >( cfg ) );
-			},
-			[cfg]( so_5::environment_params_t & params )
-			{
-				if( cfg.m_track_activity )
-					params.turn_work_thread_activity_tracking_on();
-
-				// This timer thread doesn't consume resources without
-				// actual delayed/periodic messages.
-				params.timer_thread( so_5::timer_list_factory() );
-			});
+		if( cfg.m_compare )
+			run_comparison( cfg );
+		else
+			run_benchmark( cfg );
 	}
 	catch( const std::exception & ex )
 	{
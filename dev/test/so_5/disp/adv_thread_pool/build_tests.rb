@@ -13,4 +13,6 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/so_5/disp/adv_thread_pool/custom_work_thread/prj.ut.rb" )
 	required_prj( "test/so_5/disp/adv_thread_pool/exception_from_safe_handler/prj.ut.rb" )
 	required_prj( "test/so_5/disp/adv_thread_pool/exception_from_safe_handler_2/prj.ut.rb" )
+	required_prj( "test/so_5/disp/adv_thread_pool/numa_nodes/prj.ut.rb" )
+	required_prj( "test/so_5/disp/adv_thread_pool/many_producers/prj.ut.rb" )
 }
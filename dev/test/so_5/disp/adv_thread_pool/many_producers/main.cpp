@@ -0,0 +1,189 @@
+/*
+ * A test for adv_thread_pool dispatcher: several producers send
+ * a mix of thread safe and thread unsafe messages to the same agent.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace atp_disp = so_5::disp::adv_thread_pool;
+
+constexpr std::size_t thread_count = 4u;
+constexpr unsigned int producer_count = 4u;
+constexpr unsigned int iterations = 2000u;
+constexpr unsigned int batch_size = 8u;
+
+// Every iteration of a producer sends one thread unsafe message,
+// one thread safe message and a batch of thread safe messages.
+constexpr unsigned int messages_per_iteration = 2u + batch_size;
+constexpr unsigned int total_messages =
+		producer_count * iterations * messages_per_iteration;
+
+struct msg_safe final : public so_5::message_t
+	{
+		unsigned int m_value;
+
+		msg_safe( unsigned int value ) : m_value{ value } {}
+	};
+
+struct msg_unsafe final : public so_5::message_t
+	{
+		unsigned int m_producer;
+		unsigned int m_seq;
+
+		msg_unsafe( unsigned int producer, unsigned int seq )
+			:	m_producer{ producer }
+			,	m_seq{ seq }
+			{}
+	};
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t(
+			context_t ctx,
+			std::atomic< unsigned int > & errors,
+			std::promise< void > & completed )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_errors{ errors }
+			,	m_completed{ completed }
+			,	m_last_seqs( producer_count, 0u )
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_receiver_t::evt_safe, so_5::thread_safe )
+					.event( &a_receiver_t::evt_unsafe );
+			}
+
+	private :
+		std::atomic< unsigned int > & m_errors;
+		std::promise< void > & m_completed;
+
+		std::atomic< unsigned int > m_safe_workers{ 0u };
+		std::atomic< unsigned int > m_unsafe_workers{ 0u };
+
+		std::atomic< unsigned int > m_handled{ 0u };
+
+		// Is modified only by thread unsafe handler.
+		std::vector< unsigned int > m_last_seqs;
+
+		void
+		evt_safe( mhood_t< msg_safe > )
+			{
+				++m_safe_workers;
+				if( 0u != m_unsafe_workers.load() )
+					++m_errors;
+				std::this_thread::yield();
+				--m_safe_workers;
+
+				account_handled();
+			}
+
+		void
+		evt_unsafe( mhood_t< msg_unsafe > cmd )
+			{
+				if( 0u != m_unsafe_workers.exchange( 1u ) )
+					++m_errors;
+				if( 0u != m_safe_workers.load() )
+					++m_errors;
+
+				// Thread unsafe messages from one producer have to be handled
+				// in the order of sending.
+				auto & last_seq = m_last_seqs[ cmd->m_producer ];
+				if( cmd->m_seq != last_seq + 1u )
+					++m_errors;
+				last_seq = cmd->m_seq;
+
+				m_unsafe_workers = 0u;
+
+				account_handled();
+			}
+
+		void
+		account_handled()
+			{
+				if( total_messages == m_handled.fetch_add( 1u ) + 1u )
+					m_completed.set_value();
+			}
+	};
+
+void
+do_test( atp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		std::atomic< unsigned int > errors{ 0u };
+		std::promise< void > completed;
+
+		so_5::wrapped_env_t sobj;
+
+		so_5::mbox_t receiver;
+		sobj.environment().introduce_coop(
+				atp_disp::make_dispatcher(
+						sobj.environment(),
+						"atp",
+						atp_disp::disp_params_t{}
+							.thread_count( thread_count )
+							.set_queue_params( atp_disp::queue_traits::queue_params_t{}
+								.lock_factory( lock_factory ) ) )
+					.binder(),
+				[&]( so_5::coop_t & coop ) {
+					receiver = coop.make_agent< a_receiver_t >(
+							errors, completed )->so_direct_mbox();
+				} );
+
+		std::vector< std::thread > producers;
+		for( unsigned int p = 0u; p != producer_count; ++p )
+			producers.emplace_back( [p, &receiver] {
+					std::vector< unsigned int > batch( batch_size, p );
+					for( unsigned int i = 0u; i != iterations; ++i )
+						{
+							so_5::send< msg_unsafe >( receiver, p, i + 1u );
+							so_5::send< msg_safe >( receiver, p );
+							so_5::send_batch< msg_safe >( receiver, batch );
+						}
+				} );
+
+		for( auto & t : producers )
+			t.join();
+
+		completed.get_future().wait();
+
+		sobj.stop_then_join();
+
+		ensure_or_die( 0u == errors.load(),
+				"violations of thread safety: " + std::to_string( errors.load() ) );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]() {
+				for_each_lock_factory( []( atp_disp::queue_traits::lock_factory_t f ) {
+						do_test( f );
+					} );
+			},
+			60 );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,11 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj( "so_5/prj.rb" )
+
+	target( "_unit.test.disp.adv_thread_pool.many_producers" )
+
+	cpp_source( "main.cpp" )
+}
+
@@ -0,0 +1,166 @@
+/*
+ * A test for NUMA-aware adv_thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+#include <atomic>
+
+namespace atp_disp = so_5::disp::adv_thread_pool;
+
+constexpr std::size_t node_count = 2u;
+constexpr std::size_t thread_count = 4u;
+constexpr unsigned int messages_per_agent = 200u;
+
+struct msg_work final : public so_5::signal_t {};
+
+struct msg_next final : public so_5::signal_t {};
+
+// Thread-safe handlers of the agent can be run on several worker threads
+// at the same time.
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		a_worker_t( context_t ctx, std::atomic< unsigned int > & invalid_nodes )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_invalid_nodes{ invalid_nodes }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( [this]( mhood_t< msg_work > ) {
+							check_current_node();
+							++m_handled;
+						},
+						so_5::thread_safe )
+					.event( [this]( mhood_t< msg_next > ) {
+							check_current_node();
+							if( messages_per_agent == m_handled.load() )
+								so_deregister_agent_coop_normally();
+							else
+								so_5::send< msg_next >( *this );
+						} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != messages_per_agent; ++i )
+					so_5::send< msg_work >( *this );
+				so_5::send< msg_next >( *this );
+			}
+
+	private :
+		std::atomic< unsigned int > & m_invalid_nodes;
+		std::atomic< unsigned int > m_handled{};
+
+		void
+		check_current_node()
+			{
+				if( so_5::disp::numa::current_thread_node() >= node_count )
+					++m_invalid_nodes;
+			}
+	};
+
+void
+do_test( atp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		std::atomic< unsigned int > invalid_nodes{};
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto disp = atp_disp::make_dispatcher(
+						env,
+						"numa",
+						atp_disp::disp_params_t{}
+							.thread_count( thread_count )
+							.numa_topology( so_5::disp::numa::topology_t{}
+								.add_node( {} )
+								.add_node( {} ) )
+							.set_queue_params( atp_disp::queue_traits::queue_params_t{}
+								.lock_factory( lock_factory ) ) );
+
+				env.introduce_coop(
+						disp.binder( atp_disp::bind_params_t{}.numa_node( 1u ) ),
+						[&]( so_5::coop_t & coop ) {
+							coop.make_agent< a_worker_t >( invalid_nodes );
+						} );
+				env.introduce_coop(
+						disp.binder( atp_disp::bind_params_t{} ),
+						[&]( so_5::coop_t & coop ) {
+							coop.make_agent< a_worker_t >( invalid_nodes );
+						} );
+			} );
+
+		ensure_or_die( 0u == invalid_nodes,
+				"events must be handled only on threads of NUMA nodes" );
+	}
+
+void
+do_invalid_node_test()
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto disp = atp_disp::make_dispatcher(
+						env,
+						"numa",
+						atp_disp::disp_params_t{}
+							.thread_count( thread_count )
+							.numa_topology( so_5::disp::numa::topology_t{}
+								.add_node( {} )
+								.add_node( {} ) ) );
+
+				try
+					{
+						std::atomic< unsigned int > invalid_nodes{};
+						env.introduce_coop(
+								disp.binder( atp_disp::bind_params_t{}.numa_node( 2u ) ),
+								[&]( so_5::coop_t & coop ) {
+									coop.make_agent< a_worker_t >( invalid_nodes );
+								} );
+
+						ensure_or_die( false, "an exception expected" );
+					}
+				catch( const so_5::exception_t & x )
+					{
+						// rc_invalid_numa_node is reported as the reason of
+						// the failure of binding.
+						ensure_or_die(
+								so_5::rc_agent_to_disp_binding_failed == x.error_code(),
+								"unexpected error code: " +
+										std::to_string( x.error_code() ) );
+					}
+
+				env.stop();
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]() {
+				for_each_lock_factory( []( atp_disp::queue_traits::lock_factory_t f ) {
+						do_test( f );
+					} );
+
+				do_invalid_node_test();
+			},
+			20 );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
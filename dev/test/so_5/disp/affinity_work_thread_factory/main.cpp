@@ -0,0 +1,254 @@
+/*
+ * A test for affinity-aware work thread factory.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../custom_work_thread.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+#if defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+// Error logger that counts logged messages.
+class counting_logger_t final : public so_5::error_logger_t
+	{
+	public :
+		counting_logger_t( std::atomic< unsigned int > & counter )
+			:	m_counter{ counter }
+			{}
+
+		void
+		log(
+			const char * file_name,
+			unsigned int line,
+			const std::string & message ) override
+			{
+				++m_counter;
+				std::cout << "logged: " << file_name << ":" << line
+						<< ": " << message << std::endl;
+			}
+
+	private :
+		std::atomic< unsigned int > & m_counter;
+	};
+
+// CPUs those are available for the process.
+so_5::disp::cpu_list_t
+available_cpus()
+	{
+		so_5::disp::cpu_list_t result;
+#if defined(__linux__)
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		if( 0 == sched_getaffinity( 0, sizeof(cpu_set), &cpu_set ) )
+			for( unsigned int i = 0; i != CPU_SETSIZE; ++i )
+				if( CPU_ISSET( i, &cpu_set ) )
+					result.push_back( i );
+#endif
+		if( result.empty() )
+			result.push_back( 0u );
+
+		return result;
+	}
+
+// Data collected by worker threads.
+struct thread_info_t
+	{
+		std::mutex m_lock;
+		std::set< std::size_t > m_indexes;
+		unsigned int m_mismatches{};
+	};
+
+void
+check_current_thread(
+	const so_5::disp::cpu_list_t & cpus,
+	thread_info_t & info,
+	std::size_t thread_index )
+	{
+		bool mismatch = false;
+#if defined(__linux__)
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		if( 0 == pthread_getaffinity_np(
+				pthread_self(), sizeof(cpu_set), &cpu_set ) )
+			{
+				mismatch = 1 != CPU_COUNT( &cpu_set ) ||
+						!CPU_ISSET( cpus[ thread_index % cpus.size() ], &cpu_set );
+			}
+
+		const auto tid = static_cast< id_t >( ::syscall( SYS_gettid ) );
+		if( 1 != ::getpriority( PRIO_PROCESS, tid ) )
+			mismatch = true;
+#else
+		(void)cpus;
+#endif
+
+		std::lock_guard< std::mutex > lock{ info.m_lock };
+		info.m_indexes.insert( thread_index );
+		if( mismatch )
+			++info.m_mismatches;
+	}
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_evt_start() override
+			{
+				so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+do_dispatchers_test()
+	{
+		constexpr unsigned int expected_threads = 7u;
+
+		const auto cpus = available_cpus();
+		thread_info_t info;
+		std::atomic< unsigned int > errors{};
+
+		auto actual_factory =
+				std::make_shared< disp_tests::custom_work_thread_factory_t >();
+
+		// The same factory is used for all dispatchers.
+		auto factory = so_5::disp::make_affinity_work_thread_factory(
+				so_5::disp::affinity_params_t{}
+					.round_robin_cpus( cpus )
+					.nice( 1 )
+					.thread_init_hook( [&]( std::size_t index ) {
+							check_current_thread( cpus, info, index );
+						} ),
+				actual_factory );
+
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent_with_binder< a_test_t >(
+								so_5::disp::one_thread::make_dispatcher( env, "ot",
+									so_5::disp::one_thread::disp_params_t{}
+										.work_thread_factory( factory ) ).binder() );
+					} );
+
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto disp = so_5::disp::active_obj::make_dispatcher( env, "ao",
+								so_5::disp::active_obj::disp_params_t{}
+									.work_thread_factory( factory ) );
+						coop.make_agent_with_binder< a_test_t >( disp.binder() );
+						coop.make_agent_with_binder< a_test_t >( disp.binder() );
+					} );
+
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent_with_binder< a_test_t >(
+								so_5::disp::thread_pool::make_dispatcher( env, "tp",
+									so_5::disp::thread_pool::disp_params_t{}
+										.thread_count( 3 )
+										.work_thread_factory( factory ) )
+									.binder( so_5::disp::thread_pool::bind_params_t{} ) );
+					} );
+
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						namespace prio_disp = so_5::disp::prio_one_thread::strictly_ordered;
+						coop.make_agent_with_binder< a_test_t >(
+								prio_disp::make_dispatcher( env, "prio",
+									prio_disp::disp_params_t{}
+										.work_thread_factory( factory ) ).binder() );
+					} );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				params.error_logger(
+						std::make_shared< counting_logger_t >( errors ) );
+			} );
+
+		ensure_or_die( expected_threads == actual_factory->created(),
+				"unexpected number of created threads" );
+		ensure_or_die( expected_threads == actual_factory->destroyed(),
+				"unexpected number of destroyed threads" );
+
+		ensure_or_die( expected_threads == info.m_indexes.size(),
+				"every thread has to get an unique index" );
+		ensure_or_die( expected_threads - 1u == *info.m_indexes.rbegin(),
+				"indexes of threads have to be sequential" );
+
+		// Errors are possible if the process can't change its
+		// scheduling parameters.
+		if( 0u == errors )
+			ensure_or_die( 0u == info.m_mismatches,
+					"affinity and nice value have to be applied" );
+	}
+
+void
+do_sched_fifo_test()
+	{
+		std::atomic< unsigned int > errors{};
+		std::atomic< bool > fifo_applied{ false };
+
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent_with_binder< a_test_t >(
+								so_5::disp::one_thread::make_dispatcher( env, "fifo",
+									so_5::disp::one_thread::disp_params_t{}
+										.work_thread_factory(
+											so_5::disp::make_affinity_work_thread_factory(
+												so_5::disp::affinity_params_t{}
+													.sched_fifo( 1 )
+													.thread_init_hook( [&]( std::size_t ) {
+#if defined(__linux__)
+															int policy{};
+															sched_param param{};
+															if( 0 == pthread_getschedparam(
+																	pthread_self(), &policy, &param ) )
+																fifo_applied = SCHED_FIFO == policy;
+#endif
+														} ) ) ) ).binder() );
+					} );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				params.error_logger(
+						std::make_shared< counting_logger_t >( errors ) );
+			} );
+
+#if defined(__linux__)
+		// SCHED_FIFO requires privileges. If they aren't available the error
+		// has to be reported, but the thread has to work anyway.
+		ensure_or_die( fifo_applied || 0u != errors,
+				"SCHED_FIFO has to be applied or an error has to be logged" );
+#endif
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]() {
+				do_dispatchers_test();
+				do_sched_fifo_test();
+			},
+			20 );
+	}
+	catch(const std::exception & ex)
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
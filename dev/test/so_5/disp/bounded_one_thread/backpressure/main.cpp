@@ -0,0 +1,344 @@
+/*
+ * A test for blocking of producers by bounded_one_thread dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <test/3rd_party/utest_helper/helper.hpp>
+
+#include <atomic>
+#include <future>
+#include <numeric>
+
+using namespace std::chrono_literals;
+
+namespace bounded_disp = so_5::disp::bounded_one_thread;
+
+struct msg_value final : public so_5::message_t
+{
+	int m_value;
+
+	explicit msg_value( int value ) : m_value{ value } {}
+};
+
+class a_slow_consumer_t final : public so_5::agent_t
+{
+	std::atomic< int > & m_sent;
+	std::vector< int > & m_received;
+	int & m_max_lag;
+	std::atomic< int > & m_processed;
+
+public:
+	a_slow_consumer_t(
+		context_t ctx,
+		std::atomic< int > & sent,
+		std::vector< int > & received,
+		int & max_lag,
+		std::atomic< int > & processed )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_sent{ sent }
+		,	m_received{ received }
+		,	m_max_lag{ max_lag }
+		,	m_processed{ processed }
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_value > cmd ) {
+				std::this_thread::sleep_for( 2ms );
+
+				m_received.push_back( cmd->m_value );
+				m_max_lag = std::max( m_max_lag,
+						m_sent.load() - static_cast<int>(m_received.size()) );
+
+				++m_processed;
+			} );
+	}
+};
+
+class a_blocked_consumer_t final : public so_5::agent_t
+{
+public:
+	a_blocked_consumer_t(
+		context_t ctx,
+		std::shared_future< void > may_continue,
+		std::atomic< int > & received )
+		:	so_5::agent_t{ std::move(ctx) }
+	{
+		so_subscribe_self().event(
+				[may_continue, &received]( mhood_t< msg_value > ) {
+					may_continue.wait();
+					++received;
+				} );
+	}
+};
+
+class a_self_sender_t final : public so_5::agent_t
+{
+	const int m_messages;
+	int & m_received;
+
+public:
+	a_self_sender_t( context_t ctx, int messages, int & received )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_messages{ messages }
+		,	m_received{ received }
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_value > cmd ) {
+				++m_received;
+				if( m_messages - 1 == cmd->m_value )
+					so_environment().stop();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		// The queue will be full after the second message.
+		// But the worker thread must not be blocked.
+		for( int i = 0; i != m_messages; ++i )
+			so_5::send< msg_value >( *this, i );
+	}
+};
+
+UT_UNIT_TEST( producer_is_blocked )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr std::size_t capacity = 4u;
+			constexpr int messages = 100;
+
+			std::atomic< int > sent{ 0 };
+			std::vector< int > received;
+			int max_lag = 0;
+			std::atomic< int > processed{ 0 };
+
+			{
+				so_5::wrapped_env_t env;
+
+				so_5::mbox_t dest;
+				env.environment().introduce_coop(
+						bounded_disp::make_dispatcher(
+								env.environment(),
+								"bounded",
+								bounded_disp::disp_params_t{}.capacity(
+										capacity, 10s ) ).binder(),
+						[&]( so_5::coop_t & coop ) {
+							dest = coop.make_agent< a_slow_consumer_t >(
+									sent, received, max_lag, processed )->so_direct_mbox();
+						} );
+
+				for( int i = 0; i != messages; ++i )
+				{
+					so_5::send< msg_value >( dest, i );
+					++sent;
+				}
+
+				// Wait for the processing of all messages.
+				while( messages != processed.load() )
+					std::this_thread::sleep_for( 10ms );
+			}
+
+			std::vector< int > expected( messages );
+			std::iota( expected.begin(), expected.end(), 0 );
+			UT_CHECK_CONDITION( expected == received );
+
+			// There are no more than `capacity` messages in the queue plus
+			// the message that is being processed.
+			std::cout << "max_lag: " << max_lag << std::endl;
+			UT_CHECK_CONDITION( max_lag <= static_cast<int>(capacity) + 1 );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( drop_newest_after_timeout )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr int messages = 5;
+
+			std::promise< void > consumer_may_continue;
+			auto consumer_future = consumer_may_continue.get_future().share();
+
+			std::atomic< int > received{ 0 };
+
+			so_5::wrapped_env_t env;
+
+			so_5::mbox_t dest;
+			env.environment().introduce_coop(
+					bounded_disp::make_dispatcher(
+							env.environment(),
+							"bounded",
+							bounded_disp::disp_params_t{}.capacity(
+									1u,
+									50ms,
+									bounded_disp::overflow_reaction_t::drop_newest )
+						).binder(),
+					[&]( so_5::coop_t & coop ) {
+						dest = coop.make_agent< a_blocked_consumer_t >(
+								consumer_future, received )->so_direct_mbox();
+					} );
+
+			// The consumer is blocked on the first message, the second
+			// message is stored in the queue, the rest are dropped after
+			// the timeout.
+			const auto started_at = std::chrono::steady_clock::now();
+			for( int i = 0; i != messages; ++i )
+				so_5::send< msg_value >( dest, i );
+			const auto duration = std::chrono::steady_clock::now() - started_at;
+
+			consumer_may_continue.set_value();
+
+			UT_CHECK_CONDITION( duration >= 100ms );
+
+			const auto deadline = std::chrono::steady_clock::now() + 5s;
+			while( 2 != received.load() &&
+					std::chrono::steady_clock::now() < deadline )
+				std::this_thread::sleep_for( 10ms );
+
+			// Give a chance for dropped messages to arrive (they must not).
+			std::this_thread::sleep_for( 50ms );
+			UT_CHECK_CONDITION( 2 == received.load() );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( throw_exception_after_timeout )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr int messages = 5;
+
+			std::promise< void > consumer_may_continue;
+			auto consumer_future = consumer_may_continue.get_future().share();
+
+			std::atomic< int > received{ 0 };
+
+			so_5::wrapped_env_t env;
+
+			so_5::mbox_t dest;
+			env.environment().introduce_coop(
+					bounded_disp::make_dispatcher(
+							env.environment(),
+							"bounded",
+							// throw_exception is the default reaction.
+							bounded_disp::disp_params_t{}.capacity(
+									1u, 50ms ) ).binder(),
+					[&]( so_5::coop_t & coop ) {
+						dest = coop.make_agent< a_blocked_consumer_t >(
+								consumer_future, received )->so_direct_mbox();
+					} );
+
+			int exceptions = 0;
+			for( int i = 0; i != messages; ++i )
+			{
+				try
+				{
+					so_5::send< msg_value >( dest, i );
+				}
+				catch( const so_5::exception_t & x )
+				{
+					UT_CHECK_CONDITION(
+							so_5::rc_bounded_disp_queue_overflow == x.error_code() );
+					++exceptions;
+				}
+			}
+
+			consumer_may_continue.set_value();
+
+			// The first message is being processed, the second is stored
+			// in the queue.
+			UT_CHECK_CONDITION( messages - 2 == exceptions );
+
+			while( 2 != received.load() )
+				std::this_thread::sleep_for( 10ms );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( send_from_worker_thread )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr int messages = 1000;
+
+			int received = 0;
+
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+							bounded_disp::make_dispatcher(
+									env,
+									"bounded",
+									bounded_disp::disp_params_t{}.capacity(
+											2u, 10s ) ).binder(),
+							[&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_self_sender_t >( messages, received );
+							} );
+				} );
+
+			UT_CHECK_CONDITION( messages == received );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( delayed_messages )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr int messages = 20;
+
+			std::promise< void > consumer_may_continue;
+			auto consumer_future = consumer_may_continue.get_future().share();
+
+			std::atomic< int > received{ 0 };
+
+			so_5::wrapped_env_t env;
+
+			so_5::mbox_t dest;
+			env.environment().introduce_coop(
+					bounded_disp::make_dispatcher(
+							env.environment(),
+							"bounded",
+							bounded_disp::disp_params_t{}.capacity(
+									1u, 10s ) ).binder(),
+					[&]( so_5::coop_t & coop ) {
+						dest = coop.make_agent< a_blocked_consumer_t >(
+								consumer_future, received )->so_direct_mbox();
+					} );
+
+			for( int i = 0; i != messages; ++i )
+				so_5::send_delayed< msg_value >( dest, 10ms, i );
+
+			// The timer thread must not be blocked while the consumer waits.
+			// So a delayed message to another agent has to be delivered.
+			auto ch = so_5::create_mchain( env );
+			so_5::send_delayed< msg_value >( ch, 100ms, -1 );
+
+			std::size_t extracted = 0u;
+			so_5::receive( so_5::from( ch ).handle_n( 1 ).empty_timeout( 5s ),
+					[&extracted]( so_5::mhood_t< msg_value > ) { ++extracted; } );
+			UT_CHECK_CONDITION( 1u == extracted );
+
+			consumer_may_continue.set_value();
+
+			while( messages != received.load() )
+				std::this_thread::sleep_for( 10ms );
+		},
+		20 );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( producer_is_blocked )
+	UT_RUN_UNIT_TEST( drop_newest_after_timeout )
+	UT_RUN_UNIT_TEST( throw_exception_after_timeout )
+	UT_RUN_UNIT_TEST( send_from_worker_thread )
+	UT_RUN_UNIT_TEST( delayed_messages )
+
+	return 0;
+}
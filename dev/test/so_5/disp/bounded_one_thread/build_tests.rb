@@ -0,0 +1,10 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+path = 'test/so_5/disp/bounded_one_thread'
+
+MxxRu::Cpp::composite_target {
+
+	required_prj "#{path}/simple/prj.ut.rb"
+	required_prj "#{path}/backpressure/prj.ut.rb"
+}
@@ -6,14 +6,18 @@ MxxRu::Cpp::composite_target {
 
 	add_test[ 'binder/build_tests.rb' ]
 
+	required_prj 'test/so_5/disp/affinity_work_thread_factory/prj.ut.rb'
+
 	add_test[ 'one_thread/build_tests.rb' ]
 	add_test[ 'nef_one_thread/build_tests.rb' ]
+	add_test[ 'bounded_one_thread/build_tests.rb' ]
 	add_test[ 'active_obj/build_tests.rb' ]
 	add_test[ 'active_group/build_tests.rb' ]
 
 	add_test[ 'thread_pool/build_tests.rb' ]
 	add_test[ 'adv_thread_pool/build_tests.rb' ]
 	add_test[ 'nef_thread_pool/build_tests.rb' ]
+	add_test[ 'ws_thread_pool/build_tests.rb' ]
 
 	add_test[ 'private_dispatchers/build_tests.rb' ]
 
@@ -0,0 +1,363 @@
+/*
+ * A test for LIFO slots of worker threads of thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <vector>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+struct msg_ping final : public so_5::message_t
+	{
+		so_5::mbox_t m_reply_to;
+
+		msg_ping( so_5::mbox_t reply_to ) : m_reply_to{ std::move(reply_to) } {}
+	};
+
+struct msg_pong final : public so_5::signal_t {};
+
+struct msg_stop final : public so_5::signal_t {};
+
+struct msg_request final : public so_5::signal_t {};
+
+// Thread IDs of ping-pong handlers of one chain.
+//
+// NOTE: there is just one message in flight in a chain, so handlers
+// can't modify the log at the same time.
+using thread_log_t = std::vector< so_5::current_thread_id_t >;
+
+class a_ponger_t final : public so_5::agent_t
+	{
+	public :
+		a_ponger_t( context_t ctx, thread_log_t & log )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_log{ log }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_ping > cmd ) {
+						m_log.push_back( so_5::query_current_thread_id() );
+						so_5::send< msg_pong >( cmd->m_reply_to );
+					} );
+			}
+
+	private :
+		thread_log_t & m_log;
+	};
+
+class a_pinger_t final : public so_5::agent_t
+	{
+	public :
+		a_pinger_t(
+			context_t ctx,
+			thread_log_t & log,
+			so_5::mbox_t ponger,
+			// The stopper is informed when that count of hops is passed.
+			// But the chain is finished only when the stop flag is set.
+			unsigned int hops,
+			so_5::mbox_t stopper,
+			const std::atomic< bool > & stop )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_log{ log }
+			,	m_ponger{ std::move(ponger) }
+			,	m_hops{ hops }
+			,	m_stopper{ std::move(stopper) }
+			,	m_stop{ stop }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_pong > ) {
+						m_log.push_back( so_5::query_current_thread_id() );
+
+						++m_hops_passed;
+						if( m_hops == m_hops_passed )
+							so_5::send< msg_stop >( m_stopper );
+
+						if( m_stop.load() )
+							so_deregister_agent_coop_normally();
+						else
+							next_ping();
+					} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				next_ping();
+			}
+
+	private :
+		thread_log_t & m_log;
+		const so_5::mbox_t m_ponger;
+		const unsigned int m_hops;
+		const so_5::mbox_t m_stopper;
+		const std::atomic< bool > & m_stop;
+
+		unsigned int m_hops_passed{};
+
+		void
+		next_ping()
+			{
+				so_5::send< msg_ping >( m_ponger, so_direct_mbox() );
+			}
+	};
+
+class a_stopper_t final : public so_5::agent_t
+	{
+	public :
+		a_stopper_t(
+			context_t ctx,
+			// Count of msg_stop to be received before setting the flag.
+			unsigned int chains,
+			std::atomic< bool > & stop )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_chains{ chains }
+			,	m_stop{ stop }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_stop > ) {
+						if( 0u == --m_chains )
+							m_stop = true;
+					} );
+			}
+
+	private :
+		unsigned int m_chains;
+		std::atomic< bool > & m_stop;
+	};
+
+// A chain of requests and responses has to be handled on the same
+// worker thread while all worker threads are busy.
+//
+// NOTE: the LIFO slot isn't used if there are sleeping threads. So there
+// are as many chains as worker threads.
+void
+do_locality_test( tp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		constexpr std::size_t chains = 2u;
+		constexpr unsigned int hops = 1000u;
+
+		std::vector< thread_log_t > logs( chains );
+		for( auto & l : logs )
+			l.reserve( 4u * hops );
+		std::atomic< bool > stop{ false };
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto binder = tp_disp::make_dispatcher(
+						env,
+						"lifo",
+						tp_disp::disp_params_t{}
+							.thread_count( chains )
+							.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+								.lock_factory( lock_factory ) ) )
+					.binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual )
+						.lifo_slot( true ) );
+
+				env.introduce_coop( binder, [&]( so_5::coop_t & coop ) {
+						// The stopper works on the default dispatcher to
+						// avoid any interference with the chains.
+						auto stopper = coop.make_agent_with_binder< a_stopper_t >(
+								so_5::make_default_disp_binder( env ),
+								static_cast< unsigned int >( chains ),
+								stop );
+						for( auto & l : logs )
+							{
+								auto ponger = coop.make_agent< a_ponger_t >( l );
+								coop.make_agent< a_pinger_t >(
+										l,
+										ponger->so_direct_mbox(),
+										hops,
+										stopper->so_direct_mbox(),
+										stop );
+							}
+					} );
+			} );
+
+		for( const auto & l : logs )
+			{
+				ensure_or_die( 2u * hops <= l.size(),
+						"unexpected count of handled messages: " +
+								std::to_string( l.size() ) );
+
+				// Handlers of the first and the last hops can be run on
+				// different threads because chains are started and
+				// finished at different moments.
+				std::size_t switches = 0u;
+				for( std::size_t i = 1u; i != l.size(); ++i )
+					if( l[ i - 1u ] != l[ i ] )
+						++switches;
+
+				ensure_or_die( switches <= l.size() / 10u,
+						"too many switches between threads: " +
+								std::to_string( switches ) );
+			}
+	}
+
+// Endless chain of requests and responses must not prevent handling of
+// other agents on the same worker thread.
+void
+do_starvation_test( tp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		thread_log_t log;
+		std::atomic< bool > stop{ false };
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto disp = tp_disp::make_dispatcher(
+						env,
+						"lifo",
+						tp_disp::disp_params_t{}
+							.thread_count( 1u )
+							.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+								.lock_factory( lock_factory ) ) );
+
+				env.introduce_coop(
+					disp.binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual )
+						.lifo_slot( true ) ),
+					[&]( so_5::coop_t & coop ) {
+						auto stopper = coop.make_agent_with_binder< a_stopper_t >(
+								disp.binder( tp_disp::bind_params_t{}
+									.fifo( tp_disp::fifo_t::individual ) ),
+								1u,
+								stop );
+						auto ponger = coop.make_agent< a_ponger_t >( log );
+						// The chain is endless. It's finished only when
+						// the stopper is called.
+						coop.make_agent< a_pinger_t >(
+								log,
+								ponger->so_direct_mbox(),
+								1u,
+								stopper->so_direct_mbox(),
+								stop );
+					} );
+			} );
+
+		ensure_or_die( stop.load(), "the stopper has to be called" );
+	}
+
+class a_replier_t final : public so_5::agent_t
+	{
+	public :
+		a_replier_t( context_t ctx, std::promise< void > & reply )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_reply{ reply }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_request > ) {
+						m_reply.set_value();
+					} );
+			}
+
+	private :
+		std::promise< void > & m_reply;
+	};
+
+class a_requester_t final : public so_5::agent_t
+	{
+	public :
+		a_requester_t(
+			context_t ctx,
+			so_5::mbox_t replier,
+			std::promise< void > & reply,
+			bool & replied )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_replier{ std::move(replier) }
+			,	m_reply{ reply }
+			,	m_replied{ replied }
+			{}
+
+		void
+		so_evt_start() override
+			{
+				so_5::send< msg_request >( m_replier );
+
+				// The handler is blocked until the reply is received.
+				// The replier must be handled by another thread.
+				m_replied = std::future_status::ready ==
+						m_reply.get_future().wait_for( std::chrono::seconds{ 2 } );
+
+				so_deregister_agent_coop_normally();
+			}
+
+	private :
+		const so_5::mbox_t m_replier;
+		std::promise< void > & m_reply;
+		bool & m_replied;
+	};
+
+// A message sent by a blocked event handler must not wait in the LIFO
+// slot while there are idle worker threads.
+void
+do_blocked_handler_test( tp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		std::promise< void > reply;
+		bool replied{ false };
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto binder = tp_disp::make_dispatcher(
+						env,
+						"lifo",
+						tp_disp::disp_params_t{}
+							.thread_count( 4u )
+							.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+								.lock_factory( lock_factory ) ) )
+					.binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual )
+						.lifo_slot( true ) );
+
+				env.introduce_coop( binder, [&]( so_5::coop_t & coop ) {
+						auto replier = coop.make_agent< a_replier_t >( reply );
+						coop.make_agent< a_requester_t >(
+								replier->so_direct_mbox(),
+								reply,
+								replied );
+					} );
+			} );
+
+		ensure_or_die( replied, "the replier has to be handled by another thread" );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]() {
+				for_each_lock_factory( []( tp_disp::queue_traits::lock_factory_t f ) {
+						do_locality_test( f );
+						do_starvation_test( f );
+						do_blocked_handler_test( f );
+					} );
+			},
+			30 );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,260 @@
+/*
+ * A test for NUMA-aware thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+#include "../../custom_work_thread.hpp"
+
+#include <atomic>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+constexpr std::size_t node_count = 2u;
+constexpr std::size_t thread_count = 4u;
+constexpr std::size_t agent_count = 8u;
+constexpr unsigned int messages_per_agent = 200u;
+
+struct msg_next final : public so_5::signal_t {};
+
+struct msg_done final : public so_5::signal_t {};
+
+// Counters of handled events for every NUMA node.
+struct node_stats_t
+	{
+		std::atomic< unsigned int > m_events[ node_count ]{};
+		std::atomic< unsigned int > m_invalid_nodes{};
+	};
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		a_worker_t(
+			context_t ctx,
+			so_5::mbox_t manager,
+			node_stats_t & stats )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_manager{ std::move(manager) }
+			,	m_stats{ stats }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_next > ) {
+						account_current_node();
+						if( ++m_received < messages_per_agent )
+							so_5::send< msg_next >( *this );
+						else
+							so_5::send< msg_done >( m_manager );
+					} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				account_current_node();
+				so_5::send< msg_next >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_manager;
+		node_stats_t & m_stats;
+
+		unsigned int m_received{};
+
+		void
+		account_current_node()
+			{
+				const auto node = so_5::disp::numa::current_thread_node();
+				if( node < node_count )
+					++m_stats.m_events[ node ];
+				else
+					++m_stats.m_invalid_nodes;
+			}
+	};
+
+class a_manager_t final : public so_5::agent_t
+	{
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+						if( agent_count == ++m_done )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+	private :
+		std::size_t m_done{};
+	};
+
+void
+do_test( tp_disp::queue_traits::lock_factory_t lock_factory )
+	{
+		node_stats_t stats;
+		auto factory = std::make_shared< disp_tests::custom_work_thread_factory_t >();
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto disp = tp_disp::make_dispatcher(
+								env,
+								"numa",
+								tp_disp::disp_params_t{}
+									.thread_count( thread_count )
+									.work_thread_factory( factory )
+									.numa_topology( so_5::disp::numa::topology_t{}
+										.add_node( {} )
+										.add_node( {} ) )
+									.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+										.lock_factory( lock_factory ) ) );
+
+						auto manager = coop.make_agent< a_manager_t >();
+
+						for( std::size_t i = 0; i != agent_count; ++i )
+							{
+								tp_disp::bind_params_t params;
+								params.fifo( tp_disp::fifo_t::individual );
+								// Half of agents are bound to nodes explicitly,
+								// the rest are bound in round-robin manner.
+								if( i % 2u )
+									params.numa_node( i % node_count );
+
+								coop.make_agent_with_binder< a_worker_t >(
+										disp.binder( params ),
+										manager->so_direct_mbox(),
+										stats );
+							}
+					} );
+			} );
+
+		ensure_or_die( 0u == stats.m_invalid_nodes,
+				"events must be handled only on threads of NUMA nodes" );
+		// Threads of a node can handle queues of another node if they have
+		// nothing to do with queues of their own node. So only the total
+		// count of events can be checked.
+		ensure_or_die(
+				agent_count * ( messages_per_agent + 1u ) ==
+						stats.m_events[ 0 ] + stats.m_events[ 1 ],
+				"unexpected count of handled events" );
+
+		// Threads for all nodes have to be taken from the custom factory.
+		ensure_or_die( thread_count == factory->created(),
+				"unexpected number of created threads" );
+		ensure_or_die( thread_count == factory->destroyed(),
+				"unexpected number of destroyed threads" );
+	}
+
+void
+do_invalid_node_test()
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				auto disp = tp_disp::make_dispatcher(
+						env,
+						"numa",
+						tp_disp::disp_params_t{}
+							.thread_count( thread_count )
+							.numa_topology( so_5::disp::numa::topology_t{}
+								.add_node( {} )
+								.add_node( {} ) ) );
+
+				try
+					{
+						env.introduce_coop(
+								disp.binder( tp_disp::bind_params_t{}.numa_node( 2u ) ),
+								[]( so_5::coop_t & coop ) {
+									coop.make_agent< a_manager_t >();
+								} );
+
+						ensure_or_die( false, "an exception expected" );
+					}
+				catch( const so_5::exception_t & x )
+					{
+						// rc_invalid_numa_node is reported as the reason of
+						// the failure of binding.
+						ensure_or_die(
+								so_5::rc_agent_to_disp_binding_failed == x.error_code(),
+								"unexpected error code: " +
+										std::to_string( x.error_code() ) );
+					}
+
+				env.stop();
+			} );
+	}
+
+class a_node_checker_t final : public so_5::agent_t
+	{
+	public :
+		a_node_checker_t( context_t ctx, std::size_t expected_node )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_expected_node{ expected_node }
+			{}
+
+		void
+		so_evt_start() override
+			{
+				ensure_or_die(
+						m_expected_node == so_5::disp::numa::current_thread_node(),
+						"unexpected NUMA node" );
+
+				so_deregister_agent_coop_normally();
+			}
+
+	private :
+		const std::size_t m_expected_node;
+	};
+
+void
+do_node_factory_test()
+	{
+		const auto topology = so_5::disp::numa::detect_topology();
+		ensure_or_die( !topology.empty(), "topology can't be empty" );
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto disp = so_5::disp::one_thread::make_dispatcher(
+								env,
+								"node_3",
+								so_5::disp::one_thread::disp_params_t{}
+									.work_thread_factory(
+										so_5::disp::numa::make_node_work_thread_factory(
+												3u, topology.node_cpus( 0u ) ) ) );
+
+						coop.make_agent_with_binder< a_node_checker_t >(
+								disp.binder(), 3u );
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]() {
+				for_each_lock_factory( []( tp_disp::queue_traits::lock_factory_t f ) {
+						do_test( f );
+					} );
+
+				do_invalid_node_test();
+				do_node_factory_test();
+			},
+			20 );
+	}
+	catch(const std::exception & ex)
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
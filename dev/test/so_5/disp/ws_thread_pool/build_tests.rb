@@ -0,0 +1,11 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::composite_target {
+
+	path = 'test/so_5/disp/ws_thread_pool'
+
+	required_prj( "#{path}/simple/prj.ut.rb" )
+	required_prj( "#{path}/cooperation_fifo/prj.ut.rb" )
+	required_prj( "#{path}/individual_fifo/prj.ut.rb" )
+}
@@ -0,0 +1,253 @@
+/*
+ * A for ws_thread_pool dispatcher (individual_fifo mechanism).
+ *
+ * Checks that messages from the same sender are handled by an agent
+ * in the order of sending and that handlers of an agent are never
+ * called in parallel.
+ *
+ * NOTE: there is no check for agents migration between worker threads
+ * because ws_thread_pool tries to keep an agent's queue on the thread
+ * that activated it.
+ */
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <iterator>
+#include <exception>
+#include <stdexcept>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+namespace tp_disp = so_5::disp::ws_thread_pool;
+
+struct msg_shutdown : public so_5::signal_t {};
+
+//! Kind of a sender of msg_seq.
+enum class sender_t : std::size_t
+	{
+		//! Message is sent by an agent to itself.
+		self = 0,
+		//! Message is sent by the previous agent in the ring.
+		neighbour = 1
+	};
+
+struct msg_seq : public so_5::message_t
+	{
+		sender_t m_sender;
+		unsigned int m_seq;
+
+		msg_seq( sender_t sender, unsigned int seq )
+			:	m_sender{ sender }
+			,	m_seq{ seq }
+			{}
+	};
+
+const unsigned int messages_per_sender = 10;
+
+class a_test_t : public so_5::agent_t
+{
+	// Checks that handlers of the agent aren't called in parallel.
+	class handler_guard_t
+		{
+		public :
+			handler_guard_t( a_test_t & owner )
+				:	m_owner( owner )
+			{
+				if( m_owner.m_in_handler.exchange( true ) )
+					++m_owner.m_errors;
+			}
+
+			~handler_guard_t()
+			{
+				m_owner.m_in_handler = false;
+			}
+
+		private :
+			a_test_t & m_owner;
+		};
+
+	public:
+		a_test_t(
+			so_5::environment_t & env,
+			std::atomic< unsigned int > & errors,
+			const so_5::mbox_t & shutdowner_mbox )
+			:	so_5::agent_t( env )
+			,	m_errors( errors )
+			,	m_shutdowner_mbox( shutdowner_mbox )
+		{
+		}
+
+		void
+		set_next( const so_5::mbox_t & next )
+		{
+			m_next = next;
+		}
+
+		void
+		so_define_agent() override
+		{
+			so_subscribe_self().event( &a_test_t::evt_seq );
+		}
+
+		void
+		so_evt_start() override
+		{
+			handler_guard_t guard{ *this };
+
+			so_5::send< msg_seq >( *this, sender_t::self, 0u );
+			so_5::send< msg_seq >( m_next, sender_t::neighbour, 0u );
+		}
+
+		void
+		evt_seq( mhood_t< msg_seq > cmd )
+		{
+			handler_guard_t guard{ *this };
+
+			auto & expected = m_expected[ static_cast< std::size_t >(
+					cmd->m_sender ) ];
+			if( expected != cmd->m_seq )
+				++m_errors;
+			expected = cmd->m_seq + 1u;
+
+			if( expected != messages_per_sender )
+			{
+				if( sender_t::self == cmd->m_sender )
+					so_5::send< msg_seq >( *this, sender_t::self, expected );
+				else
+					so_5::send< msg_seq >( m_next, sender_t::neighbour, expected );
+			}
+			else if( ++m_finished_senders == std::size( m_expected ) )
+				so_5::send< msg_shutdown >( m_shutdowner_mbox );
+		}
+
+	private :
+		std::atomic< unsigned int > & m_errors;
+		const so_5::mbox_t m_shutdowner_mbox;
+		so_5::mbox_t m_next;
+
+		std::atomic< bool > m_in_handler{ false };
+
+		unsigned int m_expected[ 2 ]{ 0u, 0u };
+		std::size_t m_finished_senders{ 0u };
+};
+
+class a_shutdowner_t : public so_5::agent_t
+{
+	public :
+		a_shutdowner_t(
+			so_5::environment_t & env,
+			std::size_t working_agents )
+			:	so_5::agent_t( env )
+			,	m_working_agents( working_agents )
+		{}
+
+		void
+		so_define_agent() override
+		{
+			so_subscribe_self().event( [this](mhood_t< msg_shutdown >) {
+					--m_working_agents;
+					if( !m_working_agents )
+						so_environment().stop();
+				} );
+		}
+
+	private :
+		std::size_t m_working_agents;
+};
+
+const std::size_t cooperation_count = 128; // 1000;
+const std::size_t cooperation_size = 128; // 100;
+const std::size_t thread_count = 8;
+
+const std::size_t total_agent_count = cooperation_count * cooperation_size;
+
+void
+run_sobjectizer(
+	tp_disp::queue_traits::lock_factory_t factory,
+	std::atomic< unsigned int > & errors )
+{
+	duration_meter_t duration( "running of test cooperations" );
+
+	so_5::launch(
+		[&]( so_5::environment_t & env )
+		{
+			so_5::mbox_t shutdowner_mbox;
+			{
+				auto c = env.make_coop();
+				auto a = c->make_agent< a_shutdowner_t >( total_agent_count );
+				shutdowner_mbox = a->so_direct_mbox();
+				env.register_coop( std::move( c ) );
+			}
+
+			auto disp = tp_disp::make_dispatcher(
+					env, "ws_thread_pool",
+					tp_disp::disp_params_t{}
+						.thread_count( thread_count )
+						.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+								.lock_factory( factory ) ) );
+
+			tp_disp::bind_params_t bind_params;
+			bind_params.fifo( tp_disp::fifo_t::individual );
+			bind_params.max_demands_at_once( 2 );
+			for( std::size_t i = 0; i != cooperation_count; ++i )
+			{
+				auto c = env.make_coop( disp.binder( bind_params ) );
+
+				// Agents of a cooperation form a ring.
+				std::vector< a_test_t * > agents;
+				agents.reserve( cooperation_size );
+				for( std::size_t a = 0; a != cooperation_size; ++a )
+					agents.push_back( c->make_agent< a_test_t >(
+							errors, shutdowner_mbox ) );
+				for( std::size_t a = 0; a != cooperation_size; ++a )
+					agents[ a ]->set_next(
+							agents[ (a + 1) % cooperation_size ]->so_direct_mbox() );
+
+				env.register_coop( std::move( c ) );
+			}
+		} );
+}
+
+void
+run_and_check(
+	tp_disp::queue_traits::lock_factory_t factory )
+{
+	std::atomic< unsigned int > errors{ 0u };
+
+	run_sobjectizer( factory, errors );
+
+	ensure_or_die( 0u == errors.load(),
+			"violations of FIFO order or parallel execution of handlers: " +
+					std::to_string( errors.load() ) );
+}
+
+int
+main()
+{
+	try
+	{
+		for_each_lock_factory( []( tp_disp::queue_traits::lock_factory_t factory ) {
+			run_with_time_limit(
+				[&]()
+				{
+					run_and_check( factory );
+				},
+				240,
+				"individual_fifo test" );
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"test/so_5/disp/ws_thread_pool/individual_fifo/prj.ut.rb",
+		"test/so_5/disp/ws_thread_pool/individual_fifo/prj.rb" )
+)
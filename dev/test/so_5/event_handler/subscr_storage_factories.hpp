@@ -20,6 +20,8 @@ build_subscr_storage_factories()
 			,	{ "flat_set[1]"s, so_5::flat_set_based_subscription_storage_factory( 1 ) }
 			,	{ "flat_set[8]"s, so_5::flat_set_based_subscription_storage_factory( 8 ) }
 			,	{ "flat_set[16]"s, so_5::flat_set_based_subscription_storage_factory( 16 ) }
+			,	{ "flat_hash_table[1]"s, so_5::flat_hash_table_based_subscription_storage_factory( 1 ) }
+			,	{ "flat_hash_table[64]"s, so_5::flat_hash_table_based_subscription_storage_factory( 64 ) }
 			,	{ "default"s, so_5::default_subscription_storage_factory() }
 		};
 	}
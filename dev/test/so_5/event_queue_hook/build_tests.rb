@@ -6,4 +6,6 @@ MxxRu::Cpp::composite_target {
 	path = 'test/so_5/event_queue_hook'
 
 	required_prj "#{path}/simple/prj.ut.rb"
+	required_prj "#{path}/push_batch/prj.ut.rb"
+	required_prj "#{path}/send_batch/prj.ut.rb"
 }
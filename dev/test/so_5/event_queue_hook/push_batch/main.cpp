@@ -0,0 +1,209 @@
+/*
+ * Test for event_queue_t::push_batch().
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+struct msg_value final : public so_5::message_t
+{
+	const int m_value;
+
+	msg_value( int value ) : m_value( value ) {}
+};
+
+constexpr int batch_size = 250;
+
+class test_event_queue_t final : public so_5::event_queue_t
+{
+	so_5::event_queue_t * m_actual;
+
+public :
+	test_event_queue_t( so_5::event_queue_t * actual )
+		:	m_actual( actual )
+	{}
+
+	void
+	push( so_5::execution_demand_t demand ) override
+	{
+		m_actual->push( std::move(demand) );
+	}
+
+	void
+	push_evt_start( so_5::execution_demand_t demand ) override
+	{
+		m_actual->push_evt_start( std::move(demand) );
+	}
+
+	void
+	push_evt_finish( so_5::execution_demand_t demand ) noexcept override
+	{
+		m_actual->push_evt_finish( std::move(demand) );
+	}
+};
+
+class test_event_queue_hook_t final : public so_5::event_queue_hook_t
+{
+	const bool m_wrap_queue;
+
+	std::atomic< so_5::event_queue_t * > m_queue{ nullptr };
+
+public :
+	test_event_queue_hook_t( bool wrap_queue )
+		:	m_wrap_queue( wrap_queue )
+	{}
+
+	[[nodiscard]]
+	so_5::event_queue_t *
+	on_bind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * original_queue ) noexcept override
+	{
+		so_5::event_queue_t * q = original_queue;
+		if( m_wrap_queue )
+			q = new test_event_queue_t( original_queue );
+
+		m_queue = q;
+		return q;
+	}
+
+	void
+	on_unbind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * queue ) noexcept override
+	{
+		if( m_wrap_queue )
+			delete queue;
+	}
+
+	[[nodiscard]]
+	so_5::event_queue_t &
+	queue() const noexcept { return *(m_queue.load()); }
+};
+
+class test_agent_t final : public so_5::agent_t
+{
+	const test_event_queue_hook_t & m_hook;
+
+	int m_expected{ 0 };
+
+public :
+	test_agent_t(
+		context_t ctx,
+		const test_event_queue_hook_t & hook )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_hook( hook )
+	{
+		so_subscribe_self().event( &test_agent_t::on_value );
+	}
+
+	void
+	so_evt_start() override
+	{
+		std::vector< so_5::execution_demand_t > demands;
+		demands.reserve( batch_size );
+		for( int i = 0; i != batch_size; ++i )
+			demands.emplace_back(
+					this,
+					nullptr,
+					so_direct_mbox()->id(),
+					typeid(msg_value),
+					so_5::message_ref_t{ std::make_unique< msg_value >( i ) },
+					so_5::agent_t::get_demand_handler_on_message_ptr() );
+
+		// An empty batch should be ignored.
+		m_hook.queue().push_batch( demands.data(), 0u );
+
+		m_hook.queue().push_batch( demands.data(), demands.size() );
+	}
+
+private :
+	void
+	on_value( mhood_t< msg_value > cmd )
+	{
+		ensure_or_die( m_expected == cmd->m_value,
+				"unexpected value: " + std::to_string( cmd->m_value ) +
+				", expected: " + std::to_string( m_expected ) );
+
+		++m_expected;
+		if( batch_size == m_expected )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+using binder_factory_t = std::function<
+		so_5::disp_binder_shptr_t( so_5::environment_t & ) >;
+
+void
+run_case(
+	const char * case_name,
+	bool wrap_queue,
+	binder_factory_t binder_factory )
+{
+	std::cout << case_name << (wrap_queue ? " (wrapped)" : "")
+			<< ": " << std::flush;
+
+	test_event_queue_hook_t hook{ wrap_queue };
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.register_agent_as_coop(
+					env.make_agent< test_agent_t >( hook ),
+					binder_factory( env ) );
+		},
+		[&]( so_5::environment_params_t & params ) {
+			params.event_queue_hook(
+					so_5::event_queue_hook_unique_ptr_t(
+							&hook,
+							&so_5::event_queue_hook_t::noop_deleter ) );
+		} );
+
+	std::cout << "OK" << std::endl;
+}
+
+void
+do_test()
+{
+	const std::pair< const char *, binder_factory_t > cases[] = {
+		{ "one_thread", []( so_5::environment_t & env ) {
+				return so_5::disp::one_thread::make_dispatcher( env ).binder();
+			} },
+		{ "one_thread[lock_free]", []( so_5::environment_t & env ) {
+				namespace disp = so_5::disp::one_thread;
+				return disp::make_dispatcher( env, "lock_free",
+						disp::disp_params_t{}.tune_queue_params(
+							[]( disp::queue_traits::queue_params_t & p ) {
+								p.lock_factory(
+										disp::queue_traits::lock_free_queue_lock_factory() );
+							} ) ).binder();
+			} },
+		{ "thread_pool", []( so_5::environment_t & env ) {
+				return so_5::disp::thread_pool::make_dispatcher( env, 2u )
+						.binder( so_5::disp::thread_pool::bind_params_t{} );
+			} },
+		{ "nef_thread_pool", []( so_5::environment_t & env ) {
+				return so_5::disp::nef_thread_pool::make_dispatcher( env, 2u )
+						.binder( so_5::disp::nef_thread_pool::bind_params_t{} );
+			} },
+		{ "adv_thread_pool", []( so_5::environment_t & env ) {
+				return so_5::disp::adv_thread_pool::make_dispatcher( env, 2u )
+						.binder( so_5::disp::adv_thread_pool::bind_params_t{} );
+			} }
+	};
+
+	for( const auto & c : cases )
+	{
+		run_case( c.first, false, c.second );
+		run_case( c.first, true, c.second );
+	}
+}
+
+int main()
+{
+	run_with_time_limit( do_test, 20 );
+}
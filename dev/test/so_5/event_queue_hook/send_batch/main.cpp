@@ -0,0 +1,236 @@
+/*
+ * Test for delivery of batches created by send_batch() via
+ * event_queue_t::push_batch().
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <typeindex>
+
+struct msg_value final : public so_5::message_t
+{
+	const int m_value;
+
+	msg_value( int value ) : m_value( value ) {}
+};
+
+struct msg_done final : public so_5::signal_t {};
+
+constexpr int batch_size = 10;
+
+// Counters for demands with msg_value only.
+std::atomic< int > push_calls{ 0 };
+std::atomic< int > push_batch_calls{ 0 };
+std::atomic< int > demands_in_batches{ 0 };
+
+class counting_event_queue_t final : public so_5::event_queue_t
+{
+	so_5::event_queue_t * m_actual;
+
+public :
+	counting_event_queue_t( so_5::event_queue_t * actual )
+		:	m_actual( actual )
+	{}
+
+	void
+	push( so_5::execution_demand_t demand ) override
+	{
+		if( std::type_index{ typeid(msg_value) } == demand.m_msg_type )
+			++push_calls;
+		m_actual->push( std::move(demand) );
+	}
+
+	void
+	push_batch(
+		so_5::execution_demand_t * demands,
+		std::size_t demands_count ) override
+	{
+		++push_batch_calls;
+		demands_in_batches += static_cast< int >( demands_count );
+		m_actual->push_batch( demands, demands_count );
+	}
+
+	void
+	push_evt_start( so_5::execution_demand_t demand ) override
+	{
+		m_actual->push_evt_start( std::move(demand) );
+	}
+
+	void
+	push_evt_finish( so_5::execution_demand_t demand ) noexcept override
+	{
+		m_actual->push_evt_finish( std::move(demand) );
+	}
+};
+
+class counting_event_queue_hook_t final : public so_5::event_queue_hook_t
+{
+public :
+	[[nodiscard]]
+	so_5::event_queue_t *
+	on_bind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * original_queue ) noexcept override
+	{
+		return new counting_event_queue_t( original_queue );
+	}
+
+	void
+	on_unbind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * queue ) noexcept override
+	{
+		delete queue;
+	}
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t controller,
+		int expected_count,
+		bool limited = false )
+		:	so_5::agent_t( limited ?
+				ctx + limit_then_drop< msg_value >( batch_size / 2 ) : ctx )
+		,	m_controller( std::move(controller) )
+		,	m_expected_count( expected_count )
+	{}
+
+	a_receiver_t &
+	listen( const so_5::mbox_t & from )
+	{
+		so_subscribe( from ).event( &a_receiver_t::on_value );
+		return *this;
+	}
+
+	a_receiver_t &
+	even_values_only( const so_5::mbox_t & from )
+	{
+		so_set_delivery_filter( from, []( const msg_value & msg ) {
+				return 0 == msg.m_value % 2;
+			} );
+		m_step = 2;
+		return *this;
+	}
+
+private :
+	const so_5::mbox_t m_controller;
+	const int m_expected_count;
+
+	int m_step{ 1 };
+	int m_expected_value{ 0 };
+	int m_received{ 0 };
+
+	void
+	on_value( mhood_t< msg_value > cmd )
+	{
+		ensure_or_die( m_expected_value == cmd->m_value,
+				"unexpected value: " + std::to_string( cmd->m_value ) +
+				", expected: " + std::to_string( m_expected_value ) );
+
+		m_expected_value = ( m_expected_value + m_step ) % batch_size;
+
+		++m_received;
+		if( m_expected_count == m_received )
+			so_5::send< msg_done >( m_controller );
+	}
+};
+
+class a_controller_t final : public so_5::agent_t
+{
+public :
+	a_controller_t( context_t ctx )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_mpmc( so_environment().create_mbox() )
+	{
+		so_subscribe_self().event( &a_controller_t::on_done );
+	}
+
+	void
+	so_evt_start() override
+	{
+		auto disp = so_5::disp::one_thread::make_dispatcher( so_environment() );
+
+		so_5::introduce_child_coop( *this, disp.binder(),
+			[this]( so_5::coop_t & coop ) {
+				// Gets the whole batch from MPMC mbox and the whole batch
+				// to the direct mbox.
+				auto * all = coop.make_agent< a_receiver_t >(
+						so_direct_mbox(), 2 * batch_size );
+				all->listen( m_mpmc ).listen( all->so_direct_mbox() );
+				m_all = all->so_direct_mbox();
+
+				// Gets a half of the batch from MPMC mbox.
+				coop.make_agent< a_receiver_t >(
+						so_direct_mbox(), batch_size / 2 )
+					->even_values_only( m_mpmc ).listen( m_mpmc );
+
+				// Gets a half of the batch because of the message limit.
+				coop.make_agent< a_receiver_t >(
+						so_direct_mbox(), batch_size / 2, true )
+					->listen( m_mpmc );
+			} );
+
+		std::array< int, batch_size > values;
+		for( int i = 0; i != batch_size; ++i )
+			values[ static_cast< std::size_t >(i) ] = i;
+
+		so_5::send_batch< msg_value >( m_mpmc, values );
+		so_5::send_batch< msg_value >( m_all, values );
+	}
+
+private :
+	const so_5::mbox_t m_mpmc;
+	so_5::mbox_t m_all;
+
+	int m_done{ 0 };
+
+	void
+	on_done( mhood_t< msg_done > )
+	{
+		++m_done;
+		if( 3 == m_done )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+int main()
+{
+	run_with_time_limit( [] {
+			counting_event_queue_hook_t hook;
+
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.register_agent_as_coop(
+							env.make_agent< a_controller_t >() );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					params.event_queue_hook(
+							so_5::event_queue_hook_unique_ptr_t(
+									&hook,
+									&so_5::event_queue_hook_t::noop_deleter ) );
+				} );
+
+			std::cout << "push: " << push_calls
+					<< ", push_batch: " << push_batch_calls
+					<< ", demands in batches: " << demands_in_batches
+					<< std::endl;
+
+			ensure_or_die( 0 == push_calls,
+					"msg_value should be pushed only by push_batch" );
+			// One batch for every receiver from MPMC mbox and
+			// one batch from the direct mbox.
+			ensure_or_die( 4 == push_batch_calls,
+					"unexpected count of push_batch calls" );
+			ensure_or_die( 3 * batch_size == demands_in_batches,
+					"unexpected count of demands in batches" );
+		},
+		20 );
+}
@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+MxxRu::setup_target(
+	MxxRu::BinaryUnittestTarget.new(
+		"test/so_5/event_queue_hook/send_batch/prj.ut.rb",
+		"test/so_5/event_queue_hook/send_batch/prj.rb" )
+)
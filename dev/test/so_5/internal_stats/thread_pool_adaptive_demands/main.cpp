@@ -0,0 +1,185 @@
+/*
+ * A test for the adaptive count of demands to be processed at once
+ * in thread_pool dispatcher. The current count is got from run-time
+ * monitoring messages.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+constexpr std::size_t min_demands = 2u;
+constexpr std::size_t max_demands = 32u;
+
+struct msg_loop_finished final : public so_5::signal_t {};
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		struct msg_loop final : public so_5::message_t
+			{
+				unsigned int m_remaining;
+
+				msg_loop( unsigned int remaining ) : m_remaining{ remaining } {}
+			};
+
+		a_worker_t( context_t ctx, so_5::mbox_t monitor )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_monitor{ std::move(monitor) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_worker_t::evt_loop );
+			}
+
+	private :
+		const so_5::mbox_t m_monitor;
+
+		void
+		evt_loop( mhood_t< msg_loop > cmd )
+			{
+				// The next demand is pushed while the current one is
+				// still in the queue. So the queue is never empty
+				// until the end of the loop.
+				if( cmd->m_remaining )
+					so_5::send< msg_loop >( *this, cmd->m_remaining - 1u );
+				else
+					so_5::send< msg_loop_finished >( m_monitor );
+			}
+	};
+
+class a_monitor_t final : public so_5::agent_t
+	{
+		// The only worker works and the count has to grow to the
+		// upper bound.
+		state_t st_growing{ this, "growing" };
+		// Two workers compete for the only thread and the count has to
+		// fall to the lower bound.
+		state_t st_shrinking{ this, "shrinking" };
+
+	public :
+		a_monitor_t( context_t ctx )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_disp{ tp_disp::make_dispatcher( so_environment(), "adaptive", 1u ) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				this >>= st_growing;
+
+				st_growing
+					.event( [this]( mhood_t< msg_loop_finished > ) {
+						so_environment().stats_controller().turn_on();
+					} )
+					.event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::evt_monitor_quantity );
+
+				st_shrinking.event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::evt_monitor_quantity );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						std::chrono::milliseconds( 50 ) );
+
+				m_first = make_worker();
+				so_5::send< a_worker_t::msg_loop >( m_first, 1000u );
+			}
+
+	private :
+		tp_disp::dispatcher_handle_t m_disp;
+
+		so_5::mbox_t m_first;
+
+		//! Prefix of the queue of the first worker.
+		std::string m_first_prefix;
+
+		so_5::mbox_t
+		make_worker()
+			{
+				so_5::mbox_t result;
+				so_environment().introduce_coop(
+						m_disp.binder( tp_disp::bind_params_t{}
+								.adaptive_demands_at_once( min_demands, max_demands ) ),
+						[&]( so_5::coop_t & coop ) {
+							result = coop.make_agent< a_worker_t >(
+									so_direct_mbox() )->so_direct_mbox();
+						} );
+				return result;
+			}
+
+		void
+		evt_monitor_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				if( so_5::stats::suffixes::demands_at_once() != evt.m_suffix )
+					return;
+
+				const std::string_view prefix{ evt.m_prefix.c_str() };
+				if( 0u != prefix.find( "disp/tp/adaptive/" ) )
+					throw std::runtime_error( "unexpected data source: " +
+							std::string{ prefix } );
+
+				std::cout << evt.m_prefix << evt.m_suffix
+						<< ": " << evt.m_value << std::endl;
+
+				if( evt.m_value < min_demands || evt.m_value > max_demands )
+					throw std::runtime_error( "demands_at_once is out of range: " +
+							std::to_string( evt.m_value ) );
+
+				if( so_is_active_state( st_growing ) )
+					{
+						if( max_demands == evt.m_value )
+							{
+								m_first_prefix = prefix;
+
+								this >>= st_shrinking;
+
+								auto second = make_worker();
+								so_5::send< a_worker_t::msg_loop >( m_first, 2000u );
+								so_5::send< a_worker_t::msg_loop >( second, 2000u );
+							}
+					}
+				else if( m_first_prefix == prefix && min_demands == evt.m_value )
+					so_environment().stop();
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								env.make_agent< a_monitor_t >() );
+					} );
+			},
+			20,
+			"thread_pool adaptive demands_at_once test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,154 @@
+/*
+ * A simple test for getting stats of demand pool of thread_pool dispatcher
+ * from run-time monitoring messages.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+constexpr unsigned int total_messages = 1000;
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		struct msg_next final : public so_5::message_t
+			{
+				unsigned int m_index;
+
+				msg_next( unsigned int index ) : m_index{ index } {}
+			};
+
+		struct msg_completed final : public so_5::signal_t {};
+
+		a_worker_t( context_t ctx, so_5::mbox_t monitor )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_monitor{ std::move(monitor) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_worker_t::evt_next );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_5::send< msg_next >( *this, 0u );
+			}
+
+	private :
+		const so_5::mbox_t m_monitor;
+
+		void
+		evt_next( mhood_t< msg_next > cmd )
+			{
+				// The next demand is pushed while the current one is
+				// still in the queue. So every demand object except
+				// the first two have to be taken from the pool.
+				if( cmd->m_index + 1u < total_messages )
+					so_5::send< msg_next >( *this, cmd->m_index + 1u );
+				else
+					so_5::send< msg_completed >( m_monitor );
+			}
+	};
+
+class a_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_monitor_t( context_t ctx )
+			:	so_5::agent_t{ std::move(ctx) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_monitor_t::evt_completed );
+
+				so_default_state().event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::evt_monitor_quantity );
+			}
+
+	private :
+		bool m_hits_checked = false;
+		bool m_misses_checked = false;
+
+		void
+		evt_completed( mhood_t< a_worker_t::msg_completed > )
+			{
+				so_environment().stats_controller().turn_on();
+			}
+
+		void
+		evt_monitor_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				namespace stats = so_5::stats;
+
+				if( std::string_view{ "disp/tp/pooled" } != evt.m_prefix.c_str() )
+					return;
+
+				std::cout << evt.m_prefix
+						<< evt.m_suffix
+						<< ": " << evt.m_value << std::endl;
+
+				if( stats::suffixes::demand_pool_hits() == evt.m_suffix )
+					{
+						if( evt.m_value < total_messages - 2u )
+							throw std::runtime_error( "unexpected count of "
+									"demand pool hits: " +
+									std::to_string( evt.m_value ) );
+						m_hits_checked = true;
+					}
+				else if( stats::suffixes::demand_pool_misses() == evt.m_suffix )
+					{
+						if( 0u == evt.m_value )
+							throw std::runtime_error( "no demand pool misses" );
+						m_misses_checked = true;
+					}
+
+				if( m_hits_checked && m_misses_checked )
+					so_environment().stop();
+			}
+	};
+
+void
+init( so_5::environment_t & env )
+	{
+		env.introduce_coop( [&]( so_5::coop_t & coop ) {
+				auto monitor = coop.make_agent< a_monitor_t >();
+
+				coop.make_agent_with_binder< a_worker_t >(
+						so_5::disp::thread_pool::make_dispatcher(
+								env, "pooled", 1u ).binder(),
+						monitor->so_direct_mbox() );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"thread_pool demand pool monitoring test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -353,6 +353,16 @@ do_test()
 					threshold,
 					map_based_subscription_storage_factory(),
 					flat_set_based_subscription_storage_factory( threshold ) ) }
+	,	{ "flat_set+flat_hash_table",
+			adaptive_subscription_storage_factory(
+					threshold,
+					flat_set_based_subscription_storage_factory( threshold ),
+					flat_hash_table_based_subscription_storage_factory( threshold ) ) }
+	,	{ "flat_hash_table+vector",
+			adaptive_subscription_storage_factory(
+					threshold,
+					flat_hash_table_based_subscription_storage_factory( threshold ),
+					vector_based_subscription_storage_factory( threshold ) ) }
 	}; 
 
 	for( auto & f : factories )
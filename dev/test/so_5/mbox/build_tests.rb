@@ -22,4 +22,6 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/sink_binding/build_tests.rb" )
 	required_prj( "#{path}/unique_subscribers/build_tests.rb" )
 	required_prj( "#{path}/introduce_named_mbox/build_tests.rb" )
+	required_prj( "#{path}/send_batch/prj.ut.rb" )
+	required_prj( "#{path}/flat_hash_subscribers_table/prj.ut.rb" )
 }
@@ -335,6 +335,8 @@ do_test()
 	,	{ "flat_set[1]", so_5::flat_set_based_subscription_storage_factory( 1 ) }
 	,	{ "flat_set[8]", so_5::flat_set_based_subscription_storage_factory( 8 ) }
 	,	{ "flat_set[16]", so_5::flat_set_based_subscription_storage_factory( 16 ) }
+	,	{ "flat_hash_table[1]", so_5::flat_hash_table_based_subscription_storage_factory( 1 ) }
+	,	{ "flat_hash_table[16]", so_5::flat_hash_table_based_subscription_storage_factory( 16 ) }
 	,	{ "default", so_5::default_subscription_storage_factory() }
 	}; 
 
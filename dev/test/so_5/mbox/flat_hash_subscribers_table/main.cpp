@@ -0,0 +1,187 @@
+/*
+ * A test for local mbox with flat hash table of subscribers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <iostream>
+#include <utility>
+
+constexpr std::size_t types_count = 32u;
+
+template< std::size_t I >
+struct msg_signal final : public so_5::signal_t {};
+
+struct msg_check final : public so_5::message_t
+{
+	const std::size_t m_stage;
+
+	msg_check( std::size_t stage ) : m_stage( stage ) {}
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mbox{ std::move(mbox) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_test_t::on_check );
+
+		subscribe_all( std::make_index_sequence< types_count >{} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		send_all( std::make_index_sequence< types_count >{} );
+		so_5::send< msg_check >( *this, 0u );
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+
+	std::array< std::size_t, types_count > m_received{};
+
+	template< std::size_t I >
+	void
+	subscribe_one( bool even_only )
+	{
+		if( !even_only || 0u == (I % 2u) )
+			so_subscribe( m_mbox ).event( [this]( mhood_t< msg_signal<I> > ) {
+					++m_received[ I ];
+				} );
+	}
+
+	template< std::size_t... I >
+	void
+	subscribe_all( std::index_sequence< I... >, bool even_only = false )
+	{
+		( subscribe_one< I >( even_only ), ... );
+	}
+
+	template< std::size_t I >
+	void
+	drop_one()
+	{
+		if( 0u == (I % 2u) )
+			so_drop_subscription< msg_signal<I> >( m_mbox );
+	}
+
+	template< std::size_t... I >
+	void
+	drop_even( std::index_sequence< I... > )
+	{
+		( drop_one< I >(), ... );
+	}
+
+	template< std::size_t... I >
+	void
+	send_all( std::index_sequence< I... > )
+	{
+		( so_5::send< msg_signal<I> >( m_mbox ), ... );
+	}
+
+	void
+	ensure_received( std::size_t stage, std::size_t even, std::size_t odd )
+	{
+		for( std::size_t i = 0u; i != types_count; ++i )
+		{
+			const auto expected = (0u == (i % 2u)) ? even : odd;
+			ensure_or_die( expected == m_received[ i ],
+					"stage " + std::to_string( stage ) +
+					": unexpected count for type #" + std::to_string( i ) +
+					": " + std::to_string( m_received[ i ] ) +
+					", expected: " + std::to_string( expected ) );
+		}
+	}
+
+	void
+	on_check( mhood_t< msg_check > cmd )
+	{
+		const auto seq = std::make_index_sequence< types_count >{};
+		switch( cmd->m_stage )
+		{
+		case 0u:
+			ensure_received( 0u, 1u, 1u );
+
+			// Removal of every second type from the table.
+			drop_even( seq );
+			send_all( seq );
+			so_5::send< msg_check >( *this, 1u );
+		break;
+
+		case 1u:
+			ensure_received( 1u, 1u, 2u );
+
+			// Removed types have to be added again.
+			subscribe_all( seq, true );
+			send_all( seq );
+			so_5::send< msg_check >( *this, 2u );
+		break;
+
+		default:
+			ensure_received( 2u, 2u, 3u );
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+run_test(
+	const char * case_name,
+	so_5::local_mbox_subscribers_table_t default_table,
+	std::function< so_5::mbox_t( so_5::environment_t & ) > mbox_maker )
+{
+	std::cout << case_name << ": " << std::flush;
+
+	so_5::launch(
+		[&]( so_5::environment_t & env ) {
+			env.register_agent_as_coop(
+					env.make_agent< a_test_t >( mbox_maker( env ) ) );
+		},
+		[default_table]( so_5::environment_params_t & params ) {
+			params.local_mbox_subscribers_table( default_table );
+		} );
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+			using table_t = so_5::local_mbox_subscribers_table_t;
+
+			run_test( "default flat_hash_table", table_t::flat_hash_table,
+					[]( so_5::environment_t & env ) {
+						return env.create_mbox();
+					} );
+
+			run_test( "named flat_hash_table", table_t::flat_hash_table,
+					[]( so_5::environment_t & env ) {
+						return env.create_mbox( "test" );
+					} );
+
+			run_test( "explicit flat_hash_table", table_t::std_map,
+					[]( so_5::environment_t & env ) {
+						return env.create_mbox( table_t::flat_hash_table );
+					} );
+
+			run_test( "explicit std_map", table_t::flat_hash_table,
+					[]( so_5::environment_t & env ) {
+						return env.create_mbox( table_t::std_map );
+					} );
+		},
+		10 );
+
+	return 0;
+}
@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+MxxRu::setup_target(
+	MxxRu::Binary_unittest_target.new(
+		"test/so_5/mbox/flat_hash_subscribers_table/prj.ut.rb",
+		"test/so_5/mbox/flat_hash_subscribers_table/prj.rb" )
+)
@@ -0,0 +1,144 @@
+/*
+ * A test for send_batch.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <vector>
+#include <list>
+
+struct msg_value final : public so_5::message_t
+{
+	int m_value;
+
+	msg_value( int value ) : m_value{ value } {}
+};
+
+struct user_value final
+{
+	int m_value;
+
+	user_value( int value ) : m_value{ value } {}
+};
+
+struct msg_done final : public so_5::signal_t {};
+
+const std::vector< int > batch{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t source,
+		bool only_even,
+		std::string & log )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_source{ std::move(source) }
+		,	m_only_even{ only_even }
+		,	m_log{ log }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		if( m_only_even )
+			so_set_delivery_filter( m_source,
+				[]( const msg_value & msg ) { return 0 == msg.m_value % 2; } );
+
+		so_subscribe( m_source )
+			.event( [this]( mhood_t< msg_value > cmd ) {
+					m_log += std::to_string( cmd->m_value );
+				} );
+
+		so_subscribe_self()
+			.event( [this]( mhood_t< user_value > cmd ) {
+					m_log += std::to_string( cmd->m_value );
+				} )
+			.event( [this]( mutable_mhood_t< msg_value > cmd ) {
+					m_log += "m" + std::to_string( cmd->m_value );
+				} );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+	const bool m_only_even;
+	std::string & m_log;
+};
+
+void
+do_test()
+{
+	std::string all_log;
+	std::string even_log;
+	std::string direct_log;
+	std::vector< int > from_chain;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			const auto mbox = env.create_mbox( "values" );
+
+			a_receiver_t * direct_receiver = nullptr;
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					direct_receiver = coop.make_agent< a_receiver_t >(
+							mbox, false, all_log );
+					coop.make_agent< a_receiver_t >( mbox, true, even_log );
+				} );
+
+			// A named mbox.
+			so_5::send_batch< msg_value >( mbox, batch );
+			// An anonymous mbox without subscribers.
+			so_5::send_batch< msg_value >( env.create_mbox(), batch );
+			// An empty batch.
+			so_5::send_batch< msg_value >( mbox, std::vector< int >{} );
+
+			// Mutable messages can't be sent via MPMC mbox.
+			// Nothing should be delivered in that case.
+			try
+			{
+				so_5::send_batch< so_5::mutable_msg< msg_value > >( mbox, batch );
+				ensure_or_die( false, "an exception expected" );
+			}
+			catch( const so_5::exception_t & x )
+			{
+				ensure_or_die(
+						so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox ==
+								x.error_code(),
+						"unexpected error code" );
+			}
+
+			// A direct mbox uses the default implementation.
+			so_5::send_batch< user_value >(
+					direct_receiver->so_direct_mbox(),
+					std::list< int >{ 1, 2, 3 } );
+			so_5::send_batch< so_5::mutable_msg< msg_value > >(
+					direct_receiver->so_direct_mbox(),
+					std::vector< int >{ 4, 5 } );
+
+			// A mchain.
+			auto chain = so_5::create_mchain( env );
+			so_5::send_batch< user_value >( chain, batch );
+			so_5::receive( so_5::from( chain ).handle_all().no_wait_on_empty(),
+					[&]( const user_value & v ) {
+						from_chain.push_back( v.m_value );
+					} );
+
+			env.stop();
+		} );
+
+	ensure_or_die( "0123456789123m4m5" == all_log,
+			"unexpected all_log: " + all_log );
+	ensure_or_die( "02468" == even_log,
+			"unexpected even_log: " + even_log );
+	ensure_or_die( batch == from_chain, "unexpected values from mchain" );
+}
+
+int
+main()
+{
+	run_with_time_limit( do_test, 20 );
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * A test for receive with bulk extraction of messages.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <test/3rd_party/utest_helper/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+void
+send_ten_messages( const so_5::mchain_t & chain )
+{
+	for( int i = 0; i != 5; ++i )
+	{
+		so_5::send< int >( chain, i );
+		so_5::send< string >( chain, to_string( i ) );
+	}
+}
+
+void
+do_check_handle_n( const so_5::mchain_t & chain )
+{
+	send_ten_messages( chain );
+
+	int sum = 0;
+	auto r = receive(
+			from( chain ).handle_n( 3 ).bulk_extraction( 16 ).no_wait_on_empty(),
+			[&sum]( int i ) { sum += i; } );
+
+	// Messages: 0, "0", 1, "1", 2.
+	// Bulk size is limited by the count of messages to be handled,
+	// so there shouldn't be extra extracted messages.
+	UT_CHECK_CONDITION( 3 == r.handled() );
+	UT_CHECK_CONDITION( 5 == r.extracted() );
+	UT_CHECK_CONDITION( 3 == sum );
+	UT_CHECK_CONDITION( 5 == chain->size() );
+}
+
+UT_UNIT_TEST( test_handle_n )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			do_check_handle_n( so_5::create_mchain( env ) );
+		},
+		20,
+		"test_handle_n" );
+}
+
+void
+do_check_extract_n( const so_5::mchain_t & chain )
+{
+	send_ten_messages( chain );
+
+	auto r = receive(
+			from( chain ).extract_n( 4 ).bulk_extraction( 16 ).no_wait_on_empty(),
+			[]( int ) {} );
+
+	UT_CHECK_CONDITION( 4 == r.extracted() );
+	UT_CHECK_CONDITION( 2 == r.handled() );
+	UT_CHECK_CONDITION( 6 == chain->size() );
+}
+
+UT_UNIT_TEST( test_extract_n )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			do_check_extract_n( so_5::create_mchain( env ) );
+		},
+		20,
+		"test_extract_n" );
+}
+
+void
+do_check_handle_all( const so_5::mchain_t & chain )
+{
+	send_ten_messages( chain );
+
+	vector< string > received;
+	auto r = receive(
+			from( chain ).handle_all().bulk_extraction( 4 ).no_wait_on_empty(),
+			[&received]( int i ) { received.push_back( to_string( i ) ); },
+			[&received]( const string & s ) { received.push_back( s ); } );
+
+	UT_CHECK_CONDITION( 10 == r.extracted() );
+	UT_CHECK_CONDITION( 10 == r.handled() );
+	UT_CHECK_CONDITION(
+			so_5::mchain_props::extraction_status_t::msg_extracted == r.status() );
+
+	// The order of messages has to be preserved.
+	const vector< string > expected{
+			"0", "0", "1", "1", "2", "2", "3", "3", "4", "4" };
+	UT_CHECK_CONDITION( expected == received );
+}
+
+UT_UNIT_TEST( test_handle_all )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			do_check_handle_all( so_5::create_mchain( env ) );
+		},
+		20,
+		"test_handle_all" );
+}
+
+void
+do_check_producer_consumer( const so_5::mchain_t & chain )
+{
+	constexpr int total = 10000;
+
+	std::thread producer{ [&] {
+		for( int i = 0; i != total; ++i )
+			so_5::send< int >( chain, i );
+	} };
+
+	long long sum = 0;
+	int expected_next = 0;
+	bool order_ok = true;
+	auto r = receive(
+			from( chain ).handle_n( total ).bulk_extraction( 8 ),
+			[&]( int i ) {
+				sum += i;
+				if( i != expected_next )
+					order_ok = false;
+				++expected_next;
+			} );
+
+	producer.join();
+
+	UT_CHECK_CONDITION( total == r.handled() );
+	UT_CHECK_CONDITION( order_ok );
+	UT_CHECK_CONDITION( (static_cast<long long>(total) * (total - 1)) / 2 == sum );
+}
+
+UT_UNIT_TEST( test_producer_consumer )
+{
+	namespace props = so_5::mchain_props;
+
+	// Producer has to wait on full chains.
+	vector< pair< string, so_5::mchain_params_t > > params;
+	params.emplace_back( "unlimited",
+			so_5::make_unlimited_mchain_params() );
+	params.emplace_back( "limited(dynamic,wait)",
+			so_5::make_limited_with_waiting_mchain_params(
+					5,
+					props::memory_usage_t::dynamic,
+					props::overflow_reaction_t::throw_exception,
+					chrono::seconds(5) ) );
+	params.emplace_back( "limited(preallocated,wait)",
+			so_5::make_limited_with_waiting_mchain_params(
+					5,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					chrono::seconds(5) ) );
+
+	for( const auto & p : params )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_check_producer_consumer(
+						env.environment().create_mchain( p.second ) );
+			},
+			20,
+			"test_producer_consumer: " + p.first );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_handle_n )
+	UT_RUN_UNIT_TEST( test_extract_n )
+	UT_RUN_UNIT_TEST( test_handle_all )
+	UT_RUN_UNIT_TEST( test_producer_consumer )
+
+	return 0;
+}
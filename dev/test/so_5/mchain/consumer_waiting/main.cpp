@@ -0,0 +1,130 @@
+/*
+ * A test for spin-then-block waiting of mchain consumers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <test/3rd_party/utest_helper/helper.hpp>
+
+#include "../mchain_params.hpp"
+
+using namespace std;
+using namespace chrono;
+
+namespace props = so_5::mchain_props;
+
+UT_UNIT_TEST( test_no_waiting_if_not_empty )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			auto ch = env.environment().create_mchain(
+					so_5::make_unlimited_mchain_params()
+						.consumer_waiting( props::consumer_waiting_params_t{ 100, 10 } ) );
+
+			so_5::send< int >( ch, 1 );
+			auto r = receive( from( ch ).handle_n( 1 ), []( int ) {} );
+			UT_CHECK_CONDITION( 1 == r.handled() );
+
+			const auto stats = ch->query_consumer_waiting_stats();
+			UT_CHECK_CONDITION( 0u == stats.m_completed_by_spinning );
+			UT_CHECK_CONDITION( 0u == stats.m_completed_by_yielding );
+			UT_CHECK_CONDITION( 0u == stats.m_blocked );
+		},
+		20,
+		"test_no_waiting_if_not_empty" );
+}
+
+UT_UNIT_TEST( test_blocked_on_timeout )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			for( const auto waiting : {
+					props::consumer_waiting_params_t{},
+					props::consumer_waiting_params_t{ 100, 10 } } )
+			{
+				auto ch = env.environment().create_mchain(
+						so_5::make_unlimited_mchain_params()
+							.consumer_waiting( waiting ) );
+
+				const auto started_at = steady_clock::now();
+				auto r = receive(
+						from( ch ).handle_n( 1 ).empty_timeout( milliseconds(50) ),
+						[]( int ) {} );
+				const auto elapsed = steady_clock::now() - started_at;
+
+				UT_CHECK_CONDITION( 0 == r.extracted() );
+				UT_CHECK_CONDITION( elapsed >= milliseconds(50) );
+
+				const auto stats = ch->query_consumer_waiting_stats();
+				UT_CHECK_CONDITION( 0u == stats.m_completed_by_spinning );
+				UT_CHECK_CONDITION( 0u == stats.m_completed_by_yielding );
+				UT_CHECK_CONDITION( 1u == stats.m_blocked );
+			}
+		},
+		20,
+		"test_blocked_on_timeout" );
+}
+
+UT_UNIT_TEST( test_producer_thread )
+{
+	constexpr int messages = 20000;
+
+	for( auto p : build_mchain_params() )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				auto ch = env.environment().create_mchain(
+						so_5::mchain_params_t{ p.second }.consumer_waiting(
+								props::consumer_waiting_params_t{ 1000, 16 } ) );
+
+				std::thread producer{ [&ch] {
+					for( int i = 0; i != messages; ++i )
+						so_5::send< int >( ch, i );
+					so_5::close_retain_content( so_5::exceptions_enabled, ch );
+				} };
+
+				long long sum = 0;
+				auto r = receive( from( ch ).handle_all(),
+						[&sum]( int i ) { sum += i; } );
+
+				producer.join();
+
+				// Some messages can be lost for chains with drop_newest reaction.
+				UT_CHECK_CONDITION( 0u != r.handled() );
+				if( static_cast< std::size_t >( messages ) == r.handled() )
+					UT_CHECK_CONDITION(
+							(static_cast< long long >( messages ) * (messages - 1)) / 2
+							== sum );
+
+				const auto stats = ch->query_consumer_waiting_stats();
+				cout << "spinning: " << stats.m_completed_by_spinning
+						<< ", yielding: " << stats.m_completed_by_yielding
+						<< ", blocked: " << stats.m_blocked << endl;
+			},
+			20,
+			"test_producer_thread: " + p.first );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_no_waiting_if_not_empty )
+	UT_RUN_UNIT_TEST( test_blocked_on_timeout )
+	UT_RUN_UNIT_TEST( test_producer_thread )
+
+	return 0;
+}
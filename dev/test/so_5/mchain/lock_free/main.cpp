@@ -0,0 +1,265 @@
+/*
+ * A test for mchains with lock-free queue.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <test/3rd_party/utest_helper/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+namespace props = so_5::mchain_props;
+
+so_5::mchain_t
+make_lock_free_chain(
+	so_5::environment_t & env,
+	std::size_t capacity,
+	props::overflow_reaction_t reaction )
+{
+	return env.create_mchain(
+			so_5::make_limited_without_waiting_mchain_params(
+					capacity,
+					props::memory_usage_t::preallocated,
+					reaction )
+				.enable_lock_free_queue() );
+}
+
+std::vector< int >
+receive_all( const so_5::mchain_t & chain )
+{
+	std::vector< int > result;
+	receive( from( chain ).handle_all().no_wait_on_empty(),
+			[&result]( int i ) { result.push_back( i ); } );
+	return result;
+}
+
+UT_UNIT_TEST( test_unlimited_chain_is_rejected )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			UT_CHECK_THROW( so_5::exception_t,
+					env.environment().create_mchain(
+							so_5::make_unlimited_mchain_params()
+								.enable_lock_free_queue() ) );
+		},
+		20,
+		"test_unlimited_chain_is_rejected" );
+}
+
+UT_UNIT_TEST( test_overflow_reactions )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			{
+				auto ch = make_lock_free_chain( env.environment(), 3,
+						props::overflow_reaction_t::drop_newest );
+				for( int i = 0; i != 5; ++i )
+					so_5::send< int >( ch, i );
+				UT_CHECK_CONDITION( 3 == ch->size() );
+				UT_CHECK_CONDITION( (std::vector< int >{ 0, 1, 2 }) ==
+						receive_all( ch ) );
+				UT_CHECK_CONDITION( ch->empty() );
+			}
+
+			{
+				auto ch = make_lock_free_chain( env.environment(), 3,
+						props::overflow_reaction_t::remove_oldest );
+				for( int i = 0; i != 5; ++i )
+					so_5::send< int >( ch, i );
+				UT_CHECK_CONDITION( (std::vector< int >{ 2, 3, 4 }) ==
+						receive_all( ch ) );
+			}
+
+			{
+				auto ch = make_lock_free_chain( env.environment(), 2,
+						props::overflow_reaction_t::throw_exception );
+				so_5::send< int >( ch, 0 );
+				so_5::send< int >( ch, 1 );
+				UT_CHECK_THROW( so_5::exception_t, so_5::send< int >( ch, 2 ) );
+				UT_CHECK_CONDITION( (std::vector< int >{ 0, 1 }) ==
+						receive_all( ch ) );
+			}
+		},
+		20,
+		"test_overflow_reactions" );
+}
+
+UT_UNIT_TEST( test_close )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			for( const auto mode : { props::close_mode_t::retain_content,
+					props::close_mode_t::drop_content } )
+			{
+				auto ch = make_lock_free_chain( env.environment(), 8,
+						props::overflow_reaction_t::throw_exception );
+				for( int i = 0; i != 4; ++i )
+					so_5::send< int >( ch, i );
+
+				ch->close( so_5::exceptions_enabled, mode );
+
+				// Messages can't be sent to closed chain.
+				so_5::send< int >( ch, 100 );
+
+				int handled = 0;
+				auto r = receive( from( ch ).handle_all(),
+						[&handled]( int ) { ++handled; } );
+
+				const int expected =
+						props::close_mode_t::retain_content == mode ? 4 : 0;
+				UT_CHECK_CONDITION( expected == handled );
+				UT_CHECK_CONDITION( expected == static_cast<int>(r.extracted()) );
+				if( !expected )
+					UT_CHECK_CONDITION(
+							props::extraction_status_t::chain_closed == r.status() );
+			}
+		},
+		20,
+		"test_close" );
+}
+
+UT_UNIT_TEST( test_empty_timeout )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			auto ch = make_lock_free_chain( env.environment(), 8,
+					props::overflow_reaction_t::throw_exception );
+
+			const auto started_at = steady_clock::now();
+			auto r = receive(
+					from( ch ).handle_n( 1 ).empty_timeout( milliseconds(100) ),
+					[]( int ) {} );
+			const auto elapsed = steady_clock::now() - started_at;
+
+			UT_CHECK_CONDITION( 0 == r.extracted() );
+			UT_CHECK_CONDITION(
+					props::extraction_status_t::no_messages == r.status() );
+			UT_CHECK_CONDITION( elapsed >= milliseconds(100) );
+		},
+		20,
+		"test_empty_timeout" );
+}
+
+UT_UNIT_TEST( test_many_producers )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			constexpr int producers_count = 4;
+			constexpr int messages_per_producer = 10000;
+
+			// Producers have to wait on the full chain.
+			auto ch = env.environment().create_mchain(
+					so_5::make_limited_with_waiting_mchain_params(
+							16,
+							props::memory_usage_t::preallocated,
+							props::overflow_reaction_t::throw_exception,
+							seconds(10) )
+						.enable_lock_free_queue() );
+
+			std::vector< std::thread > producers;
+			for( int p = 0; p != producers_count; ++p )
+				producers.emplace_back( [&ch, p] {
+						for( int i = 0; i != messages_per_producer; ++i )
+							so_5::send< int >( ch, p );
+					} );
+
+			std::vector< int > counters( producers_count, 0 );
+			auto r = receive(
+					from( ch ).handle_n( producers_count * messages_per_producer ),
+					[&counters]( int p ) { ++counters[ static_cast<std::size_t>(p) ]; } );
+
+			for( auto & t : producers )
+				t.join();
+
+			UT_CHECK_CONDITION(
+					producers_count * messages_per_producer ==
+					static_cast<int>(r.handled()) );
+			for( const auto c : counters )
+				UT_CHECK_CONDITION( messages_per_producer == c );
+		},
+		60,
+		"test_many_producers" );
+}
+
+UT_UNIT_TEST( test_select_with_producers )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			constexpr int messages = 20000;
+
+			auto make_chain = [&env] {
+					return env.environment().create_mchain(
+							so_5::make_limited_with_waiting_mchain_params(
+									4,
+									props::memory_usage_t::preallocated,
+									props::overflow_reaction_t::throw_exception,
+									seconds(10) )
+								.enable_lock_free_queue() );
+				};
+
+			auto ch1 = make_chain();
+			auto ch2 = make_chain();
+
+			std::thread producer1{ [&ch1] {
+					for( int i = 0; i != messages; ++i )
+						so_5::send< int >( ch1, i );
+				} };
+			std::thread producer2{ [&ch2] {
+					for( int i = 0; i != messages; ++i )
+						so_5::send< int >( ch2, i );
+				} };
+
+			int next1 = 0;
+			int next2 = 0;
+			bool order_ok = true;
+			auto r = so_5::select( so_5::from_all().handle_n( messages * 2 ),
+					receive_case( ch1, [&]( int i ) {
+							if( i != next1++ ) order_ok = false;
+						} ),
+					receive_case( ch2, [&]( int i ) {
+							if( i != next2++ ) order_ok = false;
+						} ) );
+
+			producer1.join();
+			producer2.join();
+
+			UT_CHECK_CONDITION( messages * 2 == static_cast<int>(r.handled()) );
+			UT_CHECK_CONDITION( order_ok );
+		},
+		60,
+		"test_select_with_producers" );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_unlimited_chain_is_rejected )
+	UT_RUN_UNIT_TEST( test_overflow_reactions )
+	UT_RUN_UNIT_TEST( test_close )
+	UT_RUN_UNIT_TEST( test_empty_timeout )
+	UT_RUN_UNIT_TEST( test_many_producers )
+	UT_RUN_UNIT_TEST( test_select_with_producers )
+
+	return 0;
+}
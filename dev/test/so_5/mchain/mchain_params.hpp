@@ -38,6 +38,19 @@ build_mchain_params()
 						props::memory_usage_t::preallocated,
 						props::overflow_reaction_t::drop_newest,
 						chrono::milliseconds(200) ) );
+		params.emplace_back( "lock_free(nowait)",
+				so_5::make_limited_without_waiting_mchain_params(
+						5,
+						props::memory_usage_t::preallocated,
+						props::overflow_reaction_t::drop_newest )
+					.enable_lock_free_queue() );
+		params.emplace_back( "lock_free(wait)",
+				so_5::make_limited_with_waiting_mchain_params(
+						5,
+						props::memory_usage_t::preallocated,
+						props::overflow_reaction_t::drop_newest,
+						chrono::milliseconds(200) )
+					.enable_lock_free_queue() );
 
 		return params;
 	}
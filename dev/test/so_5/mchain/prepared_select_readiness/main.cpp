@@ -0,0 +1,232 @@
+/*
+ * A test for keeping the state of select_cases between select() calls
+ * on the same prepared-select object.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <test/3rd_party/utest_helper/helper.hpp>
+
+#include "../mchain_params.hpp"
+
+using namespace std;
+using namespace std::chrono_literals;
+
+UT_UNIT_TEST( many_chains )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			for( const auto & p : build_mchain_params() )
+			{
+				cout << "=== " << p.first << " ===" << endl;
+
+				auto ch1 = env.environment().create_mchain( p.second );
+				auto ch2 = env.environment().create_mchain( p.second );
+				auto ch3 = env.environment().create_mchain( p.second );
+
+				std::vector< int > received;
+				auto handler = [&received]( int v ) { received.push_back( v ); };
+
+				auto prepared = so_5::prepare_select(
+						so_5::from_all().handle_n( 1 ).no_wait_on_empty(),
+						receive_case( ch1, handler ),
+						receive_case( ch2, handler ),
+						receive_case( ch3, handler ) );
+
+				// There is nothing to receive.
+				UT_CHECK_CONDITION( 0u == so_5::select( prepared ).extracted() );
+
+				// Messages are sent when prepared-select is not active.
+				so_5::send< int >( ch3, 1 );
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+
+				so_5::send< int >( ch1, 2 );
+				so_5::send< int >( ch2, 3 );
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+				UT_CHECK_CONDITION( 0u == so_5::select( prepared ).extracted() );
+
+				// Several messages in the same chain.
+				so_5::send< int >( ch2, 4 );
+				so_5::send< int >( ch2, 5 );
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+				UT_CHECK_CONDITION( 0u == so_5::select( prepared ).extracted() );
+
+				std::sort( received.begin(), received.end() );
+				UT_CHECK_CONDITION(
+						(std::vector< int >{ 1, 2, 3, 4, 5 }) == received );
+			}
+		},
+		20 );
+}
+
+UT_UNIT_TEST( closed_chain_on_every_call )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			auto ch1 = so_5::create_mchain( env.environment() );
+			auto ch2 = so_5::create_mchain( env.environment() );
+
+			int closed_handler_calls = 0;
+
+			auto prepared = so_5::prepare_select(
+					so_5::from_all().handle_n( 1 ).no_wait_on_empty()
+						.on_close( [&closed_handler_calls]( const so_5::mchain_t & ) {
+								++closed_handler_calls;
+							} ),
+					receive_case( ch1, []( int ) {} ),
+					receive_case( ch2, []( int ) {} ) );
+
+			UT_CHECK_CONDITION( 0u == so_5::select( prepared ).closed() );
+
+			so_5::close_drop_content( so_5::exceptions_enabled, ch1 );
+
+			for( int i = 1; i != 4; ++i )
+			{
+				const auto r = so_5::select( prepared );
+				UT_CHECK_CONDITION( 1u == r.closed() );
+				UT_CHECK_CONDITION( i == closed_handler_calls );
+			}
+
+			// All chains are closed, select() has to return immediately.
+			so_5::close_drop_content( so_5::exceptions_enabled, ch2 );
+
+			auto prepared_with_wait = so_5::prepare_select(
+					so_5::from_all().handle_n( 1 ).empty_timeout( 10s ),
+					receive_case( ch1, []( int ) {} ),
+					receive_case( ch2, []( int ) {} ) );
+			for( int i = 0; i != 3; ++i )
+				UT_CHECK_CONDITION(
+						2u == so_5::select( prepared_with_wait ).closed() );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( send_case_on_every_call )
+{
+	run_with_time_limit(
+		[]()
+		{
+			struct hello {};
+
+			so_5::wrapped_env_t env;
+
+			auto ch = so_5::create_mchain( env.environment() );
+
+			int sent = 0;
+			auto prepared = so_5::prepare_select(
+					so_5::from_all().handle_n( 1 ).no_wait_on_empty(),
+					send_case( ch, so_5::message_holder_t< hello >::make(),
+							[&sent] { ++sent; } ) );
+
+			for( int i = 1; i != 4; ++i )
+			{
+				UT_CHECK_CONDITION( so_5::select( prepared ).was_sent() );
+				UT_CHECK_CONDITION( i == sent );
+			}
+
+			UT_CHECK_CONDITION( 3u == ch->size() );
+		},
+		20 );
+}
+
+UT_UNIT_TEST( exception_from_handler )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			auto ch1 = so_5::create_mchain( env.environment() );
+			auto ch2 = so_5::create_mchain( env.environment() );
+
+			int received = 0;
+			auto prepared = so_5::prepare_select(
+					so_5::from_all().handle_n( 1 ).no_wait_on_empty(),
+					receive_case( ch1, []( int ) {
+							throw std::runtime_error( "exception from handler" );
+						} ),
+					receive_case( ch2, [&received]( int ) { ++received; } ) );
+
+			so_5::send< int >( ch1, 0 );
+			UT_CHECK_THROW( std::runtime_error, so_5::select( prepared ) );
+
+			so_5::send< int >( ch2, 0 );
+			so_5::send< int >( ch2, 1 );
+			UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+			UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+			UT_CHECK_CONDITION( 0u == so_5::select( prepared ).extracted() );
+			UT_CHECK_CONDITION( 2 == received );
+		},
+		20 );
+}
+
+template< typename Handler, std::size_t... I >
+auto
+make_prepared_select(
+	const std::vector< so_5::mchain_t > & chains,
+	Handler handler,
+	std::index_sequence< I... > )
+{
+	return so_5::prepare_select(
+			so_5::from_all().handle_n( 1 ).empty_timeout( 10s ),
+			receive_case( chains[ I ], handler )... );
+}
+
+UT_UNIT_TEST( producer_thread )
+{
+	run_with_time_limit(
+		[]()
+		{
+			constexpr std::size_t chains_count = 100u;
+			constexpr int messages = 20000;
+
+			so_5::wrapped_env_t env;
+
+			std::vector< so_5::mchain_t > chains;
+			for( std::size_t i = 0u; i != chains_count; ++i )
+				chains.push_back( so_5::create_mchain( env.environment() ) );
+
+			int received = 0;
+			auto prepared = make_prepared_select(
+					chains,
+					[&received]( int ) { ++received; },
+					std::make_index_sequence< chains_count >{} );
+
+			std::thread producer{ [&chains] {
+					for( int i = 0; i != messages; ++i )
+						so_5::send< int >(
+								chains[ static_cast<std::size_t>(i) % chains_count ],
+								i );
+				} };
+
+			for( int i = 0; i != messages; ++i )
+				UT_CHECK_CONDITION( 1u == so_5::select( prepared ).handled() );
+
+			producer.join();
+
+			UT_CHECK_CONDITION( messages == received );
+		},
+		60 );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( many_chains )
+	UT_RUN_UNIT_TEST( closed_chain_on_every_call )
+	UT_RUN_UNIT_TEST( send_case_on_every_call )
+	UT_RUN_UNIT_TEST( exception_from_handler )
+	UT_RUN_UNIT_TEST( producer_thread )
+
+	return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * A test for dense identifiers of message types.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr std::size_t types_count = 64u;
+
+template< std::size_t I >
+struct msg_signal final : public so_5::signal_t {};
+
+template< std::size_t... I >
+[[nodiscard]]
+std::array< so_5::message_type_id_t, types_count >
+runtime_ids( std::index_sequence< I... > )
+{
+	return { so_5::message_type_id( typeid(msg_signal<I>) )... };
+}
+
+template< std::size_t... I >
+[[nodiscard]]
+std::array< so_5::message_type_id_t, types_count >
+compile_time_ids( std::index_sequence< I... > )
+{
+	return { so_5::message_type_id< msg_signal<I> >()... };
+}
+
+void
+check_ids_are_dense()
+{
+	auto ids = runtime_ids( std::make_index_sequence< types_count >{} );
+
+	std::sort( ids.begin(), ids.end() );
+	ensure_or_die(
+			std::adjacent_find( ids.begin(), ids.end() ) == ids.end(),
+			"all ids have to be unique" );
+
+	// No other types were registered between the first and the last type.
+	ensure_or_die( ids.back() - ids.front() + 1u == types_count,
+			"ids have to be dense, first: " + std::to_string( ids.front() ) +
+			", last: " + std::to_string( ids.back() ) );
+}
+
+void
+check_ids_are_stable()
+{
+	const auto seq = std::make_index_sequence< types_count >{};
+
+	const auto first = runtime_ids( seq );
+	ensure_or_die( first == runtime_ids( seq ),
+			"ids have to be the same for the second call" );
+	ensure_or_die( first == compile_time_ids( seq ),
+			"ids have to be the same for both forms of message_type_id" );
+}
+
+struct never_registered final : public so_5::signal_t {};
+
+void
+check_find_without_registration()
+{
+	const auto seq = std::make_index_sequence< types_count >{};
+	const auto expected = runtime_ids( seq );
+
+	ensure_or_die(
+			expected[ 0 ] == so_5::find_message_type_id( typeid(msg_signal<0>) ),
+			"find has to return the id of a registered type" );
+	ensure_or_die(
+			expected[ types_count - 1u ] ==
+					so_5::find_message_type_id(
+							typeid(msg_signal<types_count - 1u>) ),
+			"find has to return the id of a registered type" );
+
+	ensure_or_die(
+			so_5::null_message_type_id() ==
+					so_5::find_message_type_id( typeid(never_registered) ),
+			"find has to return null id for a type without id" );
+	// The type still hasn't an id after the unsuccessful search.
+	ensure_or_die(
+			so_5::null_message_type_id() ==
+					so_5::find_message_type_id( typeid(never_registered) ),
+			"find mustn't assign an id" );
+}
+
+void
+check_ids_from_different_threads()
+{
+	const auto seq = std::make_index_sequence< types_count >{};
+	const auto expected = runtime_ids( seq );
+
+	constexpr std::size_t threads_count = 8u;
+	std::array< std::array< so_5::message_type_id_t, types_count >,
+			threads_count > results;
+
+	std::vector< std::thread > threads;
+	for( std::size_t i = 0u; i != threads_count; ++i )
+		threads.emplace_back( [&results, i, seq] {
+				results[ i ] = runtime_ids( seq );
+			} );
+	for( auto & t : threads )
+		t.join();
+
+	for( std::size_t i = 0u; i != threads_count; ++i )
+		ensure_or_die( expected == results[ i ],
+				"ids have to be the same in thread #" + std::to_string( i ) );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+			std::cout << "dense: " << std::flush;
+			check_ids_are_dense();
+			std::cout << "OK" << std::endl;
+
+			std::cout << "stable: " << std::flush;
+			check_ids_are_stable();
+			std::cout << "OK" << std::endl;
+
+			std::cout << "find: " << std::flush;
+			check_find_without_registration();
+			std::cout << "OK" << std::endl;
+
+			std::cout << "threads: " << std::flush;
+			check_ids_from_different_threads();
+			std::cout << "OK" << std::endl;
+		},
+		10 );
+
+	return 0;
+}
@@ -0,0 +1,9 @@
+require 'mxx_ru/binary_unittest'
+
+path = "test/so_5/messages/message_type_id"
+
+MxxRu::setup_target(
+	MxxRu::Binary_unittest_target.new(
+		"#{path}/prj.ut.rb",
+		"#{path}/prj.rb" )
+)
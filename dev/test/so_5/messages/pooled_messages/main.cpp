@@ -0,0 +1,172 @@
+/*
+ * Test for pooled messages.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <cstdint>
+
+struct so5_message final : public so_5::pooled_message_t< so5_message >
+{
+	unsigned int m_index;
+	std::string m_data;
+
+	so5_message( unsigned int index, std::string data )
+		:	m_index{ index }
+		,	m_data{ std::move(data) }
+	{}
+};
+
+struct user_message final
+{
+	unsigned int m_index;
+	std::string m_data;
+};
+
+template<>
+struct so_5::use_message_pool< user_message > : public std::true_type {};
+
+// Over-aligned user type that isn't pooled.
+struct alignas(64) aligned_message final
+{
+	unsigned int m_value;
+};
+
+constexpr unsigned int total_messages = 100;
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::on_so5_message )
+			.event( &a_test_t::on_mutable_so5_message )
+			.event( &a_test_t::on_user_message )
+			.event( &a_test_t::on_mutable_user_message )
+			.event( &a_test_t::on_aligned_message );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< so5_message >( *this, 0u, "immutable" );
+	}
+
+private :
+	void
+	on_so5_message( mhood_t< so5_message > cmd )
+	{
+		ensure_or_die( "immutable" == cmd->m_data, "unexpected so5_message" );
+
+		if( cmd->m_index + 1u < total_messages )
+			so_5::send< so5_message >( *this, cmd->m_index + 1u, "immutable" );
+		else
+			so_5::send< so_5::mutable_msg< so5_message > >( *this, 0u, "mutable" );
+	}
+
+	void
+	on_mutable_so5_message( mutable_mhood_t< so5_message > cmd )
+	{
+		ensure_or_die( "mutable" == cmd->m_data, "unexpected so5_message" );
+
+		if( cmd->m_index + 1u < total_messages )
+		{
+			// The same instance is sent again.
+			cmd->m_index += 1u;
+			so_5::send( *this, std::move(cmd) );
+		}
+		else
+			so_5::send< user_message >( *this, 0u, "immutable" );
+	}
+
+	void
+	on_user_message( const user_message & msg )
+	{
+		ensure_or_die( "immutable" == msg.m_data, "unexpected user_message" );
+
+		if( msg.m_index + 1u < total_messages )
+			so_5::send< user_message >( *this, msg.m_index + 1u, "immutable" );
+		else
+		{
+			// Check message_holder_t for pooled messages.
+			auto holder = so_5::message_holder_t<
+					so_5::mutable_msg< user_message > >::make(
+							0u, std::string{ "mutable" } );
+			so_5::send( *this, std::move(holder) );
+		}
+	}
+
+	void
+	on_mutable_user_message( mutable_mhood_t< user_message > cmd )
+	{
+		ensure_or_die( "mutable" == cmd->m_data, "unexpected user_message" );
+
+		if( cmd->m_index + 1u < total_messages )
+			so_5::send< so_5::mutable_msg< user_message > >(
+					*this, cmd->m_index + 1u, "mutable" );
+		else
+			so_5::send< aligned_message >( *this, 42u );
+	}
+
+	void
+	on_aligned_message( const aligned_message & msg )
+	{
+		ensure_or_die( 42u == msg.m_value, "unexpected aligned_message" );
+		ensure_or_die(
+				0u == reinterpret_cast< std::uintptr_t >( &msg ) %
+						alignof(aligned_message),
+				"aligned_message should be properly aligned" );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+template< typename Msg >
+void
+check_stats( const char * name )
+{
+	const auto stats = so_5::message_pool_t< Msg >::query_stats();
+
+	std::cout << name << ": hits=" << stats.m_hits
+			<< ", misses=" << stats.m_misses
+			<< ", free_blocks=" << stats.m_free_blocks << std::endl;
+
+	ensure_or_die( 0u != stats.m_misses, "there should be misses" );
+	ensure_or_die( stats.m_hits >= total_messages - 2u,
+			"there should be hits for almost all messages" );
+	// Every block allocated on a miss should be returned to the pool.
+	ensure_or_die( stats.m_misses == stats.m_free_blocks,
+			"all instances should be returned to the pool" );
+}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.register_agent_as_coop( env.make_agent< a_test_t >() );
+				} );
+
+			check_stats< so5_message >( "so5_message" );
+			check_stats< user_message >( "user_message" );
+
+			// Shrinking of the pool.
+			so_5::message_pool_t< so5_message >::set_capacity( 0u );
+			ensure_or_die(
+					0u == so_5::message_pool_t< so5_message >::query_stats()
+							.m_free_blocks,
+					"pool should be empty" );
+		},
+		20 );
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * A test for delivery of messages from many producer threads
+ * to an agent bound to one_thread/active_obj dispatchers
+ * with different lock factories.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using lock_factory_t = so_5::disp::mpsc_queue_traits::lock_factory_t;
+
+constexpr unsigned int producers_count = 8;
+constexpr unsigned int messages_per_producer = 20000;
+
+struct msg_data final : public so_5::message_t
+	{
+		unsigned int m_producer;
+		unsigned int m_index;
+
+		msg_data( unsigned int producer, unsigned int index )
+			:	m_producer{ producer }
+			,	m_index{ index }
+			{}
+	};
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t( context_t ctx )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_expected_indexes( producers_count, 0u )
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_receiver_t::evt_data );
+			}
+
+	private :
+		std::vector< unsigned int > m_expected_indexes;
+		unsigned int m_received = 0u;
+
+		void
+		evt_data( mhood_t< msg_data > cmd )
+			{
+				auto & expected = m_expected_indexes[ cmd->m_producer ];
+				ensure_or_die( expected == cmd->m_index,
+						"unexpected message order" );
+				++expected;
+
+				if( ++m_received == producers_count * messages_per_producer )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+run_producers( const so_5::mbox_t & dest )
+	{
+		std::vector< std::thread > producers;
+		producers.reserve( producers_count );
+
+		for( unsigned int p = 0u; p != producers_count; ++p )
+			producers.emplace_back( [dest, p] {
+					for( unsigned int i = 0u; i != messages_per_producer; ++i )
+						so_5::send< msg_data >( dest, p, i );
+				} );
+
+		for( auto & t : producers )
+			t.join();
+	}
+
+template< typename Disp_Params, typename Disp_Maker >
+void
+run_case(
+	const lock_factory_t & factory,
+	Disp_Maker && disp_maker )
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				Disp_Params params;
+				params.tune_queue_params(
+					[&]( so_5::disp::mpsc_queue_traits::queue_params_t & p ) {
+						p.lock_factory( factory );
+					} );
+
+				so_5::mbox_t dest;
+				env.introduce_coop(
+					disp_maker( env, std::move(params) ).binder(),
+					[&dest]( so_5::coop_t & coop ) {
+						dest = coop.make_agent< a_receiver_t >()->so_direct_mbox();
+					} );
+
+				run_producers( dest );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		struct lock_factory_info_t
+			{
+				std::string m_name;
+				lock_factory_t m_factory;
+			};
+		std::vector< lock_factory_info_t > factories;
+		factories.push_back( lock_factory_info_t{
+				"combined_lock",
+				so_5::disp::mpsc_queue_traits::combined_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"lock_free_queue",
+				so_5::disp::mpsc_queue_traits::lock_free_queue_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"lock_free_queue(pool=16)",
+				so_5::disp::mpsc_queue_traits::lock_free_queue_lock_factory(
+						16u, std::chrono::microseconds(1) ) } );
+
+		for( const auto & f : factories )
+			{
+				std::cout << "--- one_thread+" << f.m_name << "---" << std::endl;
+				run_with_time_limit( [&] {
+						run_case< so_5::disp::one_thread::disp_params_t >(
+								f.m_factory,
+								[]( so_5::environment_t & env, auto params ) {
+									return so_5::disp::one_thread::make_dispatcher(
+											env, std::string{}, std::move(params) );
+								} );
+					},
+					60,
+					"one_thread, lock: " + f.m_name );
+
+				std::cout << "--- active_obj+" << f.m_name << "---" << std::endl;
+				run_with_time_limit( [&] {
+						run_case< so_5::disp::active_obj::disp_params_t >(
+								f.m_factory,
+								[]( so_5::environment_t & env, auto params ) {
+									return so_5::disp::active_obj::make_dispatcher(
+											env, std::string{}, std::move(params) );
+								} );
+					},
+					60,
+					"active_obj, lock: " + f.m_name );
+			}
+
+		return 0;
+	}
+	catch( const std::exception & x )
+	{
+		std::cerr << "*** Exception caught: " << x.what() << std::endl;
+	}
+
+	return 2;
+}
+
@@ -0,0 +1,124 @@
+/*
+ * A test for invalidation of cached results of event handler search
+ * in parent states.
+ */
+
+#include <iostream>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+class a_test_t final : public so_5::agent_t
+{
+	struct sig_probe : public so_5::signal_t {};
+
+	struct msg_step : public so_5::message_t
+	{
+		int m_step;
+
+		msg_step( int step ) : m_step{ step } {}
+	};
+
+	state_t st_parent{ this, "parent" };
+	state_t st_child_1{ initial_substate_of{ st_parent }, "child_1" };
+	state_t st_child_2{ initial_substate_of{ st_child_1 }, "child_2" };
+
+	std::string m_log;
+
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+	{
+		this >>= st_child_2;
+
+		st_parent
+			.event( &a_test_t::on_step )
+			.event( [this](mhood_t< sig_probe >) { m_log += "p;"; } );
+	}
+
+	void
+	so_evt_start() override
+	{
+		next_step( 0 );
+	}
+
+private :
+	void
+	next_step( int step )
+	{
+		// The probe has to be handled before the next step.
+		so_5::send< sig_probe >( *this );
+		so_5::send< msg_step >( *this, step );
+	}
+
+	void
+	on_step( mhood_t< msg_step > cmd )
+	{
+		switch( cmd->m_step )
+		{
+		case 0:
+			// The probe has to be handled again by the parent state.
+			next_step( 1 );
+		break;
+
+		case 1:
+			st_child_2.event( [this](mhood_t< sig_probe >) { m_log += "c2;"; } );
+			next_step( 2 );
+		break;
+
+		case 2:
+			so_drop_subscription< sig_probe >( so_direct_mbox(), st_child_2 );
+			next_step( 3 );
+		break;
+
+		case 3:
+			this >>= st_child_1;
+			st_child_1.event( [this](mhood_t< sig_probe >) { m_log += "c1;"; } );
+			next_step( 4 );
+		break;
+
+		case 4:
+			this >>= st_child_2;
+			next_step( 5 );
+		break;
+
+		case 5:
+			so_drop_subscription_for_all_states< sig_probe >( so_direct_mbox() );
+			next_step( 6 );
+		break;
+
+		default:
+			ensure_or_die( "p;p;c2;p;c1;c1;" == m_log,
+					"unexpected log: " + m_log );
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >();
+							} );
+					} );
+			},
+			20,
+			"test for cached event handlers from parent states" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * A test for delivery of messages from timers elapsed on the same tick
+ * as one batch.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+struct msg_value final : public so_5::message_t
+{
+	const int m_value;
+
+	msg_value( int value ) : m_value( value ) {}
+};
+
+constexpr int messages_count = 1000;
+
+// Counters for demands with msg_value only.
+std::atomic< int > push_calls{ 0 };
+std::atomic< int > demands_in_batches{ 0 };
+
+class counting_event_queue_t final : public so_5::event_queue_t
+{
+	so_5::event_queue_t * m_actual;
+
+public :
+	counting_event_queue_t( so_5::event_queue_t * actual )
+		:	m_actual( actual )
+	{}
+
+	void
+	push( so_5::execution_demand_t demand ) override
+	{
+		if( std::type_index{ typeid(msg_value) } == demand.m_msg_type )
+			++push_calls;
+		m_actual->push( std::move(demand) );
+	}
+
+	void
+	push_batch(
+		so_5::execution_demand_t * demands,
+		std::size_t demands_count ) override
+	{
+		demands_in_batches += static_cast< int >( demands_count );
+		m_actual->push_batch( demands, demands_count );
+	}
+
+	void
+	push_evt_start( so_5::execution_demand_t demand ) override
+	{
+		m_actual->push_evt_start( std::move(demand) );
+	}
+
+	void
+	push_evt_finish( so_5::execution_demand_t demand ) noexcept override
+	{
+		m_actual->push_evt_finish( std::move(demand) );
+	}
+};
+
+class counting_event_queue_hook_t final : public so_5::event_queue_hook_t
+{
+public :
+	[[nodiscard]]
+	so_5::event_queue_t *
+	on_bind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * original_queue ) noexcept override
+	{
+		return new counting_event_queue_t( original_queue );
+	}
+
+	void
+	on_unbind(
+		so_5::agent_t * /*agent*/,
+		so_5::event_queue_t * queue ) noexcept override
+	{
+		delete queue;
+	}
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_received( messages_count, false )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_test_t::on_value );
+
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_test_t::on_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		for( int i = 0; i != messages_count; ++i )
+			so_5::send_delayed< msg_value >( *this, 20ms, i );
+	}
+
+private :
+	std::vector< bool > m_received;
+	int m_received_count{ 0 };
+
+	void
+	on_value( mhood_t< msg_value > cmd )
+	{
+		const auto index = static_cast< std::size_t >( cmd->m_value );
+		ensure_or_die( !m_received[ index ],
+				"duplicate value: " + std::to_string( cmd->m_value ) );
+		m_received[ index ] = true;
+
+		if( messages_count == ++m_received_count )
+		{
+			auto & controller = so_environment().stats_controller();
+			controller.set_distribution_period( 50ms );
+			controller.turn_on();
+		}
+	}
+
+	void
+	on_quantity( mhood_t< so_5::stats::messages::quantity< std::size_t > > cmd )
+	{
+		namespace stats = so_5::stats;
+
+		if( stats::prefixes::timer_thread() == cmd->m_prefix &&
+				stats::suffixes::timer_fired_per_tick() == cmd->m_suffix )
+		{
+			ensure_or_die( 0u != cmd->m_value,
+					"fired_per_tick is expected to be non-zero" );
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+do_test(
+	const char * case_name,
+	std::function< so_5::timer_thread_factory_t() > factory )
+{
+	std::cout << case_name << "..." << std::flush;
+
+	push_calls = 0;
+	demands_in_batches = 0;
+
+	counting_event_queue_hook_t hook;
+
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			env.register_agent_as_coop( env.make_agent< a_test_t >() );
+		},
+		[&]( so_5::environment_params_t & params ) {
+			params.timer_thread( factory() );
+			params.event_queue_hook(
+					so_5::event_queue_hook_unique_ptr_t(
+							&hook,
+							&so_5::event_queue_hook_t::noop_deleter ) );
+		} );
+
+	std::cout << " push: " << push_calls
+			<< ", demands in batches: " << demands_in_batches
+			<< std::endl;
+
+	ensure_or_die( messages_count == push_calls + demands_in_batches,
+			"unexpected count of pushed demands" );
+	// All timers are scheduled at almost the same time. So there must
+	// be ticks with several elapsed timers.
+	ensure_or_die( 0 != demands_in_batches,
+			"some messages are expected to be delivered as batches" );
+}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			do_test( "timer_wheel",
+					[] { return so_5::timer_wheel_factory(); } );
+			do_test( "timer_hierarchical_wheel",
+					[] { return so_5::timer_hierarchical_wheel_factory(); } );
+			do_test( "sharded_timer_wheel",
+					[] { return so_5::sharded_timer_wheel_factory( 2u ); } );
+		},
+		60 );
+
+	return 0;
+}
@@ -9,6 +9,10 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/single_periodic/prj.ut.rb" 
 	required_prj "#{path}/single_timer_zero_delay/prj.ut.rb" 
 	required_prj "#{path}/timers_cancelation/prj.ut.rb" 
+	required_prj "#{path}/sharded_wheel/prj.ut.rb"
+	required_prj "#{path}/hierarchical_wheel/prj.ut.rb"
+	required_prj "#{path}/batch_delivery/prj.ut.rb"
+	required_prj "#{path}/preallocated_timers/prj.ut.rb"
 	required_prj "#{path}/overloaded_mchain/prj.ut.rb" 
 	required_prj "#{path}/overloaded_mchain_2/prj.ut.rb" 
 	required_prj "#{path}/resend_periodic_signal_via_mhood/prj.ut.rb" 
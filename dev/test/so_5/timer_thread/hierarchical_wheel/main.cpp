@@ -0,0 +1,266 @@
+/*
+ * A test for hierarchical timer_wheel thread: delayed messages with
+ * pauses from different levels of the wheel (including pauses which
+ * are longer than the range of the top level) and cancellation of
+ * very long timers.
+ *
+ * There is also a check for timers which are activated when level 0
+ * of the wheel is empty and the timer thread sleeps until the next
+ * cascading. Such timers must not fire before their pauses.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using clock_type = std::chrono::steady_clock;
+
+struct msg_delayed final : public so_5::message_t
+	{
+		const std::chrono::milliseconds m_pause;
+
+		explicit msg_delayed( std::chrono::milliseconds pause )
+			:	m_pause{ pause }
+			{}
+	};
+
+struct msg_periodic final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t(
+			context_t ctx,
+			std::chrono::milliseconds granularity )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_granularity{ granularity }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_test_t::evt_delayed )
+					.event( &a_test_t::evt_periodic );
+			}
+
+		void
+		so_evt_start() override
+			{
+				m_started_at = clock_type::now();
+
+				// Pauses are sent in reverse order to check that
+				// messages arrive in order of pauses.
+				for( auto it = m_pauses.rbegin(); it != m_pauses.rend(); ++it )
+					so_5::send_delayed< msg_delayed >( *this, *it, *it );
+
+				// These timers must be cancelled before the first message.
+				for( auto pause : { 1h, 10h } )
+				{
+					auto cancelled = so_5::send_periodic< msg_periodic >(
+							*this, pause, 0ms );
+					cancelled.release();
+				}
+
+				m_periodic = so_5::send_periodic< msg_periodic >(
+						*this, 3ms, 3ms );
+			}
+
+	private :
+		const std::chrono::milliseconds m_granularity;
+
+		const std::vector< std::chrono::milliseconds > m_pauses{
+				1ms, 7ms, 30ms, 100ms, 600ms, 1500ms
+			};
+
+		clock_type::time_point m_started_at;
+
+		std::size_t m_received_delayed = 0u;
+		int m_received_periodic = 0;
+
+		so_5::timer_id_t m_periodic;
+
+		void
+		evt_delayed( mhood_t< msg_delayed > cmd )
+			{
+				const auto elapsed = clock_type::now() - m_started_at;
+
+				ensure( m_pauses[ m_received_delayed ] == cmd->m_pause,
+						"unexpected order of delayed messages, expected pause: " +
+						std::to_string( m_pauses[ m_received_delayed ].count() ) +
+						"ms, actual pause: " +
+						std::to_string( cmd->m_pause.count() ) + "ms" );
+
+				// Timer can be fired a little earlier because of
+				// rounding to the time steps.
+				ensure( elapsed + 2 * m_granularity >= cmd->m_pause,
+						"delayed message arrived too early, pause: " +
+						std::to_string( cmd->m_pause.count() ) + "ms" );
+
+				++m_received_delayed;
+				check_completion();
+			}
+
+		void
+		evt_periodic( mhood_t< msg_periodic > )
+			{
+				++m_received_periodic;
+				if( 5 == m_received_periodic )
+					m_periodic.release();
+				check_completion();
+			}
+
+		void
+		check_completion()
+			{
+				if( m_pauses.size() == m_received_delayed &&
+						5 <= m_received_periodic )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+class a_late_activation_test_t final : public so_5::agent_t
+	{
+		struct msg_check final : public so_5::message_t
+			{
+				const clock_type::time_point m_sent_at;
+
+				explicit msg_check( clock_type::time_point sent_at )
+					:	m_sent_at{ sent_at }
+					{}
+			};
+
+	public :
+		using so_5::agent_t::agent_t;
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_late_activation_test_t::evt_check );
+			}
+
+		void
+		so_evt_start() override
+			{
+				// The only long timer. Level 0 of the wheel is empty while
+				// there is no msg_check in flight.
+				m_long_timer = so_5::send_periodic< msg_periodic >(
+						*this, 1h, 1h );
+
+				send_next_check();
+			}
+
+	private :
+		const std::chrono::milliseconds m_pause{ 100ms };
+
+		// Pauses between checks to make activations at arbitrary
+		// moments of level 0 revolution.
+		const std::vector< std::chrono::milliseconds > m_sleeps{
+				7ms, 23ms, 41ms, 58ms, 13ms, 77ms, 3ms, 35ms
+			};
+
+		std::size_t m_checks_done = 0u;
+
+		so_5::timer_id_t m_long_timer;
+
+		void
+		evt_check( mhood_t< msg_check > cmd )
+			{
+				const auto elapsed = clock_type::now() - cmd->m_sent_at;
+
+				ensure( elapsed >= m_pause,
+						"delayed message arrived too early, elapsed: " +
+						std::to_string( std::chrono::duration_cast<
+								std::chrono::milliseconds >( elapsed ).count() ) +
+						"ms, check: " + std::to_string( m_checks_done ) );
+
+				++m_checks_done;
+				if( m_sleeps.size() == m_checks_done )
+				{
+					m_long_timer.release();
+					so_deregister_agent_coop_normally();
+				}
+				else
+					send_next_check();
+			}
+
+		void
+		send_next_check()
+			{
+				// Timer thread can sleep until the next cascading during
+				// that pause.
+				std::this_thread::sleep_for( m_sleeps[ m_checks_done ] );
+
+				so_5::send_delayed< msg_check >( *this, m_pause,
+						clock_type::now() );
+			}
+	};
+
+void
+do_test(
+	so_5::timer_thread_factory_t factory,
+	std::chrono::milliseconds granularity )
+	{
+		so_5::launch(
+			[granularity]( so_5::environment_t & env ) {
+				env.register_agent_as_coop(
+						env.make_agent< a_test_t >( granularity ) );
+			},
+			[&factory]( so_5::environment_params_t & params ) {
+				params.timer_thread( std::move(factory) );
+			} );
+	}
+
+void
+do_late_activation_test(
+	so_5::timer_thread_factory_t factory )
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.register_agent_as_coop(
+						env.make_agent< a_late_activation_test_t >() );
+			},
+			[&factory]( so_5::environment_params_t & params ) {
+				params.timer_thread( std::move(factory) );
+			} );
+	}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			std::cout << "default..." << std::flush;
+			do_test( so_5::timer_hierarchical_wheel_factory(), 1ms );
+			std::cout << "OK" << std::endl;
+
+			std::cout << "3 levels of 8 slots..." << std::flush;
+			do_test( so_5::timer_hierarchical_wheel_factory( 3u, 8u, 1ms ), 1ms );
+			std::cout << "OK" << std::endl;
+
+			std::cout << "2 levels of 4 slots..." << std::flush;
+			do_test( so_5::timer_hierarchical_wheel_factory( 2u, 4u, 2ms ), 2ms );
+			std::cout << "OK" << std::endl;
+
+			std::cout << "late activation, default..." << std::flush;
+			do_late_activation_test( so_5::timer_hierarchical_wheel_factory() );
+			std::cout << "OK" << std::endl;
+
+			std::cout << "late activation, 3 levels of 8 slots..." << std::flush;
+			do_late_activation_test(
+					so_5::timer_hierarchical_wheel_factory( 3u, 8u, 1ms ) );
+			std::cout << "OK" << std::endl;
+		},
+		60 );
+
+	return 0;
+}
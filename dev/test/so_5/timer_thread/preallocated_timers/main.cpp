@@ -0,0 +1,178 @@
+/*
+ * A test for timer threads with preallocated timer objects.
+ *
+ * The count of timers exceeds the size of the pool, so some timer
+ * objects are taken from the pool and some are allocated individually.
+ * It's checked for anonymous timers and for timers with timer_id_t.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+struct msg_delayed final : public so_5::signal_t {};
+
+struct msg_periodic final : public so_5::signal_t {};
+
+struct msg_cancelled final : public so_5::signal_t {};
+
+struct msg_identified final : public so_5::signal_t {};
+
+constexpr std::size_t pool_size = 64u;
+constexpr int delayed_messages = 1000;
+constexpr int rounds = 3;
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t( context_t ctx )
+			:	so_5::agent_t{ std::move(ctx) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_test_t::evt_delayed )
+					.event( &a_test_t::evt_periodic )
+					.event( &a_test_t::evt_identified )
+					.event( []( mhood_t< msg_cancelled > ) {
+							throw std::runtime_error( "msg_cancelled received" );
+						} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				start_round();
+			}
+
+	private :
+		int m_round = 0;
+		int m_received_delayed = 0;
+		int m_received_periodic = 0;
+		int m_received_identified = 0;
+
+		so_5::timer_id_t m_periodic;
+
+		// Timers that are alive until the end of a round.
+		std::vector< so_5::timer_id_t > m_identified;
+
+		void
+		start_round()
+			{
+				m_received_delayed = 0;
+				m_received_periodic = 0;
+				m_received_identified = 0;
+
+				for( int i = 0; i != delayed_messages; ++i )
+					so_5::send_delayed< msg_delayed >( *this, 10ms );
+
+				// Objects behind timer_id_t are returned to the pool
+				// only at the end of the round.
+				m_identified.reserve( delayed_messages );
+				for( int i = 0; i != delayed_messages; ++i )
+					m_identified.push_back( so_5::send_periodic< msg_identified >(
+							*this, 10ms, 0ms ) );
+
+				// Timer objects of those timers are returned to the pool
+				// before the delivery.
+				for( int i = 0; i != delayed_messages; ++i )
+					{
+						auto id = so_5::send_periodic< msg_cancelled >(
+								*this, 1h, 0ms );
+						id.release();
+					}
+
+				m_periodic = so_5::send_periodic< msg_periodic >(
+						*this, 5ms, 5ms );
+			}
+
+		void
+		evt_delayed( mhood_t< msg_delayed > )
+			{
+				++m_received_delayed;
+				check_completion();
+			}
+
+		void
+		evt_periodic( mhood_t< msg_periodic > )
+			{
+				++m_received_periodic;
+				if( 3 == m_received_periodic )
+					m_periodic.release();
+				check_completion();
+			}
+
+		void
+		evt_identified( mhood_t< msg_identified > )
+			{
+				++m_received_identified;
+				check_completion();
+			}
+
+		void
+		check_completion()
+			{
+				if( delayed_messages == m_received_delayed &&
+						delayed_messages == m_received_identified &&
+						3 == m_received_periodic )
+					{
+						m_identified.clear();
+
+						if( rounds == ++m_round )
+							so_deregister_agent_coop_normally();
+						else
+							start_round();
+					}
+			}
+	};
+
+void
+do_test(
+	const char * case_name,
+	std::function< so_5::timer_thread_factory_t() > factory )
+	{
+		std::cout << case_name << "..." << std::flush;
+
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.register_agent_as_coop( env.make_agent< a_test_t >() );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				params.timer_thread( factory() );
+				params.timer_objects_preallocation( pool_size );
+			} );
+
+		std::cout << "OK" << std::endl;
+	}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			do_test( "timer_wheel",
+					[] { return so_5::timer_wheel_factory(); } );
+			do_test( "timer_heap",
+					[] { return so_5::timer_heap_factory(); } );
+			do_test( "timer_list",
+					[] { return so_5::timer_list_factory(); } );
+			do_test( "timer_hierarchical_wheel",
+					[] { return so_5::timer_hierarchical_wheel_factory(); } );
+			do_test( "sharded_timer_wheel",
+					[] { return so_5::sharded_timer_wheel_factory( 3u ); } );
+		},
+		60 );
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * A test for sharded timer_wheel thread: delayed and periodic messages
+ * are scheduled from several threads at the same time.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace std::chrono_literals;
+
+struct msg_delayed final : public so_5::signal_t {};
+
+struct msg_periodic final : public so_5::signal_t {};
+
+struct msg_sender_finished final : public so_5::signal_t {};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t(
+			context_t ctx,
+			so_5::mbox_t manager,
+			int delayed_messages )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_manager{ std::move(manager) }
+			,	m_delayed_messages{ delayed_messages }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_sender_t::evt_delayed )
+					.event( &a_sender_t::evt_periodic );
+			}
+
+		void
+		so_evt_start() override
+			{
+				for( int i = 0; i != m_delayed_messages; ++i )
+					so_5::send_delayed< msg_delayed >( *this, 20ms );
+
+				// This timer must be cancelled before the first message.
+				auto cancelled = so_5::send_periodic< msg_periodic >(
+						*this, 1h, 0ms );
+				cancelled.release();
+
+				m_periodic = so_5::send_periodic< msg_periodic >(
+						*this, 10ms, 10ms );
+			}
+
+	private :
+		const so_5::mbox_t m_manager;
+		const int m_delayed_messages;
+
+		int m_received_delayed = 0;
+		int m_received_periodic = 0;
+
+		so_5::timer_id_t m_periodic;
+
+		void
+		evt_delayed( mhood_t< msg_delayed > )
+			{
+				++m_received_delayed;
+				check_completion();
+			}
+
+		void
+		evt_periodic( mhood_t< msg_periodic > )
+			{
+				++m_received_periodic;
+				if( 3 == m_received_periodic )
+					m_periodic.release();
+				check_completion();
+			}
+
+		void
+		check_completion()
+			{
+				if( m_delayed_messages == m_received_delayed &&
+						3 == m_received_periodic )
+					so_5::send< msg_sender_finished >( m_manager );
+			}
+	};
+
+class a_manager_t final : public so_5::agent_t
+	{
+	public :
+		a_manager_t( context_t ctx, int senders )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_senders{ senders }
+			{
+				so_subscribe_self().event( [this]( mhood_t< msg_sender_finished > ) {
+						if( 0 == --m_senders )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+	private :
+		int m_senders;
+	};
+
+const int senders = 8;
+const int delayed_messages = 1000;
+
+void
+do_test( std::size_t shards )
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.introduce_coop(
+						so_5::disp::active_obj::make_dispatcher( env ).binder(),
+						[]( so_5::coop_t & coop ) {
+							auto manager = coop.make_agent< a_manager_t >( senders );
+							for( int i = 0; i != senders; ++i )
+								coop.make_agent< a_sender_t >(
+										manager->so_direct_mbox(),
+										delayed_messages );
+						} );
+			},
+			[shards]( so_5::environment_params_t & params ) {
+				params.timer_thread( so_5::sharded_timer_wheel_factory(
+						shards, 128u, 5ms ) );
+			} );
+	}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			for( std::size_t shards : { 0u, 1u, 3u, 8u } )
+			{
+				std::cout << "shards: " << shards << "..." << std::flush;
+				do_test( shards );
+				std::cout << "OK" << std::endl;
+			}
+		},
+		60 );
+
+	return 0;
+}
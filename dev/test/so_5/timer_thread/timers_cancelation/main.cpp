@@ -125,6 +125,16 @@ main()
 		check_factory( "timer_heap_factory", so_5::timer_heap_factory() );
 		check_factory( "timer_heap_factory(2048)",
 				so_5::timer_heap_factory( 2048 ) );
+		check_factory( "sharded_timer_wheel_factory(4)",
+				so_5::sharded_timer_wheel_factory( 4 ) );
+		check_factory( "sharded_timer_wheel_factory(2,20,1s)",
+				so_5::sharded_timer_wheel_factory(
+						2, 20, std::chrono::seconds(1) ) );
+		check_factory( "timer_hierarchical_wheel_factory",
+				so_5::timer_hierarchical_wheel_factory() );
+		check_factory( "timer_hierarchical_wheel_factory(2,20,1s)",
+				so_5::timer_hierarchical_wheel_factory(
+						2, 20, std::chrono::seconds(1) ) );
 
 		return 0;
 	}